@@ -1,10 +1,9 @@
 #pragma once
 
-#include <CRCpp/CRC.h>
-
 #include "Math/FPQuat.h"
 #include "Math/FPVector.h"
 #include "Physics/Collider.h"
+#include "Utilities/ChecksumHasher.h"
 #include "Utilities/FrameType.h"
 
 namespace ProjectNomad {
@@ -22,9 +21,9 @@ namespace ProjectNomad {
             return rotation * FPVector::forward();
         }
         
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            location.CalculateCRC32(resultThusFar);
-            rotation.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
@@ -40,25 +39,38 @@ namespace ProjectNomad {
             return velocity.x != fp{0} || velocity.y != fp{0};
         }
 
+        // Mass is followed by padding, so each field is checksummed on its own
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(mass);
+            hasher.Add(velocity);
+        }
+
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&mass, sizeof(mass), CRC::CRC_32(), resultThusFar);
-            velocity.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
     struct DynamicColliderComponent {
         Collider collider;
 
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(collider);
+        }
+
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            collider.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
     struct StaticColliderComponent {
         Collider collider;
         
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(collider);
+        }
+
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            collider.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
@@ -66,9 +78,9 @@ namespace ProjectNomad {
         FrameType startingFrame = 0;
         FrameType totalLength = 15;
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&startingFrame, sizeof(startingFrame), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&totalLength, sizeof(totalLength), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
@@ -80,8 +92,9 @@ namespace ProjectNomad {
     struct InvulnerableFlagComponent {
         bool throwaway = false;
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&throwaway, sizeof(throwaway), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "CRCpp/CRC.h"
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     // Create a component per player spot so don't need an explicit player spot to entity id mapping.
@@ -13,8 +13,9 @@ namespace ProjectNomad {
     struct PlayerSpotBaseComponent {
         bool throwaway = false; // Define some data as EnTT seems to not work well with empty types (at least as of 2022)
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&throwaway, sizeof(throwaway), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
     
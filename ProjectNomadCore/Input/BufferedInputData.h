@@ -1,10 +1,10 @@
 #pragma once
 
 #include <array>
-#include <CRCpp/CRC.h>
 
 #include "InputCommand.h"
 #include "CharacterInput.h"
+#include "Utilities/ChecksumHasher.h"
 #include "Utilities/FrameType.h"
 
 namespace ProjectNomad {
@@ -63,10 +63,14 @@ namespace ProjectNomad {
             }
         }
 
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(mSetFrame);
+            hasher.Add(mIsSet);
+            hasher.Add(mWasUsed);
+        }
+
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&mSetFrame, sizeof(mSetFrame), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&mIsSet, sizeof(mIsSet), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&mWasUsed, sizeof(mWasUsed), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
       private:
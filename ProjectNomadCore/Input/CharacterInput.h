@@ -1,12 +1,11 @@
 #pragma once
 
-#include <CRCpp/CRC.h>
-
 #include "CommandSetList.h"
 #include "GameplayInteractiveUIChoice.h"
 #include "Math/FixedPoint.h"
 #include "Math/FPVector.h"
 #include "Math/FPQuat.h"
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     /**
@@ -24,10 +23,10 @@ namespace ProjectNomad {
         //      where aim pos is derived from rotation. Can even make grapple-aim-startup anim frames which mask the discontinuity.
         //      Aside from smaller packet size, this helps with "prediction"! (Rollback frame count and replay compression)
         FPVector camPosition = {};
-        FPQuat camRotation = {}; // TODO: Compress down into  8bits per fp
+        FPQuat camRotation = {}; // Quantized to 8 bits per fp for network, see CharacterInputQuantizer
         
-        fp moveForward = fp{0}; // TODO: Compress down into  8bits per fp
-        fp moveRight = fp{0}; // TODO: Compress down into  8bits per fp
+        fp moveForward = fp{0}; // Quantized to 8 bits for network, see CharacterInputQuantizer
+        fp moveRight = fp{0}; // Quantized to 8 bits for network, see CharacterInputQuantizer
 
         GameplayInteractiveUIChoice uiChoice =  GameplayInteractiveUIChoice::None;
         
@@ -35,15 +34,20 @@ namespace ProjectNomad {
         // Nice to abstract away independent buttons vs actual action commands
         CommandSetList commandInputs = {}; // TODO: Compress down into 16bits rather than 32bits
 
-        void CalculateCRC32(uint32_t& resultThusFar) const {
-            camPosition.CalculateCRC32(resultThusFar);
-            camRotation.CalculateCRC32(resultThusFar);
+        // UI choice is followed by padding, so can't simply checksum entire struct as is
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(camPosition);
+            hasher.Add(camRotation);
             
-            resultThusFar = CRC::Calculate(&moveForward, sizeof(moveForward), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&moveRight, sizeof(moveRight), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&uiChoice, sizeof(uiChoice), CRC::CRC_32(), resultThusFar);
+            hasher.Add(moveForward);
+            hasher.Add(moveRight);
+            hasher.Add(uiChoice);
             
-            commandInputs.CalculateCRC32(resultThusFar);
+            hasher.Add(commandInputs);
+        }
+
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
     };
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <algorithm>
+
+#include "CharacterInput.h"
+#include "Math/FixedPoint.h"
+
+namespace ProjectNomad {
+    /**
+    * Reduces precision of CharacterInput's axis-like values (movement axes + camera rotation) to 8 bits each, so that
+    * they can be sent over the network as single bytes.
+    *
+    * To stay deterministic, the sender must simulate with the quantized input rather than the original input. Thus
+    * Quantize is expected to be applied before the input is ever used, and quantizing is idempotent so that encoding
+    * an already quantized value always results in the exact same code (and thus the exact same decoded value).
+    *
+    * Quantization is done purely via integer math on fp's raw values, so results are identical on every platform.
+    * Note that quantized rotations are not exactly unit length (each component may be off by up to 1/254). Any code
+    * which requires unit length should normalize, which is fine as every peer then normalizes the exact same value.
+    **/
+    class CharacterInputQuantizer {
+      public:
+        CharacterInputQuantizer() = delete;
+
+        // Codes are in range [-kMaxCode, kMaxCode] to represent values in range [-1, 1]
+        static constexpr int64_t kMaxCode = 127;
+
+        static void Quantize(CharacterInput& input) {
+            input.moveForward = FromCode(ToCode(input.moveForward));
+            input.moveRight = FromCode(ToCode(input.moveRight));
+
+            input.camRotation.w = FromCode(ToCode(input.camRotation.w));
+            input.camRotation.v.x = FromCode(ToCode(input.camRotation.v.x));
+            input.camRotation.v.y = FromCode(ToCode(input.camRotation.v.y));
+            input.camRotation.v.z = FromCode(ToCode(input.camRotation.v.z));
+        }
+
+        /**
+        * Converts value in range [-1, 1] to nearest 8 bit code. Values outside that range are clamped
+        * @param value - value to convert
+        * @returns code in range [-kMaxCode, kMaxCode]
+        **/
+        static int8_t ToCode(fp value) {
+            const int64_t clampedRaw = std::clamp(value.raw_value(), -kOneRaw, kOneRaw);
+
+            // Round half away from zero. Done manually as integer division truncates towards zero
+            const int64_t scaled = clampedRaw * kMaxCode;
+            const int64_t rounded = scaled >= 0 ? (scaled + kOneRaw / 2) / kOneRaw : (scaled - kOneRaw / 2) / kOneRaw;
+            return static_cast<int8_t>(rounded);
+        }
+
+        static fp FromCode(int8_t code) {
+            // Truncation here is always less than 1/kMaxCode of a raw unit, so ToCode rounds back to same code
+            return fp::from_raw_value(static_cast<int64_t>(code) * kOneRaw / kMaxCode);
+        }
+
+      private:
+        static constexpr int64_t kOneRaw = fp{1}.raw_value();
+    };
+}
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <array>
-#include <CRCpp/CRC.h>
 
 #include "BufferedInputData.h"
 #include "InputCommand.h"
 #include "CharacterInput.h"
+#include "Utilities/ChecksumHasher.h"
 #include "Utilities/FrameType.h"
 
 namespace ProjectNomad {
@@ -44,12 +44,13 @@ namespace ProjectNomad {
             return mRawCommandInputs.IsCommandSet(command);
         }
 
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(mRawCommandInputs);
+            hasher.AddRange(mBufferedInputs.data(), mBufferedInputs.size());
+        }
+
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            mRawCommandInputs.CalculateCRC32(resultThusFar);
-            
-            for (auto& bufferedInput : mBufferedInputs) {
-                bufferedInput.CalculateCRC32(resultThusFar);
-            }
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
       private:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "InputCommand.h"
+#include "Utilities/ChecksumHasher.h"
 #include "Utilities/Containers/NumericBitSet.h"
 
 namespace ProjectNomad {
@@ -20,8 +21,9 @@ namespace ProjectNomad {
             return commandInputs.GetIndex(ToIndex(command));
         }
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            commandInputs.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
         uint16_t Serialize() const {
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <CRCpp/CRC.h>
 #include "FixedPoint.h"
+#include "Utilities/ChecksumHasher.h"
 
 /* TODO
 * fromQuat
@@ -36,10 +36,9 @@ namespace ProjectNomad {
             return result;
         }
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&roll, sizeof(roll), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&pitch, sizeof(pitch), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&yaw, sizeof(yaw), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
         std::string toString() const {
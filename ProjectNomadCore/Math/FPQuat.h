@@ -67,9 +67,9 @@ namespace ProjectNomad {
             return input + vCrossInput * (2 * w) + v.cross(vCrossInput) * fp{2};
         }
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&w, sizeof(w), CRC::CRC_32(), resultThusFar);
-            v.CalculateCRC32(resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
         std::string toString() const {
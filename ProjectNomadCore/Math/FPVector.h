@@ -1,10 +1,10 @@
 #pragma once
 
 #include <iostream>
-#include <CRCpp/CRC.h>
 
 #include "FixedPoint.h"
 #include "FPMath.h"
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     class FPVector {
@@ -183,10 +183,9 @@ namespace ProjectNomad {
             return dot(other) < fp{0};
         }
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&x, sizeof(x), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&y, sizeof(y), CRC::CRC_32(), resultThusFar);
-            resultThusFar = CRC::Calculate(&z, sizeof(z), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
         std::string toString() const {
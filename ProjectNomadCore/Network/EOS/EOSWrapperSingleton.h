@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <span>
 #include <string>
+#include <vector>
 #include <EOS/Include/eos_logging.h>
 #include <EOS/Include/eos_init.h>
 #include <EOS/Include/eos_auth.h>
@@ -14,6 +18,7 @@
 #include "Model/CrossPlatformIdWrapper.h"
 #include "Model/EpicAccountIdWrapper.h"
 #include "Model/NetLobbySlot.h"
+#include "Model/P2PReceiveStats.h"
 #include "Model/PacketReliability.h"
 #include "Model/EOSLobbyTracking.h"
 #include "Secrets/NetworkSecrets.h"
@@ -213,6 +218,22 @@ namespace ProjectNomad {
             mEosWrapperManager = iEOSWrapperManager;
         }
 
+        /**
+        * Sets max number of packets to receive per Tick. Any packets beyond this are left queued for next Tick, so that
+        * a flood of packets can't stall the game thread indefinitely.
+        * @param maxPacketsReceivedPerTick - budget per tick. Expected to be at least 1
+        **/
+        void SetMaxPacketsReceivedPerTick(uint32_t maxPacketsReceivedPerTick) {
+            if (maxPacketsReceivedPerTick == 0) {
+                mLogger.AddWarnNetLog("Budget must be at least 1, otherwise no packets would ever be received");
+                return;
+            }
+            mMaxPacketsReceivedPerTick = maxPacketsReceivedPerTick;
+        }
+        const P2PReceiveStats& GetReceiveStats() const {
+            return mReceiveStats;
+        }
+
         void ShowFriendsUI() {
             if (!IsInitialized()) {
                 mLogger.AddWarnNetLog("Not initialized");
@@ -290,6 +311,55 @@ namespace ProjectNomad {
             
             return true; // Message successfully queued up to send
         }
+        /**
+        * Sends the same message to multiple players. Login state and send options are only checked + built once, as
+        * this is used for every-frame broadcasts (eg, inputs to all other players in match).
+        * @param targetIds - ids of players to send to
+        * @param numTargets - number of ids in targetIds. Expected to be no more than 32
+        * @param data - message data
+        * @param dataLengthInBytes - message size
+        * @param packetReliability - delivery guarantees for this message
+        * @returns bitmask where bit i is set if message was not queued for targetIds[i]. 0 if queued for all targets
+        **/
+        uint32_t SendP2PMessageToAll(const CrossPlatformIdWrapper* targetIds,
+                                     uint32_t numTargets,
+                                     const void* data,
+                                     uint32_t dataLengthInBytes,
+                                     PacketReliability packetReliability) {
+            const uint32_t allTargetsMask = numTargets >= 32 ? ~0u : (1u << numTargets) - 1;
+            if (!IsFullyLoggedIn()) {
+                mLogger.AddWarnNetLog("Not cross platform logged in");
+                return allTargetsMask;
+            }
+
+            EOS_HP2P p2pHandle = EOS_Platform_GetP2PInterface(mPlatformHandle);
+
+            EOS_P2P_SocketId socketId;
+            socketId.ApiVersion = EOS_P2P_SOCKETID_API_LATEST;
+            strncpy_s(socketId.SocketName, "CHAT", 5); //  TODO: Socket input
+
+            EOS_P2P_SendPacketOptions options; // Same as SendP2PMessage, other than RemoteUserId set per target below
+            options.ApiVersion = EOS_P2P_SENDPACKET_API_LATEST;
+            options.LocalUserId = mLoggedInCrossPlatformId.GetAccountId();
+            options.SocketId = &socketId;
+            options.bAllowDelayedDelivery = EOS_TRUE; // PLACEHOLDER: Set to false once separately setting up connections
+            options.Channel = 0;
+            options.Reliability = EOSHelpers::ConvertPacketReliability(mLogger, packetReliability);
+            options.bDisableAutoAcceptConnection = EOS_FALSE;
+            options.DataLengthBytes = dataLengthInBytes;
+            options.Data = data;
+
+            uint32_t failedTargetsMask = 0;
+            for (uint32_t i = 0; i < numTargets && i < 32; i++) {
+                options.RemoteUserId = targetIds[i].GetAccountId();
+                if (!targetIds[i].IsValid() || EOS_P2P_SendPacket(p2pHandle, &options) != EOS_EResult::EOS_Success) {
+                    failedTargetsMask |= 1u << i;
+                }
+            }
+
+            // No logging here, as caller owns the failure mask and thus decides how to report failed targets
+            return failedTargetsMask;
+        }
 
         #pragma region Debug/Testing Methods
         void TestSendMessage(const std::string& targetCrossPlatformId, const std::string& message) {
@@ -1156,41 +1226,75 @@ namespace ProjectNomad {
             }
 
             EOS_HP2P p2pHandle = EOS_Platform_GetP2PInterface(mPlatformHandle);
+            mReceiveStats.queuedPacketsAtLastTick = GetIncomingPacketQueueCount(p2pHandle);
+            mReceiveStats.packetsDrainedLastTick = 0;
 
             EOS_P2P_ReceivePacketOptions options;
             options.ApiVersion = EOS_P2P_RECEIVEPACKET_API_LATEST;
             options.LocalUserId = mLoggedInCrossPlatformId.GetAccountId();
-            options.MaxDataSizeBytes = 4096; // Very future optimization: Decrease to around the expected max message size
+            options.MaxDataSizeBytes = EOS_P2P_MAX_PACKET_SIZE; // SDK never delivers larger packets
             options.RequestedChannel = nullptr;
 
             EOS_P2P_SocketId socketId;
             socketId.ApiVersion = EOS_P2P_SOCKETID_API_LATEST;
             uint8_t channel = 0;
 
-            std::vector<char> messageData;
-            messageData.resize(options.MaxDataSizeBytes); // Optimization: Initialize to this size already?
-            uint32_t bytesWritten = 0;
+            // Drain every queued packet (up to budget), as leaving packets queued delays their inputs by whole frames
+            bool didEmptyQueue = false;
+            while (mReceiveStats.packetsDrainedLastTick < mMaxPacketsReceivedPerTick) {
+                uint32_t bytesWritten = 0;
 
-            EOS_ProductUserId peerId;
-            EOS_EResult result = EOS_P2P_ReceivePacket(p2pHandle, &options, &peerId, &socketId, &channel,
-                messageData.data(), &bytesWritten);
-            
-            if (result == EOS_EResult::EOS_NotFound) {
-                // No more packets, potential expected case. Nothing to do
-            }
-            else if (result != EOS_EResult::EOS_Success) {
-                mLogger.AddErrorNetLog("Receiving packet failed with result: " + EOSHelpers::ResultCodeToString(result));
-            }
-            else { // Success case!
-                // Chop off unused data at end of array so we don't need to pass around bytes written as well.
-                //      FUTURE: Double check performance on this. Apparently linear, following quote from: https://en.cppreference.com/w/cpp/container/vector/resize
-                //      "Linear in the difference between the current size and count." (Plus note about reallocation cost)
-                messageData.resize(bytesWritten);
+                EOS_ProductUserId peerId;
+                EOS_EResult result = EOS_P2P_ReceivePacket(p2pHandle, &options, &peerId, &socketId, &channel,
+                    mReceiveBuffer.data(), &bytesWritten);
                 
+                if (result == EOS_EResult::EOS_NotFound) {
+                    // No more packets, expected case
+                    didEmptyQueue = true;
+                    break;
+                }
+                if (result != EOS_EResult::EOS_Success) {
+                    mLogger.AddErrorNetLog("Receiving packet failed with result: " + EOSHelpers::ResultCodeToString(result));
+                    didEmptyQueue = true; // Not actually empty, but no reason to count this as hitting the budget
+                    break;
+                }
+
+                mReceiveStats.packetsDrainedLastTick++;
+                mReceiveStats.totalPacketsReceived++;
+
+                // Only pass on the written part of the fixed size buffer, so nothing is resized or cleared per packet
                 if (mEosWrapperManager) {
-                    mEosWrapperManager->OnMessageReceived(CrossPlatformIdWrapper(peerId), messageData);
+                    mEosWrapperManager->OnMessageReceived(
+                        CrossPlatformIdWrapper(peerId), std::span<const char>(mReceiveBuffer.data(), bytesWritten)
+                    );
                 }
+
+                // Handling a message could theoretically result in logging out, in which case stop as can't receive
+                if (!IsFullyLoggedIn()) {
+                    didEmptyQueue = true;
+                    break;
+                }
+            }
+
+            if (!didEmptyQueue) {
+                mReceiveStats.ticksBudgetExceeded++;
             }
+            mReceiveStats.maxPacketsDrainedInOneTick = std::max(
+                mReceiveStats.maxPacketsDrainedInOneTick, mReceiveStats.packetsDrainedLastTick
+            );
+        }
+        uint64_t GetIncomingPacketQueueCount(EOS_HP2P p2pHandle) {
+            EOS_P2P_GetPacketQueueInfoOptions options;
+            options.ApiVersion = EOS_P2P_GETPACKETQUEUEINFO_API_LATEST;
+
+            EOS_P2P_PacketQueueInfo queueInfo = {};
+            EOS_EResult result = EOS_P2P_GetPacketQueueInfo(p2pHandle, &options, &queueInfo);
+            if (result != EOS_EResult::EOS_Success) {
+                mLogger.AddWarnNetLog("Getting packet queue info failed with result: " + EOSHelpers::ResultCodeToString(result));
+                return 0;
+            }
+
+            return queueInfo.IncomingPacketQueueCurrentPacketCount;
         }
         #pragma endregion
 
@@ -1859,6 +1963,12 @@ namespace ProjectNomad {
 
         IEOSWrapperManager* mEosWrapperManager = nullptr;
 
+        // P2P receiving. Budget is generous as handling a packet is cheap, while an undrained queue delays inputs
+        static constexpr uint32_t kDefaultMaxPacketsReceivedPerTick = 64;
+        uint32_t mMaxPacketsReceivedPerTick = kDefaultMaxPacketsReceivedPerTick;
+        std::array<char, EOS_P2P_MAX_PACKET_SIZE> mReceiveBuffer = {}; // Reused for every packet, as SDK never delivers larger packets
+        P2PReceiveStats mReceiveStats = {};
+
         // Current user state
         EpicAccountIdWrapper mLoggedInEpicAccountId = {};
         CrossPlatformIdWrapper mLoggedInCrossPlatformId = {};
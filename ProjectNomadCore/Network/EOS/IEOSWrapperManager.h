@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "Model/CrossPlatformIdWrapper.h"
 #include "Model/EOSLobbyProperties.h"
 #include "Model/EOSPlayersInfoTracking.h"
@@ -11,7 +13,8 @@ namespace ProjectNomad {
 
         virtual void OnLoginSuccess(const CrossPlatformIdWrapper& loggedInCrossPlatformId) = 0;
         virtual void OnLogoutSuccess() = 0;
-        virtual void OnMessageReceived(const CrossPlatformIdWrapper& peerId, const std::vector<char>& messageData) = 0;
+        // messageData is only valid for duration of the call
+        virtual void OnMessageReceived(const CrossPlatformIdWrapper& peerId, std::span<const char> messageData) = 0;
 
         virtual void OnAllPlayerInfoQueriesCompleted(const EOSPlayersInfoTracking& playersInfoTracking) = 0;
         
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ProjectNomad {
+    /**
+    * Counters for how well incoming P2P packets are keeping up, as packets left in the queue delay inputs by whole
+    * frames (and thus cause stalls and deeper rollbacks)
+    **/
+    struct P2PReceiveStats {
+        // Incoming packets queued at start of latest tick, before draining any
+        uint64_t queuedPacketsAtLastTick = 0;
+        // Packets received (drained from queue) during latest tick
+        uint32_t packetsDrainedLastTick = 0;
+        // Most packets drained during a single tick so far
+        uint32_t maxPacketsDrainedInOneTick = 0;
+        // Ticks which stopped draining due to hitting the per tick budget rather than emptying the queue.
+        //      If this keeps increasing, then budget is likely too low for current number of peers.
+        uint64_t ticksBudgetExceeded = 0;
+        uint64_t totalPacketsReceived = 0;
+    };
+}
@@ -13,7 +13,8 @@ namespace ProjectNomad {
         virtual void OnLoginStatusChanged() {}
 
         /**
-        * Callback when receiving a peer-to-peer message from another player.
+        * Callback when receiving a peer-to-peer message from another player, for message types without a typed
+        * handler registered (see SimNetworkManager::RegisterP2PMessageHandler, which is preferred as it validates once).
         * @param senderId - Message sender's id
         * @param messageType - Message identifier which was already retrieved from first byte(s) of message data
         * @param messageData - Unvalidated raw message from other player. Should validate size before using data!
@@ -18,6 +18,8 @@ namespace ProjectNomad {
 
         // Detailed lobby members info
         std::vector<CrossPlatformIdWrapper> lobbyMemberIds = {};
+        // Same as lobbyMemberIds but without local player. Cached as broadcasts to all other players happen every frame
+        std::vector<CrossPlatformIdWrapper> remoteMemberIds = {};
         std::unordered_map<CrossPlatformIdWrapper, NetPlayerInfo, EOSHashFunction> lobbyMembersInfoMap = {};
 
         NetPlayerSpotMapping playerSpotMapping = {};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "Network/EOS/Model/CrossPlatformIdWrapper.h"
+#include "Network/P2PMessages/BaseNetMessage.h"
+#include "Network/P2PMessages/NetMessageSerialization.h"
+
+namespace ProjectNomad {
+    enum class NetMessageDispatchResult : uint8_t {
+        Handled,
+        // No handler registered for message type, so caller should handle it some other way
+        NoHandler,
+        // Handler exists but message data was invalid for the message type (eg, wrong size from bad actors)
+        InvalidMessage
+    };
+
+    /**
+    * Dispatch table from NetMessageType to a typed handler.
+    * Message data is validated (and decoded if necessary) once here, so handlers directly receive the typed message
+    * struct rather than each handler needing to re-validate and cast raw data.
+    **/
+    class NetMessageDispatcher {
+      public:
+        // Decodes raw data into given message. Returns false if data is invalid for the message type
+        template <typename MessageType>
+        using Decoder = bool(*)(std::span<const char> messageData, MessageType& result);
+        template <typename MessageType>
+        using Handler = std::function<void(const CrossPlatformIdWrapper& senderId, const MessageType& message)>;
+
+        /**
+        * Registers handler for messages in their standard wire format (see NetMessageSerialization). Replaces any
+        * existing handler for the message type.
+        * @tparam MessageType - message struct. Message type is taken from its default constructed messageType value
+        * @param handler - called with decoded message. Message is only valid for duration of the call
+        **/
+        template <typename MessageType>
+        void RegisterHandler(Handler<MessageType> handler) {
+            Decoder<MessageType> decoder = &NetMessageSerialization::Decode<MessageType>;
+            RegisterHandler<MessageType>(decoder, std::move(handler));
+        }
+
+        /**
+        * Registers handler with a specific decoder, such as for tests. Replaces any existing handler for the message type.
+        * @param decoder - decodes raw data into message struct
+        * @param handler - called with decoded message. Message is only valid for duration of the call
+        **/
+        template <typename MessageType>
+        void RegisterHandler(Decoder<MessageType> decoder, Handler<MessageType> handler) {
+            static_assert(std::is_base_of_v<BaseNetMessage, MessageType>, "MessageType must inherit from BaseNetMessage");
+
+            // Decoded message is kept around and reused, as some messages are too large to comfortably put on the stack
+            //      every time and would otherwise need an allocation per message
+            auto decodedMessage = std::make_shared<MessageType>();
+            mHandlers[ToIndex(MessageType().messageType)] =
+                [decoder, handler = std::move(handler), decodedMessage](const CrossPlatformIdWrapper& senderId,
+                                                                         std::span<const char> messageData) {
+                    if (!decoder(messageData, *decodedMessage)) {
+                        return false;
+                    }
+
+                    handler(senderId, *decodedMessage);
+                    return true;
+                };
+        }
+
+        void UnregisterHandler(NetMessageType messageType) {
+            mHandlers[ToIndex(messageType)] = nullptr;
+        }
+        bool HasHandler(NetMessageType messageType) const {
+            return mHandlers[ToIndex(messageType)] != nullptr;
+        }
+
+        /**
+        * Passes message to the handler registered for its type, if any
+        * @param senderId - message sender's id
+        * @param messageType - message type, expected to already be validated from first byte of message data
+        * @param messageData - raw message data, including message type byte
+        * @returns whether message was handled. See NetMessageDispatchResult
+        **/
+        NetMessageDispatchResult Dispatch(const CrossPlatformIdWrapper& senderId,
+                                          NetMessageType messageType,
+                                          std::span<const char> messageData) const {
+            const auto& handler = mHandlers[ToIndex(messageType)];
+            if (!handler) {
+                return NetMessageDispatchResult::NoHandler;
+            }
+
+            return handler(senderId, messageData) ? NetMessageDispatchResult::Handled
+                                                  : NetMessageDispatchResult::InvalidMessage;
+        }
+
+      private:
+        using ErasedHandler = std::function<bool(const CrossPlatformIdWrapper& senderId, std::span<const char> messageData)>;
+
+        static size_t ToIndex(NetMessageType messageType) {
+            return static_cast<size_t>(messageType);
+        }
+
+        std::array<ErasedHandler, static_cast<size_t>(NetMessageType::ENUM_COUNT)> mHandlers = {};
+    };
+}
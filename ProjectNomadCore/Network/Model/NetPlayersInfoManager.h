@@ -37,6 +37,41 @@ namespace ProjectNomad {
             mPlayersInfo = {};
         }
 
+        /**
+        * Sets up state as if already logged in + in a locked lobby with given players, without going through EOS at all.
+        * Intended for headless simulation (eg, multiple peers within one process over a loopback transport).
+        * @param localPlayerId - local player's id
+        * @param playerIdsInSpotOrder - every player's id (including local player) in player spot order. First player hosts
+        **/
+        void SetFixedLobby(const CrossPlatformIdWrapper& localPlayerId,
+                           const std::vector<CrossPlatformIdWrapper>& playerIdsInSpotOrder) {
+            // Sanity check
+            if (playerIdsInSpotOrder.empty()) {
+                mLogger.AddWarnNetLog("NetPlayersInfoManager::SetFixedLobby", "No player ids given!");
+                return;
+            }
+
+            mPlayersInfo = {};
+            mPlayersInfo.isLoggedIn = true;
+            mPlayersInfo.localPlayerId = localPlayerId;
+
+            NetLobbyInfo& lobbyInfo = mPlayersInfo.netLobbyInfo; // For readability
+            lobbyInfo.isInLobby = true;
+            lobbyInfo.lobbyOwner = playerIdsInSpotOrder.front();
+            lobbyInfo.isLocalPlayerLobbyOwner = lobbyInfo.lobbyOwner == localPlayerId;
+            lobbyInfo.lobbyMaxMembers = static_cast<uint32_t>(playerIdsInSpotOrder.size());
+            lobbyInfo.lobbyMemberIds = playerIdsInSpotOrder;
+            for (const CrossPlatformIdWrapper& memberId : playerIdsInSpotOrder) {
+                if (memberId != localPlayerId) {
+                    lobbyInfo.remoteMemberIds.push_back(memberId);
+                }
+            }
+
+            // No host to receive mapping from, so every player simply uses given order. Locked as players never change
+            lobbyInfo.playerSpotMapping.SetMapping(mLogger, localPlayerId, lobbyInfo.lobbyOwner, playerIdsInSpotOrder);
+            lobbyInfo.playerSpotMapping.SetLock(true);
+        }
+
         void OnLobbyJoinOrCreationResult(bool didSucceed,
                                          const EOSLobbyProperties& lobbyProperties,
                                          const EOSPlayersInfoTracking& playersInfoTracking) {
@@ -172,6 +207,12 @@ namespace ProjectNomad {
             mPlayersInfo.netLobbyInfo.lobbyOwner = lobbyProperties.GetLobbyOwner();
             mPlayersInfo.netLobbyInfo.lobbyMaxMembers  = lobbyProperties.GetMaxMembers();
             mPlayersInfo.netLobbyInfo.lobbyMemberIds = lobbyProperties.GetMembersList(); // Expecting this to be very smol array of very smol types
+            mPlayersInfo.netLobbyInfo.remoteMemberIds.clear();
+            for (const CrossPlatformIdWrapper& memberId : mPlayersInfo.netLobbyInfo.lobbyMemberIds) {
+                if (memberId != mPlayersInfo.localPlayerId) {
+                    mPlayersInfo.netLobbyInfo.remoteMemberIds.push_back(memberId);
+                }
+            }
 
             // Do further post-processing on top of the initial copied data
             UpdateLobbyMembersGeneralInfo(playersInfoTracking);
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "Utilities/Containers/RingBuffer.h"
+
+namespace ProjectNomad {
+    struct PeerLatencyStats {
+        uint32_t sampleCount = 0;
+        uint64_t lastRttInMicroSec = 0;
+        // Exponentially smoothed round trip time, so single slow packets don't swing it much
+        uint64_t smoothedRttInMicroSec = 0;
+        // Smoothed deviation of samples from the smoothed RTT
+        uint64_t jitterInMicroSec = 0;
+        // Lowest RTT among recent samples. Closest to the link's actual latency, as queuing only ever adds delay
+        uint64_t minRttInMicroSec = 0;
+
+        bool HasSamples() const {
+            return sampleCount > 0;
+        }
+        // Assumes both directions are equally fast, as there's no way to measure each direction separately
+        uint64_t GetEstimatedOneWayDelayInMicroSec() const {
+            return smoothedRttInMicroSec / 2;
+        }
+    };
+
+    /**
+    * Estimates round trip time to a single peer from ping-pong samples (see TimeQualityReportMessage).
+    * Smoothing follows TCP's retransmission timer estimator (RFC 6298), with all math done on integers.
+    **/
+    class PeerLatencyEstimator {
+      public:
+        // Recent samples that min RTT covers. Roughly 16 seconds at the default time quality report frequency
+        static constexpr uint32_t kMinRttWindowSize = 16;
+
+        void AddRttSample(uint64_t rttInMicroSec) {
+            if (!mStats.HasSamples()) {
+                mStats.smoothedRttInMicroSec = rttInMicroSec;
+                mStats.jitterInMicroSec = rttInMicroSec / 2;
+            }
+            else {
+                const uint64_t deviation = rttInMicroSec > mStats.smoothedRttInMicroSec
+                                               ? rttInMicroSec - mStats.smoothedRttInMicroSec
+                                               : mStats.smoothedRttInMicroSec - rttInMicroSec;
+                // Jitter is updated with the old smoothed RTT, same as RFC 6298
+                mStats.jitterInMicroSec = (mStats.jitterInMicroSec * 3 + deviation) / 4;
+                mStats.smoothedRttInMicroSec = (mStats.smoothedRttInMicroSec * 7 + rttInMicroSec) / 8;
+            }
+
+            mStats.sampleCount++;
+            mStats.lastRttInMicroSec = rttInMicroSec;
+            mRecentRtts.Add(rttInMicroSec);
+            mStats.minRttInMicroSec = CalculateMinRecentRtt();
+        }
+
+        const PeerLatencyStats& GetStats() const {
+            return mStats;
+        }
+
+      private:
+        uint64_t CalculateMinRecentRtt() const {
+            const uint32_t numSamples = std::min(mStats.sampleCount, kMinRttWindowSize);
+
+            uint64_t result = mRecentRtts.Get(0);
+            for (uint32_t i = 1; i < numSamples; i++) {
+                result = std::min(result, mRecentRtts.Get(-static_cast<int>(i)));
+            }
+            return result;
+        }
+
+        PeerLatencyStats mStats = {};
+        RingBuffer<uint64_t, kMinRttWindowSize> mRecentRtts = {};
+    };
+}
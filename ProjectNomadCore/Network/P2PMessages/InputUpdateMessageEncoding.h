@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "NetMessageSerialization.h"
+#include "NetMessagesInput.h"
+#include "Input/CharacterInputQuantizer.h"
+#include "Utilities/BitStream.h"
+
+namespace ProjectNomad {
+    /**
+    * Compact wire format for InputUpdateMessage, as sending the raw struct wastes most of each packet.
+    *
+    * Format (bit packed, see BitWriter):
+    *   - Header (see NetMessageSerialization) + update frame (32 bits) + number of inputs (8 bits)
+    *   - Per player spot: 1 bit "has ack" flag, then ack's offset from update frame (variable length) if set
+    *   - Each included input from oldest to newest, delta encoded vs the prior (older) input. Oldest input is
+    *     encoded vs a default CharacterInput. Each input is either:
+    *       - 1 bit "same as prior input" flag, which is the common case as most inputs are held over many frames
+    *       - Otherwise a changed flag per field group followed by that group's data if changed:
+    *           - camPosition: variable length delta of each component's raw value (exact, not quantized)
+    *           - camRotation: 8 bit code per component (see CharacterInputQuantizer)
+    *           - moveForward/moveRight: 8 bit code each
+    *           - uiChoice: 8 bits
+    *           - commandInputs: 1 bit per command
+    *
+    * Axis values are quantized while encoding, so senders should quantize inputs before using them in simulation
+    * (see CharacterInputQuantizer). Otherwise the receiver would simulate with slightly different inputs.
+    **/
+    class InputUpdateMessageEncoding {
+      public:
+        InputUpdateMessageEncoding() = delete;
+
+        /**
+        * Encodes message into compact wire format
+        * @param message - message to encode
+        * @param result - buffer to write encoded message to. Existing contents are replaced but capacity is reused
+        **/
+        static void Encode(const InputUpdateMessage& message, std::vector<uint8_t>& result) {
+            BitWriter writer(result);
+            NetMessageSerialization::WriteHeader(writer, message.messageType);
+            // Only inputs that fit into the message are encoded, so write the clamped count to match
+            const FrameType numInputs = std::min(message.numInputs, kInputsHistorySize);
+            writer.WriteBits(message.updateFrame, kFrameBits);
+            writer.WriteBits(numInputs, kNumInputsBits);
+
+            for (FrameType ackedFrame : message.ackedFrames) {
+                const bool hasAck = ackedFrame != std::numeric_limits<FrameType>::max();
+                writer.WriteBool(hasAck);
+                if (hasAck) { // Usually a few frames behind update frame, so offset is far smaller than raw frame
+                    writer.WriteVarSigned(static_cast<int64_t>(message.updateFrame) - ackedFrame);
+                }
+            }
+
+            // Index 0 is newest, so go backwards to encode oldest first
+            CharacterInput previousInput = {};
+            for (FrameType i = numInputs; i > 0; i--) {
+                CharacterInput currentInput = message.playerInputs[i - 1];
+                CharacterInputQuantizer::Quantize(currentInput);
+
+                EncodeInput(writer, previousInput, currentInput);
+                previousInput = currentInput;
+            }
+        }
+
+        /**
+        * Decodes message from compact wire format
+        * @param data - encoded message
+        * @param sizeInBytes - size of encoded message
+        * @param result - decoded message. Only valid if decoding succeeded
+        * @returns true if data was a valid encoded InputUpdateMessage, false otherwise (eg, truncated or malformed data)
+        **/
+        static bool Decode(const uint8_t* data, size_t sizeInBytes, InputUpdateMessage& result) {
+            BitReader reader(data, sizeInBytes);
+            if (!NetMessageSerialization::ReadHeader(reader, NetMessageType::InputUpdate)) {
+                return false;
+            }
+            result.updateFrame = static_cast<FrameType>(reader.ReadBits(kFrameBits));
+            result.numInputs = static_cast<FrameType>(reader.ReadBits(kNumInputsBits));
+            if (result.numInputs == 0 || result.numInputs > kInputsHistorySize) {
+                return false;
+            }
+
+            for (FrameType& ackedFrame : result.ackedFrames) {
+                ackedFrame = std::numeric_limits<FrameType>::max();
+                if (reader.ReadBool()) {
+                    ackedFrame = static_cast<FrameType>(static_cast<int64_t>(result.updateFrame) - reader.ReadVarSigned());
+                }
+            }
+
+            CharacterInput previousInput = {};
+            for (FrameType i = result.numInputs; i > 0; i--) {
+                CharacterInput& currentInput = result.playerInputs[i - 1];
+                if (!DecodeInput(reader, previousInput, currentInput)) {
+                    return false;
+                }
+                previousInput = currentInput;
+            }
+
+            // Reject truncated data and trailing garbage, as either means data wasn't what we expected
+            return !reader.HasReadPastEnd() && reader.GetBytesRead() == sizeInBytes;
+        }
+
+        static bool Decode(std::span<const char> data, InputUpdateMessage& result) {
+            return Decode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), result);
+        }
+
+      private:
+        static constexpr uint32_t kFrameBits = sizeof(FrameType) * 8;
+        static constexpr uint32_t kNumInputsBits = 8;
+        static_assert(kInputsHistorySize < (1 << kNumInputsBits), "Number of inputs no longer fits in its bits");
+        static constexpr uint32_t kCodeBits = 8;
+        static constexpr uint32_t kUIChoiceBits = 8;
+        static constexpr uint32_t kCommandBits = static_cast<uint32_t>(InputCommand::ENUM_COUNT);
+
+        static void EncodeInput(BitWriter& writer, const CharacterInput& previous, const CharacterInput& current) {
+            const bool isSameAsPrevious = current == previous;
+            writer.WriteBool(isSameAsPrevious);
+            if (isSameAsPrevious) {
+                return;
+            }
+
+            const bool didCamPositionChange = current.camPosition != previous.camPosition;
+            writer.WriteBool(didCamPositionChange);
+            if (didCamPositionChange) {
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.x, current.camPosition.x));
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.y, current.camPosition.y));
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.z, current.camPosition.z));
+            }
+
+            const bool didCamRotationChange = current.camRotation != previous.camRotation;
+            writer.WriteBool(didCamRotationChange);
+            if (didCamRotationChange) {
+                WriteCode(writer, current.camRotation.w);
+                WriteCode(writer, current.camRotation.v.x);
+                WriteCode(writer, current.camRotation.v.y);
+                WriteCode(writer, current.camRotation.v.z);
+            }
+
+            const bool didMoveChange = current.moveForward != previous.moveForward ||
+                                       current.moveRight != previous.moveRight;
+            writer.WriteBool(didMoveChange);
+            if (didMoveChange) {
+                WriteCode(writer, current.moveForward);
+                WriteCode(writer, current.moveRight);
+            }
+
+            const bool didUIChoiceChange = current.uiChoice != previous.uiChoice;
+            writer.WriteBool(didUIChoiceChange);
+            if (didUIChoiceChange) {
+                writer.WriteBits(static_cast<uint8_t>(current.uiChoice), kUIChoiceBits);
+            }
+
+            const bool didCommandsChange = current.commandInputs != previous.commandInputs;
+            writer.WriteBool(didCommandsChange);
+            if (didCommandsChange) {
+                writer.WriteBits(current.commandInputs.Serialize(), kCommandBits);
+            }
+        }
+
+        static bool DecodeInput(BitReader& reader, const CharacterInput& previous, CharacterInput& result) {
+            result = previous;
+            if (reader.ReadBool()) { // Same as previous
+                return true;
+            }
+
+            if (reader.ReadBool()) {
+                result.camPosition.x = ApplyRawDelta(previous.camPosition.x, reader.ReadVarSigned());
+                result.camPosition.y = ApplyRawDelta(previous.camPosition.y, reader.ReadVarSigned());
+                result.camPosition.z = ApplyRawDelta(previous.camPosition.z, reader.ReadVarSigned());
+            }
+
+            if (reader.ReadBool()) {
+                result.camRotation.w = ReadCode(reader);
+                result.camRotation.v.x = ReadCode(reader);
+                result.camRotation.v.y = ReadCode(reader);
+                result.camRotation.v.z = ReadCode(reader);
+            }
+
+            if (reader.ReadBool()) {
+                result.moveForward = ReadCode(reader);
+                result.moveRight = ReadCode(reader);
+            }
+
+            if (reader.ReadBool()) {
+                const uint64_t uiChoice = reader.ReadBits(kUIChoiceBits);
+                if (uiChoice > static_cast<uint8_t>(GameplayInteractiveUIChoice::ChooseOptionE)) {
+                    return false;
+                }
+                result.uiChoice = static_cast<GameplayInteractiveUIChoice>(uiChoice);
+            }
+
+            if (reader.ReadBool()) {
+                result.commandInputs.Deserialize(static_cast<uint16_t>(reader.ReadBits(kCommandBits)));
+            }
+
+            return true;
+        }
+
+        // Deltas are calculated with unsigned math so that extreme values wrap rather than overflow (and still round trip)
+        static int64_t GetRawDelta(fp previous, fp current) {
+            return static_cast<int64_t>(static_cast<uint64_t>(current.raw_value()) -
+                                        static_cast<uint64_t>(previous.raw_value()));
+        }
+        static fp ApplyRawDelta(fp previous, int64_t delta) {
+            return fp::from_raw_value(static_cast<int64_t>(static_cast<uint64_t>(previous.raw_value()) +
+                                                           static_cast<uint64_t>(delta)));
+        }
+
+        static void WriteCode(BitWriter& writer, fp value) {
+            writer.WriteBits(static_cast<uint8_t>(CharacterInputQuantizer::ToCode(value)), kCodeBits);
+        }
+        static fp ReadCode(BitReader& reader) {
+            return CharacterInputQuantizer::FromCode(static_cast<int8_t>(reader.ReadBits(kCodeBits)));
+        }
+    };
+}
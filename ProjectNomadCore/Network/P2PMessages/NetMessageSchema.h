@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ProjectNomad {
+    // Field encoded based on its type, using as few bits as reasonable (see NetMessageSerialization)
+    template <auto MemberPtr>
+    struct NetField {};
+
+    // Field always encoded with its full bit width, for values which are rarely small (eg, checksums)
+    template <auto MemberPtr>
+    struct NetFixedField {};
+
+    // Array field where only the first "count" elements are sent, with count coming from an earlier field
+    template <auto ArrayMemberPtr, auto CountMemberPtr>
+    struct NetCountedArrayField {};
+
+    /**
+    * Compile time list of fields which make up a message's wire format, in the order they're sent.
+    * Every message declares its own schema, even if empty, as otherwise new fields could silently never be sent. Eg:
+    *       using NetSchema = NetMessageSchema<NetField<&LoadMapMessage::sessionSeed>>;
+    * Message type itself is always sent first (see NetMessageSerialization), so it's never part of the schema.
+    *
+    * Messages which need a fully custom wire format instead declare a NetCodec class with the same static
+    * Encode + Decode methods as NetMessageSerialization. See InputUpdateMessageEncoding.
+    **/
+    template <typename... Fields>
+    struct NetMessageSchema {
+        static constexpr size_t kNumFields = sizeof...(Fields);
+    };
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "BaseNetMessage.h"
+#include "NetMessageSchema.h"
+#include "Utilities/BitStream.h"
+
+namespace ProjectNomad {
+    /**
+    * Converts P2P messages to and from their wire format, based on each message's NetSchema (see NetMessageSchema).
+    * Messages are never sent as raw structs, as that would send padding, native endianness, and unused space in
+    * max size arrays.
+    *
+    * Format (bit packed, see BitWriter):
+    *   - Header: message type (8 bits) + wire version (8 bits). Message type is always the first byte, so received
+    *     messages can be identified before decoding
+    *   - Each schema field in order:
+    *       - bool: 1 bit
+    *       - unsigned integers + enums: variable length (see BitWriter::WriteVarUnsigned)
+    *       - signed integers: zigzag variable length
+    *       - char arrays: variable length string length (up to first null) then 8 bits per char
+    *       - NetFixedField: full bit width of the field's unsigned integer type
+    *       - NetCountedArrayField: only the first "count" elements, each encoded as above
+    *
+    * Messages with a NetCodec (eg, InputUpdateMessage) are passed on to it instead. Note that its header must be
+    * included wherever such messages are encoded or decoded.
+    *
+    * Decoding never allocates and is bounds checked, so malformed data (eg, from bad actors) simply fails to decode.
+    **/
+    class NetMessageSerialization {
+      public:
+        NetMessageSerialization() = delete;
+
+        // Increase whenever any message's wire format changes. Peers must be on the same version anyways, as
+        //      simulation needs to be deterministic between them, so mismatched messages are simply rejected
+        static constexpr uint8_t kWireVersion = 1;
+        static constexpr size_t kHeaderSizeInBytes = 2;
+
+        /**
+        * Encodes message into its wire format
+        * @param message - message to encode
+        * @param result - buffer to write encoded message to. Existing contents are replaced but capacity is reused
+        **/
+        template <typename MessageType>
+        static void Encode(const MessageType& message, std::vector<uint8_t>& result) {
+            static_assert(std::is_base_of_v<BaseNetMessage, MessageType>, "MessageType must inherit from BaseNetMessage");
+
+            if constexpr (kHasCustomCodec<MessageType>) {
+                MessageType::NetCodec::Encode(message, result);
+            }
+            else {
+                static_assert(MessageType::NetSchema::kNumFields > 0 || sizeof(MessageType) == sizeof(BaseNetMessage),
+                    "Message has fields but its NetSchema is empty");
+
+                BitWriter writer(result);
+                WriteHeader(writer, message.messageType);
+                EncodeFields(writer, message, typename MessageType::NetSchema{});
+            }
+        }
+
+        /**
+        * Decodes message from its wire format
+        * @param data - encoded message
+        * @param sizeInBytes - size of encoded message
+        * @param result - decoded message. Only valid if decoding succeeded
+        * @returns true if data was a valid encoded message of the expected type, false otherwise (eg, truncated or
+        *          malformed data, or from a different wire version)
+        **/
+        template <typename MessageType>
+        static bool Decode(const uint8_t* data, size_t sizeInBytes, MessageType& result) {
+            static_assert(std::is_base_of_v<BaseNetMessage, MessageType>, "MessageType must inherit from BaseNetMessage");
+
+            if constexpr (kHasCustomCodec<MessageType>) {
+                return MessageType::NetCodec::Decode(data, sizeInBytes, result);
+            }
+            else {
+                result = MessageType(); // Fields not sent (eg, unused array elements) should still be predictable
+                BitReader reader(data, sizeInBytes);
+                if (!ReadHeader(reader, result.messageType)) {
+                    return false;
+                }
+                if (!DecodeFields(reader, result, typename MessageType::NetSchema{})) {
+                    return false;
+                }
+
+                // Reject truncated data and trailing garbage, as either means data wasn't what we expected
+                return !reader.HasReadPastEnd() && reader.GetBytesRead() == sizeInBytes;
+            }
+        }
+        template <typename MessageType>
+        static bool Decode(std::span<const char> data, MessageType& result) {
+            return Decode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), result);
+        }
+
+        // Shared with custom codecs, so that every message starts with the same header
+        static void WriteHeader(BitWriter& writer, NetMessageType messageType) {
+            writer.WriteBits(static_cast<uint8_t>(messageType), 8);
+            writer.WriteBits(kWireVersion, 8);
+        }
+        static bool ReadHeader(BitReader& reader, NetMessageType expectedMessageType) {
+            const bool isExpectedType = static_cast<NetMessageType>(reader.ReadBits(8)) == expectedMessageType;
+            const bool isExpectedVersion = reader.ReadBits(8) == kWireVersion;
+            return isExpectedType && isExpectedVersion;
+        }
+
+      private:
+        template <typename MessageType>
+        static constexpr bool kHasCustomCodec = requires { typename MessageType::NetCodec; };
+
+        template <typename MessageType, typename... Fields>
+        static void EncodeFields(BitWriter& writer, const MessageType& message, NetMessageSchema<Fields...>) {
+            (FieldCodec<Fields>::Encode(writer, message), ...);
+        }
+        template <typename MessageType, typename... Fields>
+        static bool DecodeFields(BitReader& reader, MessageType& message, NetMessageSchema<Fields...>) {
+            return (FieldCodec<Fields>::Decode(reader, message) && ...); // Stops at first invalid field
+        }
+
+        template <typename Field>
+        struct FieldCodec;
+
+        template <auto MemberPtr>
+        struct FieldCodec<NetField<MemberPtr>> {
+            template <typename MessageType>
+            static void Encode(BitWriter& writer, const MessageType& message) {
+                WriteValue(writer, message.*MemberPtr);
+            }
+            template <typename MessageType>
+            static bool Decode(BitReader& reader, MessageType& message) {
+                return ReadValue(reader, message.*MemberPtr);
+            }
+        };
+
+        template <auto MemberPtr>
+        struct FieldCodec<NetFixedField<MemberPtr>> {
+            template <typename MessageType>
+            static void Encode(BitWriter& writer, const MessageType& message) {
+                using ValueType = std::remove_cvref_t<decltype(message.*MemberPtr)>;
+                static_assert(std::is_integral_v<ValueType> && std::is_unsigned_v<ValueType>,
+                    "Fixed fields must be unsigned integers");
+                writer.WriteBits(message.*MemberPtr, sizeof(ValueType) * 8);
+            }
+            template <typename MessageType>
+            static bool Decode(BitReader& reader, MessageType& message) {
+                using ValueType = std::remove_cvref_t<decltype(message.*MemberPtr)>;
+                message.*MemberPtr = static_cast<ValueType>(reader.ReadBits(sizeof(ValueType) * 8));
+                return true;
+            }
+        };
+
+        template <auto ArrayMemberPtr, auto CountMemberPtr>
+        struct FieldCodec<NetCountedArrayField<ArrayMemberPtr, CountMemberPtr>> {
+            // Count field is expected to come earlier in schema, so it's already decoded by the time array is
+            template <typename MessageType>
+            static void Encode(BitWriter& writer, const MessageType& message) {
+                const auto& array = message.*ArrayMemberPtr;
+                const uint64_t count = std::min<uint64_t>(message.*CountMemberPtr, std::size(array));
+                for (uint64_t i = 0; i < count; i++) {
+                    WriteValue(writer, array[i]);
+                }
+            }
+            template <typename MessageType>
+            static bool Decode(BitReader& reader, MessageType& message) {
+                auto& array = message.*ArrayMemberPtr;
+                const uint64_t count = message.*CountMemberPtr;
+                if (count > std::size(array)) {
+                    return false;
+                }
+
+                for (uint64_t i = 0; i < count; i++) {
+                    if (!ReadValue(reader, array[i])) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        template <typename ValueType>
+        static void WriteValue(BitWriter& writer, const ValueType& value) {
+            if constexpr (std::is_same_v<ValueType, bool>) {
+                writer.WriteBool(value);
+            }
+            else if constexpr (std::is_enum_v<ValueType>) {
+                static_assert(std::is_unsigned_v<std::underlying_type_t<ValueType>>, "Enum fields must be unsigned");
+                writer.WriteVarUnsigned(static_cast<uint64_t>(value));
+            }
+            else if constexpr (std::is_integral_v<ValueType> && std::is_unsigned_v<ValueType>) {
+                writer.WriteVarUnsigned(value);
+            }
+            else if constexpr (std::is_integral_v<ValueType>) {
+                writer.WriteVarSigned(value);
+            }
+            else {
+                static_assert(kIsUnsupportedType<ValueType>, "Field type is not supported, consider a custom NetCodec");
+            }
+        }
+        // Strings stop at first null char, or fill the entire array if none
+        template <size_t Length>
+        static void WriteValue(BitWriter& writer, const char (&value)[Length]) {
+            const uint64_t length = std::find(value, value + Length, '\0') - value;
+            writer.WriteVarUnsigned(length);
+            for (uint64_t i = 0; i < length; i++) {
+                writer.WriteBits(static_cast<uint8_t>(value[i]), 8);
+            }
+        }
+
+        template <typename ValueType>
+        static bool ReadValue(BitReader& reader, ValueType& result) {
+            if constexpr (std::is_same_v<ValueType, bool>) {
+                result = reader.ReadBool();
+            }
+            else if constexpr (std::is_enum_v<ValueType>) {
+                using UnderlyingType = std::underlying_type_t<ValueType>;
+                const uint64_t value = reader.ReadVarUnsigned();
+                if (value > std::numeric_limits<UnderlyingType>::max()) {
+                    return false;
+                }
+                result = static_cast<ValueType>(value);
+            }
+            else if constexpr (std::is_integral_v<ValueType> && std::is_unsigned_v<ValueType>) {
+                const uint64_t value = reader.ReadVarUnsigned();
+                if (value > std::numeric_limits<ValueType>::max()) {
+                    return false;
+                }
+                result = static_cast<ValueType>(value);
+            }
+            else if constexpr (std::is_integral_v<ValueType>) {
+                const int64_t value = reader.ReadVarSigned();
+                if (value < std::numeric_limits<ValueType>::min() || value > std::numeric_limits<ValueType>::max()) {
+                    return false;
+                }
+                result = static_cast<ValueType>(value);
+            }
+            else {
+                static_assert(kIsUnsupportedType<ValueType>, "Field type is not supported, consider a custom NetCodec");
+            }
+            return true;
+        }
+        template <size_t Length>
+        static bool ReadValue(BitReader& reader, char (&result)[Length]) {
+            const uint64_t length = reader.ReadVarUnsigned();
+            if (length > Length) {
+                return false;
+            }
+
+            for (uint64_t i = 0; i < length; i++) {
+                result[i] = static_cast<char>(reader.ReadBits(8));
+            }
+            if (length < Length) {
+                result[length] = '\0';
+            }
+            return true;
+        }
+
+        template <typename ValueType>
+        static constexpr bool kIsUnsupportedType = false; // Only for static_assert messages
+    };
+}
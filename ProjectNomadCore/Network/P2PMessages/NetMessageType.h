@@ -21,6 +21,10 @@ namespace ProjectNomad {
         FinishedMapLoad,
         StartGameplay,
 
+        // Appended rather than grouped with ValidationChecksum, so that existing message ids don't change
+        DesyncLocalizationRequest,
+        DesyncLocalizationResponse,
+
         ENUM_COUNT // https://stackoverflow.com/a/14989325/3735890
     };
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BaseNetMessage.h"
+#include "NetMessageSchema.h"
 #include "Utilities/FrameType.h"
 
 namespace ProjectNomad {
@@ -8,15 +9,24 @@ namespace ProjectNomad {
     // message.
     struct TimeQualityReportMessage : BaseNetMessage {
         FrameType currentFrame = 0;
-        uint64_t ping = 0;
+        uint64_t ping = 0; // Sender's current time in microseconds. Only meaningful to sender, who compares it vs pong
+
+        using NetSchema = NetMessageSchema<
+            NetField<&TimeQualityReportMessage::currentFrame>,
+            NetField<&TimeQualityReportMessage::ping>
+        >;
         
-        TimeQualityReportMessage(FrameType inCurrentFrame, uint64_t inCurTimeInMilliSec)
-        : BaseNetMessage(NetMessageType::TimeQualityReport), currentFrame(inCurrentFrame), ping(inCurTimeInMilliSec) {}
+        TimeQualityReportMessage() : BaseNetMessage(NetMessageType::TimeQualityReport) {}
+        TimeQualityReportMessage(FrameType inCurrentFrame, uint64_t inCurTimeInMicroSec)
+        : BaseNetMessage(NetMessageType::TimeQualityReport), currentFrame(inCurrentFrame), ping(inCurTimeInMicroSec) {}
     };
 
     struct TimeQualityResponseMessage : BaseNetMessage {
         uint64_t pong = 0; // Ping-pong message style is to send back the input so peer knows their ping or rather RTT (round trip time)
+
+        using NetSchema = NetMessageSchema<NetField<&TimeQualityResponseMessage::pong>>;
         
+        TimeQualityResponseMessage() : BaseNetMessage(NetMessageType::TimeQualityResponse) {}
         explicit TimeQualityResponseMessage(const TimeQualityReportMessage& reportMessage)
         : BaseNetMessage(NetMessageType::TimeQualityResponse), pong(reportMessage.ping) {}
     };
@@ -24,7 +34,13 @@ namespace ProjectNomad {
     struct ValidationChecksumMessage : BaseNetMessage {
         FrameType targetFrame = 0;
         uint32_t checksum = 0;
+
+        using NetSchema = NetMessageSchema<
+            NetField<&ValidationChecksumMessage::targetFrame>,
+            NetFixedField<&ValidationChecksumMessage::checksum> // Effectively random, so variable length wouldn't help
+        >;
         
+        ValidationChecksumMessage() : BaseNetMessage(NetMessageType::ValidationChecksum) {}
         ValidationChecksumMessage(FrameType inTargetFrame, uint32_t inChecksum)
         : BaseNetMessage(NetMessageType::ValidationChecksum), targetFrame(inTargetFrame), checksum(inChecksum) {}
     };
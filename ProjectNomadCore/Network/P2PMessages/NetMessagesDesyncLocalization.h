@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BaseNetMessage.h"
+#include "NetMessageSchema.h"
+#include "Rollback/Model/DesyncLocalization.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    // Asks host for the child checksums of a single node of its desync checksum tree (see DesyncChecksumQuery)
+    struct DesyncLocalizationRequestMessage : BaseNetMessage {
+        FrameType targetFrame = 0;
+        uint8_t typeIndex = DesyncChecksumQuery::kAllTypes;
+        uint32_t rangeStart = 0;
+        uint32_t rangeSize = 0;
+
+        using NetSchema = NetMessageSchema<
+            NetField<&DesyncLocalizationRequestMessage::targetFrame>,
+            NetField<&DesyncLocalizationRequestMessage::typeIndex>,
+            NetField<&DesyncLocalizationRequestMessage::rangeStart>,
+            NetField<&DesyncLocalizationRequestMessage::rangeSize>
+        >;
+
+        DesyncLocalizationRequestMessage() : BaseNetMessage(NetMessageType::DesyncLocalizationRequest) {}
+        DesyncLocalizationRequestMessage(FrameType inTargetFrame, const DesyncChecksumQuery& query)
+        : BaseNetMessage(NetMessageType::DesyncLocalizationRequest), targetFrame(inTargetFrame),
+          typeIndex(query.typeIndex), rangeStart(query.rangeStart), rangeSize(query.rangeSize) {}
+
+        DesyncChecksumQuery GetQuery() const {
+            return {typeIndex, rangeStart, rangeSize};
+        }
+    };
+
+    struct DesyncLocalizationResponseMessage : BaseNetMessage {
+        FrameType targetFrame = 0;
+        uint8_t typeIndex = DesyncChecksumQuery::kAllTypes;
+        uint32_t rangeStart = 0;
+        uint32_t rangeSize = 0;
+        // False if host couldn't answer, such as if it no longer has a snapshot for target frame
+        bool didCalculateChecksums = false;
+        uint8_t numChecksums = 0;
+        // Empty ranges have a checksum of 0, so variable length encoding keeps sparse nodes small
+        uint32_t checksums[DesyncChecksumQuery::kMaxChecksumsPerNode] = {};
+
+        using NetSchema = NetMessageSchema<
+            NetField<&DesyncLocalizationResponseMessage::targetFrame>,
+            NetField<&DesyncLocalizationResponseMessage::typeIndex>,
+            NetField<&DesyncLocalizationResponseMessage::rangeStart>,
+            NetField<&DesyncLocalizationResponseMessage::rangeSize>,
+            NetField<&DesyncLocalizationResponseMessage::didCalculateChecksums>,
+            NetField<&DesyncLocalizationResponseMessage::numChecksums>,
+            NetCountedArrayField<&DesyncLocalizationResponseMessage::checksums, &DesyncLocalizationResponseMessage::numChecksums>
+        >;
+
+        DesyncLocalizationResponseMessage() : BaseNetMessage(NetMessageType::DesyncLocalizationResponse) {}
+        explicit DesyncLocalizationResponseMessage(const DesyncLocalizationRequestMessage& request)
+        : BaseNetMessage(NetMessageType::DesyncLocalizationResponse), targetFrame(request.targetFrame),
+          typeIndex(request.typeIndex), rangeStart(request.rangeStart), rangeSize(request.rangeSize) {}
+
+        DesyncChecksumQuery GetQuery() const {
+            return {typeIndex, rangeStart, rangeSize};
+        }
+    };
+}
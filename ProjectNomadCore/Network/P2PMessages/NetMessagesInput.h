@@ -3,25 +3,44 @@
 #include <array>
 
 #include "BaseNetMessage.h"
+#include "GameCore/PlayerSpot.h"
 #include "Input/CharacterInput.h"
 #include "Utilities/FrameType.h"
 #include "Rollback/Model/RollbackSettings.h"
 
 namespace ProjectNomad {
-    // TODO: Only send necessary amount of inputs.
-    //       Eg, send back and forth confirmed frame for inputs, then send up to that frame of inputs.
-    
-    // For now, send enough inputs always to fill rollback info
-    // FUTURE: Minimize packet size via minimizing PlayerInput size and decreasing this var as appropriate
-    static constexpr FrameType kInputsHistorySize = RollbackStaticSettings::kMaxRollbackFrames;
+    class InputUpdateMessageEncoding;
+
+    // Max inputs per message, which is enough to fill the rollback window plus local inputs stored ahead due to input delay.
+    //      Messages usually include far fewer inputs, as only inputs not yet acknowledged by peers are sent.
+    // FUTURE: Decrease this var as appropriate. Note that message is never sent as raw struct, see
+    //         InputUpdateMessageEncoding for actual wire format
+    static constexpr FrameType kInputsHistorySize = RollbackStaticSettings::kMaxRollbackFrames + RollbackStaticSettings::kMaxInputDelay;
     using InputHistoryArray = std::array<CharacterInput, kInputsHistorySize>;
+    // Per player spot, latest frame that sender has received all inputs up to. Max value if none received yet
+    using InputAckArray = std::array<FrameType, PlayerSpotHelpers::kMaxPlayerSpots>;
     
     struct InputUpdateMessage : BaseNetMessage {
         FrameType updateFrame = std::numeric_limits<FrameType>::max();
+        // Number of valid inputs in playerInputs, ie inputs for frames (updateFrame - numInputs, updateFrame].
+        //      Expected to be in range [1, kInputsHistorySize]
+        FrameType numInputs = kInputsHistorySize;
         InputHistoryArray playerInputs = {}; // Index 0 will be given frame's input
+        // Piggybacked acknowledgements, so each peer knows which of its inputs don't need to be resent anymore.
+        //      Receiver should only look at its own player spot's entry.
+        InputAckArray ackedFrames = CreateNoAcks();
+
+        // Sent constantly and raw struct is mostly redundant data, so uses its own compact delta encoding
+        using NetCodec = InputUpdateMessageEncoding;
 
         InputUpdateMessage() : BaseNetMessage(NetMessageType::InputUpdate) {}
         InputUpdateMessage(FrameType currentFrame, const InputHistoryArray& inputs)
         : BaseNetMessage(NetMessageType::InputUpdate), updateFrame(currentFrame), playerInputs(inputs) {}
+
+        static constexpr InputAckArray CreateNoAcks() {
+            InputAckArray result = {};
+            result.fill(std::numeric_limits<FrameType>::max());
+            return result;
+        }
     };
 }
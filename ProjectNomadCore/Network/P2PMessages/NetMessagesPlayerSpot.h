@@ -1,6 +1,10 @@
 #pragma once
 
+#include <EOS/Include/eos_common.h>
+
 #include "BaseNetMessage.h"
+#include "NetMessageSchema.h"
+#include "GameCore/PlayerSpot.h"
 
 namespace ProjectNomad {
     // This represents an array of CrossPlatformIdWrapper ids in order of PlayerSpots
@@ -11,6 +15,12 @@ namespace ProjectNomad {
         uint8_t totalPlayers = 0;
         OrderedRawPlayerIdArray rawPlayerSpotMapping = {};
 
+        // Only sends ids actually in use, each without any unused chars
+        using NetSchema = NetMessageSchema<
+            NetField<&PlayerSpotMappingMessage::totalPlayers>,
+            NetCountedArrayField<&PlayerSpotMappingMessage::rawPlayerSpotMapping, &PlayerSpotMappingMessage::totalPlayers>
+        >;
+
         PlayerSpotMappingMessage() : BaseNetMessage(NetMessageType::PlayerSpotMapping) {}
     };
 }
@@ -1,21 +1,30 @@
 #pragma once
 
 #include "BaseNetMessage.h"
+#include "NetMessageSchema.h"
 
 namespace ProjectNomad {
     struct InitiateConnectionMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         InitiateConnectionMessage() : BaseNetMessage(NetMessageType::TryConnect) {}
     };
     struct AcceptConnectionMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         AcceptConnectionMessage() : BaseNetMessage(NetMessageType::AcceptConnection) {}
     };
 
 
     
     struct PrepareLobbyStartMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         PrepareLobbyStartMessage() : BaseNetMessage(NetMessageType::PrepareLobbyStartMatch) {}
     };
     struct ConfirmedLobbyStartMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         ConfirmedLobbyStartMessage() : BaseNetMessage(NetMessageType::ConfirmedLobbyStartMatch) {}
     };
     struct LoadMapMessage : BaseNetMessage {
@@ -25,11 +34,17 @@ namespace ProjectNomad {
         //      Note: Likely want to refactor this message out of this file. And perhaps add a value validation method?
         //      Need to account for bad data from other players somehow/somewhere, or be able to fallback if SimLayer setup fails.
         uint8_t sessionSeed = 0;
+
+        using NetSchema = NetMessageSchema<NetField<&LoadMapMessage::sessionSeed>>;
     };
     struct FinishedMapLoadMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         FinishedMapLoadMessage() : BaseNetMessage(NetMessageType::FinishedMapLoad) {}
     };
     struct StartGameplayMessage : BaseNetMessage {
+        using NetSchema = NetMessageSchema<>;
+
         StartGameplayMessage() : BaseNetMessage(NetMessageType::StartGameplay) {}
     };
 }
@@ -1,21 +1,60 @@
 #pragma once
 
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <span>
+
 #include "INetEventsSubscriber.h"
 #include "EOS/EOSWrapperSingleton.h"
 #include "EOS/Model/PacketReliability.h"
 #include "GameCore/PlayerId.h"
+#include "Model/NetMessageDispatcher.h"
 #include "Model/NetPlayersInfoManager.h"
 #include "Model/NetSubscribersManager.h"
+#include "Model/PeerLatencyEstimator.h"
+#include "P2PMessages/NetMessagesConnectionInfo.h"
+#include "P2PMessages/NetMessagesDesyncLocalization.h"
+#include "P2PMessages/InputUpdateMessageEncoding.h"
 #include "P2PMessages/NetMessagesPlayerSpot.h"
 #include "P2PMessages/NetMessagesSimple.h"
+#include "Transport/EOSP2PTransport.h"
+#include "Transport/IP2PTransport.h"
+#include "Utilities/SharedUtilities.h"
 #include "Utilities/Singleton.h"
 
 namespace ProjectNomad {
     /**
     * Interface class to network features
     **/
-    class SimNetworkManager : public IEOSWrapperManager {
+    class SimNetworkManager : public IEOSWrapperManager, public IP2PPacketReceiver {
       public:
+        SimNetworkManager()
+            : mEosWrapper(&Singleton<EOSWrapperSingleton>::get()), mEosTransport(std::make_unique<EOSP2PTransport>()) {
+            mDefaultTransport = mEosTransport.get();
+            mTransport = mDefaultTransport;
+            RegisterInternalMessageHandlers();
+        }
+        /**
+        * Special constructor for headless simulation (eg, multiple peers within one process), which never touches EOS.
+        * Instead all P2P messages go through given transport, and given players are treated as an already joined +
+        * locked lobby. Thus manager is immediately initialized, logged in, and in a lobby. Login, lobby, and UI
+        * features are not available.
+        * @param transport - transport for all P2P messages, which must outlive this manager
+        * @param localPlayerId - local player's id within transport
+        * @param playerIdsInSpotOrder - every player's id (including local player) in player spot order. First player hosts
+        * @param timeRetriever - time source for measuring latency, so time can be precisely controlled
+        **/
+        SimNetworkManager(IP2PTransport& transport,
+                          const CrossPlatformIdWrapper& localPlayerId,
+                          const std::vector<CrossPlatformIdWrapper>& playerIdsInSpotOrder,
+                          std::function<uint64_t()> timeRetriever)
+            : mDefaultTransport(&transport), mTransport(&transport), mTimeRetriever(std::move(timeRetriever)) {
+            RegisterInternalMessageHandlers();
+            mPlayersInfoManager.SetFixedLobby(localPlayerId, playerIdsInSpotOrder);
+            mIsInitialized = true;
+        }
         ~SimNetworkManager() override  = default;
 
         bool IsInitialized() const {
@@ -37,8 +76,12 @@ namespace ProjectNomad {
                 return;
             }
 
-            mEosWrapperSingleton.SetWrapperManager(this);
-            if (mEosWrapperSingleton.TryInitialize()) {
+            if (CheckAndLogIfNotUsingEOS("SimNetworkManager::Initialize")) {
+                return;
+            }
+
+            mEosWrapper->SetWrapperManager(this);
+            if (mEosWrapper->TryInitialize()) {
                 mIsInitialized = true;
 
                 mNetSubscribersManager.OnEOSInitialized();
@@ -56,9 +99,73 @@ namespace ProjectNomad {
         // Expected to be called once per frame
         void Tick() {
             // No need to check for initialization or such, just pass the tick down
-            mEosWrapperSingleton.Tick();
+            if (mEosWrapper) {
+                mEosWrapper->Tick();
+            }
+
+            // EOS passes packets directly to OnMessageReceived during its tick, so only need to pump other transports
+            if (mTransport != mEosTransport.get()) {
+                mTransport->ReceivePackets(*this, mMaxPacketsReceivedPerTick);
+            }
+        }
+
+        /**
+        * Swaps out transport used for sending + receiving P2P messages, such as to an in-process loopback transport for
+        * running multiple peers in one process. Note that login and lobby features still always go through EOS.
+        * @param transport - transport to use, which must outlive this manager's use of it. nullptr to go back to the
+        *                    default transport (EOS, or the transport given at construction)
+        **/
+        void SetP2PTransport(IP2PTransport* transport) {
+            mTransport = transport ? transport : mDefaultTransport;
+        }
+        
+        /**
+        * Sets max number of incoming P2P packets handled per Tick. Remaining packets are handled on following ticks.
+        * @param maxPacketsReceivedPerTick - budget per tick. Expected to be at least 1
+        **/
+        void SetMaxPacketsReceivedPerTick(uint32_t maxPacketsReceivedPerTick) {
+            if (maxPacketsReceivedPerTick > 0) { // EOS wrapper logs about invalid budget, so no need to duplicate that
+                mMaxPacketsReceivedPerTick = maxPacketsReceivedPerTick;
+            }
+            if (mEosWrapper) {
+                mEosWrapper->SetMaxPacketsReceivedPerTick(maxPacketsReceivedPerTick);
+            }
+        }
+        // Only tracked for EOS, so always empty when constructed over another transport
+        const P2PReceiveStats& GetP2PReceiveStats() const {
+            return mEosWrapper ? mEosWrapper->GetReceiveStats() : mEmptyReceiveStats;
+        }
+
+        /**
+        * Retrieves latency estimate for given peer, which is measured from time quality report ping-pongs.
+        * Reports are answered automatically and their responses are consumed here, so any peer which sends reports
+        * (see CreateTimeQualityReport) will have stats.
+        * @param peerId - remote peer's id
+        * @returns peer's latency stats. Has no samples if no responses were received from peer yet
+        **/
+        PeerLatencyStats GetPeerLatencyStats(const CrossPlatformIdWrapper& peerId) const {
+            auto it = mPeerLatencyEstimators.find(peerId);
+            return it != mPeerLatencyEstimators.end() ? it->second.GetStats() : PeerLatencyStats{};
+        }
+        // Creates report with ping set to current time, so that response can be used to measure round trip time
+        TimeQualityReportMessage CreateTimeQualityReport(FrameType currentFrame) const {
+            return TimeQualityReportMessage(currentFrame, mTimeRetriever());
         }
         
+        /**
+        * Registers typed handler for a P2P message type, which is called instead of passing the decoded message to
+        * subscribers. Message is validated + decoded (see NetMessageSerialization) before handler is called.
+        * Preferred over INetEventsSubscriber::HandleReceivedP2PMessage, especially for frequent messages.
+        * @param handler - called with received message. Message is only valid for duration of the call
+        **/
+        template<typename MessageType>
+        void RegisterP2PMessageHandler(NetMessageDispatcher::Handler<MessageType> handler) {
+            mMessageDispatcher.RegisterHandler<MessageType>(std::move(handler));
+        }
+        void UnregisterP2PMessageHandler(NetMessageType messageType) {
+            mMessageDispatcher.UnregisterHandler(messageType);
+        }
+
         void SetRendererSubscriber(std::reference_wrapper<INetEventsSubscriber> subscriber) {
             mNetSubscribersManager.SetRendererSubscriber(subscriber);
         }
@@ -75,8 +182,11 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while already logged in");
                 return;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::LoginViaAccountPortal")) {
+                return;
+            }
 
-            mEosWrapperSingleton.BeginLoginAttemptViaAccountPortal();
+            mEosWrapper->BeginLoginAttemptViaAccountPortal();
         }
         void LoginViaDevAuth(const std::string& devAuthName, const std::string& ipAndPort) {
             // Sanity checks
@@ -87,8 +197,11 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while already logged in");
                 return;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::LoginViaDevAuth")) {
+                return;
+            }
             
-            if (mEosWrapperSingleton.BeginLoginAttemptViaDevAuthTool(devAuthName, ipAndPort)) {
+            if (mEosWrapper->BeginLoginAttemptViaDevAuthTool(devAuthName, ipAndPort)) {
                 // In future, we can set a state to prevent multiple login attempts
                 // BUT we'd then need a callback in case login fails
                 // So... lazy choice for now is to do nothing here
@@ -103,15 +216,19 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while already logged in");
                 return;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::Logout")) {
+                return;
+            }
             
-            mEosWrapperSingleton.BeginLogout();
+            mEosWrapper->BeginLogout();
         }
 
         /**
         * Send a P2P message to all players in the current match lobby
         * @param message - Message to send
         * @param packetReliability - How should message be sent. This will dictate whether in UDP-style, TCP-style, etc
-        * @returns true if message successfully queued for sending to all players 
+        * @returns true if message successfully queued for sending to all players. See GetLastBroadcastFailedPlayersMask
+        *          for which players failed otherwise
         **/
         template<typename MessageType>
         bool SendP2PMessageToAllPlayersInMatchLobby(const MessageType& message, PacketReliability packetReliability) {
@@ -132,31 +249,35 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while not actually in a lobby");
                 return false;
             }
-            if (allPlayersInfo.netLobbyInfo.lobbyMemberIds.size() <= 1) {
+            const std::vector<CrossPlatformIdWrapper>& remoteMemberIds = allPlayersInfo.netLobbyInfo.remoteMemberIds;
+            if (remoteMemberIds.empty()) {
                 mLogger.AddWarnNetLog("Called while only player in lobby");
                 return false;
             }
 
-            // Send the message to each player one by one
-            bool didAnySendsFail = false;
-            for (const CrossPlatformIdWrapper& memberId : allPlayersInfo.netLobbyInfo.lobbyMemberIds) {
-                // No need to even attempt sending message to self
-                if (memberId == allPlayersInfo.localPlayerId) {
-                    continue;
-                }
-
-                // Actually send the message
-                bool didSendSucceed = SendP2PMessage(memberId, message, packetReliability);
-                if (!didSendSucceed) {
-                    mLogger.AddWarnNetLog(
-                        "SNM::SendP2PMessageToAllPlayersInMatchLobby",
-                        "Failed to send message to player with id: " + memberId.ToStringForLogging()
-                    );
-                    didAnySendsFail = true;
-                }
+            // Serialize once then send the exact same bytes to every other player in one batch
+            NetMessageSerialization::Encode(message, mEncodedMessageBuffer);
+            mLastBroadcastFailedPlayersMask = mTransport->SendPacketToAll(
+                remoteMemberIds.data(),
+                static_cast<uint32_t>(remoteMemberIds.size()),
+                mEncodedMessageBuffer.data(),
+                static_cast<uint32_t>(mEncodedMessageBuffer.size()),
+                packetReliability
+            );
+            if (mLastBroadcastFailedPlayersMask != 0) {
+                // No per player details here, as formatting ids is relatively expensive for something called every frame
+                mLogger.AddWarnNetLog("SNM::SendP2PMessageToAllPlayersInMatchLobby", "Failed to send message to some players");
+                return false;
             }
 
-            return !didAnySendsFail;
+            return true;
+        }
+        /**
+        * Which players the latest SendP2PMessageToAllPlayersInMatchLobby call failed to send to
+        * @returns bitmask where bit i is set if sending to GetPlayersInfo().netLobbyInfo.remoteMemberIds[i] failed
+        **/
+        uint32_t GetLastBroadcastFailedPlayersMask() const {
+            return mLastBroadcastFailedPlayersMask;
         }
         /**
         * Send a P2P message to match lobby's host
@@ -242,8 +363,11 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while already in a lobby");
                 return false;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::BeginCreateMainGameLobby")) {
+                return false;
+            }
 
-            return mEosWrapperSingleton.BeginCreateMainMatchLobby();
+            return mEosWrapper->BeginCreateMainMatchLobby();
         }
         bool BeginLeaveMainMatchLobby() {
             // Sanity checks
@@ -259,8 +383,11 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while not actually in a lobby");
                 return false;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::BeginLeaveMainMatchLobby")) {
+                return false;
+            }
 
-            return mEosWrapperSingleton.BeginLeaveMainGameLobby();
+            return mEosWrapper->BeginLeaveMainGameLobby();
         }
         
         void LockLobby() {
@@ -307,8 +434,11 @@ namespace ProjectNomad {
                 mLogger.AddWarnNetLog("Called while not logged in");
                 return;
             }
+            if (CheckAndLogIfNotUsingEOS("NetworkManagerSingleton::ShowFriendsUI")) {
+                return;
+            }
 
-            mEosWrapperSingleton.ShowFriendsUI();
+            mEosWrapper->ShowFriendsUI();
         }
 
         // TODO: Clean up or rework outdated "connection" tracking and logic
@@ -348,7 +478,11 @@ namespace ProjectNomad {
             mNetSubscribersManager.OnLoginStatusChanged();
         }
         
-        void OnMessageReceived(const CrossPlatformIdWrapper& senderId, const std::vector<char>& messageData) override {
+        // Non-EOS transports deliver packets here, so treat them exactly like EOS messages
+        void OnPacketReceived(const CrossPlatformIdWrapper& senderId, const std::vector<char>& packetData) override {
+            OnMessageReceived(senderId, packetData);
+        }
+        void OnMessageReceived(const CrossPlatformIdWrapper& senderId, std::span<const char> messageData) override {
             if (messageData.empty()) {
                 mLogger.AddWarnNetLog("Somehow received empty message...?");
                 return;
@@ -363,37 +497,33 @@ namespace ProjectNomad {
             }
             NetMessageType messageType = static_cast<NetMessageType>(messageData[0]);
 
-            // Handle depending on message type
-            //      NOTE: All downstream message casts should validate message size before proceeding
-            //      TODO: Would be verrry nice if we could somehow always validate here for downstream
-            switch (messageType) {
-                // TODO: Clean up or rework old message types!
-                case NetMessageType::TryConnect:
-                    SendAcceptConnectionMessage(senderId);
-                    RememberAcceptedPlayerConnection(false, senderId);
-                    break;
-                case NetMessageType::AcceptConnection:
-                    RememberAcceptedPlayerConnection(true, senderId);
-                    break;
-
-                case NetMessageType::PlayerSpotMapping: {
-                    if (messageData.size() != sizeof(PlayerSpotMappingMessage)) { // Could be wrong size from bad actors
-                        mLogger.AddWarnNetLog(
-                            "PlayerSpotMapping: Received invalid message size! Given size: " +
-                            std::to_string(messageData.size()) + ", expected size: " + std::to_string(sizeof(PlayerSpotMappingMessage))
-                        );
-                        return;
-                    }
-                
-                    const auto* actualMessage = reinterpret_cast<const PlayerSpotMappingMessage*>(messageData.data());
-                    ProcessReceivedPlayerSpotMapping(senderId, *actualMessage);
-                    break;
-                }
+            // Ping-pong is handled here regardless of any handlers, as latency measuring relies on it
+            if (HandleTimeQualityPingPong(senderId, messageType, messageData)) {
+                return;
+            }
 
-                default:
-                    // Propagate message to subscribers to handle as they see fit
-                    mNetSubscribersManager.HandleReceivedP2PMessage(senderId, messageType, messageData);
+            // Registered handlers first, which also take care of validating message data
+            NetMessageDispatchResult dispatchResult = mMessageDispatcher.Dispatch(senderId, messageType, messageData);
+            if (dispatchResult == NetMessageDispatchResult::Handled) {
+                return;
+            }
+            if (dispatchResult == NetMessageDispatchResult::InvalidMessage) { // Could be malformed from bad actors
+                mLogger.AddWarnNetLog(
+                    "Received invalid message! Type: " + std::to_string(static_cast<int>(messageType)) +
+                    ", size: " + std::to_string(messageData.size())
+                );
+                return;
+            }
+
+            // Otherwise fall back to passing message to subscribers. Subscribers expect raw message structs, so decode first
+            if (!TryDecodeToRawStruct(messageType, messageData, mDecodedMessageBuffer)) { // Could be malformed from bad actors
+                mLogger.AddWarnNetLog(
+                    "Failed to decode message! Type: " + std::to_string(static_cast<int>(messageType)) +
+                    ", size: " + std::to_string(messageData.size())
+                );
+                return;
             }
+            mNetSubscribersManager.HandleReceivedP2PMessage(senderId, messageType, mDecodedMessageBuffer);
         }
 
         void OnAllPlayerInfoQueriesCompleted(const EOSPlayersInfoTracking& playersInfoTracking) override {
@@ -459,10 +589,21 @@ namespace ProjectNomad {
             mLogger.AddWarnNetLog(identifier, "Not initialized");
             return true;
         }
+        bool CheckAndLogIfNotUsingEOS(const std::string& identifier) const {
+            if (mEosWrapper) {
+                return false;
+            }
+
+            mLogger.AddWarnNetLog(identifier, "Not available without EOS");
+            return true;
+        }
         
         void CleanupState(bool forceShutdown) {
             // Clean up callbacks/subcribers just to be clean and safe
             mNetSubscribersManager = {};
+            mMessageDispatcher = {};
+            RegisterInternalMessageHandlers();
+            mPeerLatencyEstimators.clear();
 
             // FUTURE: Clear up any actual data storage we have (like logged in status). However...
             //      This only matters if we support re-initialization which isn't a goal atm.
@@ -470,7 +611,9 @@ namespace ProjectNomad {
             
             // Unlike other typical singletons in project, the EOSWrapper is "managed" by this class
             // Thus pass on the clean up call to the EOSWrapper
-            mEosWrapperSingleton.CleanupState(forceShutdown);
+            if (mEosWrapper) {
+                mEosWrapper->CleanupState(forceShutdown);
+            }
             
             mIsInitialized = false;
         }
@@ -480,14 +623,124 @@ namespace ProjectNomad {
                             const MessageType& message,
                             PacketReliability packetReliability) {
             static_assert(std::is_base_of_v<BaseNetMessage, MessageType>, "MessageType must inherit from BaseNetMessage");
-            
-            return mEosWrapperSingleton.SendP2PMessage(
+
+            NetMessageSerialization::Encode(message, mEncodedMessageBuffer);
+            return mTransport->SendPacket(
                 targetId,
-                &message,
-                sizeof(message),
+                mEncodedMessageBuffer.data(),
+                static_cast<uint32_t>(mEncodedMessageBuffer.size()),
                 packetReliability
             );
         }
+        void RegisterInternalMessageHandlers() {
+            // TODO: Clean up or rework old message types!
+            RegisterP2PMessageHandler<InitiateConnectionMessage>(
+                [this](const CrossPlatformIdWrapper& senderId, const InitiateConnectionMessage&) {
+                    SendAcceptConnectionMessage(senderId);
+                    RememberAcceptedPlayerConnection(false, senderId);
+                }
+            );
+            RegisterP2PMessageHandler<AcceptConnectionMessage>(
+                [this](const CrossPlatformIdWrapper& senderId, const AcceptConnectionMessage&) {
+                    RememberAcceptedPlayerConnection(true, senderId);
+                }
+            );
+
+            RegisterP2PMessageHandler<PlayerSpotMappingMessage>(
+                [this](const CrossPlatformIdWrapper& senderId, const PlayerSpotMappingMessage& message) {
+                    ProcessReceivedPlayerSpotMapping(senderId, message);
+                }
+            );
+        }
+        /**
+        * Answers time quality reports and measures round trip time from their responses
+        * @returns true if message was fully handled, false if message should continue on to normal handling
+        **/
+        bool HandleTimeQualityPingPong(const CrossPlatformIdWrapper& senderId,
+                                       NetMessageType messageType,
+                                       std::span<const char> messageData) {
+            if (messageType == NetMessageType::TimeQualityReport) {
+                TimeQualityReportMessage report;
+                if (NetMessageSerialization::Decode(messageData, report)) { // Otherwise let normal handling warn about it
+                    // Unreliable as a late pong is a bad RTT sample anyways
+                    SendP2PMessage(senderId, TimeQualityResponseMessage(report), PacketReliability::UnreliableUnordered);
+                }
+                return false; // Game still needs report for time sync
+            }
+            if (messageType != NetMessageType::TimeQualityResponse) {
+                return false;
+            }
+
+            TimeQualityResponseMessage response;
+            if (!NetMessageSerialization::Decode(messageData, response)) { // Could be malformed from bad actors
+                mLogger.AddWarnNetLog("TimeQualityResponse: Failed to decode message of size: " + std::to_string(messageData.size()));
+                return true;
+            }
+
+            // Pong is our own timestamp echoed back, so anything from the future is bogus
+            const uint64_t currentTimeInMicroSec = mTimeRetriever();
+            if (response.pong > currentTimeInMicroSec) {
+                mLogger.AddWarnNetLog("TimeQualityResponse: Pong is later than current time: " + std::to_string(response.pong));
+                return true;
+            }
+
+            mPeerLatencyEstimators[senderId].AddRttSample(currentTimeInMicroSec - response.pong);
+            return true;
+        }
+        /**
+        * Decodes message into its raw struct, for subscribers which expect raw message structs
+        * @param messageType - message type, expected to already be validated
+        * @param messageData - encoded message
+        * @param result - raw message struct bytes. Only valid if decoding succeeded
+        * @returns true if message was valid for its type, false otherwise
+        **/
+        static bool TryDecodeToRawStruct(NetMessageType messageType,
+                                         std::span<const char> messageData,
+                                         std::vector<char>& result) {
+            switch (messageType) {
+                case NetMessageType::TryConnect:
+                    return TryDecodeToRawStruct<InitiateConnectionMessage>(messageData, result);
+                case NetMessageType::AcceptConnection:
+                    return TryDecodeToRawStruct<AcceptConnectionMessage>(messageData, result);
+                case NetMessageType::InputUpdate:
+                    return TryDecodeToRawStruct<InputUpdateMessage>(messageData, result);
+                case NetMessageType::PlayerSpotMapping:
+                    return TryDecodeToRawStruct<PlayerSpotMappingMessage>(messageData, result);
+                case NetMessageType::TimeQualityReport:
+                    return TryDecodeToRawStruct<TimeQualityReportMessage>(messageData, result);
+                case NetMessageType::TimeQualityResponse:
+                    return TryDecodeToRawStruct<TimeQualityResponseMessage>(messageData, result);
+                case NetMessageType::ValidationChecksum:
+                    return TryDecodeToRawStruct<ValidationChecksumMessage>(messageData, result);
+                case NetMessageType::PrepareLobbyStartMatch:
+                    return TryDecodeToRawStruct<PrepareLobbyStartMessage>(messageData, result);
+                case NetMessageType::ConfirmedLobbyStartMatch:
+                    return TryDecodeToRawStruct<ConfirmedLobbyStartMessage>(messageData, result);
+                case NetMessageType::LoadMap:
+                    return TryDecodeToRawStruct<LoadMapMessage>(messageData, result);
+                case NetMessageType::FinishedMapLoad:
+                    return TryDecodeToRawStruct<FinishedMapLoadMessage>(messageData, result);
+                case NetMessageType::StartGameplay:
+                    return TryDecodeToRawStruct<StartGameplayMessage>(messageData, result);
+                case NetMessageType::DesyncLocalizationRequest:
+                    return TryDecodeToRawStruct<DesyncLocalizationRequestMessage>(messageData, result);
+                case NetMessageType::DesyncLocalizationResponse:
+                    return TryDecodeToRawStruct<DesyncLocalizationResponseMessage>(messageData, result);
+                default:
+                    return false;
+            }
+        }
+        template<typename MessageType>
+        static bool TryDecodeToRawStruct(std::span<const char> messageData, std::vector<char>& result) {
+            MessageType decodedMessage;
+            if (!NetMessageSerialization::Decode(messageData, decodedMessage)) {
+                return false;
+            }
+
+            const char* decodedMessageBytes = reinterpret_cast<const char*>(&decodedMessage);
+            result.assign(decodedMessageBytes, decodedMessageBytes + sizeof(decodedMessage));
+            return true;
+        }
         static bool IsValidMessageType(uint8_t input) {
             static constexpr int finalEnumVal = static_cast<size_t>(NetMessageType::ENUM_COUNT) - 1;
             return input <= finalEnumVal;
@@ -695,15 +948,30 @@ namespace ProjectNomad {
         static constexpr PacketReliability mDefaultPacketReliability = PacketReliability::ReliableOrdered;
 
         LoggerSingleton& mLogger = Singleton<LoggerSingleton>::get();
-        EOSWrapperSingleton& mEosWrapperSingleton = Singleton<EOSWrapperSingleton>::get();
+        // Both are only set when using EOS, ie not when constructed over another transport
+        EOSWrapperSingleton* mEosWrapper = nullptr;
+        std::unique_ptr<EOSP2PTransport> mEosTransport = nullptr;
+        IP2PTransport* mDefaultTransport = nullptr;
+        IP2PTransport* mTransport = nullptr;
+        std::function<uint64_t()> mTimeRetriever = []{ return SharedUtilities::getTimeInMicroseconds(); };
+        inline static const P2PReceiveStats mEmptyReceiveStats = {};
+        uint32_t mMaxPacketsReceivedPerTick = 64; // Only used for non-EOS transports, as EOS wrapper has its own copy
+        static_assert(PlayerSpotHelpers::kMaxPlayerSpots <= IP2PTransport::kMaxSendToAllTargets, "Broadcasts can't reach all players");
+        uint32_t mLastBroadcastFailedPlayersMask = 0; // See GetLastBroadcastFailedPlayersMask
 
         bool mIsInitialized = false;
         NetSubscribersManager mNetSubscribersManager = {};
+        NetMessageDispatcher mMessageDispatcher = {};
+        std::map<CrossPlatformIdWrapper, PeerLatencyEstimator> mPeerLatencyEstimators = {};
 
         // TODO: Move connection tracking to players info tracking class
         bool mIsConnectedToOtherPlayer = false;
         PlayerId mConnectedPlayerId = PlayerId(PlayerSpot::Player1);
 
         NetPlayersInfoManager mPlayersInfoManager = {};
+
+        // Reused buffers for message encoding/decoding, to avoid allocating for every sent or received message
+        std::vector<uint8_t> mEncodedMessageBuffer = {};
+        std::vector<char> mDecodedMessageBuffer = {};
     };
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+
+#include "IP2PTransport.h"
+#include "Network/EOS/EOSWrapperSingleton.h"
+#include "Utilities/Singleton.h"
+
+namespace ProjectNomad {
+    /**
+    * Default transport, which sends packets through EOS P2P.
+    *
+    * Note that EOS packets are received as part of EOSWrapperSingleton::Tick, which passes them directly to its
+    * IEOSWrapperManager. Thus ReceivePackets has nothing to do for this transport.
+    **/
+    class EOSP2PTransport : public IP2PTransport {
+        static_assert(kMaxPacketSizeInBytes == EOS_P2P_MAX_PACKET_SIZE, "Max packet size no longer matches EOS");
+      public:
+        ~EOSP2PTransport() override = default;
+
+        bool SendPacket(const CrossPlatformIdWrapper& targetId,
+                        const void* data,
+                        uint32_t dataLengthInBytes,
+                        PacketReliability packetReliability) override {
+            return mEosWrapperSingleton.SendP2PMessage(targetId, data, dataLengthInBytes, packetReliability);
+        }
+        uint32_t SendPacketToAll(const CrossPlatformIdWrapper* targetIds,
+                                 uint32_t numTargets,
+                                 const void* data,
+                                 uint32_t dataLengthInBytes,
+                                 PacketReliability packetReliability) override {
+            return mEosWrapperSingleton.SendP2PMessageToAll(
+                targetIds, std::min(numTargets, kMaxSendToAllTargets), data, dataLengthInBytes, packetReliability
+            );
+        }
+
+        uint32_t ReceivePackets(IP2PPacketReceiver& receiver, uint32_t maxPackets) override {
+            return 0;
+        }
+
+      private:
+        EOSWrapperSingleton& mEosWrapperSingleton = Singleton<EOSWrapperSingleton>::get();
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Network/EOS/Model/CrossPlatformIdWrapper.h"
+#include "Network/EOS/Model/PacketReliability.h"
+
+namespace ProjectNomad {
+    /**
+    * Receives packets from an IP2PTransport
+    **/
+    class IP2PPacketReceiver {
+      public:
+        virtual ~IP2PPacketReceiver() = default;
+
+        /**
+        * @param senderId - packet sender's id
+        * @param packetData - raw packet. Only valid for duration of the call
+        **/
+        virtual void OnPacketReceived(const CrossPlatformIdWrapper& senderId, const std::vector<char>& packetData) = 0;
+    };
+
+    /**
+    * Abstraction for sending + receiving raw P2P packets, so that networking code can run on something other than EOS.
+    * Eg, in-process loopback for running multiple peers in one process without any online backend.
+    **/
+    class IP2PTransport {
+      public:
+        // Matches EOS_P2P_MAX_PACKET_SIZE, so that behavior is consistent regardless of transport
+        static constexpr uint32_t kMaxPacketSizeInBytes = 1170;
+        // Failed targets of SendPacketToAll are reported as a bitmask, so that's the limit per call
+        static constexpr uint32_t kMaxSendToAllTargets = 32;
+
+        virtual ~IP2PTransport() = default;
+
+        /**
+        * Queues packet for sending
+        * @param targetId - id of peer to send to
+        * @param data - packet data
+        * @param dataLengthInBytes - packet size. Expected to be no greater than kMaxPacketSizeInBytes
+        * @param packetReliability - delivery guarantees for this packet
+        * @returns true if packet was queued for sending. Note that unreliable packets may still be lost afterwards
+        **/
+        virtual bool SendPacket(const CrossPlatformIdWrapper& targetId,
+                                const void* data,
+                                uint32_t dataLengthInBytes,
+                                PacketReliability packetReliability) = 0;
+
+        /**
+        * Queues the same packet for sending to multiple peers, such as when broadcasting to everyone in a match.
+        * Transports may override this to reuse per-send setup across all targets, as it's called every frame.
+        * @param targetIds - ids of peers to send to
+        * @param numTargets - number of ids in targetIds. Any beyond kMaxSendToAllTargets are ignored
+        * @param data - packet data
+        * @param dataLengthInBytes - packet size. Expected to be no greater than kMaxPacketSizeInBytes
+        * @param packetReliability - delivery guarantees for this packet
+        * @returns bitmask where bit i is set if packet was not queued for targetIds[i]. 0 if queued for all targets
+        **/
+        virtual uint32_t SendPacketToAll(const CrossPlatformIdWrapper* targetIds,
+                                         uint32_t numTargets,
+                                         const void* data,
+                                         uint32_t dataLengthInBytes,
+                                         PacketReliability packetReliability) {
+            uint32_t failedTargetsMask = 0;
+            for (uint32_t i = 0; i < numTargets && i < kMaxSendToAllTargets; i++) {
+                if (!SendPacket(targetIds[i], data, dataLengthInBytes, packetReliability)) {
+                    failedTargetsMask |= 1u << i;
+                }
+            }
+            return failedTargetsMask;
+        }
+
+        /**
+        * Passes received packets to given receiver, oldest first
+        * @param receiver - receives each packet
+        * @param maxPackets - max packets to receive in this call. Any others remain queued for next call
+        * @returns number of packets received
+        **/
+        virtual uint32_t ReceivePackets(IP2PPacketReceiver& receiver, uint32_t maxPackets) = 0;
+    };
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "IP2PTransport.h"
+#include "GameCore/PlayerSpot.h"
+#include "Utilities/Containers/SpscQueue.h"
+
+namespace ProjectNomad {
+    class LoopbackP2PNetwork;
+
+    /**
+    * One peer's endpoint into a LoopbackP2PNetwork.
+    * Each peer may be used from its own thread, as every sender + receiver pair has its own single producer single
+    * consumer queue. However, a single peer's endpoint must only be used from one thread at a time.
+    **/
+    class LoopbackP2PTransport : public IP2PTransport {
+      public:
+        LoopbackP2PTransport(LoopbackP2PNetwork& network, uint32_t peerIndex) : mNetwork(network), mPeerIndex(peerIndex) {}
+        ~LoopbackP2PTransport() override = default;
+
+        /**
+        * Packets are always delivered in order. When receiving peer's queue is full, unreliable packets are dropped
+        * (like a saturated link would) while reliable packets fail to send, similar to a full EOS outgoing queue.
+        **/
+        bool SendPacket(const CrossPlatformIdWrapper& targetId,
+                        const void* data,
+                        uint32_t dataLengthInBytes,
+                        PacketReliability packetReliability) override;
+        uint32_t ReceivePackets(IP2PPacketReceiver& receiver, uint32_t maxPackets) override;
+
+        CrossPlatformIdWrapper GetLocalId() const;
+        // Unreliable packets dropped as receiver's queue was full
+        uint64_t GetDroppedPacketCount() const {
+            return mDroppedPacketCount;
+        }
+
+      private:
+        LoopbackP2PNetwork& mNetwork;
+        uint32_t mPeerIndex;
+        uint32_t mNextSenderToReceiveFrom = 0; // Rotates so no sender is always drained first
+        uint64_t mDroppedPacketCount = 0;
+        std::vector<char> mReceiveBuffer = {};
+    };
+
+    /**
+    * In-process network which connects multiple peers via memory, rather than through an online backend.
+    * Intended for running multiple peers in one process, such as for headless tests and benchmarks.
+    **/
+    class LoopbackP2PNetwork {
+      public:
+        static constexpr uint32_t kMaxPeers = PlayerSpotHelpers::kMaxPlayerSpots;
+        // Per sender + receiver pair. Roughly 4 seconds of sending multiple packets every frame at 60 fps
+        static constexpr uint32_t kQueueCapacity = 256;
+
+        struct Packet {
+            CrossPlatformIdWrapper senderId = {};
+            uint32_t sizeInBytes = 0;
+            std::array<char, IP2PTransport::kMaxPacketSizeInBytes> data = {};
+        };
+        using PacketQueue = SpscQueue<Packet, kQueueCapacity>;
+
+        /**
+        * @param numPeers - number of peers to create. Expected to be in range [1, kMaxPeers]
+        **/
+        explicit LoopbackP2PNetwork(uint32_t numPeers) {
+            mNumPeers = numPeers < 1 ? 1 : (numPeers > kMaxPeers ? kMaxPeers : numPeers);
+
+            // Queues are large, so only create for peers that actually exist. Heap allocated so they never move
+            mQueues.resize(mNumPeers * mNumPeers);
+            for (std::unique_ptr<PacketQueue>& queue : mQueues) {
+                queue = std::make_unique<PacketQueue>();
+            }
+            for (uint32_t i = 0; i < mNumPeers; i++) {
+                mPeers.push_back(std::make_unique<LoopbackP2PTransport>(*this, i));
+            }
+        }
+
+        uint32_t GetNumPeers() const {
+            return mNumPeers;
+        }
+        LoopbackP2PTransport& GetPeer(uint32_t peerIndex) {
+            return *mPeers[peerIndex];
+        }
+
+        /**
+        * Ids are fake EOS ids which only make sense within a loopback network, so they must never be passed to EOS
+        * itself (including CrossPlatformIdWrapper methods like IsValid or ToStringForLogging)
+        **/
+        static CrossPlatformIdWrapper GetPeerId(uint32_t peerIndex) {
+            return CrossPlatformIdWrapper(reinterpret_cast<EOS_ProductUserId>(static_cast<uintptr_t>(peerIndex) + 1));
+        }
+        bool TryGetPeerIndex(const CrossPlatformIdWrapper& peerId, uint32_t& result) const {
+            const uintptr_t rawId = reinterpret_cast<uintptr_t>(peerId.GetAccountId());
+            if (rawId == 0 || rawId > mNumPeers) {
+                return false;
+            }
+
+            result = static_cast<uint32_t>(rawId - 1);
+            return true;
+        }
+
+        PacketQueue& GetQueue(uint32_t senderIndex, uint32_t receiverIndex) {
+            return *mQueues[senderIndex * mNumPeers + receiverIndex];
+        }
+
+      private:
+        uint32_t mNumPeers = 0;
+        std::vector<std::unique_ptr<PacketQueue>> mQueues = {};
+        std::vector<std::unique_ptr<LoopbackP2PTransport>> mPeers = {};
+    };
+
+    inline bool LoopbackP2PTransport::SendPacket(const CrossPlatformIdWrapper& targetId,
+                                                 const void* data,
+                                                 uint32_t dataLengthInBytes,
+                                                 PacketReliability packetReliability) {
+        uint32_t targetIndex = 0;
+        if (!mNetwork.TryGetPeerIndex(targetId, targetIndex) || targetIndex == mPeerIndex) {
+            return false;
+        }
+        if (dataLengthInBytes > kMaxPacketSizeInBytes) {
+            return false;
+        }
+
+        const CrossPlatformIdWrapper senderId = GetLocalId();
+        bool didQueue = mNetwork.GetQueue(mPeerIndex, targetIndex).TryPush(
+            [&](LoopbackP2PNetwork::Packet& packet) {
+                packet.senderId = senderId;
+                packet.sizeInBytes = dataLengthInBytes;
+                std::memcpy(packet.data.data(), data, dataLengthInBytes);
+            }
+        );
+        if (didQueue) {
+            return true;
+        }
+
+        // Queue is full
+        if (packetReliability == PacketReliability::UnreliableUnordered) {
+            mDroppedPacketCount++;
+            return true; // Unreliable packets are never guaranteed to arrive, so "sending" still succeeded
+        }
+        return false;
+    }
+
+    inline uint32_t LoopbackP2PTransport::ReceivePackets(IP2PPacketReceiver& receiver, uint32_t maxPackets) {
+        const uint32_t numPeers = mNetwork.GetNumPeers();
+
+        uint32_t packetsReceived = 0;
+        for (uint32_t i = 0; i < numPeers && packetsReceived < maxPackets; i++) {
+            const uint32_t senderIndex = (mNextSenderToReceiveFrom + i) % numPeers;
+            if (senderIndex == mPeerIndex) {
+                continue;
+            }
+
+            LoopbackP2PNetwork::PacketQueue& queue = mNetwork.GetQueue(senderIndex, mPeerIndex);
+            while (packetsReceived < maxPackets) {
+                CrossPlatformIdWrapper senderId = {};
+                bool didReceive = queue.TryPop([&](const LoopbackP2PNetwork::Packet& packet) {
+                    senderId = packet.senderId;
+                    // Reused buffer, so never allocates after the first few packets
+                    mReceiveBuffer.assign(packet.data.data(), packet.data.data() + packet.sizeInBytes);
+                });
+                if (!didReceive) {
+                    break;
+                }
+
+                // Handle outside of pop, so queue slot is freed up even if receiver sends packets in response
+                receiver.OnPacketReceived(senderId, mReceiveBuffer);
+                packetsReceived++;
+            }
+        }
+
+        mNextSenderToReceiveFrom = (mNextSenderToReceiveFrom + 1) % numPeers;
+        return packetsReceived;
+    }
+
+    inline CrossPlatformIdWrapper LoopbackP2PTransport::GetLocalId() const {
+        return LoopbackP2PNetwork::GetPeerId(mPeerIndex);
+    }
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "IP2PTransport.h"
+#include "NetworkConditions.h"
+#include "Random/SquirrelRNG.h"
+#include "Utilities/SharedUtilities.h"
+
+namespace ProjectNomad {
+    struct NetworkConditionStats {
+        uint64_t packetsSent = 0;
+        // Unreliable packets which were lost entirely
+        uint64_t packetsDropped = 0;
+        // Reliable packets which were "lost" and thus delivered late, as a real reliable transport would resend them
+        uint64_t packetsResent = 0;
+        uint64_t packetsDuplicated = 0;
+        uint64_t packetsReordered = 0;
+        // Packets which the wrapped transport refused, such as due to a full queue
+        uint64_t packetsRejected = 0;
+    };
+
+    /**
+    * Transport which sits in front of another transport and impairs outgoing packets with latency, jitter, loss,
+    * duplication, and reordering. Intended for measuring how rollback behaves under real-world network conditions,
+    * such as with headless peers over LoopbackP2PNetwork.
+    *
+    * Impairments follow each PacketReliability's guarantees:
+    *   - UnreliableUnordered packets may be lost, duplicated, or reordered
+    *   - ReliableUnordered packets are never lost. Instead, a "lost" packet arrives an extra round trip late (as if
+    *     resent), and may still be reordered
+    *   - ReliableOrdered packets are likewise never lost and additionally never overtake earlier ordered packets
+    *
+    * Conditions can be set per link and per PacketReliability, as reliable and unreliable packets don't necessarily
+    * take the same path (eg, reliable packets waiting behind resends in EOS's own queues).
+    *
+    * All randomness comes from SquirrelRNG with the given seed, so the same seed + same sends at the same times always
+    * result in the exact same impairments.
+    *
+    * Only outgoing packets are impaired, so wrap every peer's transport to impair both directions of a link.
+    * Held packets are passed on to the wrapped transport whenever ReceivePackets (or FlushDuePackets) is called, thus
+    * delivery times are only as precise as how often that's called.
+    **/
+    class NetworkConditionSimulator : public IP2PTransport {
+      public:
+        NetworkConditionSimulator(IP2PTransport& innerTransport, uint64_t seed)
+            : mInnerTransport(innerTransport), mSeed(seed) {}
+        // Special constructor for tests and headless simulation so time can be precisely controlled
+        NetworkConditionSimulator(IP2PTransport& innerTransport, uint64_t seed, std::function<uint64_t()> timeRetriever)
+            : mInnerTransport(innerTransport), mSeed(seed), mTimeRetriever(std::move(timeRetriever)) {}
+        ~NetworkConditionSimulator() override = default;
+
+        // Conditions for any link which doesn't have its own conditions set, for every reliability
+        void SetDefaultConditions(const NetworkLinkConditions& conditions) {
+            mDefaultConditions.fill(conditions);
+        }
+        // Conditions for any link which doesn't have its own conditions set, only for given reliability
+        void SetDefaultConditions(PacketReliability packetReliability, const NetworkLinkConditions& conditions) {
+            mDefaultConditions[ToIndex(packetReliability)] = conditions;
+        }
+        void SetLinkConditions(const CrossPlatformIdWrapper& targetId, const NetworkLinkConditions& conditions) {
+            mLinkConditions[targetId].fill(conditions);
+        }
+        // Other reliabilities keep using the current defaults
+        void SetLinkConditions(const CrossPlatformIdWrapper& targetId,
+                               PacketReliability packetReliability,
+                               const NetworkLinkConditions& conditions) {
+            auto [iter, didInsert] = mLinkConditions.try_emplace(targetId, mDefaultConditions);
+            iter->second[ToIndex(packetReliability)] = conditions;
+        }
+
+        bool SendPacket(const CrossPlatformIdWrapper& targetId,
+                        const void* data,
+                        uint32_t dataLengthInBytes,
+                        PacketReliability packetReliability) override {
+            if (dataLengthInBytes > kMaxPacketSizeInBytes) {
+                return false;
+            }
+
+            const NetworkLinkConditions& conditions = GetConditions(targetId, packetReliability);
+            LinkState& linkState = mLinkStates[targetId];
+            const bool isReliable = packetReliability != PacketReliability::UnreliableUnordered;
+            const bool isOrdered = packetReliability == PacketReliability::ReliableOrdered;
+            mStats.packetsSent++;
+
+            const uint64_t curTime = mTimeRetriever();
+            uint64_t deliveryTime = curTime + conditions.latencyInMicroSec + RollJitter(conditions);
+
+            if (RollLoss(conditions, linkState)) {
+                if (!isReliable) {
+                    mStats.packetsDropped++;
+                    return true; // Unreliable packets are never guaranteed to arrive, so "sending" still succeeded
+                }
+
+                // Sender only notices loss after roughly a round trip, then the resent packet needs to travel again
+                deliveryTime += conditions.latencyInMicroSec * 2 + RollJitter(conditions);
+                mStats.packetsResent++;
+            }
+
+            if (isOrdered) {
+                deliveryTime = std::max(deliveryTime, linkState.lastOrderedDeliveryTime);
+                linkState.lastOrderedDeliveryTime = deliveryTime;
+            }
+            else if (RollChance(conditions.reorderChance)) {
+                deliveryTime += conditions.reorderDelayInMicroSec;
+                mStats.packetsReordered++;
+            }
+
+            HoldPacket(targetId, data, dataLengthInBytes, packetReliability, deliveryTime);
+            if (!isReliable && RollChance(conditions.duplicateChance)) {
+                HoldPacket(targetId, data, dataLengthInBytes, packetReliability,
+                           deliveryTime + RollJitter(conditions));
+                mStats.packetsDuplicated++;
+            }
+
+            return true;
+        }
+
+        uint32_t ReceivePackets(IP2PPacketReceiver& receiver, uint32_t maxPackets) override {
+            FlushDuePackets();
+            return mInnerTransport.ReceivePackets(receiver, maxPackets);
+        }
+
+        // Passes any held packets whose delivery time has been reached on to the wrapped transport
+        void FlushDuePackets() {
+            const uint64_t curTime = mTimeRetriever();
+            while (!mHeldPackets.empty() && mHeldPackets.front().deliveryTime <= curTime) {
+                HeldPacket& packet = mHeldPackets.front();
+                bool didSend = mInnerTransport.SendPacket(
+                    packet.targetId,
+                    packet.data.data(),
+                    static_cast<uint32_t>(packet.data.size()),
+                    packet.reliability
+                );
+
+                // Reliable packets must eventually arrive, so keep trying on later flushes. Still stop here either way
+                //      so later packets don't overtake this one
+                if (!didSend && packet.reliability != PacketReliability::UnreliableUnordered) {
+                    mStats.packetsRejected++;
+                    return;
+                }
+                if (!didSend) {
+                    mStats.packetsRejected++;
+                }
+
+                std::pop_heap(mHeldPackets.begin(), mHeldPackets.end(), IsDeliveredLater);
+                mFreeBuffers.push_back(std::move(mHeldPackets.back().data));
+                mHeldPackets.pop_back();
+            }
+        }
+
+        uint32_t GetHeldPacketCount() const {
+            return static_cast<uint32_t>(mHeldPackets.size());
+        }
+        const NetworkConditionStats& GetStats() const {
+            return mStats;
+        }
+
+      private:
+        static constexpr uint32_t kNumReliabilities = static_cast<uint32_t>(PacketReliability::ReliableOrdered) + 1;
+        using ConditionsPerReliability = std::array<NetworkLinkConditions, kNumReliabilities>;
+
+        // Loss bursts + ordering are per link rather than per reliability, as every packet shares the same link
+        struct LinkState {
+            bool isInLossBurst = false;
+            uint64_t lastOrderedDeliveryTime = 0;
+        };
+        struct HeldPacket {
+            uint64_t deliveryTime = 0;
+            uint64_t sequence = 0; // Tie breaker so packets with the same delivery time keep send order
+            CrossPlatformIdWrapper targetId = {};
+            PacketReliability reliability = PacketReliability::UnreliableUnordered;
+            std::vector<char> data = {};
+        };
+
+        // Heap comparison, so that earliest delivery is at front of heap
+        static bool IsDeliveredLater(const HeldPacket& lhs, const HeldPacket& rhs) {
+            if (lhs.deliveryTime != rhs.deliveryTime) {
+                return lhs.deliveryTime > rhs.deliveryTime;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+
+        static uint32_t ToIndex(PacketReliability packetReliability) {
+            return std::min(static_cast<uint32_t>(packetReliability), kNumReliabilities - 1);
+        }
+        const NetworkLinkConditions& GetConditions(const CrossPlatformIdWrapper& targetId,
+                                                   PacketReliability packetReliability) const {
+            auto iter = mLinkConditions.find(targetId);
+            const ConditionsPerReliability& conditions = iter != mLinkConditions.end() ? iter->second : mDefaultConditions;
+            return conditions[ToIndex(packetReliability)];
+        }
+
+        void HoldPacket(const CrossPlatformIdWrapper& targetId,
+                        const void* data,
+                        uint32_t dataLengthInBytes,
+                        PacketReliability packetReliability,
+                        uint64_t deliveryTime) {
+            HeldPacket packet = {};
+            packet.deliveryTime = deliveryTime;
+            packet.sequence = mNextSequence++;
+            packet.targetId = targetId;
+            packet.reliability = packetReliability;
+
+            // Reuse buffers of already delivered packets, so steady state doesn't allocate per packet
+            if (!mFreeBuffers.empty()) {
+                packet.data = std::move(mFreeBuffers.back());
+                mFreeBuffers.pop_back();
+            }
+            const char* dataAsChars = static_cast<const char*>(data);
+            packet.data.assign(dataAsChars, dataAsChars + dataLengthInBytes);
+
+            mHeldPackets.push_back(std::move(packet));
+            std::push_heap(mHeldPackets.begin(), mHeldPackets.end(), IsDeliveredLater);
+        }
+
+        // Simple two state model: losses are more likely right after another loss, which results in loss bursts
+        bool RollLoss(const NetworkLinkConditions& conditions, LinkState& linkState) {
+            const uint32_t lossChance = linkState.isInLossBurst
+                                            ? std::max(conditions.lossChance, conditions.lossBurstContinueChance)
+                                            : conditions.lossChance;
+            linkState.isInLossBurst = RollChance(lossChance);
+            return linkState.isInLossBurst;
+        }
+        bool RollChance(uint32_t chance) {
+            if (chance == 0) { // Don't consume a random number so unused impairments don't affect other rolls
+                return false;
+            }
+            return NextRandom() % NetworkLinkConditions::kChanceScale < chance;
+        }
+        uint64_t RollJitter(const NetworkLinkConditions& conditions) {
+            const uint64_t maxJitter = conditions.jitterInMicroSec;
+            switch (conditions.jitterDistribution) {
+                case JitterDistribution::Normal: {
+                    // Average of several uniform rolls (Irwin-Hall), which approaches a normal distribution while
+                    //      staying within range and only using integer math
+                    uint64_t total = 0;
+                    for (uint32_t i = 0; i < kNormalJitterRolls; i++) {
+                        total += RollUpTo(maxJitter);
+                    }
+                    return total / kNormalJitterRolls;
+                }
+                case JitterDistribution::LongTail:
+                    // Product of two uniform rolls, so small delays are far more likely than large ones
+                    return maxJitter == 0 ? 0 : RollUpTo(maxJitter) * RollUpTo(maxJitter) / maxJitter;
+                default:
+                    return RollUpTo(maxJitter);
+            }
+        }
+        uint64_t RollUpTo(uint64_t maxValue) {
+            if (maxValue == 0) {
+                return 0;
+            }
+            return NextRandom() % (maxValue + 1);
+        }
+        uint64_t NextRandom() {
+            return SquirrelRNG::GetRandom(mSeed, mRandomPosition++);
+        }
+
+        IP2PTransport& mInnerTransport;
+        uint64_t mSeed;
+        uint64_t mRandomPosition = 0;
+        std::function<uint64_t()> mTimeRetriever = []{ return SharedUtilities::getTimeInMicroseconds(); };
+
+        static constexpr uint32_t kNormalJitterRolls = 4;
+
+        ConditionsPerReliability mDefaultConditions = {};
+        std::map<CrossPlatformIdWrapper, ConditionsPerReliability> mLinkConditions = {};
+        std::map<CrossPlatformIdWrapper, LinkState> mLinkStates = {};
+
+        std::vector<HeldPacket> mHeldPackets = {}; // Min heap by delivery time
+        std::vector<std::vector<char>> mFreeBuffers = {};
+        uint64_t mNextSequence = 0;
+        NetworkConditionStats mStats = {};
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace ProjectNomad {
+    // How jitter is spread across [0, jitterInMicroSec]
+    enum class JitterDistribution : uint8_t {
+        Uniform,    // Every delay equally likely
+        Normal,     // Bell curve around half the jitter, such as a steadily busy route
+        LongTail,   // Most packets barely delayed with rare large spikes, such as wifi or mobile. Averages a quarter of jitter
+    };
+
+    /**
+    * Impairments applied to a single direction of a P2P link by NetworkConditionSimulator.
+    *
+    * Chances are integers out of kChanceScale (ie, 100 == 1%) rather than floating point, so that the exact same
+    * packets are impaired for a given seed regardless of platform or compiler settings.
+    **/
+    struct NetworkLinkConditions {
+        static constexpr uint32_t kChanceScale = 10000;
+
+        // One-way delay applied to every packet
+        uint64_t latencyInMicroSec = 0;
+        // Extra delay per packet in [0, jitter], spread per jitterDistribution. Unordered packets may thus arrive out of order
+        uint64_t jitterInMicroSec = 0;
+        JitterDistribution jitterDistribution = JitterDistribution::Uniform;
+
+        // Chance a packet is lost while link is behaving normally
+        uint32_t lossChance = 0;
+        // Chance the next packet is also lost right after a loss, which models bursts of loss (eg, wifi interference).
+        //      Values no greater than lossChance (such as 0) mean losses are independent of each other
+        uint32_t lossBurstContinueChance = 0;
+
+        // Chance an unreliable packet is delivered twice
+        uint32_t duplicateChance = 0;
+        // Chance an unordered packet is held back by reorderDelayInMicroSec, so later packets overtake it
+        uint32_t reorderChance = 0;
+        uint64_t reorderDelayInMicroSec = 0;
+    };
+
+    struct NetworkConditionProfile {
+        const char* name = "";
+        NetworkLinkConditions conditions = {};
+    };
+
+    /**
+    * Rough approximations of real-world connections, intended for benchmarking and tuning rollback settings.
+    * Values are one-way, so round trip time is roughly double the latency.
+    **/
+    class NetworkConditionProfiles {
+      public:
+        NetworkConditionProfiles() = delete;
+
+        static constexpr NetworkConditionProfile Ideal() {
+            return {"ideal", {}};
+        }
+        static constexpr NetworkConditionProfile Lan() {
+            NetworkConditionProfile result = {"lan", {}};
+            result.conditions.latencyInMicroSec = 1000;
+            result.conditions.jitterInMicroSec = 500;
+            return result;
+        }
+        static constexpr NetworkConditionProfile GoodBroadband() {
+            NetworkConditionProfile result = {"goodBroadband", {}};
+            result.conditions.latencyInMicroSec = 20000;
+            result.conditions.jitterInMicroSec = 3000;
+            result.conditions.lossChance = 10; // 0.1%
+            return result;
+        }
+        static constexpr NetworkConditionProfile Wifi() {
+            NetworkConditionProfile result = {"wifi", {}};
+            result.conditions.latencyInMicroSec = 30000;
+            result.conditions.jitterInMicroSec = 15000;
+            result.conditions.jitterDistribution = JitterDistribution::LongTail;
+            result.conditions.lossChance = 100; // 1%
+            result.conditions.lossBurstContinueChance = 3000; // 30%
+            result.conditions.reorderChance = 50; // 0.5%
+            result.conditions.reorderDelayInMicroSec = 20000;
+            return result;
+        }
+        static constexpr NetworkConditionProfile CrossRegion() {
+            NetworkConditionProfile result = {"crossRegion", {}};
+            result.conditions.latencyInMicroSec = 80000;
+            result.conditions.jitterInMicroSec = 10000;
+            result.conditions.lossChance = 50; // 0.5%
+            return result;
+        }
+        static constexpr NetworkConditionProfile PoorMobile() {
+            NetworkConditionProfile result = {"poorMobile", {}};
+            result.conditions.latencyInMicroSec = 120000;
+            result.conditions.jitterInMicroSec = 40000;
+            result.conditions.jitterDistribution = JitterDistribution::LongTail;
+            result.conditions.lossChance = 300; // 3%
+            result.conditions.lossBurstContinueChance = 5000; // 50%
+            result.conditions.duplicateChance = 100; // 1%
+            result.conditions.reorderChance = 200; // 2%
+            result.conditions.reorderDelayInMicroSec = 30000;
+            return result;
+        }
+
+        static constexpr std::array<NetworkConditionProfile, 6> GetAll() {
+            return {Ideal(), Lan(), GoodBroadband(), Wifi(), CrossRegion(), PoorMobile()};
+        }
+    };
+}
@@ -4,6 +4,7 @@
 #include "Math/FPMath2.h"
 #include "Math/FPQuat.h"
 #include "Physics/Line.h"
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     enum class ColliderType { NotInitialized, Box, Sphere, Capsule };
@@ -270,26 +271,26 @@ namespace ProjectNomad {
             }
         }
 
-        void CalculateCRC32(uint32_t& resultThusFar) const {
-            center.CalculateCRC32(resultThusFar);
-            rotation.CalculateCRC32(resultThusFar);
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(center);
+            hasher.Add(rotation);
 
             // Only make checksum based on values in use, which depends on collider type.
             // This is (supposedly) necessary as constructors and setters are designed to NOT set other values.
             switch (colliderType) {
                 case ColliderType::Box:
-                    resultThusFar = CRC::Calculate(&boxHalfSizeX, sizeof(boxHalfSizeX), CRC::CRC_32(), resultThusFar);
-                    resultThusFar = CRC::Calculate(&boxHalfSizeY, sizeof(boxHalfSizeY), CRC::CRC_32(), resultThusFar);
-                    resultThusFar = CRC::Calculate(&boxHalfSizeZ, sizeof(boxHalfSizeZ), CRC::CRC_32(), resultThusFar);
+                    hasher.Add(boxHalfSizeX);
+                    hasher.Add(boxHalfSizeY);
+                    hasher.Add(boxHalfSizeZ);
                     break;
 
                 case ColliderType::Capsule:
-                    resultThusFar = CRC::Calculate(&capsuleHalfHeight, sizeof(capsuleHalfHeight), CRC::CRC_32(), resultThusFar);
-                    resultThusFar = CRC::Calculate(&radius, sizeof(radius), CRC::CRC_32(), resultThusFar);
+                    hasher.Add(capsuleHalfHeight);
+                    hasher.Add(radius);
                     break;
 
                 case ColliderType::Sphere:
-                    resultThusFar = CRC::Calculate(&radius, sizeof(radius), CRC::CRC_32(), resultThusFar);
+                    hasher.Add(radius);
                     break;
 
                 default:
@@ -298,6 +299,10 @@ namespace ProjectNomad {
             }
         }
 
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
+        }
+
         std::string toString() const {
             switch (colliderType) {
                 case ColliderType::NotInitialized:
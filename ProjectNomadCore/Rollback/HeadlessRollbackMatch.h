@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "RollbackManager.h"
+#include "RollbackUser.h"
+#include "Model/HeadlessMatchReport.h"
+#include "Model/RollbackSettings.h"
+#include "Network/SimNetworkManager.h"
+#include "Network/Transport/LoopbackP2PTransport.h"
+#include "Network/Transport/NetworkConditions.h"
+#include "Network/Transport/NetworkConditionSimulator.h"
+
+namespace ProjectNomad {
+    struct HeadlessMatchSettings {
+        // Shared by all peers. Player count and player spots are set per peer, so those values are ignored
+        RollbackSettings rollbackSettings = {};
+        // Applied to every link in both directions
+        NetworkLinkConditions linkConditions = {};
+        uint64_t networkSeed = 0;
+
+        // Simulated time between ticks. Defaults to ticking once per frame
+        uint64_t tickIntervalInMicroSec = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        // Each peer starts this much later than the previous peer, which gives time sync something to correct
+        uint64_t peerStartStaggerInMicroSec = 0;
+        // Max packets each peer receives per tick (see SimNetworkManager::SetMaxPacketsReceivedPerTick)
+        uint32_t maxPacketsReceivedPerTick = 64;
+    };
+
+    /**
+    * Runs a full multiplayer rollback match within a single process and entirely in simulated time, with every peer
+    * connected over LoopbackP2PNetwork behind a NetworkConditionSimulator. Intended for measuring (and tuning
+    * RollbackSettings against) rollback behavior under different network conditions, without any real network or
+    * real waiting involved.
+    *
+    * Game users only need to handle gameplay callbacks (snapshots, inputs, frame processing). All networking callbacks
+    * are handled here by sending messages through each peer's own SimNetworkManager, same as the game itself would.
+    * Peer index == player spot, with peer 0 hosting.
+    *
+    * Everything is deterministic: same users + same settings always result in the exact same match and report.
+    * @tparam SnapshotType - game's snapshot type, same as RollbackManager
+    **/
+    template <typename SnapshotType>
+    class HeadlessRollbackMatch {
+      public:
+        /**
+        * @param gameUsers - one user per peer, each with entirely separate gameplay state. Expected to outlive match
+        * @param settings - match settings
+        **/
+        HeadlessRollbackMatch(const std::vector<RollbackUser<SnapshotType>*>& gameUsers, const HeadlessMatchSettings& settings)
+            : mSettings(settings), mNetwork(static_cast<uint32_t>(gameUsers.size())) {
+            // Network clamps peer count to valid range, so use that rather than given users directly
+            for (uint32_t i = 0; i < mNetwork.GetNumPeers(); i++) {
+                mPeerIds.push_back(LoopbackP2PNetwork::GetPeerId(i));
+            }
+            for (uint32_t i = 0; i < mNetwork.GetNumPeers(); i++) {
+                // Each peer needs its own RNG sequence, otherwise links would be impaired identically
+                const uint64_t peerSeed = SquirrelRNG::GetRandom(mSettings.networkSeed, i);
+                mPeers.push_back(std::make_unique<Peer>(*this, i, *gameUsers[i], peerSeed));
+            }
+        }
+
+        uint32_t GetNumPeers() const {
+            return static_cast<uint32_t>(mPeers.size());
+        }
+        RollbackManager<SnapshotType>& GetRollbackManager(uint32_t peerIndex) {
+            return mPeers[peerIndex]->rollbackManager;
+        }
+
+        /**
+        * Advances simulated time by a single tick, which starts any peers that are due to start, ticks every started
+        * peer, and then delivers any packets which arrived by now
+        **/
+        void Tick() {
+            mCurTimeInMicroSec += mSettings.tickIntervalInMicroSec;
+
+            for (std::unique_ptr<Peer>& peer : mPeers) {
+                if (!peer->isStarted && mCurTimeInMicroSec >= peer->startTimeInMicroSec) {
+                    StartPeer(*peer);
+                }
+            }
+            for (std::unique_ptr<Peer>& peer : mPeers) {
+                if (peer->isStarted) {
+                    peer->rollbackManager.OnTick();
+                    peer->report.ticks++;
+                }
+            }
+            // Receive only after everyone ticked, so peers' order within mPeers doesn't give any peer an advantage
+            for (std::unique_ptr<Peer>& peer : mPeers) {
+                if (peer->isStarted) {
+                    peer->networkManager.Tick();
+                }
+            }
+
+            UpdateFrameDifferencesToHost();
+        }
+
+        void RunFor(uint64_t durationInMicroSec) {
+            const uint64_t endTime = mCurTimeInMicroSec + durationInMicroSec;
+            while (mCurTimeInMicroSec < endTime) {
+                Tick();
+            }
+        }
+
+        HeadlessMatchReport GetReport() const {
+            HeadlessMatchReport result = {};
+            result.simulatedTimeInMicroSec = mCurTimeInMicroSec;
+            for (const std::unique_ptr<Peer>& peer : mPeers) {
+                HeadlessPeerReport peerReport = peer->report;
+                peerReport.outgoingNetworkStats = peer->transport.GetStats();
+                peerReport.latencyToHost = peer->networkManager.GetPeerLatencyStats(mPeerIds[0]);
+                peerReport.finalLocalInputDelay = peer->rollbackManager.GetLocalInputDelay();
+                result.peers.Add(peerReport);
+            }
+            return result;
+        }
+
+      private:
+        /**
+        * Passes gameplay callbacks to the game's user while sending network callbacks to other peers.
+        * Also counts rollback behavior for the report, as these callbacks are called regardless of whether
+        * RollbackManager's own perf counters are compiled in.
+        **/
+        class HeadlessPeerUser : public RollbackUser<SnapshotType> {
+          public:
+            HeadlessPeerUser(RollbackUser<SnapshotType>& gameUser, SimNetworkManager& networkManager, HeadlessPeerReport& report)
+                : mGameUser(gameUser), mNetworkManager(networkManager), mReport(report) {}
+            ~HeadlessPeerUser() override = default;
+
+            void GenerateSnapshot(FrameType expectedFrame, SnapshotType& result) override {
+                mGameUser.GenerateSnapshot(expectedFrame, result);
+            }
+            void RestoreSnapshot(FrameType expectedFrame, const SnapshotType& snapshotToRestore) override {
+                mGameUser.RestoreSnapshot(expectedFrame, snapshotToRestore);
+            }
+            bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+                return mGameUser.GetInputForNextFrame(expectedFrame, result);
+            }
+            void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+                RecordFrameSimulated(expectedFrame);
+                mGameUser.ProcessFrame(expectedFrame, playerInputs);
+            }
+            void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+                RecordFrameSimulated(expectedFrame);
+                mGameUser.ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            }
+            void OnPostRollback() override {
+                mReport.rollbacks++;
+                mGameUser.OnPostRollback();
+            }
+
+            void SendTimeQualityReport(FrameType currentFrame) override {
+                // Superseded by the next report anyways, so no need for reliability
+                mNetworkManager.SendP2PMessageToAllPlayersInMatchLobby(mNetworkManager.CreateTimeQualityReport(currentFrame),
+                                                                       PacketReliability::UnreliableUnordered);
+                mGameUser.SendTimeQualityReport(currentFrame);
+            }
+            void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) override {
+                mNetworkManager.SendP2PMessageToAllPlayersInMatchLobby(ValidationChecksumMessage(targetFrame, checksum),
+                                                                       PacketReliability::ReliableUnordered);
+                mGameUser.SendValidationChecksum(targetFrame, checksum);
+            }
+            // Desync localization stops if any message is lost, so always reliable
+            void SendDesyncLocalizationRequestToHost(const DesyncLocalizationRequestMessage& message) override {
+                mNetworkManager.SendP2PMessageToMatchLobbyHost(message, PacketReliability::ReliableUnordered);
+                mGameUser.SendDesyncLocalizationRequestToHost(message);
+            }
+            void SendDesyncLocalizationResponse(PlayerSpot requesterSpot, const DesyncLocalizationResponseMessage& message) override {
+                const NetPlayerSpotMapping& mapping = mNetworkManager.GetPlayersInfo().netLobbyInfo.playerSpotMapping;
+                CrossPlatformIdWrapper requesterId = {};
+                if (mapping.TryGetPlayerIdForSpot(mLogger, requesterSpot, requesterId)) {
+                    mNetworkManager.SendP2PMessageToSpecifiedPlayerInLobby(message, PacketReliability::ReliableUnordered, requesterId);
+                }
+                mGameUser.SendDesyncLocalizationResponse(requesterSpot, message);
+            }
+            void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {
+                mNetworkManager.SendP2PMessageToAllPlayersInMatchLobby(message, PacketReliability::UnreliableUnordered);
+                mGameUser.SendLocalInputsToRemotePlayers(message);
+            }
+            void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) override {
+                mReport.stallTicks++;
+                mGameUser.OnStallingForRemoteInputs(stallInfo);
+            }
+            void OnInputsExitRollbackWindow(FrameType confirmedFrame) override {
+                mGameUser.OnInputsExitRollbackWindow(confirmedFrame);
+            }
+
+            FrameType GetLastProcessedFrame() const {
+                return mLastProcessedFrame;
+            }
+
+          private:
+            // New frames processed during a rollback are also processed without rendering, so go by frame number instead
+            void RecordFrameSimulated(FrameType frame) {
+                if (!mHasProcessedAnyFrame || frame > mLastProcessedFrame) {
+                    mHasProcessedAnyFrame = true;
+                    mLastProcessedFrame = frame;
+                    mReport.framesProcessed++;
+                }
+                else {
+                    mReport.framesResimulated++;
+                }
+            }
+
+            RollbackUser<SnapshotType>& mGameUser;
+            SimNetworkManager& mNetworkManager;
+            HeadlessPeerReport& mReport;
+            LoggerSingleton& mLogger = Singleton<LoggerSingleton>::get();
+
+            bool mHasProcessedAnyFrame = false;
+            FrameType mLastProcessedFrame = 0;
+        };
+
+        struct Peer {
+            Peer(HeadlessRollbackMatch& match, uint32_t peerIndex, RollbackUser<SnapshotType>& gameUser, uint64_t networkSeed)
+                : peerIndex(peerIndex),
+                  transport(match.mNetwork.GetPeer(peerIndex), networkSeed, [&match] { return match.mCurTimeInMicroSec; }),
+                  networkManager(transport, match.mPeerIds[peerIndex], match.mPeerIds, [&match] { return match.mCurTimeInMicroSec; }),
+                  user(gameUser, networkManager, report),
+                  rollbackManager(user, [&match] { return match.mCurTimeInMicroSec; }) {
+                startTimeInMicroSec = match.mSettings.peerStartStaggerInMicroSec * peerIndex;
+                transport.SetDefaultConditions(match.mSettings.linkConditions);
+                networkManager.SetMaxPacketsReceivedPerTick(match.mSettings.maxPacketsReceivedPerTick);
+                RegisterMessageHandlers();
+            }
+
+            uint32_t peerIndex;
+            uint64_t startTimeInMicroSec = 0;
+            bool isStarted = false;
+
+            HeadlessPeerReport report = {};
+            NetworkConditionSimulator transport;
+            SimNetworkManager networkManager;
+            HeadlessPeerUser user;
+            RollbackManager<SnapshotType> rollbackManager;
+
+          private:
+            // Registers the same handlers a game would, while SimNetworkManager itself answers time quality reports
+            //      and measures latency from the responses
+            void RegisterMessageHandlers() {
+                networkManager.RegisterP2PMessageHandler<InputUpdateMessage>(
+                    [this](const CrossPlatformIdWrapper& senderId, const InputUpdateMessage& message) {
+                        PlayerSpot senderSpot = PlayerSpot::Player1;
+                        if (TryGetSenderSpot(senderId, senderSpot)) {
+                            rollbackManager.OnReceivedRemotePlayerInput(senderSpot, message);
+                        }
+                    }
+                );
+                networkManager.RegisterP2PMessageHandler<TimeQualityReportMessage>(
+                    [this](const CrossPlatformIdWrapper& senderId, const TimeQualityReportMessage& message) {
+                        PlayerSpot senderSpot = PlayerSpot::Player1;
+                        if (TryGetSenderSpot(senderId, senderSpot)) {
+                            const PeerLatencyStats latencyStats = networkManager.GetPeerLatencyStats(senderId);
+                            rollbackManager.OnReceivedTimeQualityReport(senderSpot,
+                                                                        message.currentFrame,
+                                                                        latencyStats.GetEstimatedOneWayDelayInMicroSec());
+                        }
+                    }
+                );
+                networkManager.RegisterP2PMessageHandler<ValidationChecksumMessage>(
+                    [this](const CrossPlatformIdWrapper& senderId, const ValidationChecksumMessage& message) {
+                        PlayerSpot senderSpot = PlayerSpot::Player1;
+                        if (TryGetSenderSpot(senderId, senderSpot)) {
+                            rollbackManager.OnReceivedValidationChecksum(senderSpot, message.targetFrame, message.checksum);
+                        }
+                    }
+                );
+                networkManager.RegisterP2PMessageHandler<DesyncLocalizationRequestMessage>(
+                    [this](const CrossPlatformIdWrapper& senderId, const DesyncLocalizationRequestMessage& message) {
+                        PlayerSpot senderSpot = PlayerSpot::Player1;
+                        if (TryGetSenderSpot(senderId, senderSpot)) {
+                            rollbackManager.OnReceivedDesyncLocalizationRequest(senderSpot, message);
+                        }
+                    }
+                );
+                networkManager.RegisterP2PMessageHandler<DesyncLocalizationResponseMessage>(
+                    [this](const CrossPlatformIdWrapper& senderId, const DesyncLocalizationResponseMessage& message) {
+                        PlayerSpot senderSpot = PlayerSpot::Player1;
+                        if (TryGetSenderSpot(senderId, senderSpot)) {
+                            rollbackManager.OnReceivedDesyncLocalizationResponse(senderSpot, message);
+                        }
+                    }
+                );
+            }
+
+            bool TryGetSenderSpot(const CrossPlatformIdWrapper& senderId, PlayerSpot& result) const {
+                const NetPlayerSpotMapping& mapping = networkManager.GetPlayersInfo().netLobbyInfo.playerSpotMapping;
+                return mapping.TryGetPlayerSpotForId(logger, senderId, result);
+            }
+
+            LoggerSingleton& logger = Singleton<LoggerSingleton>::get();
+        };
+
+        void StartPeer(Peer& peer) {
+            RollbackSettings rollbackSettings = mSettings.rollbackSettings;
+            rollbackSettings.totalPlayers = static_cast<uint8_t>(GetNumPeers());
+            rollbackSettings.localPlayerSpot = static_cast<PlayerSpot>(peer.peerIndex);
+            rollbackSettings.hostPlayerSpot = PlayerSpot::Player1;
+
+            peer.rollbackManager.StartRollbackSession(rollbackSettings);
+            peer.isStarted = true;
+        }
+
+        void UpdateFrameDifferencesToHost() {
+            const Peer& host = *mPeers[0];
+            if (!host.isStarted) {
+                return;
+            }
+
+            const int64_t hostFrame = host.user.GetLastProcessedFrame();
+            for (std::unique_ptr<Peer>& peer : mPeers) {
+                if (!peer->isStarted) {
+                    continue;
+                }
+
+                const int64_t framesAheadOfHost = static_cast<int64_t>(peer->user.GetLastProcessedFrame()) - hostFrame;
+                peer->report.finalFramesAheadOfHost = framesAheadOfHost;
+                peer->report.maxFramesApartFromHost = std::max(peer->report.maxFramesApartFromHost,
+                                                               static_cast<uint64_t>(std::abs(framesAheadOfHost)));
+            }
+        }
+
+        HeadlessMatchSettings mSettings;
+        uint64_t mCurTimeInMicroSec = 0;
+        LoopbackP2PNetwork mNetwork;
+        std::vector<CrossPlatformIdWrapper> mPeerIds = {}; // Index == peer index
+        // Heap allocated as peers reference each other's members (and this match), so they must never move
+        std::vector<std::unique_ptr<Peer>> mPeers = {};
+    };
+}
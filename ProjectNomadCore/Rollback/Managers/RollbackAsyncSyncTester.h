@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Input/PlayerInputsForFrame.h"
+#include "Rollback/RollbackUser.h"
+#include "Rollback/Model/RollbackSettings.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Result of a single async sync test, as retrieved on the game thread
+    **/
+    struct AsyncSyncTestResult {
+        FrameType testedFrame = 0;
+        uint32_t originalChecksum = 0;
+        uint32_t resimulatedChecksum = 0;
+
+        bool DidPass() const {
+            return originalChecksum == resimulatedChecksum;
+        }
+    };
+
+    /**
+    * Runs sync test re-simulation on a background worker thread rather than inline on the game thread.
+    *
+    * Each test clones the snapshot to restore, the inputs for each frame to re-process, and the originally stored
+    * snapshot to compare against. The worker then restores + re-processes those frames on a separate RollbackUser
+    * (which must own entirely separate gameplay state from the "real" user) and compares checksums.
+    *
+    * Only a single test is in flight at a time. If the worker is still busy when the next test would start, then that
+    * test is simply skipped. Thus sync test coverage degrades gracefully rather than slowing down the game thread.
+    *
+    * Threading expectations:
+    * - All public methods are expected to be called from the game thread
+    * - The sync test user is only ever called from the worker thread while a test is in flight
+    * - Logging is left to the caller (on the game thread), as LoggerSingleton is not expected to be thread safe
+    **/
+    template <typename SnapshotType>
+    class RollbackAsyncSyncTester {
+      public:
+        RollbackAsyncSyncTester() = default;
+        ~RollbackAsyncSyncTester() {
+            StopWorker();
+        }
+        RollbackAsyncSyncTester(const RollbackAsyncSyncTester&) = delete;
+        RollbackAsyncSyncTester& operator=(const RollbackAsyncSyncTester&) = delete;
+
+        void SetSyncTestUser(RollbackUser<SnapshotType>* syncTestUser) {
+            WaitUntilNotRunning(); // Never swap user out from under an in-flight test
+            mSyncTestUser = syncTestUser;
+        }
+        bool HasSyncTestUser() const {
+            return mSyncTestUser != nullptr;
+        }
+
+        /**
+        * Throws out any in-flight or finished test, such as on session start where old results are meaningless
+        **/
+        void Reset() {
+            WaitUntilNotRunning();
+            mState.store(State::Idle);
+        }
+
+        /**
+        * Checks if a new test can be started, ie if worker is not still busy with the previous test.
+        * Note that any finished result should be retrieved via TryTakeResult first.
+        **/
+        bool IsReadyForNewTest() const {
+            return mState.load() == State::Idle;
+        }
+
+        /**
+        * Retrieves job to fill in for the next test. Only valid to call and fill in if IsReadyForNewTest is true.
+        * This is exposed (rather than taking a job as input) so that large snapshots are copied directly into
+        * reused storage instead of through temporaries.
+        **/
+        SnapshotType& GetSnapshotToRestoreForNewTest() {
+            return mJob.snapshotToRestore;
+        }
+        SnapshotType& GetSnapshotToCompareForNewTest() {
+            return mJob.snapshotToCompare;
+        }
+        PlayerInputsForFrame& GetInputsForNewTest(FrameType frameOffset) {
+            return mJob.inputsPerFrame[frameOffset];
+        }
+
+        /**
+        * Hands job to worker thread. Expects all job data to already be filled in.
+        * @param firstFrameToReprocess - frame that snapshot to restore represents (ie, start of this frame)
+        * @param numOfFramesToProcess - number of frames to re-process, which is also how many inputs were filled in
+        * @returns true if test started, false if not ready for a new test or input was invalid
+        **/
+        bool StartTest(FrameType firstFrameToReprocess, FrameType numOfFramesToProcess) {
+            if (!mSyncTestUser || !IsReadyForNewTest() || numOfFramesToProcess > RollbackStaticSettings::kMaxRollbackFrames) {
+                return false;
+            }
+
+            mJob.firstFrameToReprocess = firstFrameToReprocess;
+            mJob.numOfFramesToProcess = numOfFramesToProcess;
+            StartWorkerIfNeeded();
+
+            {
+                std::lock_guard lock(mMutex);
+                mState.store(State::Running);
+            }
+            mWakeCondition.notify_one();
+            return true;
+        }
+
+        /**
+        * Retrieves result of the last started test, if finished
+        * @param result - result of finished test. Only valid if returned true
+        * @returns true if a finished result was retrieved, false otherwise
+        **/
+        bool TryTakeResult(AsyncSyncTestResult& result) {
+            if (mState.load() != State::Finished) {
+                return false;
+            }
+
+            result = mResult;
+            mState.store(State::Idle);
+            return true;
+        }
+
+        // Blocks until any in-flight test is finished. Mostly useful for deterministic unit tests and session end
+        void WaitUntilNotRunning() {
+            std::unique_lock lock(mMutex);
+            mDoneCondition.wait(lock, [this] { return mState.load() != State::Running; });
+        }
+
+      private:
+        enum class State : uint8_t {
+            Idle,
+            Running,
+            Finished
+        };
+
+        struct Job {
+            FrameType firstFrameToReprocess = 0;
+            FrameType numOfFramesToProcess = 0;
+            SnapshotType snapshotToRestore = {};
+            SnapshotType snapshotToCompare = {};
+            std::array<PlayerInputsForFrame, RollbackStaticSettings::kMaxRollbackFrames> inputsPerFrame = {};
+        };
+
+        void StartWorkerIfNeeded() {
+            if (mWorkerThread.joinable()) {
+                return;
+            }
+
+            mShouldStop = false;
+            mWorkerThread = std::thread(&RollbackAsyncSyncTester::WorkerLoop, this);
+        }
+        void StopWorker() {
+            if (!mWorkerThread.joinable()) {
+                return;
+            }
+
+            {
+                std::lock_guard lock(mMutex);
+                mShouldStop = true;
+            }
+            mWakeCondition.notify_one();
+            mWorkerThread.join();
+        }
+
+        void WorkerLoop() {
+            while (true) {
+                {
+                    std::unique_lock lock(mMutex);
+                    mWakeCondition.wait(lock, [this] { return mShouldStop || mState.load() == State::Running; });
+                    if (mShouldStop) {
+                        return;
+                    }
+                }
+
+                RunJob();
+
+                {
+                    std::lock_guard lock(mMutex);
+                    mState.store(State::Finished);
+                }
+                mDoneCondition.notify_all();
+            }
+        }
+
+        void RunJob() {
+            // Same process as a normal rollback: Restore snapshot for start of first frame then re-process each frame.
+            //      Snapshot for start of the last frame is what's compared, as that's the latest stored snapshot.
+            mSyncTestUser->RestoreSnapshot(mJob.firstFrameToReprocess, mJob.snapshotToRestore);
+            for (FrameType i = 0; i < mJob.numOfFramesToProcess; i++) {
+                mSyncTestUser->ProcessFrameWithoutRendering(mJob.firstFrameToReprocess + i, mJob.inputsPerFrame[i]);
+            }
+
+            const FrameType testedFrame = mJob.firstFrameToReprocess + mJob.numOfFramesToProcess;
+            SnapshotType resimulatedSnapshot = {};
+            mSyncTestUser->GenerateSnapshot(testedFrame, resimulatedSnapshot);
+
+            mResult.testedFrame = testedFrame;
+            mResult.originalChecksum = mJob.snapshotToCompare.GetChecksum();
+            mResult.resimulatedChecksum = resimulatedSnapshot.GetChecksum();
+        }
+
+        RollbackUser<SnapshotType>* mSyncTestUser = nullptr;
+
+        // Job + result are only touched by worker while Running, and only by game thread otherwise
+        Job mJob = {};
+        AsyncSyncTestResult mResult = {};
+
+        std::atomic<State> mState = State::Idle;
+        bool mShouldStop = false;
+        std::mutex mMutex;
+        std::condition_variable mWakeCondition;
+        std::condition_variable mDoneCondition;
+        std::thread mWorkerThread;
+    };
+}
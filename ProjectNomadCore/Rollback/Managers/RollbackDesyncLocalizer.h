@@ -0,0 +1,244 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <string>
+
+#include "Network/P2PMessages/NetMessagesDesyncLocalization.h"
+#include "Rollback/Model/DesyncLocalization.h"
+#include "Utilities/FrameType.h"
+#include "Utilities/LoggerSingleton.h"
+
+namespace ProjectNomad {
+    /**
+    * Narrows a detected desync down to the diverging type + entity, by walking the host's desync checksum tree (see
+    * DesyncChecksumQuery) one node at a time. Each round trip only sends a single node's child checksums, so a full
+    * localization costs a few hundred bytes rather than a full state dump.
+    *
+    * Both sides of the exchange live here, as any peer may be either side:
+    *   - Host answers requests using the snapshot it retained for the requested frame
+    *   - Peer which detected a desync compares each answer against its own retained snapshot, then requests the
+    *     first child whose checksum differs until reaching a single entity
+    *
+    * Snapshots of checksummed frames are retained here as RollbackSnapshotManager only keeps snapshots within the
+    * rollback window, which is far shorter than a few round trips. A few are kept, so host can still answer for older
+    * checksum frames while newer ones are already being sent.
+    * @tparam SnapshotType - game's snapshot type. Localization only does anything if it SupportsDesyncLocalization
+    **/
+    template <typename SnapshotType>
+    class RollbackDesyncLocalizer {
+      public:
+        static constexpr bool kIsSupported = SupportsDesyncLocalization<SnapshotType>;
+        // Checksums are sent every RollbackStaticSettings::kDesyncDetectionFrequency frames, so this covers a few seconds
+        static constexpr size_t kRetainedSnapshots = 3;
+
+        void Reset() {
+            for (RetainedSnapshot& retained : mRetainedSnapshots) {
+                retained.frame = kNoFrame;
+            }
+            mIsInProgress = false;
+            mHasResult = false;
+            mInProgressResult = {};
+            mResult = {};
+        }
+
+        /**
+        * Keeps copy of snapshot for a frame whose checksum was sent to (or compared against) peers. Replaces oldest
+        * retained snapshot, unless that one is being localized
+        * @param frame - frame that snapshot represents
+        * @param snapshot - snapshot to copy
+        **/
+        void RetainSnapshot(FrameType frame, const SnapshotType& snapshot) {
+            RetainedSnapshot* oldest = nullptr;
+            for (RetainedSnapshot& retained : mRetainedSnapshots) {
+                if (mIsInProgress && retained.frame == mInProgressResult.targetFrame) {
+                    continue;
+                }
+                if (oldest == nullptr || retained.frame == kNoFrame || (oldest->frame != kNoFrame && retained.frame < oldest->frame)) {
+                    oldest = &retained;
+                }
+            }
+
+            oldest->frame = frame;
+            oldest->snapshot = snapshot; // Copy-assign so retained snapshot's existing capacity is reused
+        }
+
+        bool IsInProgress() const {
+            return mIsInProgress;
+        }
+        // Result of latest finished localization, if any. Kept while any newer localization is still in progress
+        bool HasResult() const {
+            return mHasResult;
+        }
+        const DesyncLocalizationResult& GetResult() const {
+            return mResult;
+        }
+
+        /**
+        * Starts localizing desync for given frame, which must have been retained
+        * @param logger - logger for any issues
+        * @param targetFrame - frame whose checksums differed
+        * @param result - first request to send to host. Only valid if returned true
+        * @returns true if localization started, false otherwise (eg, already in progress or frame not retained)
+        **/
+        bool TryStart(LoggerSingleton& logger, FrameType targetFrame, DesyncLocalizationRequestMessage& result) {
+            if (mIsInProgress) {
+                logger.LogWarnMessage("Already localizing desync for frame " + std::to_string(mInProgressResult.targetFrame));
+                return false;
+            }
+            if (FindRetainedSnapshot(targetFrame) == nullptr) {
+                logger.LogWarnMessage("No retained snapshot for desynced frame " + std::to_string(targetFrame));
+                return false;
+            }
+
+            mIsInProgress = true;
+            mInProgressResult = {};
+            mInProgressResult.targetFrame = targetFrame;
+            mCurrentQuery = DesyncChecksumQuery::ForAllTypes();
+            result = DesyncLocalizationRequestMessage(targetFrame, mCurrentQuery);
+            return true;
+        }
+
+        /**
+        * Answers a peer's request with child checksums of the requested node
+        * @param request - request received from peer
+        * @param result - response to send back. Always filled in, but only has checksums if returned true
+        * @returns true if checksums were calculated, false if frame is no longer retained or request was invalid
+        **/
+        bool TryAnswerRequest(const DesyncLocalizationRequestMessage& request, DesyncLocalizationResponseMessage& result) const {
+            result = DesyncLocalizationResponseMessage(request);
+
+            DesyncChecksumList checksums;
+            if (!TryCalculateChecksums(request.targetFrame, request.GetQuery(), checksums)) {
+                return false;
+            }
+
+            result.didCalculateChecksums = true;
+            result.numChecksums = static_cast<uint8_t>(checksums.GetSize());
+            for (uint32_t i = 0; i < checksums.GetSize(); i++) {
+                result.checksums[i] = checksums.Get(i);
+            }
+            return true;
+        }
+
+        /**
+        * Compares host's answer against local checksums, to decide which node to request next
+        * @param logger - logger for any issues
+        * @param response - response received from host
+        * @param result - next request to send to host. Only valid if returned true
+        * @returns true if another request should be sent, false if localization is done (see GetResult) or response
+        *          was unexpected
+        **/
+        bool HandleResponse(LoggerSingleton& logger,
+                            const DesyncLocalizationResponseMessage& response,
+                            DesyncLocalizationRequestMessage& result) {
+            if (!mIsInProgress || response.targetFrame != mInProgressResult.targetFrame || response.GetQuery() != mCurrentQuery) {
+                logger.LogWarnMessage("Ignoring unexpected desync localization response for frame " + std::to_string(response.targetFrame));
+                return false;
+            }
+            mInProgressResult.roundTrips++;
+
+            DesyncChecksumList localChecksums;
+            if (!response.didCalculateChecksums || !TryCalculateChecksums(mInProgressResult.targetFrame, mCurrentQuery, localChecksums)) {
+                logger.LogWarnMessage("Desync localization failed, as checksums couldn't be calculated on both sides");
+                Finish();
+                return false;
+            }
+            if (localChecksums.GetSize() != response.numChecksums) {
+                logger.LogWarnMessage("Desync localization failed, as host has different number of checksummed types");
+                Finish();
+                return false;
+            }
+
+            for (uint32_t i = 0; i < localChecksums.GetSize(); i++) {
+                if (localChecksums.Get(i) == response.checksums[i]) {
+                    continue;
+                }
+
+                // Only need to follow first difference, as that's enough to explain the desync
+                if (mCurrentQuery.IsForSingleEntities()) {
+                    mInProgressResult.didFindDivergence = true;
+                    mInProgressResult.typeIndex = mCurrentQuery.typeIndex;
+                    mInProgressResult.entityIndex = mCurrentQuery.rangeStart + i;
+                    Finish();
+                    return false;
+                }
+
+                mCurrentQuery = mCurrentQuery.GetChildQuery(i);
+                result = DesyncLocalizationRequestMessage(mInProgressResult.targetFrame, mCurrentQuery);
+                return true;
+            }
+
+            // Everything in tree matches, so desync must be in state that isn't part of the tree
+            Finish();
+            return false;
+        }
+
+        /**
+        * Readable description of result, such as for logging
+        * @param result - result to describe
+        * @returns description of result
+        **/
+        static std::string ResultToString(const DesyncLocalizationResult& result) {
+            if (!result.didFindDivergence) {
+                return "Desync at frame " + std::to_string(result.targetFrame) + " not found within checksummed state";
+            }
+
+            std::string typeName = "type " + std::to_string(result.typeIndex);
+            if constexpr (kHasTypeNames) {
+                typeName = SnapshotType::GetDesyncChecksumTypeName(result.typeIndex);
+            }
+            return "Desync at frame " + std::to_string(result.targetFrame) + " localized to " + typeName +
+                   " of entity index " + std::to_string(result.entityIndex) + " after " +
+                   std::to_string(result.roundTrips) + " round trips";
+        }
+
+      private:
+        static constexpr FrameType kNoFrame = std::numeric_limits<FrameType>::max();
+        static constexpr bool kHasTypeNames = requires(uint8_t typeIndex) {
+            { SnapshotType::GetDesyncChecksumTypeName(typeIndex) } -> std::convertible_to<std::string>;
+        };
+
+        struct RetainedSnapshot {
+            FrameType frame = kNoFrame;
+            SnapshotType snapshot = {};
+        };
+
+        const RetainedSnapshot* FindRetainedSnapshot(FrameType frame) const {
+            for (const RetainedSnapshot& retained : mRetainedSnapshots) {
+                if (retained.frame == frame) {
+                    return &retained;
+                }
+            }
+            return nullptr;
+        }
+
+        bool TryCalculateChecksums(FrameType frame, const DesyncChecksumQuery& query, DesyncChecksumList& result) const {
+            const RetainedSnapshot* retained = FindRetainedSnapshot(frame);
+            if (retained == nullptr) {
+                return false;
+            }
+
+            if constexpr (kIsSupported) {
+                return retained->snapshot.CalculateDesyncChecksums(query, result);
+            }
+            else {
+                return false;
+            }
+        }
+
+        void Finish() {
+            mIsInProgress = false;
+            mHasResult = true;
+            mResult = mInProgressResult;
+            mCurrentQuery = {};
+        }
+
+        std::array<RetainedSnapshot, kRetainedSnapshots> mRetainedSnapshots = {};
+        bool mIsInProgress = false;
+        bool mHasResult = false;
+        DesyncChecksumQuery mCurrentQuery = {};
+        DesyncLocalizationResult mInProgressResult = {};
+        DesyncLocalizationResult mResult = {};
+    };
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "Context/FrameRate.h"
+#include "GameCore/PlayerSpot.h"
+#include "Rollback/Model/InputDelayTuningSettings.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Decides local input delay for a multiplayer session based on measured latency and how deep rollbacks are.
+    *
+    * Policy, evaluated once per evaluation window:
+    *   - Add a frame of delay if deep rollbacks kept happening, but only while delay is still less than the one-way
+    *     latency to the furthest remote player. Beyond that, inputs already arrive in time and more delay is pure lag.
+    *   - Remove a frame of delay if no rollback came within a frame of being deep, as one less frame of delay would
+    *     only make rollbacks about one frame deeper. Also remove delay which exceeds latency, for the same reason as above.
+    *
+    * Note that this only decides on the delay. RollbackManager applies it one frame at a time at frame boundaries.
+    **/
+    class RollbackInputDelayTuner {
+      public:
+        /**
+        * Resets all tracking for a new session
+        * @param settings - tuning settings. If not enabled, target delay always stays at initial delay
+        * @param initialInputDelay - delay to start session with
+        **/
+        void OnSessionStart(const InputDelayTuningSettings& settings, FrameType initialInputDelay) {
+            *this = {};
+            mSettings = settings;
+            mTargetInputDelay = initialInputDelay;
+        }
+
+        /**
+        * Provides latest estimated one-way delay to a remote player, such as from PeerLatencyStats
+        * @param remotePlayerSpot - remote player's spot
+        * @param oneWayDelayInMicroSec - estimated time for a message to reach the remote player. 0 if unknown
+        **/
+        void RecordRemoteLatency(PlayerSpot remotePlayerSpot, uint64_t oneWayDelayInMicroSec) {
+            const auto index = static_cast<size_t>(remotePlayerSpot);
+            if (index < mOneWayDelaysInMicroSec.size()) {
+                mOneWayDelaysInMicroSec[index] = oneWayDelayInMicroSec;
+            }
+        }
+
+        // Expected to be called for every rollback caused by mispredicted remote inputs
+        void RecordRollback(FrameType framesReprocessed) {
+            mMaxRollbackDepthInWindow = std::max(mMaxRollbackDepthInWindow, framesReprocessed);
+            if (framesReprocessed >= mSettings.deepRollbackFrames) {
+                mDeepRollbacksInWindow++;
+            }
+        }
+
+        // Expected to be called once per newly processed frame (ie, not for re-processed frames)
+        void OnFrameProcessed() {
+            if (!mSettings.isEnabled) {
+                return;
+            }
+
+            mFramesInWindow++;
+            if (mFramesInWindow < mSettings.evaluationWindowFrames) {
+                return;
+            }
+
+            mTargetInputDelay = DecideNextInputDelay();
+            mFramesInWindow = 0;
+            mDeepRollbacksInWindow = 0;
+            mMaxRollbackDepthInWindow = 0;
+        }
+
+        FrameType GetTargetInputDelay() const {
+            return mTargetInputDelay;
+        }
+
+        // Frames of delay which would fully cover latency to furthest remote player. 0 if no latency known yet
+        FrameType GetLatencyInFrames() const {
+            const uint64_t maxOneWayDelay = *std::max_element(mOneWayDelaysInMicroSec.begin(), mOneWayDelaysInMicroSec.end());
+            return static_cast<FrameType>((maxOneWayDelay + kTimePerFrameInMicroSec - 1) / kTimePerFrameInMicroSec); // Rounded up
+        }
+
+      private:
+        FrameType DecideNextInputDelay() const {
+            const FrameType latencyInFrames = GetLatencyInFrames();
+            const bool isLatencyKnown = latencyInFrames > 0;
+
+            FrameType result = mTargetInputDelay;
+            if (mDeepRollbacksInWindow >= mSettings.deepRollbacksToIncreaseDelay) {
+                if (!isLatencyKnown || mTargetInputDelay < latencyInFrames) {
+                    result++;
+                }
+            }
+            else if (mMaxRollbackDepthInWindow + 1 < mSettings.deepRollbackFrames ||
+                     (isLatencyKnown && mTargetInputDelay > latencyInFrames)) {
+                if (result > 0) {
+                    result--;
+                }
+            }
+
+            return std::clamp(result, mSettings.minInputDelay, mSettings.maxInputDelay);
+        }
+
+        static constexpr uint64_t kTimePerFrameInMicroSec = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+
+        InputDelayTuningSettings mSettings = {};
+        FrameType mTargetInputDelay = 0;
+
+        std::array<uint64_t, PlayerSpotHelpers::kMaxPlayerSpots> mOneWayDelaysInMicroSec = {};
+        FrameType mFramesInWindow = 0;
+        uint32_t mDeepRollbacksInWindow = 0;
+        FrameType mMaxRollbackDepthInWindow = 0;
+    };
+}
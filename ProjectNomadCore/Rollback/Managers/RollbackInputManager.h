@@ -42,28 +42,33 @@ namespace ProjectNomad {
             return true;
         }
         
-        void SetInputForPlayer(LoggerSingleton& logger,
+        /**
+        * Stores the next "confirmed" input for the given player
+        * @returns true if a different predicted input was already used to process the target frame (ie, the frame
+        *          was mispredicted and needs to be rolled back to), false otherwise
+        **/
+        bool SetInputForPlayer(LoggerSingleton& logger,
                                FrameType targetFrame,
                                PlayerSpot playerSpot,
                                const CharacterInput& playerInput) {
             if (!mIsInitialized) {
                 logger.LogWarnMessage("Not initialized!");
-                return;
+                return false;
             }
 
             uint32_t index = PlayerSpotToIndex(logger, playerSpot);
-            mPerPlayerInputs[index].AddInput(logger, targetFrame, playerInput);
+            return mPerPlayerInputs[index].AddInput(logger, targetFrame, playerInput);
         }
 
         // Intended to be used for comparing if prior prediction incorrect.
         // However, almost certainly going to need to expand on this to properly cover different cases.
         // Eg, how does consumer know whether an input was a "predicted" or "confirmed" input with these APIs atm?
-        const CharacterInput& GetPlayerInputForFrame(LoggerSingleton& logger,
-                                                     FrameType targetFrame,
-                                                     PlayerSpot playerSpot) const {
+        CharacterInput GetPlayerInputForFrame(LoggerSingleton& logger,
+                                              FrameType targetFrame,
+                                              PlayerSpot playerSpot) const {
             if (!mIsInitialized) {
                 logger.LogWarnMessage("Not initialized!");
-                return temp;
+                return {};
             }
 
             uint32_t index = PlayerSpotToIndex(logger, playerSpot);
@@ -79,8 +84,23 @@ namespace ProjectNomad {
             
             PlayerInputsForFrame result = {};
             for (int i = 0; i < mTotalPlayersInSession; i++) {
-                const CharacterInput& playerInput = GetPlayerInputForFrame(logger, targetFrame, static_cast<PlayerSpot>(i));
-                result.Add(playerInput);
+                result.Add(GetPlayerInputForFrame(logger, targetFrame, static_cast<PlayerSpot>(i)));
+            }
+            
+            return result;
+        }
+
+        // Same as GetInputsForFrame, but remembers any predictions used so later confirmed inputs can be checked for
+        //      mispredictions. Expected to be used for actual frame processing.
+        PlayerInputsForFrame GetInputsForFrameToProcess(LoggerSingleton& logger, FrameType targetFrame) {
+            if (!mIsInitialized) {
+                logger.LogWarnMessage("Not initialized!");
+                return {};
+            }
+            
+            PlayerInputsForFrame result = {};
+            for (int i = 0; i < mTotalPlayersInSession; i++) {
+                result.Add(mPerPlayerInputs[i].GetInputForFrameToProcess(logger, targetFrame));
             }
             
             return result;
@@ -152,6 +172,15 @@ namespace ProjectNomad {
             return false; // Confirmed that all players have stored input for the target frame at some point
         }
 
+        // Prediction stats summed across all players in session
+        InputPredictionStats GetCombinedPredictionStats() const {
+            InputPredictionStats result = {};
+            for (int i = 0; i < mTotalPlayersInSession; i++) {
+                result.Add(mPerPlayerInputs[i].GetPredictionStats());
+            }
+            return result;
+        }
+
       private:
         uint32_t PlayerSpotToIndex(LoggerSingleton& logger, PlayerSpot playerSpot) const {
             auto result = static_cast<uint32_t>(playerSpot); // Enum starts at 0
@@ -168,8 +197,6 @@ namespace ProjectNomad {
             return result;
         } 
         
-        CharacterInput temp = {};
-
         bool mIsInitialized = false;
         uint8_t mTotalPlayersInSession = 1; // Should always be greater than 0 in an actual game
         // Actually store input on a per-player basis.
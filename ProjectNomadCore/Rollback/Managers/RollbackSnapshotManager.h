@@ -4,12 +4,33 @@
 #include "Utilities/FrameType.h"
 #include "Utilities/LoggerSingleton.h"
 #include "Utilities/Singleton.h"
+#include "Utilities/Containers/DeltaRingBuffer.h"
 #include "Utilities/Containers/RingBuffer.h"
 
 namespace ProjectNomad {
     // Note that SnapshotType should NOT have any pointers as snapshot restoration will be ineffective.
     // This includes std::array and callbacks.
 
+    // SnapshotType can opt into delta-compressed storage by defining the following:
+    //      static constexpr bool kUseDeltaSnapshotStorage = true;
+    // This stores only the latest snapshot in full and older snapshots as XOR deltas (see DeltaRingBuffer), which is
+    //      useful for large snapshots that barely change between frames. Retrieving older snapshots becomes more
+    //      expensive, and references to them are only valid until the next GetSnapshot call.
+    template <typename SnapshotType>
+    constexpr bool UsesDeltaSnapshotStorage = requires {
+        requires SnapshotType::kUseDeltaSnapshotStorage;
+    };
+
+    // SnapshotType can opt into in-place snapshot generation by defining the following:
+    //      static constexpr bool kGenerateSnapshotInPlace = true;
+    // RollbackUser::GenerateSnapshot is then handed the recycled buffer slot directly (still holding an older
+    //      snapshot) instead of a fresh default snapshot. Thus heap-owning snapshots can reuse existing capacity and
+    //      avoid allocating every frame, as long as GenerateSnapshot fully overwrites all prior contents.
+    template <typename SnapshotType>
+    constexpr bool GeneratesSnapshotInPlace = requires {
+        requires SnapshotType::kGenerateSnapshotInPlace;
+    };
+
     /// <summary>
     /// Encapsulates snapshot data and related behavior specific to rollbacks.
     /// ie this does not define what a snapshot is nor when to take one, but rather is responsible for:
@@ -19,8 +40,17 @@ namespace ProjectNomad {
     template <typename SnapshotType>
     class RollbackSnapshotManager {
       public:
-        bool OnSessionStart() {
+        /**
+        * Resets storage for a new session
+        * @param snapshotInterval - expected distance between stored frames (see RollbackSettings::snapshotInterval).
+        *                           If greater than 1, then new snapshots may skip frames rather than needing to be
+        *                           stored for every single frame.
+        * @returns true if setup succeeded
+        **/
+        bool OnSessionStart(FrameType snapshotInterval = 1) {
             mLatestStoredFrame = std::numeric_limits<FrameType>::max(); // Next frame to store is 0 (max + 1 = 0 with overflow)
+            mStoredCount = 0;
+            mAllowFrameGaps = snapshotInterval > 1;
 
             // No need to reset RingBuffer as we just expect existing data in the buffer to be "noise"
 
@@ -34,21 +64,46 @@ namespace ProjectNomad {
         /// Assume that this value will be unusable after the call (due to swap-insert).
         /// </param>
         void StoreSnapshot(FrameType targetFrame, SnapshotType& snapshot) {
-            // Trying to add snapshot for next expected frame?
-            if (targetFrame == mLatestStoredFrame + 1) {
-                mSnapshotBuffer.SwapInsert(snapshot); 
-                mLatestStoredFrame = targetFrame;
+            bool isNewFrame = false;
+            int offset = 0;
+            if (!TryFindStorageSpot(targetFrame, isNewFrame, offset)) {
+                return;
             }
-            // Trying to replace a previously stored frame?
-            else if (targetFrame <= mLatestStoredFrame && mLatestStoredFrame != std::numeric_limits<FrameType>::max()) {
-                int offset = CalculateOffset(targetFrame);
+            
+            if (isNewFrame) {
+                mSnapshotBuffer.SwapInsert(snapshot);
+                OnNewFrameStored(targetFrame);
+            }
+            else {
                 mSnapshotBuffer.SwapReplace(offset, snapshot);
             }
-            else { // Invalid input!
-                Singleton<LoggerSingleton>::get().LogErrorMessage(
-                    "Unexpected currentFrame value! Latest stored frame: " + std::to_string(mLatestStoredFrame)
-                        + ", input frame: " + std::to_string(targetFrame)
-                );
+        }
+
+        /**
+        * Alternative to StoreSnapshot which lets the snapshot be generated directly into its storage slot, rather than
+        * generating into a separate snapshot and swapping it in. See GeneratesSnapshotInPlace.
+        * @param targetFrame - Frame that snapshot is intended for
+        * @param generateInto - callable taking SnapshotType&, which is expected to fully overwrite the slot's contents.
+        *                       Note that slot will contain an older (or replaced) snapshot's data beforehand.
+        **/
+        template <typename Generator>
+        void StoreSnapshotInPlace(FrameType targetFrame, Generator&& generateInto) {
+            static_assert(!UsesDeltaSnapshotStorage<SnapshotType>, "Delta snapshot storage has no slots to generate into");
+            
+            bool isNewFrame = false;
+            int offset = 0;
+            if (!TryFindStorageSpot(targetFrame, isNewFrame, offset)) {
+                return;
+            }
+
+            // Slot for a new frame is the oldest value, which is exactly where a swap-insert would have gone
+            SnapshotType& slot = isNewFrame ? mSnapshotBuffer.Get(1) : mSnapshotBuffer.Get(offset);
+            slot.ClearCachedChecksum(); // Contents are about to change
+            generateInto(slot);
+
+            if (isNewFrame) {
+                mSnapshotBuffer.IncrementHead();
+                OnNewFrameStored(targetFrame);
             }
         }
 
@@ -61,10 +116,52 @@ namespace ProjectNomad {
                 return mSnapshotBuffer.Get(0);
             }
 
-            int offset = CalculateOffset(frameToRetrieveSnapshotFor);
+            int offset = 0;
+            if (!TryFindOffset(frameToRetrieveSnapshotFor, offset)) {
+                Singleton<LoggerSingleton>::get().LogErrorMessage(
+                    "No snapshot stored for provided frame (outside buffer or skipped), input frame: " +
+                    std::to_string(frameToRetrieveSnapshotFor)
+                );
+                return mSnapshotBuffer.Get(0);
+            }
+            
             return mSnapshotBuffer.Get(offset);
         }
 
+        /**
+        * Finds the latest frame which has a stored snapshot, no later than the given frame. Intended for restoring
+        * from the nearest "keyframe" when not every frame has a stored snapshot.
+        * @param targetFrame - frame that want to restore to
+        * @returns latest stored frame that is <= targetFrame, or max FrameType value if no such frame is stored
+        **/
+        FrameType GetNearestStoredFrameAtOrBefore(FrameType targetFrame) const {
+            for (uint32_t age = 0; age < mStoredCount; age++) {
+                const FrameType storedFrame = mStoredFrames.Get(-static_cast<int>(age));
+                if (storedFrame <= targetFrame) {
+                    return storedFrame;
+                }
+            }
+            
+            return std::numeric_limits<FrameType>::max();
+        }
+
+        /**
+        * Counts stored snapshots for frames no older than the given frame. Useful for stats, such as seeing how many
+        * snapshots actually back the current rollback window.
+        **/
+        uint32_t GetStoredSnapshotCountSince(FrameType oldestFrame) const {
+            uint32_t result = 0;
+            for (uint32_t age = 0; age < mStoredCount; age++) {
+                if (mStoredFrames.Get(-static_cast<int>(age)) < oldestFrame) {
+                    break;
+                }
+                result++;
+            }
+            return result;
+        }
+
+        // Note that this is the latest *stored* snapshot, which may be older than latest processed frame if not
+        //      storing a snapshot every frame.
         const SnapshotType& GetLatestFrameSnapshot() const {
             // Sanity check
             if (mLatestStoredFrame == std::numeric_limits<FrameType>::max()) {
@@ -77,27 +174,78 @@ namespace ProjectNomad {
         }
 
       private:
-        bool IsInsertingInitialFrame(FrameType frameToInsert) {
-            return mLatestStoredFrame == std::numeric_limits<FrameType>::max() && frameToInsert +  1;
-        }
-        
-        int CalculateOffset(FrameType frameForStoredSnapshot) const {
-            FrameType frameOffset = mLatestStoredFrame - frameForStoredSnapshot;
+        /**
+        * Determines where snapshot for given frame should be stored
+        * @param targetFrame - Frame that snapshot is intended for
+        * @param isNewFrame - true if snapshot should be inserted as latest frame, false if replacing existing frame
+        * @param offset - if replacing, then offset of existing frame
+        * @returns true if valid frame to store, false otherwise (and logs error)
+        **/
+        bool TryFindStorageSpot(FrameType targetFrame, bool& isNewFrame, int& offset) const {
+            const bool hasStoredAnyFrame = mLatestStoredFrame != std::numeric_limits<FrameType>::max();
+            
+            // Trying to add snapshot for next expected frame?
+            //      Note that initial frame must always be stored, as otherwise would have nothing to rollback to
+            if (targetFrame == mLatestStoredFrame + 1
+                || (mAllowFrameGaps && hasStoredAnyFrame && targetFrame > mLatestStoredFrame)) {
+                isNewFrame = true;
+                return true;
+            }
 
-            // Sanity check to help catch bugs
-            if (frameOffset > RollbackStaticSettings::kOneMoreThanMaxRollbackFrames) {
-                Singleton<LoggerSingleton>::get().LogErrorMessage(
-                    "Provided retrieval frame beyond buffer size (rollback window + 1 older frames), input frame: " +
-                    std::to_string(frameForStoredSnapshot)
-                );
-                return 0;
+            // Trying to replace a previously stored frame?
+            if (hasStoredAnyFrame && targetFrame <= mLatestStoredFrame && TryFindOffset(targetFrame, offset)) {
+                isNewFrame = false;
+                return true;
             }
+            
+            // Invalid input!
+            Singleton<LoggerSingleton>::get().LogErrorMessage(
+                "Unexpected currentFrame value! Latest stored frame: " + std::to_string(mLatestStoredFrame)
+                    + ", input frame: " + std::to_string(targetFrame)
+            );
+            return false;
+        }
 
-            // Negative values represent the past in RingBuffer so flip the sign
-            return static_cast<int>(frameOffset) * -1;
+        void OnNewFrameStored(FrameType targetFrame) {
+            mStoredFrames.Add(targetFrame);
+            mLatestStoredFrame = targetFrame;
+            if (mStoredCount < kBufferSize) {
+                mStoredCount++;
+            }
         }
         
+        bool TryFindOffset(FrameType frameForStoredSnapshot, int& result) const {
+            // Stored frames are always in increasing order, so simply check from newest to oldest.
+            //      (Buffer is small enough that this is trivial compared to any snapshot work)
+            for (uint32_t age = 0; age < mStoredCount; age++) {
+                const FrameType storedFrame = mStoredFrames.Get(-static_cast<int>(age));
+                if (storedFrame == frameForStoredSnapshot) {
+                    // Negative values represent the past in RingBuffer so flip the sign
+                    result = static_cast<int>(age) * -1;
+                    return true;
+                }
+                if (storedFrame < frameForStoredSnapshot) {
+                    return false;
+                }
+            }
+            
+            return false;
+        }
+        
+        // Store current frame, 10 frames in past, and 1 extra frame for verified frame processing.
+        //      If not storing every frame, then this still covers the nearest older snapshot to rollback to (see
+        //      RollbackStaticSettings::kMaxSnapshotInterval).
+        static constexpr FrameType kBufferSize = RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames;
+        using SnapshotBufferType = std::conditional_t<
+            UsesDeltaSnapshotStorage<SnapshotType>,
+            DeltaRingBuffer<SnapshotType, kBufferSize>,
+            RingBuffer<SnapshotType, kBufferSize>
+        >;
+        
         FrameType mLatestStoredFrame = std::numeric_limits<FrameType>::max(); // Next frame to store is 0 (max + 1 = 0 with overflow)
-        RingBuffer<SnapshotType, RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames> mSnapshotBuffer = {}; // Store current frame, 10 frames in past, and 1 extra frame for verified frame processing
+        SnapshotBufferType mSnapshotBuffer = {};
+        RingBuffer<FrameType, kBufferSize> mStoredFrames = {}; // Frame for each snapshot in buffer, at same offset
+        uint32_t mStoredCount = 0;
+        bool mAllowFrameGaps = false;
     };
 }
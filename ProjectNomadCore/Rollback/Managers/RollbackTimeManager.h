@@ -8,6 +8,11 @@
 namespace ProjectNomad {
     /**
     * Encapsulates responsibility for appropriate timing of gameplay.
+    *
+    * When falling behind real time (eg, slow machine or a long rollback), the owed frames are caught up within a
+    * wall-clock budget per tick based on the measured cost of simulating a frame. Any frames that don't fit in the
+    * budget are carried over as "debt" to subsequent ticks rather than thrown away, as dropping time would otherwise
+    * cause permanent drift from the host.
     **/
     class RollbackTimeManager {
       public:
@@ -29,6 +34,7 @@ namespace ProjectNomad {
             mIsPaused = true;
             mShouldNextUpdateHandleUnpausing = false; // Just in case, as this is our expectation anyways
             mPauseTimeInMicroSec = mTimeRetriever();
+            mFrameDebt = 0; // Unpausing only ever processes a single frame, so nothing owed from before pause matters
         }
         void Resume() {
             mIsPaused = false;
@@ -99,9 +105,11 @@ namespace ProjectNomad {
 
         /**
         * Calculates how many gameplay frames need to be handled in order to maintain desired fps simulation
+        * @param timeAlreadySpentThisTickInMicroSec - time already used from this tick's catch-up budget, such as by
+        *                                             re-simulating frames during a rollback
         * @returns number of gameplay frames that need to be processed to maintain desired fps simulation
         **/
-        FrameType CheckHowManyFramesToProcess() {
+        FrameType CheckHowManyFramesToProcess(uint64_t timeAlreadySpentThisTickInMicroSec = 0) {
             if (IsPaused()) {
                 return 0;
             }
@@ -136,43 +144,102 @@ namespace ProjectNomad {
             }
             
             // Standard time handling case
-            return GetFramesToProcessBasedOnStandardTimePassing(currentTimeInMicroSec);
+            return GetFramesToProcessBasedOnStandardTimePassing(currentTimeInMicroSec, timeAlreadySpentThisTickInMicroSec);
         }
 
-        // Expose this setting for easy unit testing. Perhaps would be cleaner to refactor out to a helper class or such?
+        /**
+        * Provides measured cost of simulating frames, which decides how many owed frames fit in each tick's budget.
+        * Expected to be called once per tick with all frames simulated that tick, including rollback re-simulation.
+        * @param timeSpentInMicroSec - total wall-clock time spent simulating the frames
+        * @param numOfFramesSimulated - number of frames simulated in that time. Ignored if 0
+        **/
+        void ReportFrameSimulationCost(uint64_t timeSpentInMicroSec, FrameType numOfFramesSimulated) {
+            if (numOfFramesSimulated == 0) {
+                return;
+            }
+
+            // Exponential moving average, so single hitches (eg, GC or OS scheduling) don't swing the budget too much
+            const uint64_t costPerFrame = timeSpentInMicroSec / numOfFramesSimulated;
+            if (!mHasFrameCostEstimate) {
+                mHasFrameCostEstimate = true;
+                mFrameCostEstimateInMicroSec = costPerFrame;
+            }
+            else {
+                mFrameCostEstimateInMicroSec += (static_cast<int64_t>(costPerFrame) - static_cast<int64_t>(mFrameCostEstimateInMicroSec))
+                    / kFrameCostSmoothingFactor;
+            }
+        }
+
+        // Retrieves time via same source as frame timing itself, so cost measurements are consistent in unit tests
+        uint64_t GetCurrentTimeInMicroSec() const {
+            return mTimeRetriever();
+        }
+
+        uint64_t GetFrameCostEstimateInMicroSec() const {
+            return mFrameCostEstimateInMicroSec;
+        }
+
+        // Number of frames currently owed but not yet processed, due to not fitting within prior ticks' budgets
+        FrameType GetFrameDebt() const {
+            return mFrameDebt;
+        }
+
+        // Expose these settings for easy unit testing. Perhaps would be cleaner to refactor out to a helper class or such?
         static constexpr FrameType GetMaxFramesPossibleToProcessAtOnce() {
             return kMaxFramesToProcessAtOnce;
         }
+        static constexpr FrameType GetMaxFrameDebt() {
+            return kMaxFrameDebt;
+        }
+        static constexpr uint64_t GetCatchUpBudgetInMicroSec() {
+            return kCatchUpBudgetInMicroSec;
+        }
     
       private:
-        FrameType GetFramesToProcessBasedOnStandardTimePassing(const uint64_t currentTimeInMicroSec) {
+        FrameType GetFramesToProcessBasedOnStandardTimePassing(const uint64_t currentTimeInMicroSec,
+                                                               const uint64_t timeAlreadySpentThisTickInMicroSec) {
             // Time multiplier: Adjusting expected length of frame will adjust how fast or slow time passes by
             const uint64_t curTimePerFrameInMicroSec = GetAdjustedTimePerFrameInMicroSec();
             
-            // Calculate how many frames we should actually process based on real time that passed
+            // Calculate how many new frames are owed based on real time that passed
             uint64_t timePassedSinceLastFrameUpdate = currentTimeInMicroSec - mLastUpdateTimeInMicroSec;
-            uint64_t bigBoiNumOfFramesToProcess = timePassedSinceLastFrameUpdate / curTimePerFrameInMicroSec;
-            // Explicitly use a cast to quiet 64bit -> 32bit warnings.
-            //      A wild world to live in if this cast was an issue (as calculated based on time displacement).
-            FrameType numberOfFramesToProcess = static_cast<FrameType>(bigBoiNumOfFramesToProcess);
-
-            if (numberOfFramesToProcess > 0) {
+            uint64_t bigBoiNumOfNewFramesOwed = timePassedSinceLastFrameUpdate / curTimePerFrameInMicroSec;
+            if (bigBoiNumOfNewFramesOwed > 0) {
                 // Remember the exact timestamp we've accounted for (and no more or we can fall behind).
-                //      Note that we're doing this regardless of next bit of frames limitation code as we want the
-                //      time tracking to be as up to date as possible to prevent trying to process additional frames.
-                mLastUpdateTimeInMicroSec += curTimePerFrameInMicroSec * numberOfFramesToProcess;
-
-                // Limit max number of frames to process at once. Eg, for slow computes or when breakpoint debugging.
-                //      Especially cuz processing too many frames at once can be a death loop with slow computers and such
-                if (numberOfFramesToProcess > kMaxFramesToProcessAtOnce) {
-                    numberOfFramesToProcess = kMaxFramesToProcessAtOnce; // Pretend to be caught up after this number of frames
-                }
+                mLastUpdateTimeInMicroSec += curTimePerFrameInMicroSec * bigBoiNumOfNewFramesOwed;
             }
 
+            // Add to any frames still owed from prior ticks.
+            //      Debt is still bounded, as otherwise a very long hitch (eg, breakpoint debugging) would cause a long
+            //      fast-forward afterwards. Anything beyond that is dropped, and time sync is left to close that gap.
+            //      Explicitly use a cast to quiet 64bit -> 32bit warnings, which is safe after clamping.
+            const uint64_t bigBoiFrameDebt = std::min<uint64_t>(mFrameDebt + bigBoiNumOfNewFramesOwed, kMaxFrameDebt);
+            mFrameDebt = static_cast<FrameType>(bigBoiFrameDebt);
+
+            // Process as many owed frames as fit in this tick's budget and carry over the rest
+            const FrameType numberOfFramesToProcess = std::min(mFrameDebt, GetAffordableFramesForTick(timeAlreadySpentThisTickInMicroSec));
+            mFrameDebt -= numberOfFramesToProcess;
+
             ProcessTimeSyncDuration(numberOfFramesToProcess);
             return numberOfFramesToProcess;
         }
 
+        /**
+        * Determines how many frames can be simulated within the remaining catch-up budget for the current tick
+        * @param timeAlreadySpentThisTickInMicroSec - portion of budget that's already used up
+        * @returns number of frames which fit, which is always at least 1 so that progress is always made
+        **/
+        FrameType GetAffordableFramesForTick(uint64_t timeAlreadySpentThisTickInMicroSec) const {
+            // No measurements yet (or frames are effectively free), so only the hard limit applies
+            if (mFrameCostEstimateInMicroSec == 0) {
+                return kMaxFramesToProcessAtOnce;
+            }
+            
+            const uint64_t remainingBudget = kCatchUpBudgetInMicroSec - std::min(timeAlreadySpentThisTickInMicroSec, kCatchUpBudgetInMicroSec);
+            const uint64_t affordableFrames = remainingBudget / mFrameCostEstimateInMicroSec;
+            return static_cast<FrameType>(std::clamp<uint64_t>(affordableFrames, 1, kMaxFramesToProcessAtOnce));
+        }
+
         uint64_t GetAdjustedTimePerFrameInMicroSec() const {
             /*
              * Ironically, this is probably the one place we can use floats as exact accuracy doesn't matter at all BUT
@@ -193,7 +260,8 @@ namespace ProjectNomad {
             // TODO: Unit test the heck outta this. Eg, if time per frame in microsec is VERY high value, then result
             //       should not be that off
 
-            return mTimeSyncTimeMultiplier * kTimePerFrameInMicroSec;
+            // Multiplier is how much faster to simulate, so shorten each frame accordingly (and vice versa)
+            return static_cast<uint64_t>(kTimePerFrameInMicroSec / mTimeSyncTimeMultiplier);
         }
 
         void ProcessTimeSyncDuration(const FrameType numberOfFramesToProcess) {
@@ -220,12 +288,26 @@ namespace ProjectNomad {
         }
         
         static constexpr uint64_t kTimePerFrameInMicroSec = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
-        static constexpr FrameType kMaxFramesToProcessAtOnce = 3; // Arbitrarily chosen, should rework in future!
+        // Hard limit on frames processed in a single tick, even if frames are cheap enough to fit more in the budget.
+        //      Mainly to keep any rendered fast-forward from looking like a jarring skip.
+        static constexpr FrameType kMaxFramesToProcessAtOnce = 8;
+        // Max wall-clock time to spend simulating frames in a single tick. One gameplay frame's worth of time, so
+        //      that a machine which can simulate faster than real time is always able to catch up eventually.
+        static constexpr uint64_t kCatchUpBudgetInMicroSec = kTimePerFrameInMicroSec;
+        // Max frames to owe before throwing out extra time. Half a second at 60fps
+        static constexpr FrameType kMaxFrameDebt = FrameRate::kGameplayFrameRate / 2;
+        // Weight for each new frame cost measurement is 1 / this value
+        static constexpr int64_t kFrameCostSmoothingFactor = 8;
         
         std::function<uint64_t()> mTimeRetriever = []{ return SharedUtilities::getTimeInMicroseconds(); };
         uint64_t mLastUpdateTimeInMicroSec = 0;
         bool mHandledInitialFrameProcessing = false; // Special start case, as timer state may not be set correctly then
 
+        // Vars for catch-up budget
+        FrameType mFrameDebt = 0;
+        bool mHasFrameCostEstimate = false;
+        uint64_t mFrameCostEstimateInMicroSec = 0;
+
         // Vars to properly handle pause + unpause
         bool mIsPaused = false;
         bool mShouldNextUpdateHandleUnpausing = false;
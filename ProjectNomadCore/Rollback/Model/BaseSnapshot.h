@@ -5,5 +5,38 @@ namespace ProjectNomad {
     struct BaseSnapshot {
         virtual ~BaseSnapshot() = default;
         virtual uint32_t CalculateChecksum() const = 0;
+
+        /**
+        * Retrieves checksum for this snapshot, only doing the full CalculateChecksum pass if checksum isn't already
+        * known. Note that cached value is copied along with the snapshot itself.
+        * @returns checksum representing this snapshot
+        **/
+        uint32_t GetChecksum() const {
+            if (!mHasCachedChecksum) {
+                mCachedChecksum = CalculateChecksum();
+                mHasCachedChecksum = true;
+            }
+            
+            return mCachedChecksum;
+        }
+
+        /**
+        * Allows snapshot generation to provide an already known checksum, such as one that's incrementally kept up
+        * to date via RegistryChecksumTracker. This avoids ever needing an O(state) checksum pass for this snapshot.
+        * @param checksum - Checksum that CalculateChecksum would otherwise be expected to return
+        **/
+        void SetCachedChecksum(uint32_t checksum) {
+            mCachedChecksum = checksum;
+            mHasCachedChecksum = true;
+        }
+
+        // Expected to be called if snapshot data is modified after checksum may have been retrieved
+        void ClearCachedChecksum() {
+            mHasCachedChecksum = false;
+        }
+
+      private:
+        mutable uint32_t mCachedChecksum = 0;
+        mutable bool mHasCachedChecksum = false;
     };
 }
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <EnTT/entt.hpp>
+
+#include "Utilities/FrameType.h"
+#include "Utilities/Containers/FlexArray.h"
+
+namespace ProjectNomad {
+    /**
+    * Identifies a single node within a snapshot's desync checksum tree, whose children checksums can be requested
+    * from a peer to narrow down where a desync happened (see RollbackDesyncLocalizer).
+    *
+    * Tree levels:
+    *   1. Root: one checksum per checksummed type (eg, each component type). See ForAllTypes
+    *   2. Type: checksums of entity index ranges within that type, kChildrenPerRange children per node, repeatedly
+    *      narrowing until each child is a single entity index. See ForType
+    * Thus the diverging type + entity are found within 1 + log16(entity index range) round trips.
+    **/
+    struct DesyncChecksumQuery {
+        static constexpr uint8_t kAllTypes = 0xFF;
+        static constexpr uint32_t kMaxChecksumsPerNode = 32; // Also max checksummed types
+        static constexpr uint32_t kChildrenPerRange = 16;
+        // Every possible EnTT entity index, which is a power of kChildrenPerRange so ranges always divide evenly
+        static constexpr uint32_t kEntityIndexRange = entt::to_entity(entt::entity{entt::null}) + 1; // Null uses max index
+
+        uint8_t typeIndex = kAllTypes;
+        uint32_t rangeStart = 0;
+        uint32_t rangeSize = 0;
+
+        static DesyncChecksumQuery ForAllTypes() {
+            return {};
+        }
+        static DesyncChecksumQuery ForType(uint8_t typeIndex) {
+            return {typeIndex, 0, kEntityIndexRange};
+        }
+
+        bool IsForAllTypes() const {
+            return typeIndex == kAllTypes;
+        }
+        // Whether each child is a single entity index, ie whether this is the final level of the tree
+        bool IsForSingleEntities() const {
+            return !IsForAllTypes() && rangeSize == kChildrenPerRange;
+        }
+
+        /**
+        * Checks that range is one that ForType + GetChildQuery could produce, as queries may come from remote peers
+        * @returns true if valid, false otherwise. Type index itself is left for snapshot to check
+        **/
+        bool IsValid() const {
+            if (IsForAllTypes()) {
+                return true;
+            }
+            if (rangeStart >= kEntityIndexRange || rangeSize > kEntityIndexRange || rangeSize == 0) {
+                return false;
+            }
+
+            // Range size must be a power of kChildrenPerRange (other than 1) which range start is aligned to
+            uint32_t validRangeSize = kChildrenPerRange;
+            while (validRangeSize < rangeSize) {
+                validRangeSize *= kChildrenPerRange;
+            }
+            return validRangeSize == rangeSize && rangeStart % rangeSize == 0;
+        }
+
+        uint32_t GetChildRangeSize() const {
+            return rangeSize / kChildrenPerRange;
+        }
+
+        // Query for given child. Not valid for single entity level, as single entities have no children
+        DesyncChecksumQuery GetChildQuery(uint32_t childIndex) const {
+            if (IsForAllTypes()) {
+                return ForType(static_cast<uint8_t>(childIndex));
+            }
+            return {typeIndex, rangeStart + childIndex * GetChildRangeSize(), GetChildRangeSize()};
+        }
+
+        bool operator==(const DesyncChecksumQuery& other) const = default;
+    };
+
+    using DesyncChecksumList = FlexArray<uint32_t, DesyncChecksumQuery::kMaxChecksumsPerNode>;
+
+    // SnapshotType supports desync localization (see RollbackSettings::useDesyncLocalization) by defining the following:
+    //      bool CalculateDesyncChecksums(const DesyncChecksumQuery& query, DesyncChecksumList& result) const;
+    // Which calculates the checksums of every child of the given node, returning false if query is invalid for the
+    //      snapshot (eg, type index out of range). Optionally, snapshot can also define the following for readable logs:
+    //      static std::string GetDesyncChecksumTypeName(uint8_t typeIndex);
+    // See RegistrySnapshot for an example.
+    template <typename SnapshotType>
+    constexpr bool SupportsDesyncLocalization = requires(const SnapshotType& snapshot,
+                                                         const DesyncChecksumQuery& query,
+                                                         DesyncChecksumList& result) {
+        { snapshot.CalculateDesyncChecksums(query, result) } -> std::same_as<bool>;
+    };
+
+    /**
+    * Outcome of localizing a single desync, as found by the peer which detected the desync
+    **/
+    struct DesyncLocalizationResult {
+        FrameType targetFrame = 0;
+        // False if every checksum matched at some level, such as if desync was in state outside the checksum tree
+        bool didFindDivergence = false;
+        uint8_t typeIndex = DesyncChecksumQuery::kAllTypes; // Only valid if divergence found
+        uint32_t entityIndex = 0; // Only valid if divergence found
+        uint32_t roundTrips = 0;
+    };
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "GameCore/PlayerSpot.h"
+#include "Network/Model/PeerLatencyEstimator.h"
+#include "Network/Transport/NetworkConditionSimulator.h"
+#include "Utilities/FrameType.h"
+#include "Utilities/Containers/FlexArray.h"
+
+namespace ProjectNomad {
+    /**
+    * Everything that happened to a single peer during a headless match (see HeadlessRollbackMatch)
+    **/
+    struct HeadlessPeerReport {
+        uint64_t ticks = 0;
+        uint64_t framesProcessed = 0;
+        uint64_t framesResimulated = 0;
+        uint64_t rollbacks = 0;
+        uint64_t stallTicks = 0;
+
+        // Latest frame processed minus host's latest frame processed at end of match. Always 0 for host
+        int64_t finalFramesAheadOfHost = 0;
+        // Largest difference to host at any point after both peers started. Shows how well time sync keeps peers close
+        uint64_t maxFramesApartFromHost = 0;
+        // Local input delay in use at end of match, which only differs from starting delay if tuning is enabled
+        FrameType finalLocalInputDelay = 0;
+
+        // Impairments applied to this peer's outgoing packets
+        NetworkConditionStats outgoingNetworkStats = {};
+        // Measured via time quality report ping-pongs with host. No samples for host itself
+        PeerLatencyStats latencyToHost = {};
+    };
+
+    struct HeadlessMatchReport {
+        uint64_t simulatedTimeInMicroSec = 0;
+        FlexArray<HeadlessPeerReport, PlayerSpotHelpers::kMaxPlayerSpots> peers = {};
+
+        // Re-simulated frames per second of simulated time, which approximates rollback's CPU overhead
+        double GetResimulatedFramesPerSecond(uint32_t peerIndex) const {
+            if (simulatedTimeInMicroSec == 0) {
+                return 0;
+            }
+            return static_cast<double>(peers.Get(peerIndex).framesResimulated) * 1000000.0 /
+                   static_cast<double>(simulatedTimeInMicroSec);
+        }
+
+        /**
+        * Dumps report as a single JSON object, such as for comparing network condition profiles in a soak test
+        * @param profileName - name of network conditions the match was run with
+        * @returns JSON string
+        **/
+        std::string ToJson(const char* profileName) const {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+            writer.StartObject();
+            writer.Key("profile");
+            writer.String(profileName);
+            writer.Key("simulatedTimeInMicroSec");
+            writer.Uint64(simulatedTimeInMicroSec);
+
+            writer.Key("peers"); // Index == player spot
+            writer.StartArray();
+            for (uint32_t i = 0; i < peers.GetSize(); i++) {
+                const HeadlessPeerReport& peer = peers.Get(i);
+                writer.StartObject();
+                writer.Key("ticks");
+                writer.Uint64(peer.ticks);
+                writer.Key("framesProcessed");
+                writer.Uint64(peer.framesProcessed);
+                writer.Key("framesResimulated");
+                writer.Uint64(peer.framesResimulated);
+                writer.Key("resimulatedFramesPerSecond");
+                writer.Double(GetResimulatedFramesPerSecond(i));
+                writer.Key("rollbacks");
+                writer.Uint64(peer.rollbacks);
+                writer.Key("stallTicks");
+                writer.Uint64(peer.stallTicks);
+                writer.Key("finalFramesAheadOfHost");
+                writer.Int64(peer.finalFramesAheadOfHost);
+                writer.Key("maxFramesApartFromHost");
+                writer.Uint64(peer.maxFramesApartFromHost);
+                writer.Key("finalLocalInputDelay");
+                writer.Uint(peer.finalLocalInputDelay);
+
+                const NetworkConditionStats& networkStats = peer.outgoingNetworkStats;
+                writer.Key("packetsSent");
+                writer.Uint64(networkStats.packetsSent);
+                writer.Key("packetsDropped");
+                writer.Uint64(networkStats.packetsDropped);
+                writer.Key("packetsResent");
+                writer.Uint64(networkStats.packetsResent);
+                writer.Key("packetsDuplicated");
+                writer.Uint64(networkStats.packetsDuplicated);
+                writer.Key("packetsReordered");
+                writer.Uint64(networkStats.packetsReordered);
+
+                const PeerLatencyStats& latency = peer.latencyToHost;
+                writer.Key("rttSamples");
+                writer.Uint(latency.sampleCount);
+                writer.Key("smoothedRttInMicroSec");
+                writer.Uint64(latency.smoothedRttInMicroSec);
+                writer.Key("rttJitterInMicroSec");
+                writer.Uint64(latency.jitterInMicroSec);
+                writer.Key("minRttInMicroSec");
+                writer.Uint64(latency.minRttInMicroSec);
+                writer.EndObject();
+            }
+            writer.EndArray();
+            writer.EndObject();
+
+            return buffer.GetString();
+        }
+    };
+}
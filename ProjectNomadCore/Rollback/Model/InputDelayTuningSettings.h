@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Context/FrameRate.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Settings for automatically adjusting local input delay during a multiplayer session.
+    * More delay means remote inputs arrive before they're needed more often (and thus fewer + shallower rollbacks),
+    * at the cost of local inputs feeling less responsive. See RollbackInputDelayTuner for the exact policy.
+    **/
+    struct InputDelayTuningSettings {
+        // If false, then RollbackSettings::localInputDelay is used for the entire session
+        bool isEnabled = false;
+
+        // Range to tune within. Expected to be within [0, RollbackStaticSettings::kMaxInputDelay]
+        FrameType minInputDelay = 0;
+        FrameType maxInputDelay = 6;
+
+        // Rollbacks which re-process at least this many frames are considered expensive enough to trade delay for
+        FrameType deepRollbackFrames = 4;
+        // Number of deep rollbacks within a single evaluation window which results in adding a frame of delay
+        uint32_t deepRollbacksToIncreaseDelay = 4;
+        // How often to decide whether to change delay. Delay only ever changes by one frame per window, so that a
+        //      single burst of rollbacks or latency spike doesn't swing delay back and forth
+        FrameType evaluationWindowFrames = FrameRate::FromSeconds(fp{2});
+    };
+}
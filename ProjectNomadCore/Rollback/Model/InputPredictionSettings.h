@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+
+#include "Input/CharacterInput.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    // Each separately predicted field of CharacterInput. Count is not a valid value and only used for array sizing
+    enum class CharacterInputField : uint8_t {
+        CamPosition,
+        CamRotation,
+        MoveForward,
+        MoveRight,
+        UIChoice,
+        CommandInputs,
+        Count
+    };
+
+    enum class InputPredictionMethod : uint8_t {
+        // Predict that player keeps using the latest known value. eg, holding buttons
+        RepeatLatest,
+        // Continue the change between the two latest known values. Only valid for camera and movement fields, other
+        //      fields fall back to RepeatLatest
+        Extrapolate,
+        // Predict the default value. eg, predict that buttons are released
+        Neutral
+    };
+
+    struct InputFieldPredictionPolicy {
+        InputPredictionMethod method = InputPredictionMethod::RepeatLatest;
+        // If false, then a wrong prediction of this field never causes a rollback on its own.
+        //      Only valid for fields which do NOT affect simulation, such as camera fields used purely for rendering.
+        //      Otherwise simulation will silently diverge from the confirmed inputs (ie, cause desyncs).
+        bool countsForMisprediction = true;
+    };
+
+    /**
+    * Per-field prediction behavior for remote (or otherwise not yet known) player inputs.
+    * Defaults to repeating the latest known input for every field, which is typical fighting game rollback behavior.
+    **/
+    struct InputPredictionSettings {
+        std::array<InputFieldPredictionPolicy, static_cast<size_t>(CharacterInputField::Count)> fieldPolicies = {};
+
+        InputFieldPredictionPolicy& ForField(CharacterInputField field) {
+            return fieldPolicies[static_cast<size_t>(field)];
+        }
+        const InputFieldPredictionPolicy& ForField(CharacterInputField field) const {
+            return fieldPolicies[static_cast<size_t>(field)];
+        }
+    };
+
+    /**
+    * Running totals of how often predictions turned out to be wrong, per field.
+    * Intended for tuning InputPredictionSettings, as fewer mispredictions means fewer re-simulated frames.
+    **/
+    struct InputPredictionStats {
+        // Predictions which were used for frame processing and later compared against the confirmed input
+        uint64_t checkedPredictions = 0;
+        // Predictions which caused a rollback (ie, at least one field which counts for misprediction was wrong)
+        uint64_t mispredictions = 0;
+        // Per-field mispredictions, regardless of whether the field counts for misprediction
+        std::array<uint64_t, static_cast<size_t>(CharacterInputField::Count)> fieldMispredictions = {};
+
+        uint64_t GetFieldMispredictions(CharacterInputField field) const {
+            return fieldMispredictions[static_cast<size_t>(field)];
+        }
+        float GetMispredictionRate() const {
+            return checkedPredictions > 0 ? static_cast<float>(mispredictions) / checkedPredictions : 0;
+        }
+        float GetFieldMispredictionRate(CharacterInputField field) const {
+            return checkedPredictions > 0 ? static_cast<float>(GetFieldMispredictions(field)) / checkedPredictions : 0;
+        }
+
+        void Add(const InputPredictionStats& other) {
+            checkedPredictions += other.checkedPredictions;
+            mispredictions += other.mispredictions;
+            for (size_t i = 0; i < fieldMispredictions.size(); i++) {
+                fieldMispredictions[i] += other.fieldMispredictions[i];
+            }
+        }
+    };
+
+    /**
+    * Stateless helpers for applying InputPredictionSettings
+    **/
+    class InputPredictor {
+      public:
+        InputPredictor() = delete;
+
+        /**
+        * Predicts input for a frame after the latest known input
+        * @param settings - per-field prediction settings
+        * @param latest - latest known input
+        * @param previous - known input for frame before latest. nullptr if none, in which case extrapolation falls back
+        *                   to repeating latest
+        * @param framesAhead - how many frames past latest known input the predicted frame is. Expected to be at least 1
+        * @returns predicted input
+        **/
+        static CharacterInput Predict(const InputPredictionSettings& settings,
+                                      const CharacterInput& latest,
+                                      const CharacterInput* previous,
+                                      FrameType framesAhead) {
+            CharacterInput result = latest;
+            const CharacterInput neutral = {};
+
+            // Camera position: Continue at same velocity
+            switch (GetMethod(settings, CharacterInputField::CamPosition, previous)) {
+                case InputPredictionMethod::Extrapolate:
+                    result.camPosition = latest.camPosition + (latest.camPosition - previous->camPosition) * fp{framesAhead};
+                    break;
+                case InputPredictionMethod::Neutral:
+                    result.camPosition = neutral.camPosition;
+                    break;
+                default:
+                    break;
+            }
+
+            // Camera rotation: Continue each component's change. Per frame camera turns are small enough that this stays
+            //      well within quantization precision of a steady turn, and unlike multiplying by the latest rotation
+            //      delta it continues quantized rotations (which aren't exactly unit length) without drifting
+            switch (GetMethod(settings, CharacterInputField::CamRotation, previous)) {
+                case InputPredictionMethod::Extrapolate:
+                    result.camRotation.w = ExtrapolateAxis(latest.camRotation.w, previous->camRotation.w, framesAhead);
+                    result.camRotation.v.x = ExtrapolateAxis(latest.camRotation.v.x, previous->camRotation.v.x, framesAhead);
+                    result.camRotation.v.y = ExtrapolateAxis(latest.camRotation.v.y, previous->camRotation.v.y, framesAhead);
+                    result.camRotation.v.z = ExtrapolateAxis(latest.camRotation.v.z, previous->camRotation.v.z, framesAhead);
+                    break;
+                case InputPredictionMethod::Neutral:
+                    result.camRotation = neutral.camRotation;
+                    break;
+                default:
+                    break;
+            }
+
+            result.moveForward = PredictAxis(settings, CharacterInputField::MoveForward, latest.moveForward,
+                                             previous ? &previous->moveForward : nullptr, framesAhead);
+            result.moveRight = PredictAxis(settings, CharacterInputField::MoveRight, latest.moveRight,
+                                           previous ? &previous->moveRight : nullptr, framesAhead);
+
+            // Discrete fields don't support extrapolation, so only need to check for neutral predictions
+            if (settings.ForField(CharacterInputField::UIChoice).method == InputPredictionMethod::Neutral) {
+                result.uiChoice = neutral.uiChoice;
+            }
+            if (settings.ForField(CharacterInputField::CommandInputs).method == InputPredictionMethod::Neutral) {
+                result.commandInputs = neutral.commandInputs;
+            }
+
+            return result;
+        }
+
+        /**
+        * Compares a used prediction against the actual confirmed input, and records result in given stats
+        * @param settings - per-field prediction settings, which decide which fields count for misprediction
+        * @param predicted - input which was predicted and used for frame processing
+        * @param confirmed - actual input for the same frame
+        * @param stats - stats to update
+        * @returns true if prediction was wrong in any field which counts for misprediction (ie, should rollback)
+        **/
+        static bool CheckForMisprediction(const InputPredictionSettings& settings,
+                                          const CharacterInput& predicted,
+                                          const CharacterInput& confirmed,
+                                          InputPredictionStats& stats) {
+            bool isMispredicted = false;
+            auto checkField = [&](CharacterInputField field, bool doesFieldDiffer) {
+                if (!doesFieldDiffer) {
+                    return;
+                }
+
+                stats.fieldMispredictions[static_cast<size_t>(field)]++;
+                if (settings.ForField(field).countsForMisprediction) {
+                    isMispredicted = true;
+                }
+            };
+
+            checkField(CharacterInputField::CamPosition, predicted.camPosition != confirmed.camPosition);
+            checkField(CharacterInputField::CamRotation, predicted.camRotation != confirmed.camRotation);
+            checkField(CharacterInputField::MoveForward, predicted.moveForward != confirmed.moveForward);
+            checkField(CharacterInputField::MoveRight, predicted.moveRight != confirmed.moveRight);
+            checkField(CharacterInputField::UIChoice, predicted.uiChoice != confirmed.uiChoice);
+            checkField(CharacterInputField::CommandInputs, predicted.commandInputs != confirmed.commandInputs);
+
+            stats.checkedPredictions++;
+            if (isMispredicted) {
+                stats.mispredictions++;
+            }
+            return isMispredicted;
+        }
+
+      private:
+        static InputPredictionMethod GetMethod(const InputPredictionSettings& settings,
+                                               CharacterInputField field,
+                                               const CharacterInput* previous) {
+            const InputPredictionMethod method = settings.ForField(field).method;
+            // Can't extrapolate from a single known value
+            if (method == InputPredictionMethod::Extrapolate && previous == nullptr) {
+                return InputPredictionMethod::RepeatLatest;
+            }
+            return method;
+        }
+
+        static fp PredictAxis(const InputPredictionSettings& settings,
+                              CharacterInputField field,
+                              fp latest,
+                              const fp* previous,
+                              FrameType framesAhead) {
+            const InputPredictionMethod method = settings.ForField(field).method;
+            if (method == InputPredictionMethod::Neutral) {
+                return fp{0};
+            }
+            if (method == InputPredictionMethod::Extrapolate && previous != nullptr) {
+                return ExtrapolateAxis(latest, *previous, framesAhead);
+            }
+            return latest;
+        }
+        // Axis inputs (and rotation components) are expected to stay in range [-1, 1]
+        static fp ExtrapolateAxis(fp latest, fp previous, FrameType framesAhead) {
+            return std::clamp(latest + (latest - previous) * fp{framesAhead}, fp{-1}, fp{1});
+        }
+    };
+}
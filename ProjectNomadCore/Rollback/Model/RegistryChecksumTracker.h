@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <EnTT/entt.hpp>
+
+#include "RollbackSettings.h"
+#include "Utilities/ChecksumHasher.h"
+
+namespace ProjectNomad {
+    /**
+    * Incrementally maintains a checksum for the given component types within an EnTT registry, such that only
+    * changed components need to be rehashed when retrieving an up to date checksum.
+    *
+    * The checksum is hierarchical:
+    *   1. Each entity + component pair is hashed on its own (see ChecksumHasher)
+    *   2. All pair hashes for a component type are combined via addition, which is order-independent. Thus any single
+    *       pair hash can be swapped out without touching any other pairs
+    *   3. Finally, the per-type combined hashes are hashed together in a fixed order
+    *
+    * Changes made via registry emplace/replace/patch/remove calls are tracked automatically once Connect is called.
+    * Changes made directly to component references (eg, via view.get) must be explicitly reported via MarkDirty.
+    * After restoring the registry as a whole (eg, rollback snapshot restoration), MarkAllDirty should be called.
+    *
+    * NOTE: This class registers itself with registry signals, so it must not be moved or copied while connected.
+    * @tparam ComponentTypes - Components to include in checksum. Each must be supported by ChecksumHasher::Add
+    **/
+    template <typename... ComponentTypes>
+    class RegistryChecksumTracker {
+        static_assert(sizeof...(ComponentTypes) > 0, "Must track at least one component type");
+      public:
+        RegistryChecksumTracker() = default;
+        RegistryChecksumTracker(const RegistryChecksumTracker&) = delete;
+        RegistryChecksumTracker& operator=(const RegistryChecksumTracker&) = delete;
+
+        void Connect(entt::registry& registry) {
+            (ConnectForType<ComponentTypes>(registry), ...);
+            MarkAllDirty();
+        }
+        void Disconnect(entt::registry& registry) {
+            (registry.on_construct<ComponentTypes>().disconnect(this), ...);
+            (registry.on_update<ComponentTypes>().disconnect(this), ...);
+            (registry.on_destroy<ComponentTypes>().disconnect(this), ...);
+        }
+
+        /**
+        * Reports that a component was modified without going through registry, and thus needs to be rehashed
+        * @tparam ComponentType - Type of modified component
+        * @param entity - Entity whose component was modified
+        **/
+        template <typename ComponentType>
+        void MarkDirty(entt::entity entity) {
+            GetTypeState<ComponentType>().dirtyEntities.push_back(entity);
+        }
+
+        // Forces full rehash on next update, such as after restoring the entire registry from a snapshot
+        void MarkAllDirty() {
+            for (PerTypeState& typeState : mPerTypeStates) {
+                typeState.areAllDirty = true;
+            }
+        }
+
+        /**
+        * Rehashes any changed components then returns the up to date checksum
+        * @param registry - Registry that this tracker is connected to
+        * @returns checksum for all tracked components in the registry
+        **/
+        uint32_t UpdateChecksum(const entt::registry& registry) {
+            (UpdateForType<ComponentTypes>(registry), ...);
+
+            // Combine per-type results in a fixed order
+            ChecksumHasher hasher(RollbackStaticSettings::kChecksumAlgorithm);
+            for (const PerTypeState& typeState : mPerTypeStates) {
+                hasher.Add(typeState.combinedHash);
+            }
+            return hasher.GetResult();
+        }
+
+      private:
+        struct PerTypeState {
+            std::unordered_map<entt::entity, uint32_t> entityHashes = {};
+            std::vector<entt::entity> dirtyEntities = {};
+            uint32_t combinedHash = 0;
+            bool areAllDirty = true;
+        };
+
+        template <typename ComponentType>
+        static constexpr size_t GetTypeIndex() {
+            constexpr bool isTypeMatch[] = {std::is_same_v<ComponentType, ComponentTypes>...};
+            for (size_t i = 0; i < sizeof...(ComponentTypes); i++) {
+                if (isTypeMatch[i]) {
+                    return i;
+                }
+            }
+            return sizeof...(ComponentTypes);
+        }
+
+        template <typename ComponentType>
+        PerTypeState& GetTypeState() {
+            constexpr size_t typeIndex = GetTypeIndex<ComponentType>();
+            static_assert(typeIndex < sizeof...(ComponentTypes), "ComponentType is not tracked by this tracker");
+            return mPerTypeStates[typeIndex];
+        }
+
+        template <typename ComponentType>
+        void ConnectForType(entt::registry& registry) {
+            registry.on_construct<ComponentType>().template connect<&RegistryChecksumTracker::OnComponentChanged<ComponentType>>(*this);
+            registry.on_update<ComponentType>().template connect<&RegistryChecksumTracker::OnComponentChanged<ComponentType>>(*this);
+            registry.on_destroy<ComponentType>().template connect<&RegistryChecksumTracker::OnComponentChanged<ComponentType>>(*this);
+        }
+
+        template <typename ComponentType>
+        void OnComponentChanged(entt::registry& registry, entt::entity entity) {
+            MarkDirty<ComponentType>(entity);
+        }
+
+        template <typename ComponentType>
+        static uint32_t HashEntry(entt::entity entity, const ComponentType& component) {
+            // Include entity itself so that (eg) two entities swapping component values still changes checksum
+            ChecksumHasher hasher(RollbackStaticSettings::kChecksumAlgorithm);
+            hasher.Add(entity);
+            hasher.Add(component);
+            return hasher.GetResult();
+        }
+
+        template <typename ComponentType>
+        void UpdateForType(const entt::registry& registry) {
+            PerTypeState& typeState = GetTypeState<ComponentType>();
+
+            // Full rehash case
+            if (typeState.areAllDirty) {
+                typeState.areAllDirty = false;
+                typeState.dirtyEntities.clear();
+                typeState.entityHashes.clear();
+                typeState.combinedHash = 0;
+
+                for (auto [entity, component] : registry.view<const ComponentType>().each()) {
+                    uint32_t entryHash = HashEntry(entity, component);
+                    typeState.entityHashes[entity] = entryHash;
+                    typeState.combinedHash += entryHash;
+                }
+                return;
+            }
+
+            // Otherwise only rehash dirty entries
+            for (entt::entity entity : typeState.dirtyEntities) {
+                // Remove old contribution, if any
+                auto existingEntry = typeState.entityHashes.find(entity);
+                if (existingEntry != typeState.entityHashes.end()) {
+                    typeState.combinedHash -= existingEntry->second;
+                    typeState.entityHashes.erase(existingEntry);
+                }
+
+                // Add new contribution, if component still exists (ie, wasn't removed)
+                if (registry.valid(entity) && registry.all_of<ComponentType>(entity)) {
+                    uint32_t entryHash = HashEntry(entity, registry.get<ComponentType>(entity));
+                    typeState.entityHashes[entity] = entryHash;
+                    typeState.combinedHash += entryHash;
+                }
+            }
+            typeState.dirtyEntities.clear();
+        }
+
+        std::array<PerTypeState, sizeof...(ComponentTypes)> mPerTypeStates = {};
+    };
+}
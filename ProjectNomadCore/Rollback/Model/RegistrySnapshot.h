@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <EnTT/entt.hpp>
+
+#include "BaseSnapshot.h"
+#include "DesyncLocalization.h"
+#include "RollbackSettings.h"
+#include "Context/CoreContext.h"
+#include "GameCore/CoreComponents.h"
+#include "GameCore/PlayerSpotComponents.h"
+#include "Utilities/ChecksumHasher.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Reusable rollback snapshot for a CoreContext, so that games don't need to hand-write registry copying.
+    *
+    * The registry is serialized in a single pass (via entt::snapshot) into one contiguous byte buffer, where each value
+    * is simply bump-allocated (appended) after the last. Restoring (via entt::snapshot_loader) is then a single linear
+    * read through that same buffer.
+    *
+    * The buffer is retained between captures and only ever grows, so in steady state capturing does not allocate.
+    * This is especially true as this snapshot opts into in-place generation (see GeneratesSnapshotInPlace), so each
+    * rollback buffer slot keeps its own already-sized buffer.
+    *
+    * The checksum is calculated while capturing. Values without padding are left in the buffer until a padded value (or
+    * the end) is reached, so long runs of them (eg, entity lists or most component arrays) are hashed in one go.
+    * Padded values are instead checksummed via their own AddToChecksum, as padding may differ between otherwise
+    * identical states. Either way the result matches checksumming each value on its own.
+    *
+    * Expectations:
+    * - Every component type that gameplay relies on must be listed, as restoring clears the entire registry first
+    * - Component types must be trivially copyable, as they are copied as raw bytes
+    * - Component types with any padding must define AddToChecksum (see ChecksumHasher)
+    *
+    * Supports desync localization (see DesyncChecksumQuery), where checksummed types are each component type in
+    * listed order followed by the entities themselves (so entities without any components are still covered).
+    * @tparam ComponentTypes - Components to include in snapshot
+    **/
+    template <typename... ComponentTypes>
+    class RegistrySnapshot : public BaseSnapshot {
+        static_assert((std::is_trivially_copyable_v<ComponentTypes> && ...), "Components must be trivially copyable");
+        static_assert(sizeof...(ComponentTypes) < DesyncChecksumQuery::kMaxChecksumsPerNode,
+            "Too many component types for desync localization, which also needs a slot for entities");
+
+      public:
+        static constexpr bool kGenerateSnapshotInPlace = true;
+        static constexpr uint8_t kEntitiesDesyncChecksumTypeIndex = sizeof...(ComponentTypes);
+
+        /**
+        * Overwrites this snapshot with the current state of the given context
+        * @param context - context to capture registry + frame count from
+        **/
+        void Capture(const CoreContext& context) {
+            mUsedBytes = 0;
+
+            OutputArchive output(*this);
+            output(context.simFrame.GetCurrentFrameCount());
+            entt::snapshot{context.registry}.entities(output).template component<ComponentTypes...>(output);
+
+            mCapturedChecksum = output.FinishChecksum();
+            SetCachedChecksum(mCapturedChecksum);
+        }
+
+        /**
+        * Restores the given context to the state this snapshot represents, including exact entity identifiers (and
+        * versions) and component storage order
+        * @param context - context to restore registry + frame count into
+        **/
+        void Restore(CoreContext& context) const {
+            // Sanity check: Snapshot loader can't handle a snapshot that was never captured
+            if (mUsedBytes == 0) {
+                context.logger.LogWarnMessage("Restoring snapshot that was never captured!");
+                return;
+            }
+            
+            context.simFrame.SetCurrentFrameCount(RestoreRegistry(context.registry));
+        }
+
+        uint32_t CalculateChecksum() const override {
+            return mCapturedChecksum;
+        }
+
+        /**
+        * Calculates checksums of every child of given node within this snapshot's desync checksum tree. Each entity +
+        * component pair is hashed on its own then summed per range, same as RegistryChecksumTracker, so that ranges
+        * can be compared without caring about storage order.
+        *
+        * Restores into a temporary registry to do so, which is fine as this is only expected after a desync.
+        * @param query - node to calculate child checksums of
+        * @param result - checksum for each child, in order
+        * @returns true if query was valid for this snapshot, false otherwise
+        **/
+        bool CalculateDesyncChecksums(const DesyncChecksumQuery& query, DesyncChecksumList& result) const {
+            result = {};
+            if (!query.IsValid() || (!query.IsForAllTypes() && query.typeIndex > kEntitiesDesyncChecksumTypeIndex)) {
+                return false;
+            }
+
+            entt::registry registry;
+            RestoreRegistry(registry);
+
+            if (query.IsForAllTypes()) {
+                // Type checksum is simply the sum of its top level ranges, so it's consistent with lower levels
+                for (uint8_t typeIndex = 0; typeIndex <= kEntitiesDesyncChecksumTypeIndex; typeIndex++) {
+                    uint32_t rangeChecksums[DesyncChecksumQuery::kChildrenPerRange] = {};
+                    AddDesyncChecksumsForType(registry, DesyncChecksumQuery::ForType(typeIndex), rangeChecksums);
+                    result.Add(std::accumulate(std::begin(rangeChecksums), std::end(rangeChecksums), 0u));
+                }
+                return true;
+            }
+
+            uint32_t childChecksums[DesyncChecksumQuery::kChildrenPerRange] = {};
+            AddDesyncChecksumsForType(registry, query, childChecksums);
+            for (uint32_t childChecksum : childChecksums) {
+                result.Add(childChecksum);
+            }
+            return true;
+        }
+
+        static std::string GetDesyncChecksumTypeName(uint8_t typeIndex) {
+            if (typeIndex == kEntitiesDesyncChecksumTypeIndex) {
+                return "Entities";
+            }
+
+            std::string result = "Unknown type " + std::to_string(typeIndex);
+            uint8_t curTypeIndex = 0;
+            ((curTypeIndex++ == typeIndex ? (result = entt::type_name<ComponentTypes>::value(), true) : false) || ...);
+            return result;
+        }
+
+        // Pre-sizes buffer, such as to avoid any allocations during the first frames of a session
+        void Reserve(size_t totalBytes) {
+            if (totalBytes > mBuffer.size()) {
+                mBuffer.resize(totalBytes);
+            }
+        }
+
+        size_t GetUsedBytes() const {
+            return mUsedBytes;
+        }
+        size_t GetCapacityBytes() const {
+            return mBuffer.size();
+        }
+
+      private:
+        // Returns frame count stored alongside the registry
+        FrameType RestoreRegistry(entt::registry& registry) const {
+            InputArchive input(*this);
+
+            FrameType frameCount = 0;
+            input(frameCount);
+
+            // Snapshot loader expects an empty registry
+            registry.clear();
+            entt::snapshot_loader{registry}.entities(input).template component<ComponentTypes...>(input);
+            return frameCount;
+        }
+
+        /**
+        * Adds checksum of every entity within query's range to the checksum of its child range
+        * @param registry - registry to checksum
+        * @param query - type + entity index range to checksum
+        * @param result - checksum per child range, expected to hold kChildrenPerRange entries
+        **/
+        static void AddDesyncChecksumsForType(const entt::registry& registry, const DesyncChecksumQuery& query, uint32_t* result) {
+            auto addEntry = [&query, result](entt::entity entity, uint32_t entryChecksum) {
+                const uint32_t entityIndex = entt::to_entity(entity);
+                if (entityIndex >= query.rangeStart && entityIndex - query.rangeStart < query.rangeSize) {
+                    result[(entityIndex - query.rangeStart) / query.GetChildRangeSize()] += entryChecksum;
+                }
+            };
+
+            if (query.typeIndex == kEntitiesDesyncChecksumTypeIndex) {
+                registry.each([&addEntry](entt::entity entity) {
+                    addEntry(entity, HashDesyncEntity(entity));
+                });
+                return;
+            }
+
+            uint8_t curTypeIndex = 0;
+            ((curTypeIndex++ == query.typeIndex ? (AddDesyncChecksumsForComponent<ComponentTypes>(registry, addEntry), true) : false) || ...);
+        }
+
+        template <typename ComponentType, typename AddEntryFunc>
+        static void AddDesyncChecksumsForComponent(const entt::registry& registry, AddEntryFunc& addEntry) {
+            for (entt::entity entity : registry.view<const ComponentType>()) {
+                // Includes entity version, so recycled vs new entities still differ
+                ChecksumHasher hasher(RollbackStaticSettings::kChecksumAlgorithm);
+                hasher.Add(entity);
+                if constexpr (!std::is_empty_v<ComponentType>) { // Tag components only exist or don't
+                    hasher.Add(registry.get<ComponentType>(entity));
+                }
+                addEntry(entity, hasher.GetResult());
+            }
+        }
+
+        static uint32_t HashDesyncEntity(entt::entity entity) {
+            return ChecksumHasher::Calculate(RollbackStaticSettings::kChecksumAlgorithm, entity);
+        }
+
+        // Appends every given value to the end of the buffer while checksumming it. Used for all of entt::snapshot's
+        //      archive calls
+        class OutputArchive {
+          public:
+            explicit OutputArchive(RegistrySnapshot& target)
+                : mTarget(target), mHasher(RollbackStaticSettings::kChecksumAlgorithm), mFirstUnhashedByte(target.mUsedBytes) {}
+
+            template <typename... ValueTypes>
+            void operator()(const ValueTypes&... values) {
+                (Write(values), ...);
+            }
+
+            // Checksum of everything written, once done writing
+            uint32_t FinishChecksum() {
+                HashPendingBytes();
+                return mHasher.GetResult();
+            }
+
+          private:
+            template <typename ValueType>
+            void Write(const ValueType& value) {
+                if constexpr (ChecksumHasher::kIsHashedAsRawBytes<ValueType>) {
+                    mTarget.Write(value); // Hashed later alongside any following raw values
+                }
+                else {
+                    HashPendingBytes();
+                    mHasher.Add(value);
+                    mTarget.Write(value);
+                    mFirstUnhashedByte = mTarget.mUsedBytes;
+                }
+            }
+
+            void HashPendingBytes() {
+                mHasher.AddBytes(mTarget.mBuffer.data() + mFirstUnhashedByte, mTarget.mUsedBytes - mFirstUnhashedByte);
+                mFirstUnhashedByte = mTarget.mUsedBytes;
+            }
+
+            RegistrySnapshot& mTarget;
+            ChecksumHasher mHasher;
+            size_t mFirstUnhashedByte; // Offset instead of pointer, as buffer may be reallocated while writing
+        };
+
+        // Reads every given value in the same order as they were written. Used for all of entt::snapshot_loader's calls
+        class InputArchive {
+          public:
+            explicit InputArchive(const RegistrySnapshot& source) : mSource(source) {}
+
+            template <typename... ValueTypes>
+            void operator()(ValueTypes&... values) {
+                (Read(values), ...);
+            }
+
+          private:
+            template <typename ValueType>
+            void Read(ValueType& result) {
+                static_assert(std::is_trivially_copyable_v<ValueType>, "Only raw values are expected to be read");
+
+                // Sanity check: Never read beyond what was written (eg, default constructed snapshot)
+                if (mReadOffset + sizeof(ValueType) > mSource.mUsedBytes) {
+                    result = {};
+                    return;
+                }
+
+                std::memcpy(&result, mSource.mBuffer.data() + mReadOffset, sizeof(ValueType));
+                mReadOffset += sizeof(ValueType);
+            }
+
+            const RegistrySnapshot& mSource;
+            size_t mReadOffset = 0;
+        };
+
+        template <typename ValueType>
+        void Write(const ValueType& value) {
+            static_assert(std::is_trivially_copyable_v<ValueType>, "Only raw values are expected to be written");
+
+            // Grow geometrically if out of space, so that reaching steady state size only takes a few frames
+            const size_t requiredBytes = mUsedBytes + sizeof(ValueType);
+            if (requiredBytes > mBuffer.size()) {
+                mBuffer.resize(std::max(requiredBytes, mBuffer.size() * 2));
+            }
+
+            std::memcpy(mBuffer.data() + mUsedBytes, &value, sizeof(ValueType));
+            mUsedBytes = requiredBytes;
+        }
+
+        std::vector<std::byte> mBuffer = {};
+        size_t mUsedBytes = 0;
+        uint32_t mCapturedChecksum = 0;
+    };
+
+    // Snapshot covering every component defined in ProjectNomadCore. Games with additional components are expected
+    //      to define their own RegistrySnapshot with the full list instead.
+    using CoreRegistrySnapshot = RegistrySnapshot<
+        TransformComponent,
+        PhysicsComponent,
+        DynamicColliderComponent,
+        StaticColliderComponent,
+        HitstopComponent,
+        InvulnerableFlagComponent,
+        PlayerSpot1Component,
+        PlayerSpot2Component,
+        PlayerSpot3Component,
+        PlayerSpot4Component
+    >;
+}
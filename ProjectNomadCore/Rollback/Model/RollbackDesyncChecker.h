@@ -31,7 +31,7 @@ namespace ProjectNomad {
         bool DidDesyncOccur() {
             mWasDesyncCheckedForCurrentTargetFrame = true;
             
-            return mRemoteHostChecksum == mLocalChecksum;
+            return mRemoteHostChecksum != mLocalChecksum;
         }
         
         void ProvideRemoteHostChecksum(LoggerSingleton& logger, FrameType targetFrame, uint32_t checksum) {
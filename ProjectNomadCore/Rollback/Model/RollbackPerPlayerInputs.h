@@ -1,7 +1,9 @@
 #pragma once
 
+#include "InputPredictionSettings.h"
 #include "RollbackSettings.h"
 #include "Input/CharacterInput.h"
+#include "Input/CharacterInputQuantizer.h"
 #include "Utilities/LoggerSingleton.h"
 #include "Utilities/Containers/RingBuffer.h"
 
@@ -14,9 +16,15 @@ namespace ProjectNomad {
     class RollbackPerPlayerInputs {
       public:
         bool SetupForNewSession(LoggerSingleton& logger,
-                                const RollbackSettings& rollbackSettingso) {
+                                const RollbackSettings& rollbackSettings) {
             // Reset any other relevant vars
             mNextFrameToStore = 0;
+            mPredictionSettings = rollbackSettings.inputPrediction;
+            mShouldQuantizePredictions = rollbackSettings.IsMultiplayerSession();
+            mPredictionStats = {};
+            for (PredictedInputRecord& predictionRecord : mPredictedInputs) {
+                predictionRecord = {};
+            }
 
             // Note that don't need to reset the ring buffer as unused frames are just "noise".
             // However, "head" value may be use for player predictions. This shouldn't matter in actual games, but
@@ -31,8 +39,10 @@ namespace ProjectNomad {
         * @param logger - Logger reference
         * @param targetFrame - Intended frame that trying to add input for. Used for validation purposes
         * @param input - "Confirmed" input for given player
+        * @returns true if the target frame was already processed with a predicted input that differs from the
+        *          confirmed input (ie, a misprediction occurred and frame should be rolled back to), false otherwise
         **/
-        void AddInput(LoggerSingleton& logger,
+        bool AddInput(LoggerSingleton& logger,
                       FrameType targetFrame,
                       const CharacterInput& input) {
             // Sanity check: We should only be incrementally adding inputs for all players
@@ -41,11 +51,23 @@ namespace ProjectNomad {
                     "Unexpected frame given! Expected next frame: " + std::to_string(targetFrame) +
                     ", provided input frame: " + std::to_string(targetFrame)
                 );
-                return;
+                return false;
+            }
+
+            // Check if we already "used" a prediction for this frame, and if so then whether that prediction was wrong
+            bool wasPredictionIncorrect = false;
+            PredictedInputRecord& predictionRecord = GetPredictionRecordForFrame(targetFrame);
+            if (predictionRecord.frame == targetFrame) {
+                wasPredictionIncorrect = InputPredictor::CheckForMisprediction(
+                    mPredictionSettings, predictionRecord.predictedInput, input, mPredictionStats
+                );
+                predictionRecord = {}; // Frame is now confirmed so prediction is no longer relevant
             }
 
             mConfirmedInputs.Add(input); // Expectation: "Head" is always the last value we've received
             mNextFrameToStore++;
+
+            return wasPredictionIncorrect;
         }
 
         /**
@@ -54,12 +76,12 @@ namespace ProjectNomad {
         * @param targetFrame - Target frame to retrieve player's input for
         * @returns Input to use for a player on the given frame. May be predicted or "confirmed" (actual) input
         **/
-        const CharacterInput& GetInputForFrame(LoggerSingleton& logger, FrameType targetFrame) const {
+        CharacterInput GetInputForFrame(LoggerSingleton& logger, FrameType targetFrame) const {
             // Is target frame outside data that we've stored?
             if (targetFrame >= mNextFrameToStore) {
                 // Valid input IF trying to retrieve input within prediction window
                 if (!IsFrameOutsideOfGetRange(targetFrame)) {
-                    return GetPredictedPlayerInput();
+                    return GetPredictedPlayerInput(targetFrame);
                 }
 
                 // Otherwise invalid situation:
@@ -76,23 +98,72 @@ namespace ProjectNomad {
             return mConfirmedInputs.Get(offset);
         }
 
+        /**
+        * Identical to GetInputForFrame except that any predicted input handed out is remembered. This allows
+        * AddInput to later detect whether the prediction used for actual frame processing was incorrect.
+        * @param logger - Logger reference
+        * @param targetFrame - Target frame to retrieve player's input for, which is about to be processed
+        * @returns Input to use for a player on the given frame. May be predicted or "confirmed" (actual) input
+        **/
+        CharacterInput GetInputForFrameToProcess(LoggerSingleton& logger, FrameType targetFrame) {
+            CharacterInput result = GetInputForFrame(logger, targetFrame);
+
+            // Only need to remember actual predictions (and not out of range fallback values)
+            if (targetFrame >= mNextFrameToStore && !IsFrameOutsideOfGetRange(targetFrame)) {
+                PredictedInputRecord& predictionRecord = GetPredictionRecordForFrame(targetFrame);
+                predictionRecord.frame = targetFrame;
+                predictionRecord.predictedInput = result;
+            }
+
+            return result;
+        }
+
         FrameType GetLastStoredFrame() const {
             return mNextFrameToStore - 1;
         }
 
+        const InputPredictionStats& GetPredictionStats() const {
+            return mPredictionStats;
+        }
+
         // Useful to confirm if missing too many inputs to process the next frame and thus should gameplay "delay" (freeze)
         bool IsFrameOutsideOfGetRange(FrameType targetFrame) const {
             return targetFrame > GetMaxPredictionFrame();
         }
         
       private:
-        const CharacterInput& GetPredictedPlayerInput() const {
-            // Always predict that player will use the latest known input.
+        // Remembers which predicted input was used to process a not-yet-confirmed frame
+        struct PredictedInputRecord {
+            FrameType frame = std::numeric_limits<FrameType>::max(); // Max value represents "no prediction stored"
+            CharacterInput predictedInput = {};
+        };
 
-            // Using this prediction as piggybacking off of typical FGC rollback algo findings: Using latest known input
+        // Predictions are only ever made within the rollback window past the next frame to store, so one record per
+        //      possible predicted frame is enough (and older records are naturally overwritten or cleared)
+        PredictedInputRecord& GetPredictionRecordForFrame(FrameType targetFrame) {
+            return mPredictedInputs[targetFrame % RollbackStaticSettings::kMaxRollbackFrames];
+        }
+
+        CharacterInput GetPredictedPlayerInput(FrameType targetFrame) const {
+            // By default, predict that player will use the latest known input.
+            //  Using this prediction as piggybacking off of typical FGC rollback algo findings: Using latest known input
             //  will be accurate more often than not as player isn't really switching inputs that fast compared to how
             //  fast simulation is.
-            return mConfirmedInputs.Get(0);
+            //  However, some fields (like camera) change nearly every frame and thus may be configured otherwise.
+            
+            // Previous input only exists once at least 2 inputs are stored (as head is a default value before then)
+            const CharacterInput* previousInput = mNextFrameToStore >= 2 ? &mConfirmedInputs.Get(-1) : nullptr;
+            const FrameType framesAhead = targetFrame - GetLastStoredFrame();
+            CharacterInput result = InputPredictor::Predict(
+                mPredictionSettings, mConfirmedInputs.Get(0), previousInput, framesAhead
+            );
+
+            // Confirmed inputs are always quantized in multiplayer, so extrapolated predictions must be as well to
+            //      ever exactly match them
+            if (mShouldQuantizePredictions) {
+                CharacterInputQuantizer::Quantize(result);
+            }
+            return result;
         }
 
         FrameType GetMaxPredictionFrame() const {
@@ -116,7 +187,7 @@ namespace ProjectNomad {
             
             /// Sanity checks:
             // If target frame is outside intended window of inputs, then there's likely a higher level logic issue
-            FrameType maxIntendedStoredInputs = RollbackStaticSettings::kMaxRollbackFrames + 1;
+            FrameType maxIntendedStoredInputs = kInputBufferSize;
             if (offset > maxIntendedStoredInputs) {
                 logger.LogWarnMessage(
                     "Trying to retrieve inputs outside expected range! Given target frame: " + std::to_string(targetFrame)
@@ -126,7 +197,7 @@ namespace ProjectNomad {
                 return 0;
             }
             // If target frame is outside max rollback buffer window entirely, then there's a very serious issue (out of bounds)
-            if (offset > RollbackStaticSettings::kMaxRollbackFrames) {
+            if (offset >= kInputBufferSize) {
                 logger.LogWarnMessage(
                     "Offset is outside max buffer window! Target frame: " + std::to_string(targetFrame)
                     + ", offset: " + std::to_string(offset)
@@ -140,7 +211,18 @@ namespace ProjectNomad {
         }
 
         // Storage for "confirmed" (not predicted) inputs. Head represents latest input given (ie, mNextFrameToStore - 1)
-        RingBuffer<CharacterInput, RollbackStaticSettings::kOneMoreThanMaxRollbackFrames> mConfirmedInputs = {};
+        //      Note that this covers more than just the rollback window, as rolling back with a snapshot interval may
+        //      need to re-process frames before the rollback window too. Local player's inputs are also stored up to
+        //      input delay frames ahead of the latest processed frame.
+        static constexpr FrameType kInputBufferSize =
+            RollbackStaticSettings::kMaxFramesToResimulate + RollbackStaticSettings::kMaxInputDelay + 1;
+        RingBuffer<CharacterInput, kInputBufferSize> mConfirmedInputs = {};
         FrameType mNextFrameToStore = 1000; // Starting session should set this back to 0. Cheap way for enforcing session start
+        // Predicted inputs that were actually used for frame processing, for later misprediction detection
+        PredictedInputRecord mPredictedInputs[RollbackStaticSettings::kMaxRollbackFrames] = {};
+
+        InputPredictionSettings mPredictionSettings = {};
+        bool mShouldQuantizePredictions = false;
+        InputPredictionStats mPredictionStats = {};
     };
 }
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "RollbackSettings.h"
+#include "RollbackStallInfo.h"
+#include "GameCore/PlayerSpot.h"
+#include "Utilities/FrameType.h"
+#include "Utilities/Containers/FlexArray.h"
+#include "Utilities/Containers/RingBuffer.h"
+
+// Compile-time switch for rollback perf counters. Defaults to off, in which case RollbackManager never reads the
+//      clock for or otherwise touches its counters (all such calls are discarded via if constexpr).
+//      Define as 1 in the project's preprocessor definitions to enable.
+#ifndef NOMAD_ROLLBACK_PERF_COUNTERS
+#define NOMAD_ROLLBACK_PERF_COUNTERS 0
+#endif
+
+namespace ProjectNomad {
+    inline constexpr bool kRollbackPerfCountersEnabled = NOMAD_ROLLBACK_PERF_COUNTERS != 0;
+
+    // Each RollbackManager section that is timed. Count is not a valid value and only used for array sizing
+    enum class RollbackPerfTimer : uint8_t {
+        GenerateSnapshot,
+        RestoreSnapshot,
+        ProcessFrame,
+        ProcessFrameWithoutRendering,
+        Checksum,
+        Count
+    };
+
+    struct RollbackPerfCounterStaticSettings {
+        static constexpr uint32_t kTimerCount = static_cast<uint32_t>(RollbackPerfTimer::Count);
+        // Misprediction rollback + sync test rollback
+        static constexpr uint32_t kMaxRollbacksPerTick = 2;
+        // Depth == number of frames re-simulated, which includes any extra frames due to snapshot interval
+        static constexpr uint32_t kRollbackDepthHistogramSize = RollbackStaticSettings::kMaxFramesToResimulate + 1;
+        // Number of most recent ticks that rolling window totals cover. ~1 second at 60 ticks per second
+        static constexpr uint32_t kRollingWindowTicks = 60;
+    };
+
+    using RollbackPerfTimes = std::array<uint64_t, RollbackPerfCounterStaticSettings::kTimerCount>;
+    using RollbackDepthHistogram = std::array<uint64_t, RollbackPerfCounterStaticSettings::kRollbackDepthHistogramSize>;
+
+    /**
+    * Everything that happened during a single RollbackManager::OnTick call
+    **/
+    struct RollbackTickCounters {
+        // New frames processed, ie not counting re-simulated frames
+        FrameType framesProcessed = 0;
+        FrameType framesResimulated = 0;
+        FlexArray<FrameType, RollbackPerfCounterStaticSettings::kMaxRollbacksPerTick> rollbackDepths = {};
+
+        bool didStall = false;
+        FlexStallPlayerInfoArray stallWaitingOnPlayers = {};
+
+        RollbackPerfTimes timesInMicroSec = {};
+        uint64_t tickTimeInMicroSec = 0;
+    };
+
+    /**
+    * Sum of multiple ticks' counters, such as over the rolling window or the entire session
+    **/
+    struct RollbackPerfTotals {
+        uint64_t ticks = 0;
+        uint64_t framesProcessed = 0;
+        uint64_t framesResimulated = 0;
+        uint64_t rollbacks = 0;
+        RollbackDepthHistogram rollbackDepthHistogram = {};
+
+        uint64_t stallTicks = 0;
+        // Number of stalled ticks that waited on each player. A single tick may wait on multiple players
+        std::array<uint64_t, PlayerSpotHelpers::kMaxPlayerSpots> stallTicksPerPlayer = {};
+
+        RollbackPerfTimes timesInMicroSec = {};
+        uint64_t tickTimeInMicroSec = 0;
+
+        void Add(const RollbackTickCounters& tick) {
+            Accumulate(tick, 1);
+        }
+        void Remove(const RollbackTickCounters& tick) {
+            // Unsigned wraparound cancels out as every removed tick was previously added
+            Accumulate(tick, static_cast<uint64_t>(-1));
+        }
+
+        uint64_t GetTimeInMicroSec(RollbackPerfTimer timer) const {
+            return timesInMicroSec[static_cast<uint32_t>(timer)];
+        }
+
+      private:
+        void Accumulate(const RollbackTickCounters& tick, uint64_t sign) {
+            ticks += sign;
+            framesProcessed += sign * tick.framesProcessed;
+            framesResimulated += sign * tick.framesResimulated;
+            rollbacks += sign * tick.rollbackDepths.GetSize();
+            for (uint32_t i = 0; i < tick.rollbackDepths.GetSize(); i++) {
+                // Depth is validated before being recorded, so no need to check range here
+                rollbackDepthHistogram[tick.rollbackDepths.Get(i)] += sign;
+            }
+
+            if (tick.didStall) {
+                stallTicks += sign;
+                for (uint32_t i = 0; i < tick.stallWaitingOnPlayers.GetSize(); i++) {
+                    stallTicksPerPlayer[static_cast<uint32_t>(tick.stallWaitingOnPlayers.Get(i).waitingOnPlayer)] += sign;
+                }
+            }
+
+            for (uint32_t i = 0; i < RollbackPerfCounterStaticSettings::kTimerCount; i++) {
+                timesInMicroSec[i] += sign * tick.timesInMicroSec[i];
+            }
+            tickTimeInMicroSec += sign * tick.tickTimeInMicroSec;
+        }
+    };
+
+    /**
+    * Per-tick and rolling window counters for where RollbackManager::OnTick spends its time.
+    * Only updated if NOMAD_ROLLBACK_PERF_COUNTERS is enabled, otherwise all values simply stay at zero.
+    *
+    * Intended to be queried by the game (eg, for an on-screen debug overlay) or dumped via ToJson (eg, for soak tests).
+    * Note that timings are wall clock time of the RollbackUser calls themselves, so they include any work the game
+    * does within those calls. Checksum time only covers checksums calculated outside of snapshot generation.
+    **/
+    class RollbackPerfCounters {
+      public:
+        void Reset() {
+            mCurrentTick = {};
+            mLastTick = {};
+            mRecentTicks = {};
+            mRecentTickCount = 0;
+            mWindowTotals = {};
+            mSessionTotals = {};
+        }
+
+        void BeginTick() {
+            mCurrentTick = {};
+        }
+        /**
+        * Finishes current tick, adding it to both the rolling window and session totals
+        * @param tickTimeInMicroSec - total time spent in the tick
+        **/
+        void EndTick(uint64_t tickTimeInMicroSec) {
+            mCurrentTick.tickTimeInMicroSec = tickTimeInMicroSec;
+
+            // Evict oldest tick from window once full, as it's about to be overwritten
+            if (mRecentTickCount == RollbackPerfCounterStaticSettings::kRollingWindowTicks) {
+                mWindowTotals.Remove(mRecentTicks.Get(1));
+            }
+            else {
+                mRecentTickCount++;
+            }
+            mRecentTicks.Add(mCurrentTick);
+            mWindowTotals.Add(mCurrentTick);
+            mSessionTotals.Add(mCurrentTick);
+
+            mLastTick = mCurrentTick;
+        }
+
+        void AddTime(RollbackPerfTimer timer, uint64_t timeInMicroSec) {
+            mCurrentTick.timesInMicroSec[static_cast<uint32_t>(timer)] += timeInMicroSec;
+        }
+        void OnFramesProcessed(FrameType numOfFrames) {
+            mCurrentTick.framesProcessed += numOfFrames;
+        }
+        void OnRollback(FrameType numOfFramesToResimulate) {
+            mCurrentTick.framesResimulated += numOfFramesToResimulate;
+            if (numOfFramesToResimulate < RollbackPerfCounterStaticSettings::kRollbackDepthHistogramSize) {
+                mCurrentTick.rollbackDepths.Add(numOfFramesToResimulate);
+            }
+        }
+        void OnStall(const RollbackStallInfo& stallInfo) {
+            mCurrentTick.didStall = true;
+            mCurrentTick.stallWaitingOnPlayers = stallInfo.waitingOnPlayers;
+        }
+
+        const RollbackTickCounters& GetLastTick() const {
+            return mLastTick;
+        }
+        // Totals over the last kRollingWindowTicks ticks (or fewer if session just started)
+        const RollbackPerfTotals& GetWindowTotals() const {
+            return mWindowTotals;
+        }
+        const RollbackPerfTotals& GetSessionTotals() const {
+            return mSessionTotals;
+        }
+
+        /**
+        * Dumps all counters as a single JSON object with "lastTick", "window", and "session" members
+        * @returns JSON string
+        **/
+        std::string ToJson() const {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+            writer.StartObject();
+            writer.Key("lastTick");
+            WriteTick(writer, mLastTick);
+            writer.Key("window");
+            WriteTotals(writer, mWindowTotals);
+            writer.Key("session");
+            WriteTotals(writer, mSessionTotals);
+            writer.EndObject();
+
+            return buffer.GetString();
+        }
+
+      private:
+        using JsonWriter = rapidjson::Writer<rapidjson::StringBuffer>;
+
+        static const char* GetTimerName(uint32_t timerIndex) {
+            switch (static_cast<RollbackPerfTimer>(timerIndex)) {
+                case RollbackPerfTimer::GenerateSnapshot:
+                    return "generateSnapshot";
+                case RollbackPerfTimer::RestoreSnapshot:
+                    return "restoreSnapshot";
+                case RollbackPerfTimer::ProcessFrame:
+                    return "processFrame";
+                case RollbackPerfTimer::ProcessFrameWithoutRendering:
+                    return "processFrameWithoutRendering";
+                case RollbackPerfTimer::Checksum:
+                    return "checksum";
+                default:
+                    return "unknown";
+            }
+        }
+
+        static void WriteTimes(JsonWriter& writer, const RollbackPerfTimes& timesInMicroSec, uint64_t tickTimeInMicroSec) {
+            writer.Key("timesInMicroSec");
+            writer.StartObject();
+            for (uint32_t i = 0; i < RollbackPerfCounterStaticSettings::kTimerCount; i++) {
+                writer.Key(GetTimerName(i));
+                writer.Uint64(timesInMicroSec[i]);
+            }
+            writer.Key("tick");
+            writer.Uint64(tickTimeInMicroSec);
+            writer.EndObject();
+        }
+
+        static void WriteTick(JsonWriter& writer, const RollbackTickCounters& tick) {
+            writer.StartObject();
+            writer.Key("framesProcessed");
+            writer.Uint(tick.framesProcessed);
+            writer.Key("framesResimulated");
+            writer.Uint(tick.framesResimulated);
+
+            writer.Key("rollbackDepths");
+            writer.StartArray();
+            for (uint32_t i = 0; i < tick.rollbackDepths.GetSize(); i++) {
+                writer.Uint(tick.rollbackDepths.Get(i));
+            }
+            writer.EndArray();
+
+            writer.Key("stalled");
+            writer.Bool(tick.didStall);
+            writer.Key("stallWaitingOnPlayers");
+            writer.StartArray();
+            for (uint32_t i = 0; i < tick.stallWaitingOnPlayers.GetSize(); i++) {
+                const RollbackStallPlayerInfo& playerInfo = tick.stallWaitingOnPlayers.Get(i);
+                writer.StartObject();
+                writer.Key("playerSpot");
+                writer.Uint(static_cast<uint32_t>(playerInfo.waitingOnPlayer));
+                writer.Key("lastFrameReceived");
+                writer.Uint(playerInfo.lastFrameReceived);
+                writer.EndObject();
+            }
+            writer.EndArray();
+
+            WriteTimes(writer, tick.timesInMicroSec, tick.tickTimeInMicroSec);
+            writer.EndObject();
+        }
+
+        static void WriteTotals(JsonWriter& writer, const RollbackPerfTotals& totals) {
+            writer.StartObject();
+            writer.Key("ticks");
+            writer.Uint64(totals.ticks);
+            writer.Key("framesProcessed");
+            writer.Uint64(totals.framesProcessed);
+            writer.Key("framesResimulated");
+            writer.Uint64(totals.framesResimulated);
+            writer.Key("rollbacks");
+            writer.Uint64(totals.rollbacks);
+
+            // Index == rollback depth
+            writer.Key("rollbackDepthHistogram");
+            writer.StartArray();
+            for (uint64_t count : totals.rollbackDepthHistogram) {
+                writer.Uint64(count);
+            }
+            writer.EndArray();
+
+            writer.Key("stallTicks");
+            writer.Uint64(totals.stallTicks);
+            // Index == player spot
+            writer.Key("stallTicksPerPlayer");
+            writer.StartArray();
+            for (uint64_t count : totals.stallTicksPerPlayer) {
+                writer.Uint64(count);
+            }
+            writer.EndArray();
+
+            WriteTimes(writer, totals.timesInMicroSec, totals.tickTimeInMicroSec);
+            writer.EndObject();
+        }
+
+        RollbackTickCounters mCurrentTick = {};
+        RollbackTickCounters mLastTick = {};
+
+        RingBuffer<RollbackTickCounters, RollbackPerfCounterStaticSettings::kRollingWindowTicks> mRecentTicks = {};
+        uint32_t mRecentTickCount = 0;
+        RollbackPerfTotals mWindowTotals = {};
+        RollbackPerfTotals mSessionTotals = {};
+    };
+}
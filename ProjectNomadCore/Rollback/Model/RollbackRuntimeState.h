@@ -18,6 +18,9 @@ namespace ProjectNomad {
     struct RollbackRuntimeState {
         // Should always be one less than next frame to process (including overflow)
         FrameType lastProcessedFrame = std::numeric_limits<FrameType>::max();
+        // Earliest frame which was processed with an incorrect input prediction, and thus needs to be rolled back to
+        //      on next update. Max value represents no known misprediction.
+        FrameType earliestMispredictedFrame = std::numeric_limits<FrameType>::max();
 
         RollbackDesyncChecker desyncChecker = {};
         RollbackInputManager inputManager = {};
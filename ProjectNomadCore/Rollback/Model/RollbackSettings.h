@@ -2,6 +2,9 @@
 
 #include "Context/FrameRate.h"
 #include "GameCore/PlayerSpot.h"
+#include "Rollback/Model/InputDelayTuningSettings.h"
+#include "Rollback/Model/InputPredictionSettings.h"
+#include "Utilities/ChecksumHasher.h"
 #include "Utilities/FrameType.h"
 
 namespace ProjectNomad {
@@ -16,12 +19,37 @@ namespace ProjectNomad {
         
         bool useSyncTest = false;
         FrameType syncTestFrames = 2;
+        // If true, sync test re-simulation happens on a background thread with a separate RollbackUser (see
+        //      RollbackManager::SetAsyncSyncTestUser) rather than rolling back the game itself every frame.
+        //      Tests are skipped while the previous test is still running, so not every frame may be tested.
+        bool useAsyncSyncTest = false;
 
         // If this is negative then "negative input delay" feature will be used.
         // "Negative input delay" best explained by this: https://medium.com/@yosispring/input-buffering-action-canceling-and-also-forbidden-knowledge-47a3f8a95151
         // In short, game will predict local player's inputs for number of negative input frames, which is useful for
         // 
+        // Positive delay is only applied in multiplayer sessions, as it only exists to hide network latency.
+        //      Local inputs are then used this many frames after they're retrieved, so remote players receive them
+        //      before they're needed more often. Negative input delay is not yet supported.
         int localInputDelay = 3;
+        // Optionally adjust local input delay during session, starting from localInputDelay
+        InputDelayTuningSettings inputDelayTuning = {};
+
+        // Only store a snapshot every this many frames, rather than every single frame. Rolling back then restores
+        //      the nearest earlier snapshot and re-processes (without rendering) any extra frames from there.
+        //      Trades snapshot generation cost for extra re-simulated frames per rollback, so best value depends on
+        //      cost of GenerateSnapshot vs cost of a frame update. See RollbackManager::GetSnapshotStats.
+        //      Expected to be in range [1, RollbackStaticSettings::kMaxSnapshotInterval]. 1 = every frame (default)
+        FrameType snapshotInterval = 1;
+
+        // How to predict inputs not yet received from remote players, and which mispredicted fields cause a rollback.
+        //      See RollbackManager::GetInputPredictionStats for tuning this.
+        InputPredictionSettings inputPrediction = {};
+
+        // After a desync is detected, exchange checksum trees with host to find the diverging type + entity (see
+        //      RollbackDesyncLocalizer). Requires snapshot type to SupportsDesyncLocalization, and costs a snapshot copy
+        //      whenever a validation checksum is sent.
+        bool useDesyncLocalization = false;
 
         // Additional pure debug settings
         bool logSyncTestChecksums = false;
@@ -47,6 +75,12 @@ namespace ProjectNomad {
         //      This may be useful for, say, verified (post-rollback window) frame processing. Such as desync detection.
         static constexpr FrameType kTwoMoreThanMaxRollbackFrames = kOneMoreThanMaxRollbackFrames + 1;
 
+        // Max supported RollbackSettings::snapshotInterval.
+        //      Rolling back may need to restore up to (interval - 1) frames before the earliest frame to re-process,
+        //      so inputs are stored for that many more frames than just the rollback window.
+        static constexpr FrameType kMaxSnapshotInterval = 8;
+        static constexpr FrameType kMaxFramesToResimulate = kMaxRollbackFrames + kMaxSnapshotInterval - 1;
+
         // Easy access to calculation for max "buffer" windows for all relevant rollback windows
         // Size includes rollback window + positive input delay max value + 1 for "current" frame
         // (Note that no need to explicitly account for negative input delay
@@ -65,5 +99,8 @@ namespace ProjectNomad {
         //          either store multiple checksums (if using UDP + receive out of order) or to accept throwing out older
         //          checksums if packets come in out of order or even get dropped entirely.
         static constexpr FrameType kDesyncDetectionFrequency = FrameRate::FromSeconds(fp{1}); // No significant thought put into 1 second frequency
+        // Algorithm for snapshot checksums (eg, RegistrySnapshot), which every peer must agree on.
+        //      Switch to Crc32Compatible to compare against checksums from builds before ChecksumHasher existed
+        static constexpr ChecksumAlgorithm kChecksumAlgorithm = ChecksumAlgorithm::Crc32c;
     }; 
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Running totals for snapshot + rollback costs over a session.
+    * Intended for tuning RollbackSettings::snapshotInterval per game mode: Higher intervals store (and thus generate)
+    * fewer snapshots, but each rollback needs to re-process extra frames from the nearest older snapshot.
+    **/
+    struct RollbackSnapshotStats {
+        uint64_t snapshotsStored = 0;
+        // Frames which would have had a snapshot stored if snapshot interval was 1
+        uint64_t snapshotsSkipped = 0;
+        // Only measured if NOMAD_ROLLBACK_PERF_COUNTERS is enabled, as otherwise stays at zero
+        uint64_t totalSnapshotGenerationTimeInMicroSec = 0;
+
+        uint64_t rollbacks = 0;
+        // All frames re-processed due to rollbacks, including extra frames below
+        uint64_t framesResimulated = 0;
+        // Frames re-processed only because nearest stored snapshot was older than the frame that needed re-processing
+        uint64_t extraFramesResimulated = 0;
+
+        // Number of snapshots backing the rollback window at last update, with size of each stored snapshot.
+        //      Note that snapshot buffer capacity itself is fixed at compile time. This instead shows how many
+        //      snapshots are actually in use, such as for deciding whether a smaller buffer would suffice.
+        uint32_t snapshotsInRollbackWindow = 0;
+        uint64_t bytesPerSnapshot = 0;
+
+        uint64_t GetAverageSnapshotGenerationTimeInMicroSec() const {
+            return snapshotsStored > 0 ? totalSnapshotGenerationTimeInMicroSec / snapshotsStored : 0;
+        }
+        // Estimated time saved by not generating skipped snapshots, to compare against cost of extra re-simulated frames
+        uint64_t GetEstimatedSnapshotTimeSavedInMicroSec() const {
+            return snapshotsSkipped * GetAverageSnapshotGenerationTimeInMicroSec();
+        }
+        uint64_t GetSnapshotBytesInRollbackWindow() const {
+            return snapshotsInRollbackWindow * bytesPerSnapshot;
+        }
+    };
+}
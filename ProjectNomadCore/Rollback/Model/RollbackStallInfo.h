@@ -2,6 +2,7 @@
 
 #include "GameCore/PlayerSpot.h"
 #include "Utilities/FrameType.h"
+#include "Utilities/Containers/FlexArray.h"
 
 namespace ProjectNomad {
     struct RollbackStallPlayerInfo {
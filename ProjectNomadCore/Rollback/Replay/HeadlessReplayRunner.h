@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ReplayReader.h"
+#include "ReplayRunReport.h"
+#include "Rollback/RollbackUser.h"
+#include "Rollback/Managers/RollbackSnapshotManager.h"
+#include "Utilities/LoggerSingleton.h"
+#include "Utilities/SharedUtilities.h"
+
+namespace ProjectNomad {
+    struct HeadlessReplayRunnerSettings {
+        // Worker threads used by RunBatch. 0 = one per hardware thread
+        uint32_t maxThreads = 0;
+        // Checksum is recorded every Nth frame, as generating a snapshot usually costs more than simulating a frame.
+        //      Final frame's checksum is always recorded regardless
+        FrameType checksumInterval = 1;
+    };
+
+    /**
+    * Plays back replays (see ReplayReader) as fast as the simulation allows, without any RollbackManager, time
+    * manager, rendering or network involved. Intended for verifying determinism across builds, by playing back a
+    * corpus of recorded matches and comparing the resulting checksum traces against traces from a known good build.
+    *
+    * Each replay gets its own freshly created RollbackUser (and thus its own gameplay state) from the user factory,
+    * which is then driven directly with each frame's inputs via ProcessFrameWithoutRendering. Checksums come from
+    * snapshots generated by that user, so they match RollbackManager's validation checksums for the same frame.
+    *
+    * Threading expectations for RunBatch:
+    * - User factory is called from worker threads, so must be thread safe. Created users must not share any mutable
+    *   state (eg, singletons) with each other
+    * - Each replay logs into its own LoggerSingleton, which are then all forwarded to the caller's logger once every
+    *   replay is done, as LoggerSingleton is not expected to be thread safe. Users are expected to log into the
+    *   logger given to the user factory, rather than the LoggerSingleton singleton
+    * @tparam SnapshotType - game's snapshot type, same as RollbackManager
+    **/
+    template <typename SnapshotType>
+    class HeadlessReplayRunner {
+      public:
+        // Creates user at initial game state for given replay, which should log into the given logger. Returning
+        //      nullptr fails that replay
+        using UserFactory = std::function<std::unique_ptr<RollbackUser<SnapshotType>>(LoggerSingleton& logger,
+                                                                                      const ReplayHeader& header)>;
+
+        explicit HeadlessReplayRunner(UserFactory userFactory, const HeadlessReplayRunnerSettings& settings = {})
+            : mUserFactory(std::move(userFactory)), mSettings(settings) {
+            if (mSettings.checksumInterval == 0) {
+                mSettings.checksumInterval = 1;
+            }
+        }
+
+        /**
+        * Plays back a single replay on the calling thread
+        * @param logger - logger for any issues, which is also given to the user factory
+        * @param replayPath - path of replay file
+        * @returns report of replay, including checksum trace
+        **/
+        ReplayRunReport RunReplay(LoggerSingleton& logger, const std::string& replayPath) const {
+            ReplayRunReport result = {};
+            result.replayPath = replayPath;
+
+            ReplayReader reader;
+            if (!reader.Open(logger, replayPath)) {
+                return result;
+            }
+            std::unique_ptr<RollbackUser<SnapshotType>> user = mUserFactory(logger, reader.GetHeader());
+            if (!user) {
+                logger.LogWarnMessage("User factory didn't create a user for replay: " + replayPath);
+                return result;
+            }
+
+            result.firstFrame = reader.GetFirstFrame();
+            result.didComplete = true;
+            const uint64_t startTime = SharedUtilities::getTimeInMicroseconds();
+
+            SnapshotType snapshot = {};
+            PlayerInputsForFrame inputs;
+            FrameType frame = reader.GetFirstFrame();
+            for (; frame < reader.GetEndFrame(); frame++) {
+                if ((frame - result.firstFrame) % mSettings.checksumInterval == 0) {
+                    RecordChecksum(*user, frame, snapshot, result);
+                }
+
+                if (!reader.GetInputsForFrame(logger, frame, inputs)) {
+                    result.didComplete = false; // Reader already logged which chunk is corrupted
+                    break;
+                }
+                user->ProcessFrameWithoutRendering(frame, inputs);
+                result.framesSimulated++;
+            }
+            if (result.checksumTrace.empty() || result.checksumTrace.back().frame != frame) {
+                RecordChecksum(*user, frame, snapshot, result); // State after final frame
+            }
+
+            result.runTimeInMicroSec = SharedUtilities::getTimeInMicroseconds() - startTime;
+            return result;
+        }
+
+        /**
+        * Plays back every given replay across a pool of worker threads, with each replay fully isolated from the others
+        * @param logger - logger that every replay's issues are forwarded to after all replays are done
+        * @param replayPaths - paths of replay files
+        * @returns report of every replay (in same order as given) plus overall throughput
+        **/
+        ReplayBatchReport RunBatch(LoggerSingleton& logger, const std::vector<std::string>& replayPaths) const {
+            ReplayBatchReport result = {};
+            result.replays.resize(replayPaths.size());
+            std::vector<LoggerSingleton> replayLoggers(replayPaths.size()); // Index matches replayPaths
+
+            uint32_t numThreads = mSettings.maxThreads > 0 ? mSettings.maxThreads : std::thread::hardware_concurrency();
+            numThreads = std::clamp(numThreads, 1u, std::max(1u, static_cast<uint32_t>(replayPaths.size())));
+            result.threadsUsed = numThreads;
+
+            const uint64_t startTime = SharedUtilities::getTimeInMicroseconds();
+            // Replays vary a lot in length, so workers take the next replay when done rather than a fixed share each
+            std::atomic<size_t> nextReplayIndex = 0;
+            auto workerLoop = [&] {
+                for (size_t i = nextReplayIndex.fetch_add(1); i < replayPaths.size(); i = nextReplayIndex.fetch_add(1)) {
+                    result.replays[i] = RunReplay(replayLoggers[i], replayPaths[i]);
+                }
+            };
+
+            std::vector<std::thread> workers;
+            for (uint32_t i = 1; i < numThreads; i++) {
+                workers.emplace_back(workerLoop);
+            }
+            workerLoop(); // Calling thread would otherwise just sit idle
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+            result.wallTimeInMicroSec = SharedUtilities::getTimeInMicroseconds() - startTime;
+
+            for (LoggerSingleton& replayLogger : replayLoggers) {
+                std::queue<DebugMessage>& messages = replayLogger.getDebugMessages();
+                while (!messages.empty()) {
+                    logger.addDebugMessage(messages.front());
+                    messages.pop();
+                }
+            }
+            return result;
+        }
+
+      private:
+        static void RecordChecksum(RollbackUser<SnapshotType>& user,
+                                   FrameType frame,
+                                   SnapshotType& snapshot,
+                                   ReplayRunReport& result) {
+            if constexpr (GeneratesSnapshotInPlace<SnapshotType>) {
+                snapshot.ClearCachedChecksum(); // Reused snapshot is about to change
+            }
+            else {
+                snapshot = {};
+            }
+            user.GenerateSnapshot(frame, snapshot);
+            result.checksumTrace.push_back({frame, snapshot.GetChecksum()});
+        }
+
+        UserFactory mUserFactory;
+        HeadlessReplayRunnerSettings mSettings;
+    };
+}
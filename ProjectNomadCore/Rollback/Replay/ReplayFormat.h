@@ -0,0 +1,425 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Input/PlayerInputsForFrame.h"
+#include "Rollback/Model/RollbackSettings.h"
+#include "Utilities/BitStream.h"
+#include "Utilities/ChecksumHasher.h"
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    /**
+    * Everything needed (alongside the inputs themselves) to replay a session
+    **/
+    struct ReplayHeader {
+        uint64_t sessionSeed = 0;
+        RollbackSettings rollbackSettings = {};
+    };
+
+    /**
+    * Fixed size header in front of every chunk, so that chunks can be indexed without decoding their payload
+    **/
+    struct ReplayChunkInfo {
+        FrameType firstFrame = 0;
+        FrameType numFrames = 0;
+        uint32_t payloadSizeInBytes = 0;
+        uint32_t payloadChecksum = 0; // CRC32 of payload, as replays are often kept (and copied around) for a long time
+
+        FrameType GetEndFrame() const { // Exclusive
+            return firstFrame + numFrames;
+        }
+    };
+
+    /**
+    * Binary replay file format shared by ReplayWriter and ReplayReader. All multi-byte values are written via
+    * BitWriter, so files are identical regardless of platform endianness.
+    *
+    * File layout:
+    *   - File header prefix: magic (4 bytes) + format version (8 bits) + header body size in bytes (32 bits)
+    *   - Header body (bit packed): session seed + RollbackSettings, see EncodeFileHeader
+    *   - Chunks until end of file, each being:
+    *       - Chunk header: first frame + number of frames + payload size + payload CRC32 (32 bits each)
+    *       - Payload (bit packed), which only depends on itself so each chunk can be decoded on its own:
+    *           - Runs of identical frames until number of frames is reached. Each run is:
+    *               - Run length minus 1 (variable length), as inputs are usually held for many frames
+    *               - Each player's input delta encoded vs that player's input in the prior run (or default input for
+    *                 first run), see EncodeInput
+    *
+    * Unlike InputUpdateMessageEncoding, inputs are never quantized as replays must reproduce simulation exactly.
+    **/
+    class ReplayFormat {
+      public:
+        ReplayFormat() = delete;
+
+        // Increase whenever file layout changes. Old replays aren't expected to stay playable anyways, as any
+        //      gameplay change breaks determinism with previously recorded inputs
+        static constexpr uint8_t kFormatVersion = 2;
+        static constexpr uint8_t kMagic[4] = {'N', 'M', 'R', 'P'};
+        static constexpr size_t kFileHeaderPrefixSizeInBytes = 9;
+        static constexpr size_t kChunkHeaderSizeInBytes = 16;
+        // Far more than any writer uses, but small enough that a corrupted chunk header can't cause a huge allocation
+        static constexpr FrameType kMaxFramesPerChunk = 1 << 14; // About 4.5 minutes at 60fps
+
+        /**
+        * Encodes file header prefix + body
+        * @param header - header to encode
+        * @param result - buffer to write encoded header to. Existing contents are replaced
+        **/
+        static void EncodeFileHeader(const ReplayHeader& header, std::vector<uint8_t>& result) {
+            std::vector<uint8_t> body;
+            EncodeFileHeaderBody(header, body);
+
+            BitWriter writer(result);
+            for (uint8_t magicByte : kMagic) {
+                writer.WriteBits(magicByte, 8);
+            }
+            writer.WriteBits(kFormatVersion, 8);
+            writer.WriteBits(body.size(), 32);
+            result.insert(result.end(), body.begin(), body.end());
+        }
+
+        /**
+        * Decodes file header prefix
+        * @param data - first kFileHeaderPrefixSizeInBytes bytes of file
+        * @param bodySizeInBytes - size of header body which follows. Only valid if returned true
+        * @returns true if prefix is from a replay file with the current format version, false otherwise
+        **/
+        static bool DecodeFileHeaderPrefix(std::span<const uint8_t> data, uint32_t& bodySizeInBytes) {
+            if (data.size() < kFileHeaderPrefixSizeInBytes) {
+                return false;
+            }
+
+            BitReader reader(data.data(), data.size());
+            bool isMagicCorrect = true;
+            for (uint8_t magicByte : kMagic) {
+                isMagicCorrect &= reader.ReadBits(8) == magicByte;
+            }
+            const bool isExpectedVersion = reader.ReadBits(8) == kFormatVersion;
+            bodySizeInBytes = static_cast<uint32_t>(reader.ReadBits(32));
+
+            return isMagicCorrect && isExpectedVersion;
+        }
+
+        /**
+        * Decodes file header body
+        * @param data - header body, ie the bytes after prefix
+        * @param result - decoded header. Only valid if returned true
+        * @returns true if body was valid, false otherwise (eg, truncated or out of range values)
+        **/
+        static bool DecodeFileHeaderBody(std::span<const uint8_t> data, ReplayHeader& result) {
+            result = {};
+            BitReader reader(data.data(), data.size());
+            result.sessionSeed = reader.ReadVarUnsigned();
+
+            RollbackSettings& settings = result.rollbackSettings;
+            settings.totalPlayers = static_cast<uint8_t>(reader.ReadVarUnsigned());
+            if (!TryReadPlayerSpot(reader, settings.localPlayerSpot) || !TryReadPlayerSpot(reader, settings.hostPlayerSpot)) {
+                return false;
+            }
+            settings.useSyncTest = reader.ReadBool();
+            settings.syncTestFrames = static_cast<FrameType>(reader.ReadVarUnsigned());
+            settings.useAsyncSyncTest = reader.ReadBool();
+            settings.localInputDelay = static_cast<int>(reader.ReadVarSigned());
+
+            InputDelayTuningSettings& tuning = settings.inputDelayTuning;
+            tuning.isEnabled = reader.ReadBool();
+            tuning.minInputDelay = static_cast<FrameType>(reader.ReadVarUnsigned());
+            tuning.maxInputDelay = static_cast<FrameType>(reader.ReadVarUnsigned());
+            tuning.deepRollbackFrames = static_cast<FrameType>(reader.ReadVarUnsigned());
+            tuning.deepRollbacksToIncreaseDelay = static_cast<uint32_t>(reader.ReadVarUnsigned());
+            tuning.evaluationWindowFrames = static_cast<FrameType>(reader.ReadVarUnsigned());
+
+            settings.snapshotInterval = static_cast<FrameType>(reader.ReadVarUnsigned());
+            for (InputFieldPredictionPolicy& policy : settings.inputPrediction.fieldPolicies) {
+                const uint64_t method = reader.ReadVarUnsigned();
+                if (method > static_cast<uint8_t>(InputPredictionMethod::Neutral)) {
+                    return false;
+                }
+                policy.method = static_cast<InputPredictionMethod>(method);
+                policy.countsForMisprediction = reader.ReadBool();
+            }
+            settings.useDesyncLocalization = reader.ReadBool();
+
+            settings.logSyncTestChecksums = reader.ReadBool();
+            settings.logChecksumForEveryStoredFrameSnapshot = reader.ReadBool();
+
+            return !reader.HasReadPastEnd() && reader.GetBytesRead() == data.size();
+        }
+
+        static void EncodeChunkHeader(const ReplayChunkInfo& chunkInfo, std::vector<uint8_t>& result) {
+            BitWriter writer(result);
+            writer.WriteBits(chunkInfo.firstFrame, 32);
+            writer.WriteBits(chunkInfo.numFrames, 32);
+            writer.WriteBits(chunkInfo.payloadSizeInBytes, 32);
+            writer.WriteBits(chunkInfo.payloadChecksum, 32);
+        }
+        static bool DecodeChunkHeader(std::span<const uint8_t> data, ReplayChunkInfo& result) {
+            if (data.size() < kChunkHeaderSizeInBytes) {
+                return false;
+            }
+
+            BitReader reader(data.data(), data.size());
+            result.firstFrame = static_cast<FrameType>(reader.ReadBits(32));
+            result.numFrames = static_cast<FrameType>(reader.ReadBits(32));
+            result.payloadSizeInBytes = static_cast<uint32_t>(reader.ReadBits(32));
+            result.payloadChecksum = static_cast<uint32_t>(reader.ReadBits(32));
+            return result.numFrames > 0 && result.numFrames <= kMaxFramesPerChunk;
+        }
+
+        /**
+        * Encodes a full chunk (header + payload) of consecutive frames
+        * @param firstFrame - frame that first inputs are for
+        * @param frames - inputs for each frame. Every frame is expected to have the same number of players, and
+        *                 there's expected to be no more than kMaxFramesPerChunk frames
+        * @param payloadBuffer - scratch buffer for payload, passed in so that capacity is reused between chunks
+        * @param result - buffer to write encoded chunk to. Existing contents are replaced
+        **/
+        static void EncodeChunk(FrameType firstFrame,
+                                std::span<const PlayerInputsForFrame> frames,
+                                std::vector<uint8_t>& payloadBuffer,
+                                std::vector<uint8_t>& result) {
+            BitWriter writer(payloadBuffer);
+            PlayerInputsForFrame previousFrame = {};
+            for (size_t i = 0; i < frames.size();) {
+                const PlayerInputsForFrame& currentFrame = frames[i];
+
+                size_t runLength = 1;
+                while (i + runLength < frames.size() && AreFramesEqual(frames[i + runLength], currentFrame)) {
+                    runLength++;
+                }
+                writer.WriteVarUnsigned(runLength - 1);
+
+                for (uint32_t player = 0; player < currentFrame.GetSize(); player++) {
+                    const CharacterInput& previousInput = player < previousFrame.GetSize() ? previousFrame.Get(player) : CharacterInput{};
+                    EncodeInput(writer, previousInput, currentFrame.Get(player));
+                }
+
+                previousFrame = currentFrame;
+                i += runLength;
+            }
+
+            ReplayChunkInfo chunkInfo;
+            chunkInfo.firstFrame = firstFrame;
+            chunkInfo.numFrames = static_cast<FrameType>(frames.size());
+            chunkInfo.payloadSizeInBytes = static_cast<uint32_t>(payloadBuffer.size());
+            chunkInfo.payloadChecksum = CalculatePayloadChecksum(payloadBuffer.data(), payloadBuffer.size());
+            EncodeChunkHeader(chunkInfo, result);
+            result.insert(result.end(), payloadBuffer.begin(), payloadBuffer.end());
+        }
+
+        /**
+        * Decodes a chunk's payload
+        * @param chunkInfo - header of chunk being decoded
+        * @param payload - chunk's payload
+        * @param totalPlayers - number of players in each frame, from file header
+        * @param result - inputs for each frame in chunk. Existing contents are replaced but capacity is reused
+        * @returns true if payload was valid, false otherwise (eg, corrupted or truncated data)
+        **/
+        static bool DecodeChunkPayload(const ReplayChunkInfo& chunkInfo,
+                                       std::span<const uint8_t> payload,
+                                       uint8_t totalPlayers,
+                                       std::vector<PlayerInputsForFrame>& result) {
+            result.clear();
+            if (payload.size() != chunkInfo.payloadSizeInBytes ||
+                CalculatePayloadChecksum(payload.data(), payload.size()) != chunkInfo.payloadChecksum) {
+                return false;
+            }
+            if (totalPlayers > PlayerInputsForFrame::GetMaxSize()) {
+                return false;
+            }
+
+            BitReader reader(payload.data(), payload.size());
+            PlayerInputsForFrame previousFrame = {};
+            for (uint8_t player = 0; player < totalPlayers; player++) {
+                previousFrame.Add({});
+            }
+
+            while (result.size() < chunkInfo.numFrames) {
+                const uint64_t runLength = reader.ReadVarUnsigned() + 1;
+                if (reader.HasReadPastEnd() || runLength > chunkInfo.numFrames - result.size()) {
+                    return false;
+                }
+
+                PlayerInputsForFrame currentFrame = {};
+                for (uint8_t player = 0; player < totalPlayers; player++) {
+                    CharacterInput input;
+                    if (!DecodeInput(reader, previousFrame.Get(player), input)) {
+                        return false;
+                    }
+                    currentFrame.Add(input);
+                }
+
+                result.insert(result.end(), runLength, currentFrame);
+                previousFrame = currentFrame;
+            }
+
+            return !reader.HasReadPastEnd() && reader.GetBytesRead() == payload.size();
+        }
+
+      private:
+        static constexpr uint32_t kUIChoiceBits = 8;
+        static constexpr uint32_t kCommandBits = static_cast<uint32_t>(InputCommand::ENUM_COUNT);
+
+        // Stays plain CRC-32 regardless of snapshot checksum algorithm, so file format never depends on that choice
+        static uint32_t CalculatePayloadChecksum(const uint8_t* payload, size_t sizeInBytes) {
+            ChecksumHasher hasher(ChecksumAlgorithm::Crc32Compatible);
+            hasher.AddBytes(payload, sizeInBytes);
+            return hasher.GetResult();
+        }
+
+        static void EncodeFileHeaderBody(const ReplayHeader& header, std::vector<uint8_t>& result) {
+            BitWriter writer(result);
+            writer.WriteVarUnsigned(header.sessionSeed);
+
+            const RollbackSettings& settings = header.rollbackSettings;
+            writer.WriteVarUnsigned(settings.totalPlayers);
+            writer.WriteVarUnsigned(static_cast<uint8_t>(settings.localPlayerSpot));
+            writer.WriteVarUnsigned(static_cast<uint8_t>(settings.hostPlayerSpot));
+            writer.WriteBool(settings.useSyncTest);
+            writer.WriteVarUnsigned(settings.syncTestFrames);
+            writer.WriteBool(settings.useAsyncSyncTest);
+            writer.WriteVarSigned(settings.localInputDelay);
+
+            const InputDelayTuningSettings& tuning = settings.inputDelayTuning;
+            writer.WriteBool(tuning.isEnabled);
+            writer.WriteVarUnsigned(tuning.minInputDelay);
+            writer.WriteVarUnsigned(tuning.maxInputDelay);
+            writer.WriteVarUnsigned(tuning.deepRollbackFrames);
+            writer.WriteVarUnsigned(tuning.deepRollbacksToIncreaseDelay);
+            writer.WriteVarUnsigned(tuning.evaluationWindowFrames);
+
+            writer.WriteVarUnsigned(settings.snapshotInterval);
+            for (const InputFieldPredictionPolicy& policy : settings.inputPrediction.fieldPolicies) {
+                writer.WriteVarUnsigned(static_cast<uint8_t>(policy.method));
+                writer.WriteBool(policy.countsForMisprediction);
+            }
+            writer.WriteBool(settings.useDesyncLocalization);
+
+            writer.WriteBool(settings.logSyncTestChecksums);
+            writer.WriteBool(settings.logChecksumForEveryStoredFrameSnapshot);
+        }
+
+        static bool TryReadPlayerSpot(BitReader& reader, PlayerSpot& result) {
+            const uint64_t playerSpot = reader.ReadVarUnsigned();
+            if (playerSpot >= PlayerSpotHelpers::kMaxPlayerSpots) {
+                return false;
+            }
+            result = static_cast<PlayerSpot>(playerSpot);
+            return true;
+        }
+
+        static bool AreFramesEqual(const PlayerInputsForFrame& lhs, const PlayerInputsForFrame& rhs) {
+            if (lhs.GetSize() != rhs.GetSize()) {
+                return false;
+            }
+            for (uint32_t i = 0; i < lhs.GetSize(); i++) {
+                if (lhs.Get(i) != rhs.Get(i)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /**
+        * Same idea as InputUpdateMessageEncoding: 1 bit "same as previous" flag, otherwise a changed flag per field
+        * group followed by that group's data. All fp values are written as exact raw value deltas, which are small
+        * for analog values that change gradually.
+        **/
+        static void EncodeInput(BitWriter& writer, const CharacterInput& previous, const CharacterInput& current) {
+            const bool isSameAsPrevious = current == previous;
+            writer.WriteBool(isSameAsPrevious);
+            if (isSameAsPrevious) {
+                return;
+            }
+
+            const bool didCamPositionChange = current.camPosition != previous.camPosition;
+            writer.WriteBool(didCamPositionChange);
+            if (didCamPositionChange) {
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.x, current.camPosition.x));
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.y, current.camPosition.y));
+                writer.WriteVarSigned(GetRawDelta(previous.camPosition.z, current.camPosition.z));
+            }
+
+            const bool didCamRotationChange = current.camRotation != previous.camRotation;
+            writer.WriteBool(didCamRotationChange);
+            if (didCamRotationChange) {
+                writer.WriteVarSigned(GetRawDelta(previous.camRotation.w, current.camRotation.w));
+                writer.WriteVarSigned(GetRawDelta(previous.camRotation.v.x, current.camRotation.v.x));
+                writer.WriteVarSigned(GetRawDelta(previous.camRotation.v.y, current.camRotation.v.y));
+                writer.WriteVarSigned(GetRawDelta(previous.camRotation.v.z, current.camRotation.v.z));
+            }
+
+            const bool didMoveChange = current.moveForward != previous.moveForward ||
+                                       current.moveRight != previous.moveRight;
+            writer.WriteBool(didMoveChange);
+            if (didMoveChange) {
+                writer.WriteVarSigned(GetRawDelta(previous.moveForward, current.moveForward));
+                writer.WriteVarSigned(GetRawDelta(previous.moveRight, current.moveRight));
+            }
+
+            const bool didUIChoiceChange = current.uiChoice != previous.uiChoice;
+            writer.WriteBool(didUIChoiceChange);
+            if (didUIChoiceChange) {
+                writer.WriteBits(static_cast<uint8_t>(current.uiChoice), kUIChoiceBits);
+            }
+
+            const bool didCommandsChange = current.commandInputs != previous.commandInputs;
+            writer.WriteBool(didCommandsChange);
+            if (didCommandsChange) {
+                writer.WriteBits(current.commandInputs.Serialize(), kCommandBits);
+            }
+        }
+
+        static bool DecodeInput(BitReader& reader, const CharacterInput& previous, CharacterInput& result) {
+            result = previous;
+            if (reader.ReadBool()) { // Same as previous
+                return true;
+            }
+
+            if (reader.ReadBool()) {
+                result.camPosition.x = ApplyRawDelta(previous.camPosition.x, reader.ReadVarSigned());
+                result.camPosition.y = ApplyRawDelta(previous.camPosition.y, reader.ReadVarSigned());
+                result.camPosition.z = ApplyRawDelta(previous.camPosition.z, reader.ReadVarSigned());
+            }
+
+            if (reader.ReadBool()) {
+                result.camRotation.w = ApplyRawDelta(previous.camRotation.w, reader.ReadVarSigned());
+                result.camRotation.v.x = ApplyRawDelta(previous.camRotation.v.x, reader.ReadVarSigned());
+                result.camRotation.v.y = ApplyRawDelta(previous.camRotation.v.y, reader.ReadVarSigned());
+                result.camRotation.v.z = ApplyRawDelta(previous.camRotation.v.z, reader.ReadVarSigned());
+            }
+
+            if (reader.ReadBool()) {
+                result.moveForward = ApplyRawDelta(previous.moveForward, reader.ReadVarSigned());
+                result.moveRight = ApplyRawDelta(previous.moveRight, reader.ReadVarSigned());
+            }
+
+            if (reader.ReadBool()) {
+                const uint64_t uiChoice = reader.ReadBits(kUIChoiceBits);
+                if (uiChoice > static_cast<uint8_t>(GameplayInteractiveUIChoice::ChooseOptionE)) {
+                    return false;
+                }
+                result.uiChoice = static_cast<GameplayInteractiveUIChoice>(uiChoice);
+            }
+
+            if (reader.ReadBool()) {
+                result.commandInputs.Deserialize(static_cast<uint16_t>(reader.ReadBits(kCommandBits)));
+            }
+
+            return !reader.HasReadPastEnd();
+        }
+
+        // Deltas are calculated with unsigned math so that extreme values wrap rather than overflow (and still round trip)
+        static int64_t GetRawDelta(fp previous, fp current) {
+            return static_cast<int64_t>(static_cast<uint64_t>(current.raw_value()) -
+                                        static_cast<uint64_t>(previous.raw_value()));
+        }
+        static fp ApplyRawDelta(fp previous, int64_t delta) {
+            return fp::from_raw_value(static_cast<int64_t>(static_cast<uint64_t>(previous.raw_value()) +
+                                                           static_cast<uint64_t>(delta)));
+        }
+    };
+}
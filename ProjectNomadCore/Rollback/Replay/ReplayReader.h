@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ReplayFormat.h"
+#include "Utilities/LoggerSingleton.h"
+
+namespace ProjectNomad {
+    /**
+    * Reads replay files written by ReplayWriter (see ReplayFormat).
+    *
+    * Opening only reads the file header + each chunk's header, so even hour long replays open quickly. Chunk payloads
+    * are then read + decoded lazily as frames are requested, with only the latest decoded chunk kept in memory.
+    * Frames are expected to mostly be requested in order (eg, from RollbackUser::GetInputForNextFrame).
+    *
+    * If the file ends partway through a chunk (eg, game crashed while writing), then replay simply ends with the last
+    * complete chunk.
+    **/
+    class ReplayReader {
+      public:
+        /**
+        * Opens replay file and indexes its chunks
+        * @param logger - logger for any issues
+        * @param filePath - path of replay file
+        * @returns true if file is a valid replay, false otherwise
+        **/
+        bool Open(LoggerSingleton& logger, const std::string& filePath) {
+            Close();
+
+            mFile.open(filePath, std::ios::binary);
+            if (!mFile.is_open()) {
+                logger.LogWarnMessage("Failed to open replay file: " + filePath);
+                return false;
+            }
+            mFile.seekg(0, std::ios::end);
+            mFileSizeInBytes = mFile.tellg();
+            mFile.seekg(0);
+            if (!TryReadHeader()) {
+                logger.LogWarnMessage("Invalid replay header: " + filePath);
+                Close();
+                return false;
+            }
+            if (!TryIndexChunks()) {
+                logger.LogWarnMessage("Replay ends with an incomplete chunk, ignoring it: " + filePath);
+            }
+            return true;
+        }
+
+        void Close() {
+            if (mFile.is_open()) {
+                mFile.close();
+            }
+            mFile.clear();
+            mFileSizeInBytes = 0;
+            mHeader = {};
+            mChunks.clear();
+            mChunkPayloadOffsets.clear();
+            mDecodedChunkIndex = kNoChunk;
+            mDecodedFrames.clear();
+        }
+
+        bool IsOpen() const {
+            return mFile.is_open();
+        }
+
+        const ReplayHeader& GetHeader() const {
+            return mHeader;
+        }
+
+        // Whether replay has any frames at all. First + end frame are only meaningful if true
+        bool HasAnyFrames() const {
+            return !mChunks.empty();
+        }
+        FrameType GetFirstFrame() const {
+            return mChunks.empty() ? 0 : mChunks.front().firstFrame;
+        }
+        FrameType GetEndFrame() const { // Exclusive
+            return mChunks.empty() ? 0 : mChunks.back().GetEndFrame();
+        }
+        uint32_t GetNumChunks() const {
+            return static_cast<uint32_t>(mChunks.size());
+        }
+
+        /**
+        * Retrieves inputs for given frame, reading + decoding its chunk if not already decoded
+        * @param logger - logger for any issues
+        * @param frame - frame to retrieve inputs for
+        * @param result - inputs for frame, one per player. Only valid if returned true
+        * @returns true if inputs were found, false if frame is outside replay or its chunk is corrupted
+        **/
+        bool GetInputsForFrame(LoggerSingleton& logger, FrameType frame, PlayerInputsForFrame& result) {
+            if (!IsOpen()) {
+                logger.LogWarnMessage("Not open!");
+                return false;
+            }
+
+            const uint32_t chunkIndex = FindChunkIndex(frame);
+            if (chunkIndex == kNoChunk) {
+                return false; // Simply past end of replay, which is expected when replay is over
+            }
+            if (chunkIndex != mDecodedChunkIndex && !TryDecodeChunk(chunkIndex)) {
+                logger.LogWarnMessage("Failed to decode replay chunk " + std::to_string(chunkIndex));
+                return false;
+            }
+
+            result = mDecodedFrames[frame - mChunks[chunkIndex].firstFrame];
+            return true;
+        }
+
+      private:
+        static constexpr uint32_t kNoChunk = std::numeric_limits<uint32_t>::max();
+
+        bool TryReadHeader() {
+            std::vector<uint8_t> buffer(ReplayFormat::kFileHeaderPrefixSizeInBytes);
+            uint32_t bodySizeInBytes = 0;
+            if (!TryReadBytes(buffer) || !ReplayFormat::DecodeFileHeaderPrefix(buffer, bodySizeInBytes)) {
+                return false;
+            }
+
+            // Size comes from the file itself, so make sure it's actually there before allocating for it
+            if (bodySizeInBytes > GetRemainingFileSizeInBytes()) {
+                return false;
+            }
+            buffer.resize(bodySizeInBytes);
+            if (!TryReadBytes(buffer) || !ReplayFormat::DecodeFileHeaderBody(buffer, mHeader)) {
+                return false;
+            }
+            return !PlayerSpotHelpers::IsInvalidTotalPlayers(mHeader.rollbackSettings.totalPlayers);
+        }
+
+        // Returns false if file ended partway through a chunk
+        bool TryIndexChunks() {
+            std::vector<uint8_t> chunkHeader(ReplayFormat::kChunkHeaderSizeInBytes);
+            std::streamoff chunkOffset = mFile.tellg();
+            while (chunkOffset < mFileSizeInBytes) {
+                ReplayChunkInfo chunkInfo;
+                if (!TryReadBytes(chunkHeader) || !ReplayFormat::DecodeChunkHeader(chunkHeader, chunkInfo)) {
+                    return false;
+                }
+                if (!mChunks.empty() && chunkInfo.firstFrame != mChunks.back().GetEndFrame()) {
+                    return false; // Chunks are always written back to back, so gap can only be from corrupted data
+                }
+
+                const std::streamoff payloadOffset = chunkOffset + static_cast<std::streamoff>(ReplayFormat::kChunkHeaderSizeInBytes);
+                chunkOffset = payloadOffset + chunkInfo.payloadSizeInBytes;
+                if (chunkOffset > mFileSizeInBytes) { // Also means payload is never read into a buffer bigger than file
+                    return false;
+                }
+
+                mChunks.push_back(chunkInfo);
+                mChunkPayloadOffsets.push_back(payloadOffset);
+                mFile.seekg(chunkOffset); // Skip payload, as it's only read once needed
+            }
+            return true;
+        }
+
+        uint32_t FindChunkIndex(FrameType frame) const {
+            // Usually still in the decoded chunk or the one right after it, so check those first
+            if (mDecodedChunkIndex != kNoChunk) {
+                for (uint32_t i = mDecodedChunkIndex; i < mChunks.size() && i <= mDecodedChunkIndex + 1; i++) {
+                    if (frame >= mChunks[i].firstFrame && frame < mChunks[i].GetEndFrame()) {
+                        return i;
+                    }
+                }
+            }
+
+            // Otherwise binary search, as chunks are in frame order
+            auto it = std::upper_bound(mChunks.begin(), mChunks.end(), frame,
+                [](FrameType targetFrame, const ReplayChunkInfo& chunk) { return targetFrame < chunk.firstFrame; });
+            if (it == mChunks.begin()) {
+                return kNoChunk;
+            }
+            --it;
+            if (frame >= it->GetEndFrame()) {
+                return kNoChunk;
+            }
+            return static_cast<uint32_t>(it - mChunks.begin());
+        }
+
+        bool TryDecodeChunk(uint32_t chunkIndex) {
+            mDecodedChunkIndex = kNoChunk;
+
+            const ReplayChunkInfo& chunkInfo = mChunks[chunkIndex];
+            mPayloadBuffer.resize(chunkInfo.payloadSizeInBytes);
+            mFile.clear();
+            mFile.seekg(mChunkPayloadOffsets[chunkIndex]);
+            if (!TryReadBytes(mPayloadBuffer)) {
+                return false;
+            }
+            if (!ReplayFormat::DecodeChunkPayload(chunkInfo, mPayloadBuffer, mHeader.rollbackSettings.totalPlayers, mDecodedFrames)) {
+                return false;
+            }
+
+            mDecodedChunkIndex = chunkIndex;
+            return true;
+        }
+
+        uint64_t GetRemainingFileSizeInBytes() {
+            const std::streamoff curOffset = mFile.tellg();
+            return curOffset < 0 || curOffset > mFileSizeInBytes ? 0 : static_cast<uint64_t>(mFileSizeInBytes - curOffset);
+        }
+
+        bool TryReadBytes(std::vector<uint8_t>& result) {
+            mFile.read(reinterpret_cast<char*>(result.data()), static_cast<std::streamsize>(result.size()));
+            return mFile.gcount() == static_cast<std::streamsize>(result.size());
+        }
+
+        std::ifstream mFile;
+        std::streamoff mFileSizeInBytes = 0;
+        ReplayHeader mHeader = {};
+        std::vector<ReplayChunkInfo> mChunks;
+        std::vector<std::streamoff> mChunkPayloadOffsets; // Index matches mChunks
+
+        uint32_t mDecodedChunkIndex = kNoChunk;
+        std::vector<PlayerInputsForFrame> mDecodedFrames;
+        std::vector<uint8_t> mPayloadBuffer;
+    };
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "Utilities/FrameType.h"
+
+namespace ProjectNomad {
+    struct ReplayChecksumEntry {
+        FrameType frame = 0; // Checksum represents start of this frame, same as RollbackManager's validation checksums
+        uint32_t checksum = 0;
+
+        bool operator==(const ReplayChecksumEntry& other) const = default;
+    };
+
+    /**
+    * Result of playing back a single replay via HeadlessReplayRunner
+    **/
+    struct ReplayRunReport {
+        std::string replayPath = {};
+        // False if replay couldn't be opened or ended early due to a corrupted chunk. Trace is still valid up to there
+        bool didComplete = false;
+
+        FrameType firstFrame = 0;
+        uint64_t framesSimulated = 0;
+        std::vector<ReplayChecksumEntry> checksumTrace = {};
+        // Wall clock time spent playing back, excluding opening the replay file
+        uint64_t runTimeInMicroSec = 0;
+
+        double GetFramesPerSecond() const {
+            if (runTimeInMicroSec == 0) {
+                return 0;
+            }
+            return static_cast<double>(framesSimulated) * 1000000.0 / static_cast<double>(runTimeInMicroSec);
+        }
+
+        /**
+        * Compares checksum trace against a trace from another run of the same replay (eg, from a previous build)
+        * @param expectedTrace - trace to compare against. Only frames present in both traces are compared
+        * @param result - first frame where checksums differ. Only valid if returned true
+        * @returns true if any checksum differs, false if every shared frame matches
+        **/
+        bool TryFindFirstMismatch(const std::vector<ReplayChecksumEntry>& expectedTrace, FrameType& result) const {
+            size_t expectedIndex = 0;
+            for (const ReplayChecksumEntry& entry : checksumTrace) {
+                // Both traces are in frame order, so simply walk them side by side
+                while (expectedIndex < expectedTrace.size() && expectedTrace[expectedIndex].frame < entry.frame) {
+                    expectedIndex++;
+                }
+                if (expectedIndex == expectedTrace.size()) {
+                    return false;
+                }
+
+                if (expectedTrace[expectedIndex].frame == entry.frame && expectedTrace[expectedIndex].checksum != entry.checksum) {
+                    result = entry.frame;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void WriteJson(rapidjson::Writer<rapidjson::StringBuffer>& writer, bool includeChecksumTrace) const {
+            writer.StartObject();
+            writer.Key("replayPath");
+            writer.String(replayPath.c_str());
+            writer.Key("didComplete");
+            writer.Bool(didComplete);
+            writer.Key("firstFrame");
+            writer.Uint(firstFrame);
+            writer.Key("framesSimulated");
+            writer.Uint64(framesSimulated);
+            writer.Key("runTimeInMicroSec");
+            writer.Uint64(runTimeInMicroSec);
+            writer.Key("framesPerSecond");
+            writer.Double(GetFramesPerSecond());
+
+            if (includeChecksumTrace) {
+                writer.Key("checksumTrace"); // Pairs of [frame, checksum]
+                writer.StartArray();
+                for (const ReplayChecksumEntry& entry : checksumTrace) {
+                    writer.StartArray();
+                    writer.Uint(entry.frame);
+                    writer.Uint(entry.checksum);
+                    writer.EndArray();
+                }
+                writer.EndArray();
+            }
+            writer.EndObject();
+        }
+    };
+
+    /**
+    * Result of playing back many replays at once via HeadlessReplayRunner::RunBatch
+    **/
+    struct ReplayBatchReport {
+        std::vector<ReplayRunReport> replays = {}; // Same order as replays were given in
+        uint32_t threadsUsed = 0;
+        uint64_t wallTimeInMicroSec = 0;
+
+        uint32_t GetNumFailed() const {
+            return static_cast<uint32_t>(std::count_if(replays.begin(), replays.end(),
+                [](const ReplayRunReport& replay) { return !replay.didComplete; }));
+        }
+
+        uint64_t GetTotalFramesSimulated() const {
+            uint64_t result = 0;
+            for (const ReplayRunReport& replay : replays) {
+                result += replay.framesSimulated;
+            }
+            return result;
+        }
+
+        // Overall throughput across every thread, ie what decides how long verifying a whole corpus takes
+        double GetFramesPerSecond() const {
+            if (wallTimeInMicroSec == 0) {
+                return 0;
+            }
+            return static_cast<double>(GetTotalFramesSimulated()) * 1000000.0 / static_cast<double>(wallTimeInMicroSec);
+        }
+
+        /**
+        * Dumps report as a single JSON object, such as for storing as the expected traces of a build
+        * @param includeChecksumTraces - whether to include every replay's full checksum trace
+        * @returns JSON string
+        **/
+        std::string ToJson(bool includeChecksumTraces) const {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+            writer.StartObject();
+            writer.Key("threadsUsed");
+            writer.Uint(threadsUsed);
+            writer.Key("wallTimeInMicroSec");
+            writer.Uint64(wallTimeInMicroSec);
+            writer.Key("totalFramesSimulated");
+            writer.Uint64(GetTotalFramesSimulated());
+            writer.Key("framesPerSecond");
+            writer.Double(GetFramesPerSecond());
+            writer.Key("failedReplays");
+            writer.Uint(GetNumFailed());
+
+            writer.Key("replays");
+            writer.StartArray();
+            for (const ReplayRunReport& replay : replays) {
+                replay.WriteJson(writer, includeChecksumTraces);
+            }
+            writer.EndArray();
+            writer.EndObject();
+
+            return buffer.GetString();
+        }
+    };
+}
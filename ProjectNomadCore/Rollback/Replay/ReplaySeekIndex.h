@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "ReplayReader.h"
+#include "Rollback/RollbackManager.h"
+#include "Rollback/RollbackUser.h"
+#include "Rollback/Model/RollbackRuntimeState.h"
+#include "Utilities/LoggerSingleton.h"
+
+namespace ProjectNomad {
+    /**
+    * Supports seeking to any frame of a replay without re-simulating from frame 0, by storing periodic keyframes
+    * in memory. Seeking restores the nearest earlier keyframe then fast forwards (without rendering) from there, so
+    * seek time is bounded by the keyframe interval rather than by replay length.
+    *
+    * Keyframes are recorded as frames are reached during playback, including while fast forwarding past frames that
+    * don't have keyframes yet. Thus seeking far ahead the first time takes longer, but seeking anywhere already
+    * played is quick.
+    *
+    * Two ways of playing back are supported, though a single index is expected to only be used with one of them:
+    *   - Driving RollbackUser directly with ReplayReader inputs (eg, headless playback). Keyframes only hold game state
+    *   - Local RollbackManager session where user retrieves inputs from replay. Keyframes then also hold
+    *     RollbackRuntimeState, so manager can continue from the restored frame as if it was never left
+    *
+    * Memory: each keyframe holds one snapshot (plus RollbackRuntimeState if using RollbackManager, which itself holds
+    *         a snapshot per frame in rollback window). So pick interval based on snapshot size vs frame update cost.
+    **/
+    template <typename SnapshotType>
+    class ReplaySeekIndex {
+      public:
+        static constexpr FrameType kDefaultKeyframeInterval = 120; // 2s at 60fps, ie usually at most 119 frames to fast forward
+
+        struct Keyframe {
+            FrameType frame = 0; // Snapshot represents start of this frame, ie before it is processed
+            SnapshotType gameSnapshot = {};
+            std::unique_ptr<RollbackRuntimeState<SnapshotType>> runtimeState = nullptr; // Only if using RollbackManager
+        };
+
+        explicit ReplaySeekIndex(FrameType keyframeInterval = kDefaultKeyframeInterval)
+            : mKeyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1) {}
+
+        // Expected before playing a different replay, as keyframes are only valid for the replay they were recorded from
+        void Clear() {
+            mKeyframes.clear();
+        }
+
+        FrameType GetKeyframeInterval() const {
+            return mKeyframeInterval;
+        }
+        size_t GetNumKeyframes() const {
+            return mKeyframes.size();
+        }
+
+        /**
+        * Checks if a keyframe should be recorded at start of given frame, ie if it's the first frame reached at or past
+        * the next keyframe interval boundary. Not requiring frame to be exactly on the boundary matters for
+        * RollbackManager playback, as a single tick may process multiple frames.
+        **/
+        bool ShouldRecordKeyframe(FrameType frame) const {
+            return mKeyframes.empty() || frame >= GetNextKeyframeBoundary(mKeyframes.back().frame);
+        }
+
+        /**
+        * Records keyframe for direct RollbackUser playback if due. Expected to be called before processing each frame,
+        * including frame 0 (as there's nothing to seek back to otherwise).
+        * @param user - user to snapshot, which is expected to be at start of given frame
+        * @param frame - next frame to process
+        **/
+        void RecordKeyframeIfDue(RollbackUser<SnapshotType>& user, FrameType frame) {
+            if (!ShouldRecordKeyframe(frame)) {
+                return;
+            }
+
+            Keyframe& keyframe = mKeyframes.emplace_back();
+            keyframe.frame = frame;
+            user.GenerateSnapshot(frame, keyframe.gameSnapshot);
+        }
+
+        /**
+        * Records keyframe for RollbackManager playback if due. Expected to be called after each manager tick, including
+        * before the very first tick (as there's nothing to seek back to otherwise).
+        * @param manager - manager to store internal state of
+        * @param user - user to snapshot, which is expected to have processed same frames as manager
+        **/
+        void RecordKeyframeIfDue(const RollbackManager<SnapshotType>& manager, RollbackUser<SnapshotType>& user) {
+            const FrameType frame = manager.GetInternalStateSnapshot().lastProcessedFrame + 1; // Max value overflows to 0
+            if (!ShouldRecordKeyframe(frame)) {
+                return;
+            }
+
+            RecordKeyframeIfDue(user, frame);
+            mKeyframes.back().runtimeState = std::make_unique<RollbackRuntimeState<SnapshotType>>(manager.GetInternalStateSnapshot());
+        }
+
+        /**
+        * Moves user to start of target frame (ie, target frame is the next frame to process), using replay inputs
+        * @param logger - logger for any issues
+        * @param user - user to restore + fast forward. OnPostRollback is called afterwards so rendering can catch up
+        * @param reader - replay to retrieve inputs from
+        * @param targetFrame - frame to seek to
+        * @returns true if user is now at target frame, false if there's no earlier keyframe or replay ran out of inputs
+        **/
+        bool SeekTo(LoggerSingleton& logger,
+                    RollbackUser<SnapshotType>& user,
+                    ReplayReader& reader,
+                    FrameType targetFrame) {
+            const Keyframe* keyframe = FindNearestKeyframe(targetFrame);
+            if (keyframe == nullptr) {
+                logger.LogWarnMessage("No keyframe at or before frame " + std::to_string(targetFrame));
+                return false;
+            }
+
+            const FrameType keyframeFrame = keyframe->frame; // Recording more keyframes may invalidate pointer
+            user.RestoreSnapshot(keyframeFrame, keyframe->gameSnapshot);
+            bool didSucceed = true;
+            PlayerInputsForFrame inputs;
+            for (FrameType frame = keyframeFrame; frame < targetFrame; frame++) {
+                if (!reader.GetInputsForFrame(logger, frame, inputs)) {
+                    logger.LogWarnMessage("Replay has no inputs for frame " + std::to_string(frame));
+                    didSucceed = false;
+                    break;
+                }
+
+                user.ProcessFrameWithoutRendering(frame, inputs);
+                RecordKeyframeIfDue(user, frame + 1);
+            }
+
+            user.OnPostRollback();
+            return didSucceed;
+        }
+
+        /**
+        * Moves manager + user to start of target frame (ie, target frame is the next frame to process). User is
+        * expected to provide replay inputs from GetInputForNextFrame.
+        * @param logger - logger for any issues
+        * @param manager - manager to restore + fast forward, which is expected to be running a local session
+        * @param user - same user as manager's. OnPostRollback is called afterwards so rendering can catch up
+        * @param targetFrame - frame to seek to
+        * @returns true if now at target frame, false if there's no earlier keyframe or user ran out of inputs
+        **/
+        bool SeekTo(LoggerSingleton& logger,
+                    RollbackManager<SnapshotType>& manager,
+                    RollbackUser<SnapshotType>& user,
+                    FrameType targetFrame) {
+            const Keyframe* keyframe = FindNearestKeyframe(targetFrame);
+            if (keyframe == nullptr || keyframe->runtimeState == nullptr) {
+                logger.LogWarnMessage("No RollbackManager keyframe at or before frame " + std::to_string(targetFrame));
+                return false;
+            }
+
+            manager.RestoreInternalStateSnapshot(*keyframe->runtimeState);
+            user.RestoreSnapshot(keyframe->frame, keyframe->gameSnapshot);
+
+            // Fast forward up to each keyframe boundary in turn, so any keyframes not yet recorded are filled in
+            bool didSucceed = true;
+            FrameType curFrame = keyframe->frame; // Recording more keyframes may invalidate pointer, so not used after this
+            while (curFrame < targetFrame) {
+                const FrameType framesToProcess = std::min(targetFrame, GetNextKeyframeBoundary(curFrame)) - curFrame;
+                if (manager.FastForwardFrames(framesToProcess) != framesToProcess) {
+                    logger.LogWarnMessage("Ran out of inputs before frame " + std::to_string(targetFrame));
+                    didSucceed = false;
+                    break;
+                }
+
+                curFrame += framesToProcess;
+                RecordKeyframeIfDue(manager, user);
+            }
+
+            user.OnPostRollback();
+            return didSucceed;
+        }
+
+        // Latest keyframe at or before given frame, if any
+        const Keyframe* FindNearestKeyframe(FrameType frame) const {
+            auto it = std::upper_bound(mKeyframes.begin(), mKeyframes.end(), frame,
+                [](FrameType targetFrame, const Keyframe& keyframe) { return targetFrame < keyframe.frame; });
+            if (it == mKeyframes.begin()) {
+                return nullptr;
+            }
+            return &*(it - 1);
+        }
+
+      private:
+        FrameType GetNextKeyframeBoundary(FrameType frame) const {
+            return (frame / mKeyframeInterval + 1) * mKeyframeInterval;
+        }
+
+        const FrameType mKeyframeInterval;
+        std::vector<Keyframe> mKeyframes; // Always in frame order
+    };
+}
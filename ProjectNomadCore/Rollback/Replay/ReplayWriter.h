@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ReplayFormat.h"
+#include "Utilities/LoggerSingleton.h"
+
+namespace ProjectNomad {
+    /**
+    * Streams confirmed inputs into a replay file (see ReplayFormat), such as from RollbackManager::SetReplayWriter.
+    *
+    * Frames are collected into a chunk on the game thread, which is then handed off to a background worker thread
+    * that encodes + writes it. Frames are double buffered: game thread keeps filling one buffer while worker writes
+    * the other. If worker is still busy by the time a chunk is full (eg, disk is stalled), then the game thread simply
+    * keeps adding to its buffer and hands everything off once worker is free. Thus adding frames never waits on disk.
+    *
+    * Threading expectations:
+    * - All public methods are expected to be called from the game thread
+    * - Worker only touches its own buffer + file while writing a chunk
+    * - Logging is left to the game thread, as LoggerSingleton is not expected to be thread safe. Write failures are
+    *   thus only reported via HasWriteFailed and Close
+    **/
+    class ReplayWriter {
+      public:
+        static constexpr FrameType kDefaultFramesPerChunk = 256; // About 4s at 60fps
+
+        /**
+        * @param framesPerChunk - how many frames to collect before handing a chunk off to worker. Bigger chunks
+        *                         compress slightly better, but are more data to lose if game crashes.
+        *                         Clamped to [1, ReplayFormat::kMaxFramesPerChunk]
+        **/
+        explicit ReplayWriter(FrameType framesPerChunk = kDefaultFramesPerChunk)
+            : mFramesPerChunk(std::clamp<FrameType>(framesPerChunk, 1, ReplayFormat::kMaxFramesPerChunk)) {
+            mPendingFrames.reserve(mFramesPerChunk);
+            mWorkerFrames.reserve(mFramesPerChunk);
+        }
+        ~ReplayWriter() {
+            FlushAndClose();
+        }
+        ReplayWriter(const ReplayWriter&) = delete;
+        ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+        /**
+        * Creates (or replaces) replay file and writes its header
+        * @param logger - logger for any issues
+        * @param filePath - path of replay file
+        * @param header - header for replay. Total players is expected to match inputs for each added frame
+        * @returns true if file was created, false otherwise
+        **/
+        bool Open(LoggerSingleton& logger, const std::string& filePath, const ReplayHeader& header) {
+            if (IsOpen()) {
+                logger.LogWarnMessage("Already open! Closing prior replay first");
+                Close(logger);
+            }
+            if (PlayerSpotHelpers::IsInvalidTotalPlayers(header.rollbackSettings.totalPlayers)) {
+                logger.LogWarnMessage("Invalid total players in header");
+                return false;
+            }
+
+            mFile.open(filePath, std::ios::binary | std::ios::trunc);
+            if (!mFile.is_open()) {
+                logger.LogWarnMessage("Failed to open replay file: " + filePath);
+                return false;
+            }
+
+            std::vector<uint8_t> encodedHeader;
+            ReplayFormat::EncodeFileHeader(header, encodedHeader);
+            mFile.write(reinterpret_cast<const char*>(encodedHeader.data()), static_cast<std::streamsize>(encodedHeader.size()));
+
+            mTotalPlayers = header.rollbackSettings.totalPlayers;
+            mHasAnyFrames = false;
+            mNextFrameToAdd = 0;
+            mPendingFirstFrame = 0;
+            mPendingFrames.clear();
+            mHasWriteFailed.store(!mFile.good());
+            mBytesWritten.store(encodedHeader.size());
+            return !mHasWriteFailed.load();
+        }
+
+        /**
+        * Flushes all added frames to file then closes it. Blocks until done, so expected at session end.
+        * @param logger - logger for any issues
+        * @returns true if every frame was written successfully, false otherwise
+        **/
+        bool Close(LoggerSingleton& logger) {
+            if (!IsOpen()) {
+                return true;
+            }
+
+            FlushAndClose();
+            if (mHasWriteFailed.load()) {
+                logger.LogWarnMessage("Failed to write replay file");
+                return false;
+            }
+            return true;
+        }
+
+        bool IsOpen() const {
+            return mFile.is_open();
+        }
+
+        /**
+        * Adds inputs for next frame. Frames are expected to be added in order without gaps, starting from any frame.
+        * @param logger - logger for any issues
+        * @param frame - frame that inputs are for
+        * @param inputs - confirmed inputs for frame, one per player
+        * @returns true if inputs were added, false if not open or frame/inputs are not as expected
+        **/
+        bool AddFrame(LoggerSingleton& logger, FrameType frame, const PlayerInputsForFrame& inputs) {
+            if (!IsOpen()) {
+                logger.LogWarnMessage("Not open!");
+                return false;
+            }
+            if (mHasAnyFrames && frame != mNextFrameToAdd) {
+                logger.LogWarnMessage("Unexpected frame " + std::to_string(frame) + ", expected " + std::to_string(mNextFrameToAdd));
+                return false;
+            }
+            if (inputs.GetSize() != mTotalPlayers) {
+                logger.LogWarnMessage("Unexpected number of inputs: " + std::to_string(inputs.GetSize()));
+                return false;
+            }
+
+            if (mPendingFrames.empty()) {
+                mPendingFirstFrame = frame;
+            }
+            mPendingFrames.push_back(inputs);
+            mHasAnyFrames = true;
+            mNextFrameToAdd = frame + 1;
+
+            if (mPendingFrames.size() >= mFramesPerChunk) {
+                TryHandOffPendingFrames();
+            }
+            return true;
+        }
+
+        bool HasAnyFrames() const {
+            return mHasAnyFrames;
+        }
+        // Only meaningful if HasAnyFrames is true
+        FrameType GetNextFrameToAdd() const {
+            return mNextFrameToAdd;
+        }
+
+        bool HasWriteFailed() const {
+            return mHasWriteFailed.load();
+        }
+        // Includes file header. Only includes chunks that worker has finished writing
+        uint64_t GetBytesWritten() const {
+            return mBytesWritten.load();
+        }
+
+        // Blocks until worker finishes any in-flight chunk. Mostly useful for deterministic unit tests
+        void WaitUntilNotWriting() {
+            std::unique_lock lock(mMutex);
+            mDoneCondition.wait(lock, [this] { return !mIsWriting.load(); });
+        }
+
+      private:
+        void TryHandOffPendingFrames() {
+            if (mIsWriting.load()) {
+                return; // Keep collecting, as never want to wait on disk. Next added frame will try again
+            }
+
+            // Worker is idle so its buffer is free. Swap rather than copy, which also keeps both buffers' capacity
+            std::swap(mPendingFrames, mWorkerFrames);
+            mPendingFrames.clear();
+            mWorkerFirstFrame = mPendingFirstFrame;
+            StartWorkerIfNeeded();
+
+            {
+                std::lock_guard lock(mMutex);
+                mIsWriting.store(true);
+            }
+            mWakeCondition.notify_one();
+        }
+
+        void FlushAndClose() {
+            WaitUntilNotWriting();
+            if (IsOpen() && !mPendingFrames.empty()) { // Worker is idle, so simply write remaining frames directly
+                std::swap(mPendingFrames, mWorkerFrames);
+                mPendingFrames.clear();
+                mWorkerFirstFrame = mPendingFirstFrame;
+                WriteWorkerChunk();
+            }
+            CloseFileAndStopWorker();
+        }
+
+        void StartWorkerIfNeeded() {
+            if (mWorkerThread.joinable()) {
+                return;
+            }
+
+            mShouldStop = false;
+            mWorkerThread = std::thread(&ReplayWriter::WorkerLoop, this);
+        }
+        void CloseFileAndStopWorker() {
+            if (mWorkerThread.joinable()) {
+                {
+                    std::lock_guard lock(mMutex);
+                    mShouldStop = true;
+                }
+                mWakeCondition.notify_one();
+                mWorkerThread.join();
+            }
+
+            if (mFile.is_open()) {
+                mFile.close();
+                if (mFile.fail()) {
+                    mHasWriteFailed.store(true);
+                }
+            }
+        }
+
+        void WorkerLoop() {
+            while (true) {
+                {
+                    std::unique_lock lock(mMutex);
+                    mWakeCondition.wait(lock, [this] { return mShouldStop || mIsWriting.load(); });
+                    // Always finish a handed off chunk before stopping, so no frames are lost
+                    if (!mIsWriting.load()) {
+                        return;
+                    }
+                }
+
+                WriteWorkerChunk();
+
+                {
+                    std::lock_guard lock(mMutex);
+                    mIsWriting.store(false);
+                }
+                mDoneCondition.notify_all();
+            }
+        }
+
+        void WriteWorkerChunk() {
+            ReplayFormat::EncodeChunk(mWorkerFirstFrame, mWorkerFrames, mPayloadBuffer, mChunkBuffer);
+            mWorkerFrames.clear();
+
+            mFile.write(reinterpret_cast<const char*>(mChunkBuffer.data()), static_cast<std::streamsize>(mChunkBuffer.size()));
+            mFile.flush(); // Chunks are infrequent, and flushing each means a crash only loses latest frames
+            if (!mFile.good()) {
+                mHasWriteFailed.store(true);
+                return;
+            }
+            mBytesWritten.fetch_add(mChunkBuffer.size());
+        }
+
+        const FrameType mFramesPerChunk;
+        uint8_t mTotalPlayers = 0;
+
+        // Game thread only
+        bool mHasAnyFrames = false;
+        FrameType mNextFrameToAdd = 0;
+        FrameType mPendingFirstFrame = 0;
+        std::vector<PlayerInputsForFrame> mPendingFrames;
+
+        // Worker only while writing, and game thread otherwise
+        FrameType mWorkerFirstFrame = 0;
+        std::vector<PlayerInputsForFrame> mWorkerFrames;
+        std::vector<uint8_t> mPayloadBuffer;
+        std::vector<uint8_t> mChunkBuffer;
+        std::ofstream mFile;
+
+        std::atomic<bool> mIsWriting = false;
+        std::atomic<bool> mHasWriteFailed = false;
+        std::atomic<uint64_t> mBytesWritten = 0;
+        bool mShouldStop = false;
+        std::mutex mMutex;
+        std::condition_variable mWakeCondition;
+        std::condition_variable mDoneCondition;
+        std::thread mWorkerThread;
+    };
+}
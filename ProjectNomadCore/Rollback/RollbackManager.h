@@ -1,15 +1,22 @@
 #pragma once
 
 #include "RollbackUser.h"
+#include "Input/CharacterInputQuantizer.h"
+#include "Managers/RollbackAsyncSyncTester.h"
+#include "Managers/RollbackDesyncLocalizer.h"
+#include "Managers/RollbackInputDelayTuner.h"
 #include "Managers/RollbackTimeManager.h"
 #include "Model/BaseSnapshot.h"
+#include "Model/RollbackPerfCounters.h"
 #include "Model/RollbackRuntimeState.h"
 #include "Model/RollbackSettings.h"
+#include "Model/RollbackSnapshotStats.h"
+#include "Replay/ReplayWriter.h"
 #include "Network/P2PMessages/NetMessagesInput.h"
 #include "Utilities/LoggerSingleton.h"
 #include "Utilities/Singleton.h"
 
-// TODO: Local input delay (just separate and stagger render frame. Only real "confusion" is at verrry beginning to get the stagger)
+// TODO: Negative local input delay (just separate and stagger render frame. Only real "confusion" is at verrry beginning to get the stagger)
 
 namespace ProjectNomad {
     /**
@@ -26,6 +33,9 @@ namespace ProjectNomad {
         
       public:
         explicit RollbackManager(RollbackUser<SnapshotType>& rollbackUser) : mRollbackUser(rollbackUser) {}
+        // Special constructor for unit tests so can precisely control how many frames are processed per tick
+        RollbackManager(RollbackUser<SnapshotType>& rollbackUser, std::function<uint64_t()> timeRetriever)
+            : mRollbackUser(rollbackUser), mTimeManager(std::move(timeRetriever)) {}
 
         /**
         * Expected to be called at start of new game session before any other method is called.
@@ -55,7 +65,47 @@ namespace ProjectNomad {
             mIsSessionRunning = false;
         }
 
-        void OnReceivedTimeQualityReport(PlayerSpot remotePlayerSpot, FrameType remotePlayerFrame) {
+        /**
+        * Provides the separate user which async sync test re-simulates on (see RollbackSettings::useAsyncSyncTest).
+        * This user must own entirely separate gameplay state from the main user, as it's used from a background thread.
+        * Only RestoreSnapshot, ProcessFrameWithoutRendering, and GenerateSnapshot will be called on it.
+        * @param syncTestUser - user to re-simulate on. Expected to outlive this manager or be cleared via nullptr
+        **/
+        void SetAsyncSyncTestUser(RollbackUser<SnapshotType>* syncTestUser) {
+            mAsyncSyncTester.SetSyncTestUser(syncTestUser);
+        }
+
+        /**
+        * Provides replay writer to stream inputs to as they exit the rollback window (see
+        * RollbackUser::OnInputsExitRollbackWindow). Writer is expected to already be opened by the user, as only the
+        * user knows the session seed + where to save, and to be closed by the user after session ends.
+        * Note that inputs for the last frames of a session never exit the rollback window, so they're never written.
+        * @param replayWriter - writer to add confirmed frames to. Expected to outlive this manager or be cleared via nullptr
+        **/
+        void SetReplayWriter(ReplayWriter* replayWriter) {
+            mReplayWriter = replayWriter;
+        }
+
+        /**
+        * Blocks until any in-flight async sync test finishes, then handles its result.
+        * Useful for deterministic behavior such as at end of a soak test or within unit tests.
+        **/
+        void WaitForPendingAsyncSyncTest() {
+            mAsyncSyncTester.WaitUntilNotRunning();
+            HandleAsyncSyncTestResultIfAny();
+        }
+
+        /**
+        * Handles time quality report from a remote player, which is used to time sync with the host
+        * @param remotePlayerSpot - player spot of report sender
+        * @param remotePlayerFrame - sender's frame at the time report was sent
+        * @param senderOneWayDelayInMicroSec - estimated time report took to arrive (see PeerLatencyStats). Sender kept
+        *                                      simulating in the meantime, so this is used to estimate its current frame.
+        *                                      Also used for input delay tuning. 0 if unknown
+        **/
+        void OnReceivedTimeQualityReport(PlayerSpot remotePlayerSpot,
+                                         FrameType remotePlayerFrame,
+                                         uint64_t senderOneWayDelayInMicroSec = 0) {
             // Sanity checks
             if (!mIsSessionRunning) {
                 mLogger.LogWarnMessage("Called while session not running!");
@@ -73,6 +123,10 @@ namespace ProjectNomad {
                 return;
             }
 
+            if (senderOneWayDelayInMicroSec > 0) {
+                mInputDelayTuner.RecordRemoteLatency(remotePlayerSpot, senderOneWayDelayInMicroSec);
+            }
+
             // Ignore any messages not from host player, as currently only time syncing to host.
             //      This is contrary to, say, typical 2-player fighting game rollback.  But this decision was made as
             //      there may be an arbitrary number of players and we need to time sync to a single point.
@@ -84,8 +138,14 @@ namespace ProjectNomad {
             // Set TimeManager's time sync info. That's it for time sync management here! ^_^
             //      Note that we could also do input range validation, but the time manager call will also validate range for us.
             //      Not the best practice, but eh good enough for now.
+            //      Host's frame is from when report was sent, so add the frames it simulated while report was in flight.
+            //      Otherwise we'd think host is further behind the longer the latency, and thus over-correct.
+            const int64_t framesSimulatedInTransit = static_cast<int64_t>(
+                (senderOneWayDelayInMicroSec + kTimePerFrameInMicroSec / 2) / kTimePerFrameInMicroSec // Rounded
+            );
             int64_t hostNumberOfFramesAhead = // Cast to int64 to avoid underflow as FrameType is currently uint32
-                static_cast<int64_t>(remotePlayerFrame) - static_cast<int64_t>(mRuntimeState.lastProcessedFrame);
+                static_cast<int64_t>(remotePlayerFrame) + framesSimulatedInTransit -
+                static_cast<int64_t>(mRuntimeState.lastProcessedFrame);
             mTimeManager.SetupTimeSyncForRemoteFrameDifference(mLogger, hostNumberOfFramesAhead);
         }
         void OnReceivedValidationChecksum(PlayerSpot remotePlayerSpot, FrameType targetFrame, uint32_t checksum) {
@@ -116,9 +176,43 @@ namespace ProjectNomad {
             bool isChecksumFromLocalPlayer = false;
             HandleDesyncDetectionChecksum(targetFrame, checksum, isChecksumFromLocalPlayer);
         }
+        // Only expected on host, from a peer localizing a desync (see RollbackSettings::useDesyncLocalization)
+        void OnReceivedDesyncLocalizationRequest(PlayerSpot remotePlayerSpot, const DesyncLocalizationRequestMessage& message) {
+            if (!IsDesyncLocalizationActive() || !IsLocalPlayerHost()) {
+                mLogger.LogWarnMessage("Received desync localization request while not localizing desyncs as host");
+                return;
+            }
+
+            DesyncLocalizationResponseMessage response;
+            if (!mDesyncLocalizer.TryAnswerRequest(message, response)) {
+                // Still answer so requester can stop waiting
+                mLogger.LogWarnMessage("Unable to answer desync localization request for frame " + std::to_string(message.targetFrame));
+            }
+            mRollbackUser.SendDesyncLocalizationResponse(remotePlayerSpot, response);
+        }
+        void OnReceivedDesyncLocalizationResponse(PlayerSpot remotePlayerSpot, const DesyncLocalizationResponseMessage& message) {
+            if (!IsDesyncLocalizationActive() || remotePlayerSpot != mRollbackSettings.hostPlayerSpot) {
+                mLogger.LogWarnMessage("Received desync localization response while not localizing desyncs against host");
+                return;
+            }
+
+            DesyncLocalizationRequestMessage nextRequest;
+            if (mDesyncLocalizer.HandleResponse(mLogger, message, nextRequest)) {
+                mRollbackUser.SendDesyncLocalizationRequestToHost(nextRequest);
+            }
+            else if (!mDesyncLocalizer.IsInProgress() && mDesyncLocalizer.HasResult()) {
+                mLogger.LogErrorMessage(
+                    RollbackDesyncLocalizer<SnapshotType>::ResultToString(mDesyncLocalizer.GetResult())
+                );
+            }
+        }
+        // Convenience overload for a full input history without any acks
         void OnReceivedRemotePlayerInput(PlayerSpot remotePlayerSpot,
                                          FrameType updateFrame,
                                          const InputHistoryArray& playerInputs) {
+            OnReceivedRemotePlayerInput(remotePlayerSpot, InputUpdateMessage(updateFrame, playerInputs));
+        }
+        void OnReceivedRemotePlayerInput(PlayerSpot remotePlayerSpot, const InputUpdateMessage& message) {
             // Sanity checks
             if (!mIsSessionRunning) {
                 mLogger.LogWarnMessage("Called while session not running!");
@@ -135,7 +229,16 @@ namespace ProjectNomad {
                 );
                 return;
             }
+            if (message.numInputs == 0 || message.numInputs > kInputsHistorySize) {
+                mLogger.LogWarnMessage("Invalid number of inputs in message: " + std::to_string(message.numInputs));
+                return;
+            }
+
+            // Remember how far remote player has received our inputs, so we don't need to keep resending those.
+            //      Acks may arrive out of order (as sent via "UDP"), so only ever move forward.
+            RecordLocalInputsAck(remotePlayerSpot, message.ackedFrames[static_cast<size_t>(mRollbackSettings.localPlayerSpot)]);
 
+            const FrameType updateFrame = message.updateFrame;
             const FrameType preNewInputLastStoredFrame = mRuntimeState.inputManager.GetLastStoredFrameForPlayer(
                 mLogger, remotePlayerSpot
             );
@@ -161,7 +264,7 @@ namespace ProjectNomad {
             }
             
             // Sanity check: Remote player should never send inputs from too far into future (as they should stall instead).
-            //               ie, is number of new frames greater than # of inputs actually in the update message.
+            //               ie, is number of new frames greater than # of inputs that can fit in an update message.
             if (numOfNewFrames > kInputsHistorySize) {
                 mLogger.LogWarnMessage(
                     "Ignoring, possible bad update as further ahead into future than expected! Player spot: " +
@@ -171,6 +274,18 @@ namespace ProjectNomad {
                 );
                 return;
             }
+            // Valid throwaway case: Message doesn't go back far enough to connect to inputs we already have.
+            //      Expected if an earlier message was lost before sender received our ack for it. Sender will keep
+            //      including the missing inputs until our ack (sent with our inputs) catches up, so simply wait.
+            if (numOfNewFrames > message.numInputs) {
+                mLogger.LogInfoMessage(
+                    "Ignoring message as missing older unacknowledged inputs. Player spot: " +
+                    std::to_string(static_cast<int>(remotePlayerSpot)) + ", previous last frame stored: " +
+                    std::to_string(preNewInputLastStoredFrame) + ", received update frame: " +
+                    std::to_string(updateFrame) + ", inputs in message: " + std::to_string(message.numInputs)
+                );
+                return;
+            }
 
             // Finally add the new frames one by one, from oldest to newest.
             //      Note atm that input data storage expects inputs to be incrementally added one by one.
@@ -180,11 +295,19 @@ namespace ProjectNomad {
                 // Retrieve the appropriate input for this frame.
                 //      Note that the "head" (0th index) is the latest input.
                 FrameType targetIndex = numOfNewFrames - count; // Validated size earlier. Should be in range of 0 to kInputsHistorySize - 1
-                const CharacterInput& newInput = playerInputs.at(targetIndex);
+                const CharacterInput& newInput = message.playerInputs.at(targetIndex);
                 
-                mRuntimeState.inputManager.SetInputForPlayer(
+                bool wasPredictionIncorrect = mRuntimeState.inputManager.SetInputForPlayer(
                     mLogger, targetFrame, remotePlayerSpot, newInput
                 );
+
+                // If we already processed this frame with a wrong prediction, then remember to rollback to it.
+                //      Only the earliest such frame (across all players) matters, as rolling back to it will
+                //      re-process all later frames anyways. Thus any number of corrections received before the next
+                //      update will result in only a single rollback.
+                if (wasPredictionIncorrect) {
+                    mRuntimeState.earliestMispredictedFrame = std::min(mRuntimeState.earliestMispredictedFrame, targetFrame);
+                }
             }
         }
 
@@ -237,12 +360,23 @@ namespace ProjectNomad {
                 }
                 return 0;
             }
+
+            const uint64_t tickStartTime = StartPerfTimer();
+            if constexpr (kRollbackPerfCountersEnabled) {
+                mPerfCounters.BeginTick();
+            }
+            // Track simulation cost for this tick, so time manager knows how many frames fit in its catch-up budget
+            const uint64_t simulationStartTime = mTimeManager.GetCurrentTimeInMicroSec();
+            mFramesSimulatedThisTick = 0;
             
-            // TODO: Check if should rollback (and only update rendering once even with sync test)
-            bool didRollbackOccur = false;
+            // Rollback if any prior predictions were incorrect, and only do so once no matter how many corrections
+            //      were received since last update. (Rendering will then only be updated once even with sync test)
+            bool didRollbackOccur = HandleRollbackForMispredictionsIfAny();
             
-            // Do normal processing for x number of frames (time based)
-            FrameType numOfNewFramesToProcess = mTimeManager.CheckHowManyFramesToProcess();
+            // Do normal processing for x number of frames (time based).
+            //      Any time already spent re-simulating frames for a rollback comes out of this tick's budget.
+            const uint64_t rollbackTime = mTimeManager.GetCurrentTimeInMicroSec() - simulationStartTime;
+            FrameType numOfNewFramesToProcess = mTimeManager.CheckHowManyFramesToProcess(rollbackTime);
             for (FrameType i = 0; i < numOfNewFramesToProcess; i++) {
                 // Edge case: If we don't have enough inputs for a frame update, then wait for inputs.
                 //      FUTURE: If stalled for inputs, then make TimeManager return 1 on next call to CheckHowManyFramesToProcess()
@@ -252,31 +386,27 @@ namespace ProjectNomad {
                 RollbackStallInfo stallInfo = CheckIfShouldStallForRemoteInputs();
                 if (stallInfo.shouldStall) {
                     mRollbackUser.OnStallingForRemoteInputs(stallInfo);
+                    if constexpr (kRollbackPerfCountersEnabled) {
+                        mPerfCounters.OnStall(stallInfo);
+                    }
                     
                     numOfNewFramesToProcess = i; // Update number of frames we actually processed to be accurate for latter logic
                     break; //  Stop trying to process any frames or otherwise do any further updates here
                 }
 
-                // Try to retrieve input for this frame, if any
-                FrameType targetFrame = mRuntimeState.lastProcessedFrame + 1;
-                CharacterInput localPlayerInput = {};
-                bool wasAnyInputGiven = mRollbackUser.GetInputForNextFrame(targetFrame, localPlayerInput);
-                // Edge case: If no input given, then "user" doesn't want us to process any more frames.
-                //            Such as if this was using a replay file and the replay ran out of inputs
-                if (!wasAnyInputGiven) {
+                // Try to retrieve local input, if any. Input is stored for a later frame if using input delay
+                if (!TryStoreNextLocalInput()) {
+                    // Edge case: If no input given, then "user" doesn't want us to process any more frames.
+                    //            Such as if this was using a replay file and the replay ran out of inputs
                     numOfNewFramesToProcess = i; // Update number of frames we actually processed to be accurate for latter logic
                     break; //  Stop trying to process any frames or otherwise do any further updates here
                 }
-                
-                // Store input for given frame so can be retrieved as needed later on
-                mRuntimeState.inputManager.SetInputForPlayer(
-                    mLogger, targetFrame, mRollbackSettings.localPlayerSpot, localPlayerInput
-                );
 
                 // Actually do the processing for the "next" frame.
                 //      This is a generic method reused for "processing one more frame" during other contexts like
                 //      post-rollback re-processing of frames.
                 ProcessNextFrame(false, didRollbackOccur);
+                mInputDelayTuner.OnFrameProcessed();
 
                 // Do any necessary processing on the latest verified frame (if any).
                 //      "Verified frame" == frame that exits rollback window and thus expecting to be consistent between
@@ -301,7 +431,12 @@ namespace ProjectNomad {
             if (numOfNewFramesToProcess > 0) {
                 // Handle SyncTest *after* normal processing is done so we can redo the frames again and compare results
                 if (mRollbackSettings.useSyncTest) {
-                    HandleSyncTest();
+                    if (mRollbackSettings.useAsyncSyncTest) {
+                        HandleAsyncSyncTest();
+                    }
+                    else {
+                        HandleSyncTest();
+                    }
                     
                     // FUTURE: Mark didRollbackOccur = true so do PostRollback call as well (for a full render re-sync).
                     //         However, not strictly necessary for sync test since should have same results
@@ -310,27 +445,7 @@ namespace ProjectNomad {
 
                 // If playing multiplayer, then send (new) local player inputs to other players in session
                 if (IsMultiplayerMatch()) {
-                    // Since packets are sent via "UDP" (unreliable unordered), add many inputs per update packet.
-                    // In future, we only want to send a certain number of inputs to reduce packet size.
-                    // However for initial implementation simplicity, just always send many inputs at once.
-
-                    // Fill in inputs from newest to oldest (so index 0 is newest input)
-                    InputHistoryArray latestInputs = {};
-                    for (FrameType i = 0; i < kInputsHistorySize; i++) {
-                        FrameType targetFrame = mRuntimeState.lastProcessedFrame - i;
-
-                        const CharacterInput& localPlayerInput = mRuntimeState.inputManager.GetPlayerInputForFrame(
-                            mLogger, targetFrame, mRollbackSettings.localPlayerSpot
-                        );
-                        latestInputs[i] = localPlayerInput;
-
-                        // Edge case: If run out of inputs to send (like first few frames of gameplay), then stop
-                        if (targetFrame == 0) {
-                            break;
-                        }
-                    }
-                    
-                    mRollbackUser.SendLocalInputsToRemotePlayers(mRuntimeState.lastProcessedFrame, latestInputs);
+                    SendLocalInputsToRemotePlayers();
                 }
 
                 // Notify user of confirmed inputs (such as to help decide when to flush inputs to a replay file)
@@ -339,11 +454,11 @@ namespace ProjectNomad {
                     if (mRuntimeState.lastProcessedFrame >= curLocalRollbackRange) { // If beyond "initial" frames, then have frames we can confirm
                         // For simplified logic, just validate any frame once it exits the possible rollback range.
                         // (Technically we could consider inputs never changing for sync test and whatnot, but no need to complicate further)
-                        mRollbackUser.OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame - curLocalRollbackRange);
+                        OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame - curLocalRollbackRange);
                     }
                 }
                 else {
-                    mRollbackUser.OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame);
+                    OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame);
                 }
             }
 
@@ -353,6 +468,14 @@ namespace ProjectNomad {
                 mRollbackUser.OnPostRollback();
             }
 
+            mTimeManager.ReportFrameSimulationCost(
+                mTimeManager.GetCurrentTimeInMicroSec() - simulationStartTime, mFramesSimulatedThisTick
+            );
+            if constexpr (kRollbackPerfCountersEnabled) {
+                mPerfCounters.OnFramesProcessed(numOfNewFramesToProcess);
+                mPerfCounters.EndTick(mTimeManager.GetCurrentTimeInMicroSec() - tickStartTime);
+            }
+
             return numOfNewFramesToProcess;
         }
         
@@ -379,6 +502,45 @@ namespace ProjectNomad {
             // FUTURE: Maybe explicitly check that not in multiplayer session?
             
             mRuntimeState = snapshot;
+            // Frames may have jumped arbitrarily, so only pass frames on to replay writer again once next confirmed
+            mNextFrameToConfirm = std::numeric_limits<FrameType>::max();
+        }
+
+        /**
+        * Immediately processes given number of new frames without rendering, regardless of time passed.
+        * Intended for offline replay seeking after RestoreInternalStateSnapshot (see ReplaySeekIndex), so only
+        * supported in local sessions. Sync test, desync detection, and confirmed input notifications are skipped, as
+        * frames being fast forwarded through were already fully processed before.
+        * Confirmed inputs are still passed on to replay writer (if any) so it never ends up with a gap, unless internal
+        * state was just restored (as writer already received those frames before).
+        * Note that OnPostRollback is not called, so caller is expected to let user know when to update rendering.
+        * @param numOfFrames - number of frames to process
+        * @returns number of frames actually processed, which is less than requested if user ran out of inputs
+        **/
+        FrameType FastForwardFrames(FrameType numOfFrames) {
+            if (!mIsSessionRunning) {
+                mLogger.LogWarnMessage("Called while session not running!");
+                return 0;
+            }
+            if (IsMultiplayerMatch()) {
+                mLogger.LogWarnMessage("Fast forwarding is not supported in multiplayer sessions!");
+                return 0;
+            }
+
+            for (FrameType i = 0; i < numOfFrames; i++) {
+                if (!TryStoreNextLocalInput()) {
+                    return i;
+                }
+
+                // Snapshots are still stored as usual, as snapshot manager expects every frame (or interval) in order
+                ProcessNextFrame(false, true);
+
+                FrameType confirmedFrame = 0;
+                if (!IsFrameValueMax(mNextFrameToConfirm) && TryGetLatestConfirmedFrame(confirmedFrame)) {
+                    PassConfirmedInputsToReplayWriter(confirmedFrame);
+                }
+            }
+            return numOfFrames;
         }
 
         // Technically could just get internal state snapshot and retrieve this directly, but nice not to care so
@@ -387,6 +549,39 @@ namespace ProjectNomad {
             return mRuntimeState.snapshotManager.GetLatestFrameSnapshot();
         }
 
+        // Stats for current session, mainly intended for tuning RollbackSettings::snapshotInterval
+        const RollbackSnapshotStats& GetSnapshotStats() const {
+            return mSnapshotStats;
+        }
+
+        // Per-field misprediction stats for current session, mainly intended for tuning RollbackSettings::inputPrediction
+        InputPredictionStats GetInputPredictionStats() const {
+            return mRuntimeState.inputManager.GetCombinedPredictionStats();
+        }
+
+        /**
+        * Retrieves result of latest finished desync localization (see RollbackSettings::useDesyncLocalization)
+        * @param result - result of localization. Only valid if returned true
+        * @returns true if any localization finished during this session, false otherwise
+        **/
+        bool TryGetDesyncLocalizationResult(DesyncLocalizationResult& result) const {
+            if (!mDesyncLocalizer.HasResult()) {
+                return false;
+            }
+            result = mDesyncLocalizer.GetResult();
+            return true;
+        }
+
+        // Local input delay currently in use, which may change during session if input delay tuning is enabled
+        FrameType GetLocalInputDelay() const {
+            return mLocalInputDelay;
+        }
+
+        // Per-tick and rolling window timing breakdown. Only updated if NOMAD_ROLLBACK_PERF_COUNTERS is enabled
+        const RollbackPerfCounters& GetPerfCounters() const {
+            return mPerfCounters;
+        }
+
       private:
         bool AreSettingsValid(const RollbackSettings& rollbackSettings) const {
             if (PlayerSpotHelpers::IsInvalidTotalPlayers(rollbackSettings.totalPlayers)) {
@@ -411,6 +606,29 @@ namespace ProjectNomad {
                     );
                     return false;
                 }
+                if (rollbackSettings.useAsyncSyncTest && !mAsyncSyncTester.HasSyncTestUser()) {
+                    mLogger.LogWarnMessage("Async sync test requested but no sync test user was provided!");
+                    return false;
+                }
+                // Async sync test clones exact snapshots for its window, so it expects every frame to be stored
+                if (rollbackSettings.useAsyncSyncTest && rollbackSettings.snapshotInterval > 1) {
+                    mLogger.LogWarnMessage("Async sync test is not supported with a snapshot interval above 1!");
+                    return false;
+                }
+            }
+
+            if (rollbackSettings.useDesyncLocalization && !RollbackDesyncLocalizer<SnapshotType>::kIsSupported) {
+                mLogger.LogWarnMessage("Desync localization requested but snapshot type doesn't support it!");
+                return false;
+            }
+
+            if (rollbackSettings.snapshotInterval == 0
+                || rollbackSettings.snapshotInterval > RollbackStaticSettings::kMaxSnapshotInterval) {
+                mLogger.LogWarnMessage(
+                    "Provided snapshot interval is outside expected range. Provided: " +
+                    std::to_string(rollbackSettings.snapshotInterval)
+                );
+                return false;
             }
 
             // Assure that input delay is not outside expected range
@@ -419,6 +637,19 @@ namespace ProjectNomad {
                 mLogger.LogWarnMessage("Provided input delay is outside expected window: " + std::to_string(rollbackSettings.localInputDelay));
                 return false;
             }
+            const InputDelayTuningSettings& inputDelayTuning = rollbackSettings.inputDelayTuning;
+            if (inputDelayTuning.isEnabled) {
+                if (inputDelayTuning.minInputDelay > inputDelayTuning.maxInputDelay
+                    || inputDelayTuning.maxInputDelay > RollbackStaticSettings::kMaxInputDelay
+                    || inputDelayTuning.evaluationWindowFrames == 0) {
+                    mLogger.LogWarnMessage(
+                        "Invalid input delay tuning settings! Min: " + std::to_string(inputDelayTuning.minInputDelay) +
+                        ", max: " + std::to_string(inputDelayTuning.maxInputDelay) +
+                        ", evaluation window: " + std::to_string(inputDelayTuning.evaluationWindowFrames)
+                    );
+                    return false;
+                }
+            }
 
             // Multiplayer only checks
             if (rollbackSettings.IsMultiplayerSession()) {
@@ -466,9 +697,17 @@ namespace ProjectNomad {
             mRuntimeState = {};
             // Store the session info as a whole for direct reference at any time
             mRollbackSettings = rollbackSettings;
+            // Throw out any async sync test from a prior session, as result would be meaningless
+            mAsyncSyncTester.Reset();
+            mDesyncLocalizer.Reset();
+            mSnapshotStats = {};
+            mSnapshotStats.bytesPerSnapshot = sizeof(SnapshotType);
+            mLocalInputsAckedFrames = InputUpdateMessage::CreateNoAcks();
+            mPerfCounters.Reset();
+            mNextFrameToConfirm = 0;
 
             // Setup relevant managers
-            if (!mRuntimeState.snapshotManager.OnSessionStart()) {
+            if (!mRuntimeState.snapshotManager.OnSessionStart(rollbackSettings.snapshotInterval)) {
                 mLogger.LogWarnMessage("Snapshot manager setup failed!");
                 return false;
             }
@@ -476,10 +715,83 @@ namespace ProjectNomad {
                 mLogger.LogWarnMessage("Input manager setup failed!");
                 return false;
             }
+
+            // Input delay only exists to hide network latency, so don't add any lag to single player
+            mLocalInputDelay = 0;
+            FrameType initialInputDelay = 0;
+            InputDelayTuningSettings inputDelayTuning = {}; // Disabled by default
+            if (IsMultiplayerMatch()) {
+                initialInputDelay = static_cast<FrameType>(rollbackSettings.localInputDelay); // Validated as non-negative
+                inputDelayTuning = rollbackSettings.inputDelayTuning;
+                if (inputDelayTuning.isEnabled) {
+                    initialInputDelay = std::clamp(initialInputDelay, inputDelayTuning.minInputDelay, inputDelayTuning.maxInputDelay);
+                }
+            }
+            mInputDelayTuner.OnSessionStart(inputDelayTuning, initialInputDelay);
+            // Nothing was pressed before session start, so frames within initial delay simply use empty inputs
+            for (FrameType i = 0; i < initialInputDelay; i++) {
+                StoreLocalInputForNextDelayedFrame({});
+            }
             
             return true;
         }
 
+        /**
+        * Retrieves next local input from user and stores it for the frame it'll be used on (ie, current input delay
+        * frames after the next frame to process). Input delay changes are applied here, as this is the only point at
+        * which local inputs are added:
+        *   - Increasing delay stores one extra filler frame which holds the latest input's axes + camera (as if they
+        *     were held a frame longer), but not its commands or UI choice so those are never applied twice
+        *   - Decreasing delay skips retrieving input once, as input for the next frame to process is already stored
+        * Thus every input retrieved from user is used for exactly one frame, and no frame is ever missing local input.
+        * @returns false if user had no input (ie, shouldn't process any more frames), true otherwise
+        **/
+        bool TryStoreNextLocalInput() {
+            const FrameType targetInputDelay = mInputDelayTuner.GetTargetInputDelay();
+            if (targetInputDelay < mLocalInputDelay) {
+                mLocalInputDelay--;
+                return true;
+            }
+            if (targetInputDelay > mLocalInputDelay) {
+                const FrameType latestInputFrame = GetNextLocalInputFrame() - 1;
+                CharacterInput latestInput = {};
+                if (!IsFrameValueMax(latestInputFrame)) { // Otherwise no input stored yet
+                    latestInput = mRuntimeState.inputManager.GetPlayerInputForFrame(
+                        mLogger, latestInputFrame, mRollbackSettings.localPlayerSpot
+                    );
+                }
+                latestInput.commandInputs = {};
+                latestInput.uiChoice = GameplayInteractiveUIChoice::None;
+                StoreLocalInputForNextDelayedFrame(latestInput);
+            }
+
+            CharacterInput localPlayerInput = {};
+            if (!mRollbackUser.GetInputForNextFrame(GetNextLocalInputFrame(), localPlayerInput)) {
+                return false;
+            }
+            // Remote players only receive quantized inputs (see InputUpdateMessageEncoding), so must simulate
+            //      with the exact same quantized input locally to stay in sync
+            if (IsMultiplayerMatch()) {
+                CharacterInputQuantizer::Quantize(localPlayerInput);
+            }
+
+            // Store input for given frame so can be retrieved as needed later on
+            mRuntimeState.inputManager.SetInputForPlayer(
+                mLogger, GetNextLocalInputFrame(), mRollbackSettings.localPlayerSpot, localPlayerInput
+            );
+            return true;
+        }
+        void StoreLocalInputForNextDelayedFrame(const CharacterInput& input) {
+            mRuntimeState.inputManager.SetInputForPlayer(
+                mLogger, GetNextLocalInputFrame(), mRollbackSettings.localPlayerSpot, input
+            );
+            mLocalInputDelay++;
+        }
+        // Local inputs are stored ahead of processing by input delay frames, so this is past next frame to process
+        FrameType GetNextLocalInputFrame() const {
+            return mRuntimeState.inputManager.GetLastStoredFrameForPlayer(mLogger, mRollbackSettings.localPlayerSpot) + 1;
+        }
+
         bool IsMultiplayerMatch() const { // Just for readability and not needing to remember where this is stored
             return mRollbackSettings.IsMultiplayerSession();
         }
@@ -488,6 +800,61 @@ namespace ProjectNomad {
             return mRollbackSettings.localPlayerSpot == mRollbackSettings.hostPlayerSpot;
         }
 
+        /**
+        * Sends local inputs which haven't been acknowledged by every remote player yet, along with our own acks.
+        * Inputs are sent via "UDP" (unreliable unordered), so unacknowledged inputs are resent until acked. Thus a lost
+        * packet is covered by the next one, while steady state packets only hold the last round trip's worth of inputs.
+        **/
+        void SendLocalInputsToRemotePlayers() {
+            // Includes inputs stored ahead due to input delay, as that head start is the whole point of input delay
+            const FrameType updateFrame = GetNextLocalInputFrame() - 1;
+
+            InputUpdateMessage message = {};
+            message.updateFrame = updateFrame;
+
+            // Find how far back the furthest behind remote player is, and fill in our acks for each remote player
+            FrameType numUnackedFrames = 1; // Always send at least latest input, so acks and latest frame still go out
+            for (uint8_t i = 0; i < mRollbackSettings.totalPlayers; i++) {
+                const PlayerSpot playerSpot = static_cast<PlayerSpot>(i);
+                if (playerSpot == mRollbackSettings.localPlayerSpot) {
+                    continue;
+                }
+
+                message.ackedFrames[i] = mRuntimeState.inputManager.GetLastStoredFrameForPlayer(mLogger, playerSpot);
+
+                const FrameType ackedFrame = mLocalInputsAckedFrames[i];
+                if (IsFrameValueMax(ackedFrame)) { // Nothing acked yet, so need to send everything
+                    numUnackedFrames = kInputsHistorySize;
+                }
+                else if (updateFrame > ackedFrame) {
+                    numUnackedFrames = std::max(numUnackedFrames, updateFrame - ackedFrame);
+                }
+            }
+
+            // Can't send more than fits in message (remote player will stall until they catch up anyways), nor more
+            //      frames than exist yet
+            message.numInputs = std::min({numUnackedFrames, kInputsHistorySize, updateFrame + 1});
+
+            // Fill in inputs from newest to oldest (so index 0 is newest input)
+            for (FrameType i = 0; i < message.numInputs; i++) {
+                message.playerInputs[i] = mRuntimeState.inputManager.GetPlayerInputForFrame(
+                    mLogger, updateFrame - i, mRollbackSettings.localPlayerSpot
+                );
+            }
+
+            mRollbackUser.SendLocalInputsToRemotePlayers(message);
+        }
+        void RecordLocalInputsAck(PlayerSpot remotePlayerSpot, FrameType ackedFrame) {
+            if (IsFrameValueMax(ackedFrame)) { // Remote player hasn't received any of our inputs yet
+                return;
+            }
+
+            FrameType& latestAckedFrame = mLocalInputsAckedFrames[static_cast<size_t>(remotePlayerSpot)];
+            if (IsFrameValueMax(latestAckedFrame) || ackedFrame > latestAckedFrame) {
+                latestAckedFrame = ackedFrame;
+            }
+        }
+
         /**
         * Actually do gameplay update for next frame
         * @param skipSnapshotCreation - true if should skip snapshot creation, such as when re-processing the first
@@ -498,24 +865,63 @@ namespace ProjectNomad {
             FrameType targetFrame = mRuntimeState.lastProcessedFrame + 1; // Don't take this as an input to assure we always do the "next" frame
 
             if (!skipSnapshotCreation) {
-                // Store game state at START of frame.
-                // This works around how to re-process first (0th) frame and thus how to rollback to before then
-                StoreSnapshot(targetFrame);
+                if (ShouldStoreSnapshotForFrame(targetFrame)) {
+                    // Store game state at START of frame.
+                    // This works around how to re-process first (0th) frame and thus how to rollback to before then
+                    StoreSnapshot(targetFrame);
+                }
+                else {
+                    mSnapshotStats.snapshotsSkipped++;
+                }
             }
             
             // Grab input(s) for updating game
-            PlayerInputsForFrame inputsForFrame = mRuntimeState.inputManager.GetInputsForFrame(mLogger, targetFrame);
+            PlayerInputsForFrame inputsForFrame = mRuntimeState.inputManager.GetInputsForFrameToProcess(mLogger, targetFrame);
 
             // Update game. Note that this is also expected to increment RollbackUser's frame tracking as well
+            const uint64_t processStartTime = StartPerfTimer();
             if (!didRollbackOccur) {
                 mRollbackUser.ProcessFrame(targetFrame, inputsForFrame);
+                StopPerfTimer(RollbackPerfTimer::ProcessFrame, processStartTime);
             }
             else {
                 mRollbackUser.ProcessFrameWithoutRendering(targetFrame, inputsForFrame);
+                StopPerfTimer(RollbackPerfTimer::ProcessFrameWithoutRendering, processStartTime);
             }
 
             // Finally internally remember that we processed this frame
             mRuntimeState.lastProcessedFrame = targetFrame;
+            mFramesSimulatedThisTick++;
+        }
+
+        /**
+        * Rolls back to earliest mispredicted frame, if any, then re-processes up to current frame
+        * @returns true if a rollback occurred, false otherwise
+        **/
+        bool HandleRollbackForMispredictionsIfAny() {
+            const FrameType firstFrameToReprocess = mRuntimeState.earliestMispredictedFrame;
+            if (IsFrameValueMax(firstFrameToReprocess)) { // No known misprediction
+                return false;
+            }
+            
+            // Clear misprediction tracking first, as re-processing frames will use the latest inputs anyways
+            mRuntimeState.earliestMispredictedFrame = std::numeric_limits<FrameType>::max();
+            if (firstFrameToReprocess <= mRuntimeState.lastProcessedFrame) { // Otherwise invalid, see sanity check below
+                mInputDelayTuner.RecordRollback(mRuntimeState.lastProcessedFrame - firstFrameToReprocess + 1);
+            }
+
+            // Sanity check: A misprediction is only detected for frames that were already processed
+            if (firstFrameToReprocess > mRuntimeState.lastProcessedFrame) {
+                mLogger.LogWarnMessage(
+                    "Mispredicted frame was never processed! Last processed frame: " +
+                    std::to_string(mRuntimeState.lastProcessedFrame) + ", mispredicted frame: " +
+                    std::to_string(firstFrameToReprocess)
+                );
+                return false;
+            }
+
+            HandleRollback(firstFrameToReprocess);
+            return true;
         }
 
         void HandleSyncTest() {
@@ -530,7 +936,9 @@ namespace ProjectNomad {
             }
             
             // Grab current snapshot's checksum so we know what to compare against
-            uint32_t preTestSnapshotChecksum = mRuntimeState.snapshotManager.GetSnapshot(mRuntimeState.lastProcessedFrame).CalculateChecksum();
+            uint64_t checksumStartTime = StartPerfTimer();
+            uint32_t preTestSnapshotChecksum = GetSyncTestChecksumForLatestFrame();
+            StopPerfTimer(RollbackPerfTimer::Checksum, checksumStartTime);
             
             // Do normal rollback process
             // Note that OnFixedGameplayUpdate() doesn't care that we call HandleRollback here as we expect no different
@@ -539,7 +947,9 @@ namespace ProjectNomad {
             HandleRollback(firstFrameToReprocess);
 
             // Finally compare hashes and output result
-            uint32_t postTestSnapshotChecksum = mRuntimeState.snapshotManager.GetSnapshot(mRuntimeState.lastProcessedFrame).CalculateChecksum();
+            checksumStartTime = StartPerfTimer();
+            uint32_t postTestSnapshotChecksum = GetSyncTestChecksumForLatestFrame();
+            StopPerfTimer(RollbackPerfTimer::Checksum, checksumStartTime);
             if (preTestSnapshotChecksum != postTestSnapshotChecksum) {
                 mLogger.LogWarnMessage(
                     "RollbackManager::HandleSyncTest",
@@ -557,6 +967,75 @@ namespace ProjectNomad {
             }
         }
 
+        uint32_t GetSyncTestChecksumForLatestFrame() {
+            // Every frame has a stored snapshot, so just use what's already stored
+            if (mRollbackSettings.snapshotInterval <= 1) {
+                return mRuntimeState.snapshotManager.GetSnapshot(mRuntimeState.lastProcessedFrame).GetChecksum();
+            }
+
+            // Otherwise latest frame may not have a stored snapshot, so generate a throwaway one for current state
+            //      instead. Extra cost is fine as sync test is a debug feature anyways.
+            SnapshotType currentStateSnapshot = {};
+            mRollbackUser.GenerateSnapshot(mRuntimeState.lastProcessedFrame + 1, currentStateSnapshot);
+            return currentStateSnapshot.GetChecksum();
+        }
+
+        /**
+        * Same as HandleSyncTest, except the re-simulation is handed off to a background thread using cloned state.
+        * Thus the game itself is never rolled back and the result is only checked on a later update.
+        **/
+        void HandleAsyncSyncTest() {
+            // Check result of prior test first, which also frees the tester up for a new test
+            HandleAsyncSyncTestResultIfAny();
+            
+            // If in initial frames - so can't rollback far enough - then don't bother testing
+            if (mRuntimeState.lastProcessedFrame < mRollbackSettings.syncTestFrames) {
+                return;
+            }
+            // If prior test is still running then just skip testing this time rather than waiting on it
+            if (!mAsyncSyncTester.IsReadyForNewTest()) {
+                return;
+            }
+
+            // Clone all necessary state for re-simulation.
+            //      Snapshot for start of latest processed frame is compared against, so only need to re-process frames
+            //      up to (but not including) latest processed frame.
+            const FrameType firstFrameToReprocess = mRuntimeState.lastProcessedFrame - mRollbackSettings.syncTestFrames;
+            const FrameType numOfFramesToProcess = mRollbackSettings.syncTestFrames;
+            
+            mAsyncSyncTester.GetSnapshotToRestoreForNewTest() = mRuntimeState.snapshotManager.GetSnapshot(firstFrameToReprocess);
+            mAsyncSyncTester.GetSnapshotToCompareForNewTest() = mRuntimeState.snapshotManager.GetSnapshot(mRuntimeState.lastProcessedFrame);
+            for (FrameType i = 0; i < numOfFramesToProcess; i++) {
+                mAsyncSyncTester.GetInputsForNewTest(i) =
+                    mRuntimeState.inputManager.GetInputsForFrame(mLogger, firstFrameToReprocess + i);
+            }
+
+            if (!mAsyncSyncTester.StartTest(firstFrameToReprocess, numOfFramesToProcess)) {
+                mLogger.LogWarnMessage("Failed to start async sync test for frame " + std::to_string(mRuntimeState.lastProcessedFrame));
+            }
+        }
+
+        void HandleAsyncSyncTestResultIfAny() {
+            AsyncSyncTestResult result = {};
+            if (!mAsyncSyncTester.TryTakeResult(result)) {
+                return;
+            }
+            
+            if (!result.DidPass()) {
+                mLogger.LogWarnMessage(
+                    "RollbackManager::HandleAsyncSyncTest",
+                    "SyncTest failed for frame " + std::to_string(result.testedFrame)
+                );
+            }
+            if (mRollbackSettings.logSyncTestChecksums) {
+                mLogger.LogInfoMessage(
+                    "RollbackManager::HandleAsyncSyncTest",
+                    "Frame " + std::to_string(result.testedFrame) + " Checksum Pre: " +
+                    std::to_string(result.originalChecksum) + " | Post: " + std::to_string(result.resimulatedChecksum)
+                );
+            }
+        }
+
         /**
         * Handles process of rolling back then re-processing relevant frames. Relevant inputs are expected to be stored
         * before calling this method.
@@ -585,11 +1064,30 @@ namespace ProjectNomad {
                 return;
             }
             
+            // Find the nearest stored snapshot to restore, as not every frame may have a snapshot stored.
+            //      Any frames between that snapshot and first frame to re-process will be re-processed as well.
+            const FrameType frameToRestore = mRuntimeState.snapshotManager.GetNearestStoredFrameAtOrBefore(firstFrameToReprocess);
+            if (IsFrameValueMax(frameToRestore)) {
+                mLogger.LogErrorMessage(
+                    "RollbackManager::HandleRollback",
+                    "No stored snapshot at or before frame to re-process! Input frame: " + std::to_string(firstFrameToReprocess)
+                );
+                return;
+            }
+            const FrameType numOfFramesToResimulate = mRuntimeState.lastProcessedFrame - frameToRestore + 1;
+            
+            mSnapshotStats.rollbacks++;
+            mSnapshotStats.framesResimulated += numOfFramesToResimulate;
+            mSnapshotStats.extraFramesResimulated += numOfFramesToResimulate - numOfFramesToProcess;
+            if constexpr (kRollbackPerfCountersEnabled) {
+                mPerfCounters.OnRollback(numOfFramesToResimulate);
+            }
+            
             // 1. Restore snapshot before the first frame we want to reprocess
-            RestoreSnapshot(firstFrameToReprocess);
+            RestoreSnapshot(frameToRestore);
             
             // 2. Simply reprocess all needed frames
-            for (FrameType i = 0; i < numOfFramesToProcess; i++) {
+            for (FrameType i = 0; i < numOfFramesToResimulate; i++) {
                 // Skip snapshot creation for first frame as it'll be identical to what's already stored and been restored,
                 // since snapshots are stored at the start of a frame
                 bool skipSnapshotCreation = i == 0;
@@ -619,16 +1117,29 @@ namespace ProjectNomad {
                 return;
             }
 
-            {   // Create then swap-replace insert snapshot.
+            const uint64_t generationStartTime = StartPerfTimer();
+            if constexpr (GeneratesSnapshotInPlace<SnapshotType>) {
+                // Generate directly into recycled buffer slot so any existing (heap) capacity is reused
+                mRuntimeState.snapshotManager.StoreSnapshotInPlace(targetFrame, [this, targetFrame](SnapshotType& slot) {
+                    mRollbackUser.GenerateSnapshot(targetFrame, slot);
+                });
+            }
+            else {  // Create then swap-replace insert snapshot.
                 //      Using scope delimiters to make explicit that variable should NOT be used after this cuz of the
                 //      store call using swap-replace.
                 SnapshotType snapshot = {}; 
                 mRollbackUser.GenerateSnapshot(targetFrame, snapshot);
                 mRuntimeState.snapshotManager.StoreSnapshot(targetFrame, snapshot); 
             }
+            mSnapshotStats.totalSnapshotGenerationTimeInMicroSec +=
+                StopPerfTimer(RollbackPerfTimer::GenerateSnapshot, generationStartTime);
+
+            mSnapshotStats.snapshotsStored++;
+            const FrameType oldestRollbackFrame = targetFrame - std::min(targetFrame, RollbackStaticSettings::kMaxRollbackFrames);
+            mSnapshotStats.snapshotsInRollbackWindow = mRuntimeState.snapshotManager.GetStoredSnapshotCountSince(oldestRollbackFrame);
 
             if (mRollbackSettings.logChecksumForEveryStoredFrameSnapshot) {
-                uint32_t curSnapshotChecksum = mRuntimeState.snapshotManager.GetSnapshot(targetFrame).CalculateChecksum();
+                uint32_t curSnapshotChecksum = mRuntimeState.snapshotManager.GetSnapshot(targetFrame).GetChecksum();
                 mLogger.LogInfoMessage(
                     "RollbackManager::StoreSnapshot",
                     "Frame " + std::to_string(targetFrame) + ": " + std::to_string(curSnapshotChecksum)
@@ -654,8 +1165,10 @@ namespace ProjectNomad {
             }
             
             // Get and restore game snapshot
+            const uint64_t restoreStartTime = StartPerfTimer();
             const SnapshotType& snapshot = mRuntimeState.snapshotManager.GetSnapshot(frameToReprocess);
             mRollbackUser.RestoreSnapshot(frameToReprocess, snapshot);
+            StopPerfTimer(RollbackPerfTimer::RestoreSnapshot, restoreStartTime);
 
             // Also update necessary internal state, which is just this manager's frame tracking at the moment.
             //  Yes, at time of writing ALL other rollback state is either history based (so shouldn't be overwritten)
@@ -663,6 +1176,42 @@ namespace ProjectNomad {
             mRuntimeState.lastProcessedFrame = frameToReprocess - 1;
         }
 
+        /**
+        * Passes newly confirmed inputs on to replay writer (if any), then notifies user.
+        * Only called once per tick even if multiple frames were processed, so writer may receive multiple frames at once.
+        * @param confirmedFrame - frame that inputs have been fully validated up to (inclusive)
+        **/
+        void OnInputsExitRollbackWindow(FrameType confirmedFrame) {
+            PassConfirmedInputsToReplayWriter(confirmedFrame);
+
+            mRollbackUser.OnInputsExitRollbackWindow(confirmedFrame);
+        }
+        void PassConfirmedInputsToReplayWriter(FrameType confirmedFrame) {
+            if (IsFrameValueMax(mNextFrameToConfirm)) { // Internal state was restored
+                mNextFrameToConfirm = confirmedFrame;
+            }
+            if (mReplayWriter && mReplayWriter->IsOpen()) {
+                for (FrameType frame = mNextFrameToConfirm; frame <= confirmedFrame; frame++) {
+                    mReplayWriter->AddFrame(mLogger, frame, mRuntimeState.inputManager.GetInputsForFrame(mLogger, frame));
+                }
+            }
+            mNextFrameToConfirm = confirmedFrame + 1;
+        }
+        /**
+        * Retrieves latest frame whose inputs have exited the rollback window, same as DoPostNewGameplayFramesProcessing
+        * @param result - latest confirmed frame. Only valid if returned true
+        * @returns false if no frame is confirmed yet (ie, still within initial frames of session)
+        **/
+        bool TryGetLatestConfirmedFrame(FrameType& result) const {
+            const FrameType curLocalRollbackRange = GetCurrentMaxPossibleRollbackFrames();
+            if (mRuntimeState.lastProcessedFrame < curLocalRollbackRange) {
+                return false;
+            }
+
+            result = mRuntimeState.lastProcessedFrame - curLocalRollbackRange;
+            return true;
+        }
+
         // Called to do one-time processing after any new gameplay  frames
         void DoPostNewGameplayFramesProcessing() {
             // Sanity check
@@ -678,13 +1227,32 @@ namespace ProjectNomad {
                 if (mRuntimeState.lastProcessedFrame >= curLocalRollbackRange) { // If beyond "initial" frames, then have frames we can confirm
                     // For simplified logic, just validate any frame once it exits the possible rollback range.
                     // (Technically we could consider inputs never changing for synctest and whatnot, but no need to complicate further)
-                    mRollbackUser.OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame - curLocalRollbackRange);
+                    OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame - curLocalRollbackRange);
                 }
             }
             // Otherwise not using any form of rollback at all in the current session, so immediately validate every frame
             else {
-                mRollbackUser.OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame);
+                OnInputsExitRollbackWindow(mRuntimeState.lastProcessedFrame);
+            }
+        }
+
+        /**
+        * Checks whether a snapshot should be stored for the start of the given frame, as snapshots may not be stored
+        * every frame (see RollbackSettings::snapshotInterval)
+        * @param targetFrame - frame that is about to be processed
+        * @returns true if snapshot should be generated and stored
+        **/
+        bool ShouldStoreSnapshotForFrame(FrameType targetFrame) const {
+            if (targetFrame % mRollbackSettings.snapshotInterval == 0) { // Includes initial frame and interval of 1
+                return true;
+            }
+            
+            // Desync detection needs exact snapshot for each checked frame (see HandleLatestVerifiedFrame)
+            if (IsMultiplayerMatch() && targetFrame % RollbackStaticSettings::kDesyncDetectionFrequency == 0) {
+                return true;
             }
+
+            return false;
         }
 
         FrameType GetCurrentMaxPossibleRollbackFrames() const {
@@ -710,6 +1278,27 @@ namespace ProjectNomad {
             return frame == std::numeric_limits<FrameType>::max();
         }
 
+        // Perf counter timing helpers. Both compile to nothing if perf counters are compiled out
+        uint64_t StartPerfTimer() const {
+            if constexpr (kRollbackPerfCountersEnabled) {
+                return mTimeManager.GetCurrentTimeInMicroSec();
+            }
+            else {
+                return 0;
+            }
+        }
+        // Returns measured time for callers which also track it elsewhere, which is 0 if perf counters are compiled out
+        uint64_t StopPerfTimer(RollbackPerfTimer timer, uint64_t startTime) {
+            if constexpr (kRollbackPerfCountersEnabled) {
+                const uint64_t elapsedTime = mTimeManager.GetCurrentTimeInMicroSec() - startTime;
+                mPerfCounters.AddTime(timer, elapsedTime);
+                return elapsedTime;
+            }
+            else {
+                return 0;
+            }
+        }
+
         RollbackStallInfo CheckIfShouldStallForRemoteInputs() const {
             if (!IsMultiplayerMatch()) { // Stalling is only done during multiplayer games
                 return RollbackStallInfo::NoStall();
@@ -775,8 +1364,16 @@ namespace ProjectNomad {
             //      and likely not worth the effort. After all, desyncs should be rare.
             if (IsMultiplayerMatch() && latestVerifiedFrame % RollbackStaticSettings::kDesyncDetectionFrequency == 0) {
                 // Calculate checksum for the verified frame (whose snapshot should still be stored)
-                //      FUTURE: Would be nice to implement caching of some sort?
-                uint32_t verifiedFrameChecksum = mRuntimeState.snapshotManager.GetSnapshot(latestVerifiedFrame).CalculateChecksum();
+                //      Note that this is cached per snapshot, and may even be provided during snapshot generation
+                const uint64_t checksumStartTime = StartPerfTimer();
+                const SnapshotType& verifiedFrameSnapshot = mRuntimeState.snapshotManager.GetSnapshot(latestVerifiedFrame);
+                uint32_t verifiedFrameChecksum = verifiedFrameSnapshot.GetChecksum();
+                StopPerfTimer(RollbackPerfTimer::Checksum, checksumStartTime);
+
+                // Snapshot will leave rollback window long before any desync localization could finish, so keep a copy
+                if (IsDesyncLocalizationActive()) {
+                    mDesyncLocalizer.RetainSnapshot(latestVerifiedFrame, verifiedFrameSnapshot);
+                }
                 
                 // Send checksum to peers so they can do their desync detection as appropriate
                 mRollbackUser.SendValidationChecksum(latestVerifiedFrame, verifiedFrameChecksum);
@@ -826,12 +1423,30 @@ namespace ProjectNomad {
                     + std::to_string(mRuntimeState.desyncChecker.GetCurrentTargetFrame())
                 );
 
+                // Find out what actually diverged, while both sides still have a snapshot for this frame
+                DesyncLocalizationRequestMessage firstRequest;
+                if (IsDesyncLocalizationActive() &&
+                    mDesyncLocalizer.TryStart(mLogger, mRuntimeState.desyncChecker.GetCurrentTargetFrame(), firstRequest)) {
+                    mRollbackUser.SendDesyncLocalizationRequestToHost(firstRequest);
+                }
+
                 // TODO: Proper desync handling
                 //      - Should disconnect from match and notify player (eg, error popup with debug help instructions perhaps)
                 //      - Store replay perhaps or other stuff
             }
         }
+
+        bool IsDesyncLocalizationActive() const {
+            if constexpr (RollbackDesyncLocalizer<SnapshotType>::kIsSupported) {
+                return mIsSessionRunning && IsMultiplayerMatch() && mRollbackSettings.useDesyncLocalization;
+            }
+            else {
+                return false;
+            }
+        }
         
+        static constexpr uint64_t kTimePerFrameInMicroSec = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+
         LoggerSingleton& mLogger = Singleton<LoggerSingleton>::get();
         RollbackUser<SnapshotType>& mRollbackUser;
 
@@ -839,6 +1454,18 @@ namespace ProjectNomad {
         
         bool mIsSessionRunning = false;
         RollbackTimeManager mTimeManager = {}; // Assuming no need to be in rollback-able runtime state atm, including pausing + resuming
+        RollbackInputDelayTuner mInputDelayTuner = {};
+        FrameType mLocalInputDelay = 0; // Frames that local inputs are stored ahead of the next frame to process
+        FrameType mFramesSimulatedThisTick = 0; // Includes re-simulated frames, for time manager's frame cost tracking
         RollbackRuntimeState<SnapshotType> mRuntimeState = {};
+        RollbackAsyncSyncTester<SnapshotType> mAsyncSyncTester; // Only used if async sync test is enabled
+        RollbackDesyncLocalizer<SnapshotType> mDesyncLocalizer = {}; // Only used if desync localization is enabled
+        ReplayWriter* mReplayWriter = nullptr; // Optional, owned by user
+        FrameType mNextFrameToConfirm = 0; // Next frame to pass on to replay writer once its inputs exit rollback window
+        RollbackSnapshotStats mSnapshotStats = {};
+        RollbackPerfCounters mPerfCounters = {}; // Stays zeroed out if perf counters are compiled out
+        // Per remote player, latest frame they've acknowledged receiving all our local inputs up to. Not part of runtime
+        //      state as purely network bookkeeping, which doesn't need to be rolled back
+        InputAckArray mLocalInputsAckedFrames = InputUpdateMessage::CreateNoAcks();
     };
 }
@@ -2,6 +2,7 @@
 #include "Input/CharacterInput.h"
 #include "Input/PlayerInputsForFrame.h"
 #include "Model/RollbackStallInfo.h"
+#include "Network/P2PMessages/NetMessagesDesyncLocalization.h"
 #include "Network/P2PMessages/NetMessagesInput.h"
 #include "Utilities/FrameType.h"
 
@@ -21,14 +22,19 @@ namespace ProjectNomad {
         * Generates snapshot for start of frame. This will be used with RestoreSnapshot when rollback occurs.
         * @param expectedFrame - frame number of snapshot. Called before frame number is processed (ie, before ProcessFrame
         *                        is called for related frame). Only intended for debug assistance
-        * @param result - represents snapshot of current frame. Can be assumed to be "empty"/default initializer state
+        * @param result - represents snapshot of current frame. Can be assumed to be "empty"/default initializer state,
+        *                 unless SnapshotType opts into in-place generation (see GeneratesSnapshotInPlace). In that case
+        *                 this is a recycled buffer slot still holding an older snapshot, which must be fully
+        *                 overwritten (ideally reusing existing capacity, such as via assign/clear + insert)
         **/
         virtual void GenerateSnapshot(FrameType expectedFrame, SnapshotType& result) = 0;
         /**
         * Callback to restore the gameplay state from the provided snapshot.
         * This is the "rollback to previous state" part of the rollback library.
         * @param expectedFrame - frame number of snapshot. Only intended for debug assistance
-        * @param snapshotToRestore - represents gameplay snapshot that should be used going forward
+        * @param snapshotToRestore - represents gameplay snapshot that should be used going forward. This is the stored
+        *                            snapshot itself rather than a copy, and it may be restored again later. Thus copy-assign
+        *                            into existing gameplay state (which reuses capacity) rather than moving from it
         **/
         virtual void RestoreSnapshot(FrameType expectedFrame, const SnapshotType& snapshotToRestore) = 0;
 
@@ -36,7 +42,8 @@ namespace ProjectNomad {
         * Called to retrieve input for next frame.
         * Intended to be an abstraction so user can either provide current actual input for next frame or input from
         * a replay file.
-        * @param expectedFrame - Expected frame to retrieve input for. Useful for sanity checking
+        * @param expectedFrame - Expected frame to retrieve input for. Useful for sanity checking. Note that this is
+        *                        ahead of the next frame to process when using input delay (see RollbackSettings)
         * @param result - input for next frame, if any
         * @returns true if input for next frame was found, false otherwise (ie, if should stop trying to process new frames).
         *           Intended to support stopping new frame updating if replay is used and replay runs out of inputs. 
@@ -77,8 +84,27 @@ namespace ProjectNomad {
         * @param checksum - Checksum from snapshot for target frame
         **/
         virtual void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) = 0;
+        /**
+        * Send desync localization request to host only (see RollbackSettings::useDesyncLocalization). Expected to be
+        * sent reliably, as localization simply stops if any message is lost.
+        * Only called if desync localization is enabled, so users which never enable it don't need to implement this.
+        * @param message - message to send as is
+        **/
+        virtual void SendDesyncLocalizationRequestToHost(const DesyncLocalizationRequestMessage& message) {}
+        /**
+        * Send answer to a desync localization request back to the peer that requested it. Expected to be sent reliably.
+        * Same as SendDesyncLocalizationRequestToHost, only called if desync localization is enabled.
+        * @param requesterSpot - player spot of peer which sent the request
+        * @param message - message to send as is
+        **/
+        virtual void SendDesyncLocalizationResponse(PlayerSpot requesterSpot, const DesyncLocalizationResponseMessage& message) {}
         
-        virtual void SendLocalInputsToRemotePlayers(FrameType updateFrame, const InputHistoryArray& playerInputs) = 0;
+        /**
+        * Send local player's latest inputs to all peers. Expected to be sent via "UDP" (unreliable unordered), as
+        * inputs are resent until peers acknowledge them.
+        * @param message - message to send as is. Only includes inputs which haven't been acknowledged by all peers yet
+        **/
+        virtual void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) = 0;
         virtual void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) = 0;
         
         /**
@@ -86,7 +112,8 @@ namespace ProjectNomad {
         * otherwise changed.
         *
         * Intended purpose is writing inputs to a replay file once we're confident they won't change, which is
-        * particularly relevant for multiplayer games.
+        * particularly relevant for multiplayer games. See RollbackManager::SetReplayWriter for a ready made replay
+        * format, in which case inputs up to confirmedFrame are already added to the writer when this is called.
         * @param confirmedFrame - frame that inputs have been fully validated up to (inclusive)
         **/
         virtual void OnInputsExitRollbackWindow(FrameType confirmedFrame) = 0;
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ProjectNomad {
+    /**
+    * Appends values with arbitrary bit widths to a byte buffer, such as for compact network message encoding.
+    * Bits are written least significant bit first, so output is identical regardless of platform endianness.
+    **/
+    class BitWriter {
+      public:
+        /**
+        * @param target - buffer to write to. Any existing contents are cleared, but capacity is retained so that a
+        *                 reused buffer does not allocate in steady state.
+        **/
+        explicit BitWriter(std::vector<uint8_t>& target) : mTarget(target) {
+            mTarget.clear();
+        }
+
+        /**
+        * Appends lowest numBits bits of given value
+        * @param value - value to write. Any bits above numBits are ignored
+        * @param numBits - number of bits to write, expected to be in range [0, 64]
+        **/
+        void WriteBits(uint64_t value, uint32_t numBits) {
+            for (uint32_t i = 0; i < numBits; i++) {
+                if (mBitOffset == 0) {
+                    mTarget.push_back(0);
+                }
+
+                if ((value >> i) & 1) {
+                    mTarget.back() |= static_cast<uint8_t>(1 << mBitOffset);
+                }
+                mBitOffset = (mBitOffset + 1) % 8;
+            }
+        }
+        void WriteBool(bool value) {
+            WriteBits(value ? 1 : 0, 1);
+        }
+
+        /**
+        * Writes a signed value using as few bits as possible, with a fixed size prefix for the number of bits.
+        * Intended for deltas which are usually close to 0.
+        * @param value - value to write
+        **/
+        void WriteVarSigned(int64_t value) {
+            // Zigzag encode so small negative values also use few bits (0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...)
+            const uint64_t zigzagValue = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+            WriteVarUnsigned(zigzagValue);
+        }
+        /**
+        * Writes an unsigned value using as few bits as possible, with a fixed size prefix for the number of bits.
+        * Intended for values which are usually small, such as counts or lengths.
+        * @param value - value to write
+        **/
+        void WriteVarUnsigned(uint64_t value) {
+            uint32_t numBits = 0;
+            while (numBits < 64 && (value >> numBits) != 0) {
+                numBits++;
+            }
+
+            WriteBits(numBits, kVarLengthPrefixBits);
+            WriteBits(value, numBits);
+        }
+
+        size_t GetSizeInBytes() const {
+            return mTarget.size();
+        }
+
+        // Bits needed to store a length of 0 through 64
+        static constexpr uint32_t kVarLengthPrefixBits = 7;
+
+      private:
+        std::vector<uint8_t>& mTarget;
+        uint32_t mBitOffset = 0;
+    };
+
+    /**
+    * Reads values written by BitWriter in the same order.
+    * Reading beyond the end of the data does not fail immediately. Instead, zeros are returned and HasReadPastEnd
+    * becomes true, so that callers only need to check once after reading everything (eg, for malformed messages).
+    **/
+    class BitReader {
+      public:
+        BitReader(const uint8_t* data, size_t sizeInBytes) : mData(data), mSizeInBytes(sizeInBytes) {}
+
+        uint64_t ReadBits(uint32_t numBits) {
+            uint64_t result = 0;
+            for (uint32_t i = 0; i < numBits; i++) {
+                const size_t byteIndex = mBitPosition / 8;
+                if (byteIndex >= mSizeInBytes) {
+                    mHasReadPastEnd = true;
+                    return 0;
+                }
+
+                if ((mData[byteIndex] >> (mBitPosition % 8)) & 1) {
+                    result |= uint64_t{1} << i;
+                }
+                mBitPosition++;
+            }
+
+            return result;
+        }
+        bool ReadBool() {
+            return ReadBits(1) != 0;
+        }
+
+        int64_t ReadVarSigned() {
+            const uint64_t zigzagValue = ReadVarUnsigned();
+            return static_cast<int64_t>((zigzagValue >> 1) ^ (~(zigzagValue & 1) + 1));
+        }
+        uint64_t ReadVarUnsigned() {
+            const uint32_t numBits = static_cast<uint32_t>(ReadBits(BitWriter::kVarLengthPrefixBits));
+            if (numBits > 64) { // Only possible with malformed data
+                mHasReadPastEnd = true;
+                return 0;
+            }
+
+            return ReadBits(numBits);
+        }
+
+        bool HasReadPastEnd() const {
+            return mHasReadPastEnd;
+        }
+        // Number of bytes which were at least partially read
+        size_t GetBytesRead() const {
+            return (mBitPosition + 7) / 8;
+        }
+
+      private:
+        const uint8_t* mData;
+        size_t mSizeInBytes;
+        size_t mBitPosition = 0;
+        bool mHasReadPastEnd = false;
+    };
+}
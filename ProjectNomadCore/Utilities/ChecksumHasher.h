@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// SSE4.2 has a dedicated CRC-32C instruction. Only used when the compiler already targets SSE4.2 (eg, -msse4.2 or
+//      /arch:AVX), so that there's no need for any runtime CPU checks. Otherwise the software fallback is used, which
+//      gives identical results just slower.
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#include <nmmintrin.h>
+#define NOMAD_USE_SSE42_CRC32C 1
+#endif
+
+namespace ProjectNomad {
+    enum class ChecksumAlgorithm : uint8_t {
+        // Same CRC-32 as CRCpp's CRC::CRC_32(), which gives the exact same checksums as the original per-field
+        //      CRC::Calculate calls. Useful for comparing against checksums from older builds
+        Crc32Compatible,
+        // CRC-32C (Castagnoli), which uses the SSE4.2 crc32 instruction when available
+        Crc32c
+    };
+
+    class ChecksumHasher;
+
+    namespace ChecksumHasherInternal {
+        // Slicing-by-8 lookup tables, where tables[0] is the usual byte at a time table
+        using LookupTables = std::array<std::array<uint32_t, 256>, 8>;
+
+        // Both algorithms are reflected CRCs with all bits set for initial value + final xor, so only polynomial differs
+        constexpr LookupTables CreateLookupTables(uint32_t reflectedPolynomial) {
+            LookupTables result = {};
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; bit++) {
+                    value = (value & 1) != 0 ? (value >> 1) ^ reflectedPolynomial : value >> 1;
+                }
+                result[0][i] = value;
+            }
+            for (size_t table = 1; table < result.size(); table++) {
+                for (uint32_t i = 0; i < 256; i++) {
+                    const uint32_t previous = result[table - 1][i];
+                    result[table][i] = (previous >> 8) ^ result[0][previous & 0xFF];
+                }
+            }
+            return result;
+        }
+    }
+
+    // Type checksums itself field by field, such as to skip padding or fields that aren't in use
+    template <typename ValueType>
+    concept DefinesAddToChecksum = requires(const ValueType& value, ChecksumHasher& hasher) {
+        value.AddToChecksum(hasher);
+    };
+    // Type's CalculateCRC32 is only kept for older callers and itself uses ChecksumHasher (eg, FPVector). Only
+    //      needed for types without AddToChecksum, as otherwise hasher would call back into CalculateCRC32 forever
+    template <typename ValueType>
+    concept WrapsChecksumHasherInCalculateCRC32 = ValueType::kCalculateCRC32WrapsChecksumHasher;
+    // Older style of per-type checksum, which may still exist in game code
+    template <typename ValueType>
+    concept DefinesLegacyCalculateCRC32 = !WrapsChecksumHasherInCalculateCRC32<ValueType>
+        && requires(const ValueType& value, uint32_t& resultThusFar) {
+            value.CalculateCRC32(resultThusFar);
+        };
+
+    /**
+    * Streaming checksum over any number of values, with a pluggable algorithm (see ChecksumAlgorithm).
+    *
+    * Values are added via Add, which picks the cheapest way to checksum each type:
+    *   1. Type's own AddToChecksum(ChecksumHasher&) method, if defined
+    *   2. Type's legacy CalculateCRC32(uint32_t&) method, if defined and not simply a wrapper around ChecksumHasher
+    *   3. Otherwise type's raw bytes, in a single call. Only allowed for types without padding (or floats), as
+    *      otherwise identical values could have different checksums
+    * As raw bytes are hashed in one go, arrays of such types (see AddRange) and entire structs of such fields are
+    * checksummed in a single pass rather than one call per field.
+    *
+    * Raw bytes are hashed in the same order as the fields they represent, so for Crc32Compatible this gives the exact
+    * same result as checksumming every field one at a time. Thus engine types keep their CalculateCRC32 methods as
+    * Crc32Compatible wrappers, so older code calling them directly gets the same checksums as before.
+    **/
+    class ChecksumHasher {
+      public:
+        // Whether Add simply hashes the value's bytes, which means consecutive values can be hashed as one block
+        template <typename ValueType>
+        static constexpr bool kIsHashedAsRawBytes = !DefinesAddToChecksum<ValueType>
+            && !DefinesLegacyCalculateCRC32<ValueType>
+            && std::has_unique_object_representations_v<ValueType>;
+
+        /**
+        * @param algorithm - algorithm to use. Every peer must use the same one
+        * @param resultThusFar - result of an earlier checksum to continue from, such as to chain checksums
+        **/
+        explicit ChecksumHasher(ChecksumAlgorithm algorithm, uint32_t resultThusFar = 0)
+            : mAlgorithm(algorithm), mState(~resultThusFar) {}
+
+        /**
+        * Convenience function for checksumming a single value
+        * @param algorithm - algorithm to use
+        * @param value - value to checksum
+        * @param resultThusFar - result of an earlier checksum to continue from, if any
+        * @returns checksum including value
+        **/
+        template <typename ValueType>
+        static uint32_t Calculate(ChecksumAlgorithm algorithm, const ValueType& value, uint32_t resultThusFar = 0) {
+            ChecksumHasher hasher(algorithm, resultThusFar);
+            hasher.Add(value);
+            return hasher.GetResult();
+        }
+
+        // Whether algorithm runs on dedicated hardware instructions in this build, rather than the software fallback
+        static constexpr bool IsHardwareAccelerated(ChecksumAlgorithm algorithm) {
+#ifdef NOMAD_USE_SSE42_CRC32C
+            return algorithm == ChecksumAlgorithm::Crc32c;
+#else
+            return false;
+#endif
+        }
+
+        ChecksumAlgorithm GetAlgorithm() const {
+            return mAlgorithm;
+        }
+        uint32_t GetResult() const {
+            return ~mState;
+        }
+
+        template <typename ValueType>
+        void Add(const ValueType& value) {
+            if constexpr (DefinesAddToChecksum<ValueType>) {
+                value.AddToChecksum(*this);
+            }
+            else if constexpr (DefinesLegacyCalculateCRC32<ValueType>) {
+                AddLegacy(value);
+            }
+            else {
+                static_assert(std::has_unique_object_representations_v<ValueType>,
+                    "Type has padding or floating point values, so it must define AddToChecksum(ChecksumHasher&)");
+                AddBytes(&value, sizeof(ValueType));
+            }
+        }
+
+        // Adds every value in order. Equivalent to calling Add for each value, just a single pass when possible
+        template <typename ValueType>
+        void AddRange(const ValueType* values, size_t count) {
+            if constexpr (kIsHashedAsRawBytes<ValueType>) {
+                AddBytes(values, count * sizeof(ValueType));
+            }
+            else {
+                for (size_t i = 0; i < count; i++) {
+                    Add(values[i]);
+                }
+            }
+        }
+
+        void AddBytes(const void* data, size_t sizeInBytes) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            if (mAlgorithm == ChecksumAlgorithm::Crc32c) {
+#ifdef NOMAD_USE_SSE42_CRC32C
+                mState = UpdateSse42(mState, bytes, sizeInBytes);
+#else
+                mState = UpdateSoftware(kCrc32cTables, mState, bytes, sizeInBytes);
+#endif
+            }
+            else {
+                mState = UpdateSoftware(kCrc32Tables, mState, bytes, sizeInBytes);
+            }
+        }
+
+      private:
+        using LookupTables = ChecksumHasherInternal::LookupTables;
+
+        static constexpr LookupTables kCrc32Tables = ChecksumHasherInternal::CreateLookupTables(0xEDB88320);
+        static constexpr LookupTables kCrc32cTables = ChecksumHasherInternal::CreateLookupTables(0x82F63B78);
+
+        static uint32_t UpdateSoftware(const LookupTables& tables, uint32_t state, const uint8_t* data, size_t size) {
+            // Bytes are combined explicitly (rather than loaded as words), so result doesn't depend on endianness
+            for (; size >= 8; data += 8, size -= 8) {
+                const uint32_t low = state ^ (data[0] | data[1] << 8 | data[2] << 16 | static_cast<uint32_t>(data[3]) << 24);
+                state = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF]
+                      ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+                      ^ tables[3][data[4]] ^ tables[2][data[5]]
+                      ^ tables[1][data[6]] ^ tables[0][data[7]];
+            }
+            for (; size > 0; data++, size--) {
+                state = tables[0][(state ^ *data) & 0xFF] ^ (state >> 8);
+            }
+            return state;
+        }
+
+#ifdef NOMAD_USE_SSE42_CRC32C
+        static uint32_t UpdateSse42(uint32_t state, const uint8_t* data, size_t size) {
+#if defined(__x86_64__) || defined(_M_X64)
+            uint64_t wideState = state;
+            for (; size >= 8; data += 8, size -= 8) {
+                uint64_t value;
+                std::memcpy(&value, data, sizeof(value));
+                wideState = _mm_crc32_u64(wideState, value);
+            }
+            state = static_cast<uint32_t>(wideState);
+#endif
+            for (; size >= 4; data += 4, size -= 4) {
+                uint32_t value;
+                std::memcpy(&value, data, sizeof(value));
+                state = _mm_crc32_u32(state, value);
+            }
+            for (; size > 0; data++, size--) {
+                state = _mm_crc32_u8(state, *data);
+            }
+            return state;
+        }
+#endif
+
+        template <typename ValueType>
+        void AddLegacy(const ValueType& value) {
+            // Legacy methods continue a finished CRC-32, which is exactly what compatible mode already is
+            if (mAlgorithm == ChecksumAlgorithm::Crc32Compatible) {
+                uint32_t resultThusFar = GetResult();
+                value.CalculateCRC32(resultThusFar);
+                mState = ~resultThusFar;
+                return;
+            }
+
+            // Otherwise can only include the value's own CRC-32
+            uint32_t valueChecksum = 0;
+            value.CalculateCRC32(valueChecksum);
+            AddBytes(&valueChecksum, sizeof(valueChecksum));
+        }
+
+        ChecksumAlgorithm mAlgorithm;
+        uint32_t mState; // Running CRC before the final xor
+    };
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "RingBuffer.h"
+
+namespace ProjectNomad {
+    /// <summary>
+    /// Alternative to RingBuffer which trades retrieval speed for memory usage. Intended for large snapshots which
+    /// mostly do not change from frame to frame.
+    ///
+    /// Only the latest element is stored in full (ie, the "keyframe"). Every older element is stored as a XOR delta
+    /// against the next newer element, with unchanged (all zero) 8-byte words run-length encoded away. Thus retrieving
+    /// the latest value is free while retrieving older values requires rebuilding them by walking the delta chain.
+    ///
+    /// Supports the same offset semantics and insertion API as RingBuffer, with the following caveats:
+    /// - ContentType is compared and rebuilt as raw bytes. Thus it must be safe to memcpy between two instances of
+    ///     the same type (ie, no pointers or heap-owning members, which snapshots already must avoid).
+    /// - Returned references to non-latest values point at a shared scratch value that is only valid until the
+    ///     next Get call.
+    /// - Values may carry a lazily filled cache within their own bytes (eg, BaseSnapshot's cached checksum), which can
+    ///     change after a delta against them was encoded. Thus any ClearCachedChecksum method is called on every
+    ///     rebuilt value, so a stale cache is never treated as valid.
+    /// </summary>
+    template <typename ContentType, uint32_t Size>
+    class DeltaRingBuffer {
+        static_assert(Size > 1, "Size must be greater than 1 (one keyframe plus at least one delta)");
+      public:
+        static constexpr uint32_t getSize() {
+            return Size;
+        }
+
+        /**
+        * Uses swap to insert the provided element into the "front" of the buffer
+        * @param element - Element that is swap-inserted into the "front" of the buffer
+        **/
+        void SwapInsert(ContentType& element) {
+            // Current latest value becomes one frame older, so store it as a delta against the new latest value.
+            //      Reuse the slot for the oldest delta (which is about to be dropped) to retain its capacity.
+            if (mStoredCount > 0) {
+                std::vector<uint64_t>& oldestDelta = mDeltas.Get(1);
+                EncodeDelta(element, mLatest, oldestDelta);
+                mDeltas.IncrementHead();
+            }
+
+            std::swap(element, mLatest);
+            if (mStoredCount < Size) {
+                mStoredCount++;
+            }
+
+            mScratchAge = kNoCachedAge; // All stored values are now one spot older
+        }
+
+        /**
+        * Uses swap to replace an existing stored value
+        * @param offset - what spot to replace, relative to latest insertion. 0 = latest value, -1 = second latest value,
+        *                 etc. Expected to be in range (-Size, 0]
+        * @param element - what to replace currently stored value with via swap-replace
+        **/
+        void SwapReplace(int offset, ContentType& element) {
+            const uint32_t age = OffsetToAge(offset);
+
+            // Remember value directly older than replaced value (if any), as its delta is relative to the replaced value
+            const bool hasOlderValue = age + 1 < mStoredCount;
+            if (hasOlderValue) {
+                RebuildInto(age + 1, mScratchOlder);
+            }
+
+            if (age == 0) {
+                std::swap(element, mLatest);
+            }
+            else {
+                // Delta for replaced value is relative to next newer value
+                RebuildInto(age - 1, mScratch);
+                EncodeDelta(mScratch, element, GetDeltaForAge(age));
+            }
+
+            if (hasOlderValue) {
+                EncodeDelta(age == 0 ? mLatest : element, mScratchOlder, GetDeltaForAge(age + 1));
+            }
+
+            // Invalidate any cached rebuilt value as stored data changed
+            mScratchAge = kNoCachedAge;
+        }
+
+        /**
+        * Retrieves element at "front" (latest value) of buffer then moving "backwards" by offset amount.
+        * @param offset - what spot to get, relative to latest insertion. 0 = latest value, -1 = second latest value,
+        *                 etc. Expected to be in range (-Size, 0]
+        * @returns Value stored in buffer represented by the "front" (latest inserted value) offsetted by the provided
+        *          value. Only the latest value reference is stable, see class comments.
+        **/
+        const ContentType& Get(int offset) const {
+            const uint32_t age = OffsetToAge(offset);
+            if (age == 0) {
+                return mLatest;
+            }
+
+            // Rebuild into scratch unless already rebuilt (eg, when retrieving same frame multiple times in a row)
+            if (mScratchAge != age) {
+                RebuildInto(age, mScratch);
+                mScratchAge = age;
+            }
+            return mScratch;
+        }
+
+        /**
+        * Total bytes currently used for all stored deltas. Useful to compare against raw size of full copies
+        * (ie, sizeof(ContentType) * Size).
+        **/
+        size_t GetEncodedDeltaBytes() const {
+            size_t result = 0;
+            for (uint32_t i = 0; i < kDeltaCount; i++) {
+                result += mDeltas.Get(-static_cast<int>(i)).size() * sizeof(uint64_t);
+            }
+            return result;
+        }
+
+      private:
+        static constexpr uint32_t kDeltaCount = Size - 1;
+        static constexpr uint32_t kNoCachedAge = 0; // Age 0 (latest value) never uses scratch
+        static constexpr size_t kFullWordCount = sizeof(ContentType) / sizeof(uint64_t);
+        static constexpr size_t kTailByteCount = sizeof(ContentType) % sizeof(uint64_t);
+        static constexpr size_t kTotalWordCount = kFullWordCount + (kTailByteCount > 0 ? 1 : 0);
+
+        static uint32_t OffsetToAge(int offset) {
+            // Negative values represent the past in RingBuffer so flip the sign. Clamp to stay in bounds
+            if (offset > 0) {
+                return 0;
+            }
+            const auto age = static_cast<uint32_t>(offset * -1);
+            return age < Size ? age : Size - 1;
+        }
+
+        // Delta for given age converts value of (age - 1) into value of age. Expects age to be in range [1, Size)
+        std::vector<uint64_t>& GetDeltaForAge(uint32_t age) {
+            return mDeltas.Get(-static_cast<int>(age - 1));
+        }
+        const std::vector<uint64_t>& GetDeltaForAge(uint32_t age) const {
+            return mDeltas.Get(-static_cast<int>(age - 1));
+        }
+
+        void RebuildInto(uint32_t age, ContentType& result) const {
+            result = mLatest;
+            for (uint32_t curAge = 1; curAge <= age && curAge < mStoredCount; curAge++) {
+                ApplyDelta(GetDeltaForAge(curAge), result);
+            }
+
+            if constexpr (requires { result.ClearCachedChecksum(); }) {
+                result.ClearCachedChecksum();
+            }
+        }
+
+        static uint64_t LoadWord(const unsigned char* bytes, size_t wordIndex) {
+            uint64_t result = 0;
+            const size_t byteCount = wordIndex < kFullWordCount ? sizeof(uint64_t) : kTailByteCount;
+            std::memcpy(&result, bytes + wordIndex * sizeof(uint64_t), byteCount);
+            return result;
+        }
+        static void XorWord(unsigned char* bytes, size_t wordIndex, uint64_t value) {
+            const size_t byteCount = wordIndex < kFullWordCount ? sizeof(uint64_t) : kTailByteCount;
+            uint64_t word = LoadWord(bytes, wordIndex) ^ value;
+            std::memcpy(bytes + wordIndex * sizeof(uint64_t), &word, byteCount);
+        }
+
+        /**
+        * Encodes XOR of both values as a series of runs. Each run is a single header word (unchanged word count in
+        * upper 32 bits and changed word count in lower 32 bits) followed by the changed (XOR'd) words themselves.
+        **/
+        static void EncodeDelta(const ContentType& newer, const ContentType& older, std::vector<uint64_t>& result) {
+            result.clear(); // Retains capacity, so no allocations once steady-state delta size is reached
+
+            const auto* newerBytes = reinterpret_cast<const unsigned char*>(&newer);
+            const auto* olderBytes = reinterpret_cast<const unsigned char*>(&older);
+
+            size_t wordIndex = 0;
+            while (wordIndex < kTotalWordCount) {
+                // Count unchanged words
+                uint64_t unchangedCount = 0;
+                while (wordIndex < kTotalWordCount && LoadWord(newerBytes, wordIndex) == LoadWord(olderBytes, wordIndex)) {
+                    unchangedCount++;
+                    wordIndex++;
+                }
+                if (wordIndex == kTotalWordCount) {
+                    break; // No need to encode trailing unchanged words
+                }
+
+                // Reserve header then copy changed words until next unchanged word
+                const size_t headerIndex = result.size();
+                result.push_back(0);
+                uint64_t changedCount = 0;
+                while (wordIndex < kTotalWordCount) {
+                    const uint64_t diff = LoadWord(newerBytes, wordIndex) ^ LoadWord(olderBytes, wordIndex);
+                    if (diff == 0) {
+                        break;
+                    }
+                    result.push_back(diff);
+                    changedCount++;
+                    wordIndex++;
+                }
+
+                result[headerIndex] = (unchangedCount << 32) | changedCount;
+            }
+        }
+
+        static void ApplyDelta(const std::vector<uint64_t>& delta, ContentType& target) {
+            auto* targetBytes = reinterpret_cast<unsigned char*>(&target);
+
+            size_t wordIndex = 0;
+            size_t deltaIndex = 0;
+            while (deltaIndex < delta.size()) {
+                const uint64_t header = delta[deltaIndex++];
+                wordIndex += header >> 32;
+
+                const uint64_t changedCount = header & 0xFFFFFFFF;
+                for (uint64_t i = 0; i < changedCount; i++) {
+                    XorWord(targetBytes, wordIndex++, delta[deltaIndex++]);
+                }
+            }
+        }
+
+        ContentType mLatest = {}; // ie, the only fully stored value
+        RingBuffer<std::vector<uint64_t>, kDeltaCount> mDeltas = {}; // Head represents delta for second latest value
+        uint32_t mStoredCount = 0;
+
+        // Rebuilding older values requires somewhere to rebuild into
+        mutable ContentType mScratch = {};
+        mutable uint32_t mScratchAge = kNoCachedAge;
+        ContentType mScratchOlder = {};
+    };
+}
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <CRCpp/CRC.h>
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     /// <summary>
@@ -116,23 +116,14 @@ namespace ProjectNomad {
             return true;
         }
 
-        void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&mHeadIndex, sizeof(mHeadIndex), CRC::CRC_32(), resultThusFar);
+        // Only elements in use are included, as elements beyond head may be stale
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(mHeadIndex);
+            hasher.AddRange(mArray, mHeadIndex);
+        }
 
-            // Check if ContentTyPpe has CalculateCRC32 method. From https://stackoverflow.com/a/22014784/3735890
-            // This is vital as otherwise checksum will use padding bits. See BaseComponent.h comments for more info
-            constexpr bool HasCalculateCRC32 = requires(const ContentType& element, uint32_t& result) {
-                element.CalculateCRC32(result);
-            };
-            
-            for (uint32_t i = 0; i < mHeadIndex; i++) {
-                if constexpr (HasCalculateCRC32) {
-                    mArray[i].CalculateCRC32(resultThusFar);
-                }
-                else {
-                    resultThusFar = CRC::Calculate(&mArray[i], sizeof(mArray[i]), CRC::CRC_32(), resultThusFar);
-                }
-            }
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
       private:
@@ -1,7 +1,8 @@
 #pragma once
 
 #include <type_traits>
-#include <CRCpp/CRC.h>
+
+#include "Utilities/ChecksumHasher.h"
 
 namespace ProjectNomad {
     /**
@@ -59,8 +60,9 @@ namespace ProjectNomad {
             mInternalRepresentation = newValue;
         }
 
+        static constexpr bool kCalculateCRC32WrapsChecksumHasher = true;
         void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&mInternalRepresentation, sizeof(BaseType), CRC::CRC_32(), resultThusFar);
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
         auto operator<=>(const NumericBitSet& other) const = default;
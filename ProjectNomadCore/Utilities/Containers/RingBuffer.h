@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Utilities/ChecksumHasher.h"
+
 namespace ProjectNomad {
     /// <summary>
     /// Simple in-memory ring/circular buffer where "head" moves forward as each element is added, and older
@@ -77,25 +79,16 @@ namespace ProjectNomad {
             mNextAddValueIndex = (mNextAddValueIndex + 1) % Size;
         }
 
-        void CalculateCRC32(uint32_t& resultThusFar) const {
-            resultThusFar = CRC::Calculate(&mNextAddValueIndex, sizeof(mNextAddValueIndex), CRC::CRC_32(), resultThusFar);
-
-            // Check if ContentTyPpe has CalculateCRC32 method. From https://stackoverflow.com/a/22014784/3735890
-            // This is vital as otherwise checksum will use padding bits. See BaseComponent.h comments for more info
-            constexpr bool HasCalculateCRC32 = requires(const ContentType& element, uint32_t& result) {
-                element.CalculateCRC32(result);
-            };
+        void AddToChecksum(ChecksumHasher& hasher) const {
+            hasher.Add(mNextAddValueIndex);
 
             // Calculate checksum for buffer array. Note that there's no concept of "invalid" or unused values,
             // and thus must calculate checksum for all values.
-            for (uint32_t i = 0; i < getSize(); i++) {
-                if constexpr (HasCalculateCRC32) {
-                    mArray[i].CalculateCRC32(resultThusFar);
-                }
-                else {
-                    resultThusFar = CRC::Calculate(&mArray[i], sizeof(mArray[i]), CRC::CRC_32(), resultThusFar);
-                }
-            }
+            hasher.AddRange(mArray, getSize());
+        }
+
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, *this, resultThusFar);
         }
 
       private:
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace ProjectNomad {
+    /**
+    * Fixed capacity lock-free queue for exactly one producer thread and one consumer thread.
+    * Elements are constructed once up front and then written + read in place, so large elements (eg, packet buffers)
+    * are never copied around nor allocated while in use.
+    * @tparam ContentType - element type. Expected to be default constructible
+    * @tparam Capacity - max number of queued elements
+    **/
+    template <typename ContentType, uint32_t Capacity>
+    class SpscQueue {
+        static_assert(Capacity > 0, "Capacity must be greater than 0");
+      public:
+        static constexpr uint32_t GetCapacity() {
+            return Capacity;
+        }
+
+        /**
+        * Producer only. Adds element by letting given writer fill in the next free slot in place.
+        * @param writer - callable taking ContentType&. Slot may hold an old element, which should be fully overwritten
+        * @returns true if element was added, false if queue is full
+        **/
+        template <typename Writer>
+        bool TryPush(Writer&& writer) {
+            const uint64_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mHead.load(std::memory_order_acquire) >= Capacity) {
+                return false;
+            }
+
+            writer(mSlots[tail % Capacity]);
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+        * Consumer only. Removes oldest element after letting given reader use it in place.
+        * @param reader - callable taking const ContentType&. Reference is only valid during the call
+        * @returns true if an element was read, false if queue is empty
+        **/
+        template <typename Reader>
+        bool TryPop(Reader&& reader) {
+            const uint64_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            reader(static_cast<const ContentType&>(mSlots[head % Capacity]));
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate if called while other thread is pushing or popping
+        uint32_t GetSize() const {
+            // Read head first, as tail only ever catches up to or passes it. Thus never negative
+            const uint64_t head = mHead.load(std::memory_order_acquire);
+            return static_cast<uint32_t>(mTail.load(std::memory_order_acquire) - head);
+        }
+
+      private:
+        std::array<ContentType, Capacity> mSlots = {};
+        // Ever increasing counters rather than wrapped indices, so full vs empty is never ambiguous.
+        //      Separate cache lines so producer and consumer don't fight over the same line
+        alignas(64) std::atomic<uint64_t> mHead = 0; // Next element to read
+        alignas(64) std::atomic<uint64_t> mTail = 0; // Next slot to write
+    };
+}
@@ -0,0 +1,39 @@
+#include "pchNCT.h"
+
+#include "Input/CharacterInputQuantizer.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace CharacterInputQuantizerTests {
+    class CharacterInputQuantizerTests : public BaseSimTest {};
+
+    TEST_F(CharacterInputQuantizerTests, ToCode_whenGivenEveryCode_roundTripsToSameCode) {
+        for (int code = -CharacterInputQuantizer::kMaxCode; code <= CharacterInputQuantizer::kMaxCode; code++) {
+            fp value = CharacterInputQuantizer::FromCode(static_cast<int8_t>(code));
+            EXPECT_EQ(code, CharacterInputQuantizer::ToCode(value));
+        }
+    }
+
+    TEST_F(CharacterInputQuantizerTests, ToCode_whenGivenRangeEndsOrOutOfRange_clampsToMaxCodes) {
+        EXPECT_EQ(CharacterInputQuantizer::kMaxCode, CharacterInputQuantizer::ToCode(fp{1}));
+        EXPECT_EQ(CharacterInputQuantizer::kMaxCode, CharacterInputQuantizer::ToCode(fp{5}));
+        EXPECT_EQ(-CharacterInputQuantizer::kMaxCode, CharacterInputQuantizer::ToCode(fp{-1}));
+        EXPECT_EQ(-CharacterInputQuantizer::kMaxCode, CharacterInputQuantizer::ToCode(fp{-5}));
+        EXPECT_EQ(0, CharacterInputQuantizer::ToCode(fp{0}));
+    }
+
+    TEST_F(CharacterInputQuantizerTests, Quantize_whenAppliedTwice_secondCallChangesNothing) {
+        CharacterInput input = {};
+        input.moveForward = fp{0.3f};
+        input.moveRight = fp{-0.77f};
+        input.camRotation = FPQuat(fp{0.6f}, FPVector(fp{0.1f}, fp{-0.5f}, fp{0.2f}));
+
+        CharacterInputQuantizer::Quantize(input);
+        CharacterInput quantizedOnce = input;
+        CharacterInputQuantizer::Quantize(input);
+
+        EXPECT_EQ(quantizedOnce, input);
+        // Sanity check that value is close to original
+        EXPECT_NEAR(0.3f, static_cast<float>(quantizedOnce.moveForward), 1.0f / CharacterInputQuantizer::kMaxCode);
+    }
+}
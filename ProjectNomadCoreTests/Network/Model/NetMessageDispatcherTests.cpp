@@ -0,0 +1,79 @@
+#include "pchNCT.h"
+
+#include "Network/Model/NetMessageDispatcher.h"
+#include "Network/P2PMessages/InputUpdateMessageEncoding.h"
+#include "Network/P2PMessages/NetMessageSerialization.h"
+#include "Network/P2PMessages/NetMessagesSimple.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace NetMessageDispatcherTests {
+    class NetMessageDispatcherTests : public BaseSimTest {
+      protected:
+        template <typename MessageType>
+        static std::vector<char> ToRawData(const MessageType& message) {
+            std::vector<uint8_t> encodedData;
+            NetMessageSerialization::Encode(message, encodedData);
+            return std::vector<char>(encodedData.begin(), encodedData.end());
+        }
+
+        NetMessageDispatcher mToTest = {};
+        CrossPlatformIdWrapper mSenderId = {};
+    };
+
+    TEST_F(NetMessageDispatcherTests, Dispatch_whenNoHandlerRegistered_returnsNoHandler) {
+        std::vector<char> rawData = ToRawData(LoadMapMessage());
+
+        EXPECT_EQ(NetMessageDispatchResult::NoHandler,
+                  mToTest.Dispatch(mSenderId, NetMessageType::LoadMap, rawData));
+    }
+
+    TEST_F(NetMessageDispatcherTests, Dispatch_whenHandlerRegistered_passesDecodedMessage) {
+        uint8_t receivedSeed = 0;
+        mToTest.RegisterHandler<LoadMapMessage>([&](const CrossPlatformIdWrapper&, const LoadMapMessage& message) {
+            receivedSeed = message.sessionSeed;
+        });
+
+        LoadMapMessage message = {};
+        message.sessionSeed = 42;
+        std::vector<char> rawData = ToRawData(message);
+
+        EXPECT_EQ(NetMessageDispatchResult::Handled, mToTest.Dispatch(mSenderId, NetMessageType::LoadMap, rawData));
+        EXPECT_EQ(42, receivedSeed);
+    }
+
+    TEST_F(NetMessageDispatcherTests, Dispatch_whenMessageHasTrailingData_returnsInvalidWithoutCallingHandler) {
+        bool wasHandlerCalled = false;
+        mToTest.RegisterHandler<LoadMapMessage>([&](const CrossPlatformIdWrapper&, const LoadMapMessage&) {
+            wasHandlerCalled = true;
+        });
+
+        std::vector<char> rawData = ToRawData(LoadMapMessage());
+        rawData.push_back(0);
+
+        EXPECT_EQ(NetMessageDispatchResult::InvalidMessage,
+                  mToTest.Dispatch(mSenderId, NetMessageType::LoadMap, rawData));
+        EXPECT_FALSE(wasHandlerCalled);
+    }
+
+    TEST_F(NetMessageDispatcherTests, Dispatch_whenCustomDecoderRegistered_passesDecodedMessage) {
+        FrameType receivedUpdateFrame = 0;
+        NetMessageDispatcher::Decoder<InputUpdateMessage> decoder = &InputUpdateMessageEncoding::Decode;
+        mToTest.RegisterHandler<InputUpdateMessage>(decoder,
+            [&](const CrossPlatformIdWrapper&, const InputUpdateMessage& message) {
+                receivedUpdateFrame = message.updateFrame;
+            }
+        );
+
+        InputUpdateMessage message = {};
+        message.updateFrame = 77;
+        message.numInputs = 1;
+        std::vector<uint8_t> encodedData;
+        InputUpdateMessageEncoding::Encode(message, encodedData);
+        std::vector<char> rawData(encodedData.begin(), encodedData.end());
+
+        EXPECT_EQ(NetMessageDispatchResult::Handled,
+                  mToTest.Dispatch(mSenderId, NetMessageType::InputUpdate, rawData));
+        EXPECT_EQ(77, receivedUpdateFrame);
+    }
+}
@@ -0,0 +1,61 @@
+#include "pchNCT.h"
+
+#include "Network/Model/PeerLatencyEstimator.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+
+namespace PeerLatencyEstimatorTests {
+    class PeerLatencyEstimatorTests : public BaseSimTest {
+      protected:
+        PeerLatencyEstimator mToTest = {};
+    };
+
+    TEST_F(PeerLatencyEstimatorTests, GetStats_whenNoSamples_hasNoSamples) {
+        EXPECT_FALSE(mToTest.GetStats().HasSamples());
+        EXPECT_EQ(0, mToTest.GetStats().GetEstimatedOneWayDelayInMicroSec());
+    }
+
+    TEST_F(PeerLatencyEstimatorTests, AddRttSample_whenFirstSample_usesSampleDirectly) {
+        mToTest.AddRttSample(100000);
+
+        const PeerLatencyStats& result = mToTest.GetStats();
+        EXPECT_EQ(1, result.sampleCount);
+        EXPECT_EQ(100000, result.lastRttInMicroSec);
+        EXPECT_EQ(100000, result.smoothedRttInMicroSec);
+        EXPECT_EQ(50000, result.jitterInMicroSec);
+        EXPECT_EQ(100000, result.minRttInMicroSec);
+        EXPECT_EQ(50000, result.GetEstimatedOneWayDelayInMicroSec());
+    }
+
+    TEST_F(PeerLatencyEstimatorTests, AddRttSample_whenSingleSpike_onlyMovesSmoothedRttAnEighth) {
+        mToTest.AddRttSample(80000);
+        mToTest.AddRttSample(160000);
+
+        const PeerLatencyStats& result = mToTest.GetStats();
+        EXPECT_EQ(160000, result.lastRttInMicroSec);
+        EXPECT_EQ(90000, result.smoothedRttInMicroSec);
+        EXPECT_EQ((40000 * 3 + 80000) / 4, result.jitterInMicroSec);
+        EXPECT_EQ(80000, result.minRttInMicroSec);
+    }
+
+    TEST_F(PeerLatencyEstimatorTests, AddRttSample_whenSamplesAreSteady_jitterDecaysTowardsZero) {
+        for (int i = 0; i < 50; i++) {
+            mToTest.AddRttSample(50000);
+        }
+
+        EXPECT_EQ(50000, mToTest.GetStats().smoothedRttInMicroSec);
+        EXPECT_EQ(0, mToTest.GetStats().jitterInMicroSec);
+    }
+
+    TEST_F(PeerLatencyEstimatorTests, AddRttSample_whenMinSampleLeavesWindow_minRttRisesToRecentMin) {
+        mToTest.AddRttSample(10000);
+        for (uint32_t i = 0; i < PeerLatencyEstimator::kMinRttWindowSize - 1; i++) {
+            mToTest.AddRttSample(30000 + i);
+        }
+        ASSERT_EQ(10000, mToTest.GetStats().minRttInMicroSec);
+
+        mToTest.AddRttSample(40000);
+        EXPECT_EQ(30000, mToTest.GetStats().minRttInMicroSec);
+    }
+}
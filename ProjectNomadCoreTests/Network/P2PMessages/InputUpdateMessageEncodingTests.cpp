@@ -0,0 +1,101 @@
+#include "pchNCT.h"
+
+#include "Network/P2PMessages/InputUpdateMessageEncoding.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace InputUpdateMessageEncodingTests {
+    class InputUpdateMessageEncodingTests : public BaseSimTest {
+      protected:
+        // Typical input history: Player held the same input for a while then changed movement + buttons
+        static InputUpdateMessage CreateTypicalMessage() {
+            InputHistoryArray inputs = {};
+            for (FrameType i = 0; i < kInputsHistorySize; i++) {
+                CharacterInput& input = inputs[i];
+                input.camPosition = FPVector(fp{100.5f}, fp{-20}, fp{3});
+                input.camRotation = FPQuat(fp{0.7f}, FPVector(fp{0}, fp{0.7f}, fp{0}));
+                input.moveForward = fp{1};
+            }
+            for (FrameType i = 0; i < 3; i++) { // Index 0 is newest input
+                inputs[i].moveRight = fp{-0.5f};
+                inputs[i].camPosition.x += fp{0.25f};
+                inputs[i].commandInputs.SetCommandValue(InputCommand::Jump, true);
+                inputs[i].uiChoice = GameplayInteractiveUIChoice::ChooseOptionB;
+            }
+
+            InputUpdateMessage result(123456, inputs);
+            result.ackedFrames[static_cast<size_t>(PlayerSpot::Player2)] = 123450;
+            result.ackedFrames[static_cast<size_t>(PlayerSpot::Player3)] = 123460; // Peers may be ahead as well
+            return result;
+        }
+
+        std::vector<uint8_t> mBuffer = {};
+    };
+
+    TEST_F(InputUpdateMessageEncodingTests, Decode_whenGivenEncodedQuantizedMessage_returnsExactSameMessage) {
+        InputUpdateMessage original = CreateTypicalMessage();
+        for (CharacterInput& input : original.playerInputs) {
+            CharacterInputQuantizer::Quantize(input);
+        }
+
+        InputUpdateMessageEncoding::Encode(original, mBuffer);
+        InputUpdateMessage decoded = {};
+        ASSERT_TRUE(InputUpdateMessageEncoding::Decode(mBuffer.data(), mBuffer.size(), decoded));
+
+        EXPECT_EQ(original.messageType, decoded.messageType);
+        EXPECT_EQ(original.updateFrame, decoded.updateFrame);
+        EXPECT_EQ(original.numInputs, decoded.numInputs);
+        EXPECT_EQ(original.ackedFrames, decoded.ackedFrames);
+        for (FrameType i = 0; i < kInputsHistorySize; i++) {
+            EXPECT_EQ(original.playerInputs[i], decoded.playerInputs[i]) << "Input index: " << i;
+        }
+    }
+
+    TEST_F(InputUpdateMessageEncodingTests, Encode_whenGivenTypicalMessage_isAtLeastTenTimesSmallerThanRawStruct) {
+        InputUpdateMessageEncoding::Encode(CreateTypicalMessage(), mBuffer);
+
+        EXPECT_LE(mBuffer.size() * 10, sizeof(InputUpdateMessage));
+    }
+
+    TEST_F(InputUpdateMessageEncodingTests, Encode_whenOnlyLatestInputIncluded_skipsOlderInputs) {
+        InputUpdateMessage original = CreateTypicalMessage();
+        original.numInputs = 1;
+
+        InputUpdateMessageEncoding::Encode(original, mBuffer);
+        InputUpdateMessage decoded = {};
+        ASSERT_TRUE(InputUpdateMessageEncoding::Decode(mBuffer.data(), mBuffer.size(), decoded));
+
+        EXPECT_EQ(1, decoded.numInputs);
+        CharacterInput expectedLatestInput = original.playerInputs[0];
+        CharacterInputQuantizer::Quantize(expectedLatestInput);
+        EXPECT_EQ(expectedLatestInput, decoded.playerInputs[0]);
+        EXPECT_EQ(CharacterInput{}, decoded.playerInputs[1]);
+    }
+
+    TEST_F(InputUpdateMessageEncodingTests, Encode_whenNumInputsExceedsHistorySize_writesClampedCount) {
+        InputUpdateMessage original = CreateTypicalMessage();
+        original.numInputs = kInputsHistorySize + 5;
+
+        InputUpdateMessageEncoding::Encode(original, mBuffer);
+        InputUpdateMessage decoded = {};
+        ASSERT_TRUE(InputUpdateMessageEncoding::Decode(mBuffer.data(), mBuffer.size(), decoded));
+
+        EXPECT_EQ(kInputsHistorySize, decoded.numInputs);
+    }
+
+    TEST_F(InputUpdateMessageEncodingTests, Decode_whenGivenTruncatedOrMalformedData_fails) {
+        InputUpdateMessageEncoding::Encode(CreateTypicalMessage(), mBuffer);
+        InputUpdateMessage decoded = {};
+
+        // Truncated
+        EXPECT_FALSE(InputUpdateMessageEncoding::Decode(mBuffer.data(), mBuffer.size() - 1, decoded));
+        // Trailing garbage
+        std::vector<uint8_t> withExtraByte = mBuffer;
+        withExtraByte.push_back(0);
+        EXPECT_FALSE(InputUpdateMessageEncoding::Decode(withExtraByte.data(), withExtraByte.size(), decoded));
+        // Wrong message type
+        std::vector<uint8_t> wrongType = mBuffer;
+        wrongType[0] = static_cast<uint8_t>(NetMessageType::ValidationChecksum);
+        EXPECT_FALSE(InputUpdateMessageEncoding::Decode(wrongType.data(), wrongType.size(), decoded));
+    }
+}
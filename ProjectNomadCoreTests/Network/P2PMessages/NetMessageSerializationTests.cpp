@@ -0,0 +1,124 @@
+#include "pchNCT.h"
+
+#include <cstring>
+
+#include "Network/P2PMessages/InputUpdateMessageEncoding.h"
+#include "Network/P2PMessages/NetMessageSerialization.h"
+#include "Network/P2PMessages/NetMessagesConnectionInfo.h"
+#include "Network/P2PMessages/NetMessagesPlayerSpot.h"
+#include "Network/P2PMessages/NetMessagesSimple.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace NetMessageSerializationTests {
+    class NetMessageSerializationTests : public BaseSimTest {
+      protected:
+        static PlayerSpotMappingMessage CreateTwoPlayerMapping() {
+            PlayerSpotMappingMessage result = {};
+            result.totalPlayers = 2;
+            std::memset(result.rawPlayerSpotMapping[0], 'a', EOS_PRODUCTUSERID_MAX_LENGTH); // Max length, so no null char
+            std::memcpy(result.rawPlayerSpotMapping[1], "short", 6);
+            return result;
+        }
+
+        std::vector<uint8_t> mBuffer = {};
+    };
+
+    TEST_F(NetMessageSerializationTests, Decode_whenSimpleMessagesEncoded_roundTrips) {
+        NetMessageSerialization::Encode(TimeQualityReportMessage(4000000000, 123456789012), mBuffer);
+        TimeQualityReportMessage decodedReport;
+        ASSERT_TRUE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedReport));
+        EXPECT_EQ(4000000000, decodedReport.currentFrame);
+        EXPECT_EQ(123456789012, decodedReport.ping);
+
+        NetMessageSerialization::Encode(ValidationChecksumMessage(77, 0xDEADBEEF), mBuffer);
+        ValidationChecksumMessage decodedChecksum;
+        ASSERT_TRUE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedChecksum));
+        EXPECT_EQ(77, decodedChecksum.targetFrame);
+        EXPECT_EQ(0xDEADBEEF, decodedChecksum.checksum);
+
+        NetMessageSerialization::Encode(StartGameplayMessage(), mBuffer);
+        EXPECT_EQ(NetMessageSerialization::kHeaderSizeInBytes, mBuffer.size());
+        StartGameplayMessage decodedStart;
+        EXPECT_TRUE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedStart));
+    }
+
+    TEST_F(NetMessageSerializationTests, Encode_always_startsWithMessageTypeThenVersion) {
+        LoadMapMessage message = {};
+        message.sessionSeed = 5;
+
+        NetMessageSerialization::Encode(message, mBuffer);
+
+        ASSERT_LE(2, mBuffer.size());
+        EXPECT_EQ(static_cast<uint8_t>(NetMessageType::LoadMap), mBuffer[0]);
+        EXPECT_EQ(NetMessageSerialization::kWireVersion, mBuffer[1]);
+    }
+
+    TEST_F(NetMessageSerializationTests, Decode_whenPlayerSpotMappingEncoded_onlySendsUsedIdsAndRoundTrips) {
+        const PlayerSpotMappingMessage original = CreateTwoPlayerMapping();
+
+        NetMessageSerialization::Encode(original, mBuffer);
+        PlayerSpotMappingMessage decoded;
+        ASSERT_TRUE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decoded));
+
+        EXPECT_GT(50, mBuffer.size()); // Raw struct would always include every spot's max length id
+        EXPECT_LT(sizeof(PlayerSpotMappingMessage) / 2, sizeof(PlayerSpotMappingMessage) - mBuffer.size());
+        EXPECT_EQ(2, decoded.totalPlayers);
+        EXPECT_EQ(0, std::memcmp(original.rawPlayerSpotMapping, decoded.rawPlayerSpotMapping, sizeof(OrderedRawPlayerIdArray)));
+    }
+
+    TEST_F(NetMessageSerializationTests, Decode_whenCountExceedsArraySize_fails) {
+        PlayerSpotMappingMessage original = CreateTwoPlayerMapping();
+        original.totalPlayers = PlayerSpotHelpers::kMaxPlayerSpots + 1; // Only the max number of ids are actually sent
+
+        NetMessageSerialization::Encode(original, mBuffer);
+        PlayerSpotMappingMessage decoded;
+        EXPECT_FALSE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decoded));
+    }
+
+    TEST_F(NetMessageSerializationTests, Decode_whenValueDoesNotFitFieldType_fails) {
+        // Same wire layout as LoadMapMessage, but with a seed too large for its uint8_t field
+        std::vector<uint8_t> data;
+        BitWriter writer(data);
+        NetMessageSerialization::WriteHeader(writer, NetMessageType::LoadMap);
+        writer.WriteVarUnsigned(256);
+
+        LoadMapMessage decoded;
+        EXPECT_FALSE(NetMessageSerialization::Decode(data.data(), data.size(), decoded));
+    }
+
+    TEST_F(NetMessageSerializationTests, Decode_whenDataMalformed_fails) {
+        NetMessageSerialization::Encode(CreateTwoPlayerMapping(), mBuffer);
+        PlayerSpotMappingMessage decoded;
+
+        EXPECT_FALSE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size() - 1, decoded));
+        EXPECT_FALSE(NetMessageSerialization::Decode(mBuffer.data(), 0, decoded));
+
+        std::vector<uint8_t> withExtraByte = mBuffer;
+        withExtraByte.push_back(0);
+        EXPECT_FALSE(NetMessageSerialization::Decode(withExtraByte.data(), withExtraByte.size(), decoded));
+
+        std::vector<uint8_t> wrongType = mBuffer;
+        wrongType[0] = static_cast<uint8_t>(NetMessageType::LoadMap);
+        EXPECT_FALSE(NetMessageSerialization::Decode(wrongType.data(), wrongType.size(), decoded));
+    }
+
+    TEST_F(NetMessageSerializationTests, Decode_whenDifferentWireVersion_fails) {
+        TimeQualityResponseMessage original;
+        original.pong = 99;
+        NetMessageSerialization::Encode(original, mBuffer);
+        mBuffer[1]++;
+        TimeQualityResponseMessage decodedResponse;
+        EXPECT_FALSE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedResponse));
+
+        // Messages with their own codec share the same header
+        InputUpdateMessage inputUpdate = {};
+        inputUpdate.updateFrame = 10;
+        inputUpdate.numInputs = 1;
+        NetMessageSerialization::Encode(inputUpdate, mBuffer);
+        InputUpdateMessage decodedInputUpdate;
+        ASSERT_TRUE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedInputUpdate));
+        mBuffer[1]++;
+        EXPECT_FALSE(NetMessageSerialization::Decode(mBuffer.data(), mBuffer.size(), decodedInputUpdate));
+    }
+}
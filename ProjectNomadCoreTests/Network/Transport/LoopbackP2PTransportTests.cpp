@@ -0,0 +1,263 @@
+#include "pchNCT.h"
+
+#include "Network/SimNetworkManager.h"
+#include "Network/Transport/LoopbackP2PTransport.h"
+#include "Rollback/RollbackManager.h"
+#include "TestHelpers/TestHelpers.h"
+#include "TestHelpers/TestSnapshot.h"
+#include "TestHelpers/Rollback/RollbackTestUser.h"
+
+using namespace ProjectNomad;
+namespace LoopbackP2PTransportTests {
+    // Simply records every received packet
+    class RecordingReceiver : public IP2PPacketReceiver {
+      public:
+        void OnPacketReceived(const CrossPlatformIdWrapper& senderId, const std::vector<char>& packetData) override {
+            senderIds.push_back(senderId);
+            packets.push_back(packetData);
+        }
+
+        std::vector<CrossPlatformIdWrapper> senderIds = {};
+        std::vector<std::vector<char>> packets = {};
+    };
+
+    class LoopbackP2PTransportTests : public BaseSimTest {
+      protected:
+        static bool SendByte(LoopbackP2PTransport& sender, uint32_t targetIndex, char value,
+                             PacketReliability reliability = PacketReliability::UnreliableUnordered) {
+            return sender.SendPacket(LoopbackP2PNetwork::GetPeerId(targetIndex), &value, 1, reliability);
+        }
+
+        LoopbackP2PNetwork mNetwork = LoopbackP2PNetwork(3);
+        RecordingReceiver mReceiver = {};
+    };
+
+    TEST_F(LoopbackP2PTransportTests, ReceivePackets_whenPacketsSent_receivesInOrderWithSenderId) {
+        ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 1, 10));
+        ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 1, 11));
+        ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 2, 99)); // Different receiver so should not be received
+
+        EXPECT_EQ(2, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 10));
+
+        ASSERT_EQ(2, mReceiver.packets.size());
+        EXPECT_EQ(std::vector<char>{10}, mReceiver.packets[0]);
+        EXPECT_EQ(std::vector<char>{11}, mReceiver.packets[1]);
+        EXPECT_EQ(LoopbackP2PNetwork::GetPeerId(0), mReceiver.senderIds[0]);
+    }
+
+    TEST_F(LoopbackP2PTransportTests, ReceivePackets_whenMorePacketsThanMax_leavesRestForNextCall) {
+        for (char i = 0; i < 5; i++) {
+            ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 1, i));
+        }
+
+        EXPECT_EQ(3, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 3));
+        EXPECT_EQ(2, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 3));
+        EXPECT_EQ(0, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 3));
+    }
+
+    TEST_F(LoopbackP2PTransportTests, SendPacket_whenQueueFull_dropsUnreliableAndFailsReliable) {
+        for (uint32_t i = 0; i < LoopbackP2PNetwork::kQueueCapacity; i++) {
+            ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 1, 0));
+        }
+
+        EXPECT_TRUE(SendByte(mNetwork.GetPeer(0), 1, 0, PacketReliability::UnreliableUnordered));
+        EXPECT_EQ(1, mNetwork.GetPeer(0).GetDroppedPacketCount());
+        EXPECT_FALSE(SendByte(mNetwork.GetPeer(0), 1, 0, PacketReliability::ReliableOrdered));
+    }
+
+    TEST_F(LoopbackP2PTransportTests, SendPacket_whenTargetInvalid_fails) {
+        EXPECT_FALSE(SendByte(mNetwork.GetPeer(0), 0, 0)); // Self
+        EXPECT_FALSE(SendByte(mNetwork.GetPeer(0), 3, 0)); // Outside network
+    }
+
+    TEST_F(LoopbackP2PTransportTests, SendPacketToAll_whenAllTargetsValid_deliversSamePacketToEach) {
+        const CrossPlatformIdWrapper targetIds[] = {LoopbackP2PNetwork::GetPeerId(1), LoopbackP2PNetwork::GetPeerId(2)};
+        const char data[] = {7, 8, 9};
+
+        EXPECT_EQ(0, mNetwork.GetPeer(0).SendPacketToAll(targetIds, 2, data, 3, PacketReliability::UnreliableUnordered));
+
+        EXPECT_EQ(1, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 10));
+        EXPECT_EQ(1, mNetwork.GetPeer(2).ReceivePackets(mReceiver, 10));
+        ASSERT_EQ(2, mReceiver.packets.size());
+        EXPECT_EQ((std::vector<char>{7, 8, 9}), mReceiver.packets[0]);
+        EXPECT_EQ((std::vector<char>{7, 8, 9}), mReceiver.packets[1]);
+    }
+
+    TEST_F(LoopbackP2PTransportTests, SendPacketToAll_whenSomeTargetsFail_reportsOnlyThoseTargets) {
+        for (uint32_t i = 0; i < LoopbackP2PNetwork::kQueueCapacity; i++) {
+            ASSERT_TRUE(SendByte(mNetwork.GetPeer(0), 2, 0)); // Fill up second target's queue
+        }
+        const CrossPlatformIdWrapper targetIds[] = {
+            LoopbackP2PNetwork::GetPeerId(1), LoopbackP2PNetwork::GetPeerId(2), LoopbackP2PNetwork::GetPeerId(0)
+        };
+        const char data = 1;
+
+        uint32_t failedTargetsMask = mNetwork.GetPeer(0).SendPacketToAll(
+            targetIds, 3, &data, 1, PacketReliability::ReliableOrdered
+        );
+
+        EXPECT_EQ(0b110, failedTargetsMask); // Full queue + self
+        EXPECT_EQ(1, mNetwork.GetPeer(1).ReceivePackets(mReceiver, 10));
+    }
+
+    #pragma region Headless match over loopback
+
+    // Sends local inputs through its network manager like a real game would, and records the inputs each frame was
+    //      last simulated with
+    class LoopbackRollbackUser : public RollbackTestUser {
+      public:
+        LoopbackRollbackUser(SimNetworkManager& networkManager, uint32_t inputChangeInterval)
+            : mNetworkManager(networkManager), mInputChangeInterval(inputChangeInterval) {}
+
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+            // Change input every so often, so that remote peer mispredicts and must roll back
+            result.commandInputs.SetCommandValue(InputCommand::Jump, (expectedFrame / mInputChangeInterval) % 2 == 1);
+            return true;
+        }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrame(expectedFrame, playerInputs);
+            RecordInputs(expectedFrame, playerInputs);
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            RecordInputs(expectedFrame, playerInputs);
+        }
+        void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {
+            RollbackTestUser::SendLocalInputsToRemotePlayers(message);
+            mNetworkManager.SendP2PMessageToAllPlayersInMatchLobby(message, PacketReliability::UnreliableUnordered);
+        }
+
+        // Latest inputs each frame was simulated with, indexed by frame
+        std::vector<std::vector<CharacterInput>> simulatedInputs = {};
+
+      private:
+        void RecordInputs(FrameType frame, const PlayerInputsForFrame& playerInputs) {
+            if (simulatedInputs.size() <= frame) {
+                simulatedInputs.resize(frame + 1);
+            }
+            simulatedInputs[frame].clear();
+            for (uint32_t i = 0; i < playerInputs.GetSize(); i++) {
+                simulatedInputs[frame].push_back(playerInputs.Get(i));
+            }
+        }
+
+        SimNetworkManager& mNetworkManager;
+        uint32_t mInputChangeInterval;
+    };
+
+    class LoopbackRollbackMatchTests : public BaseSimTest {
+      protected:
+        void SetUp() override {
+            BaseSimTest::SetUp();
+            RegisterInputHandler(mPlayer1NetworkManager, mPlayer1Manager);
+            RegisterInputHandler(mPlayer2NetworkManager, mPlayer2Manager);
+        }
+
+        uint64_t GetCurrentTime() const {
+            return mCurTimeInMicroSec;
+        }
+
+        // Passes received input updates to rollback manager, as game's network layer would
+        static void RegisterInputHandler(SimNetworkManager& networkManager, RollbackManager<TestSnapshot>& rollbackManager) {
+            networkManager.RegisterP2PMessageHandler<InputUpdateMessage>(
+                [&networkManager, &rollbackManager](const CrossPlatformIdWrapper& senderId, const InputUpdateMessage& message) {
+                    PlayerSpot senderSpot = PlayerSpot::Player1;
+                    const NetPlayerSpotMapping& mapping = networkManager.GetPlayersInfo().netLobbyInfo.playerSpotMapping;
+                    if (mapping.TryGetPlayerSpotForId(GetLoggerSingleton(), senderId, senderSpot)) {
+                        rollbackManager.OnReceivedRemotePlayerInput(senderSpot, message);
+                    }
+                }
+            );
+        }
+
+        void StartSession(RollbackManager<TestSnapshot>& rollbackManager, PlayerSpot localSpot) {
+            RollbackSettings settings = {};
+            settings.totalPlayers = 2;
+            settings.localPlayerSpot = localSpot;
+            settings.hostPlayerSpot = PlayerSpot::Player1;
+            settings.localInputDelay = 0; // Guarantees mispredictions, so rollbacks are exercised
+            rollbackManager.StartRollbackSession(settings);
+        }
+
+        // Both peers simulate one frame then exchange whatever they sent
+        void TickBothPeersOneFrame() {
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+            mPlayer1Manager.OnTick();
+            mPlayer2Manager.OnTick();
+
+            mPlayer1NetworkManager.Tick();
+            mPlayer2NetworkManager.Tick();
+        }
+
+        uint64_t mCurTimeInMicroSec = 0;
+        LoopbackP2PNetwork mNetwork = LoopbackP2PNetwork(2);
+        const std::vector<CrossPlatformIdWrapper> mPlayerIds = {LoopbackP2PNetwork::GetPeerId(0), LoopbackP2PNetwork::GetPeerId(1)};
+
+        SimNetworkManager mPlayer1NetworkManager = SimNetworkManager(
+            mNetwork.GetPeer(0), mPlayerIds[0], mPlayerIds, std::bind_front(&LoopbackRollbackMatchTests::GetCurrentTime, this)
+        );
+        SimNetworkManager mPlayer2NetworkManager = SimNetworkManager(
+            mNetwork.GetPeer(1), mPlayerIds[1], mPlayerIds, std::bind_front(&LoopbackRollbackMatchTests::GetCurrentTime, this)
+        );
+        LoopbackRollbackUser mPlayer1User = LoopbackRollbackUser(mPlayer1NetworkManager, 4);
+        LoopbackRollbackUser mPlayer2User = LoopbackRollbackUser(mPlayer2NetworkManager, 7);
+        RollbackManager<TestSnapshot> mPlayer1Manager = RollbackManager<TestSnapshot>(
+            mPlayer1User, std::bind_front(&LoopbackRollbackMatchTests::GetCurrentTime, this)
+        );
+        RollbackManager<TestSnapshot> mPlayer2Manager = RollbackManager<TestSnapshot>(
+            mPlayer2User, std::bind_front(&LoopbackRollbackMatchTests::GetCurrentTime, this)
+        );
+    };
+
+    TEST_F(LoopbackRollbackMatchTests, SimNetworkManager_whenConstructedOverTransport_isInLockedLobbyWithGivenPlayers) {
+        EXPECT_TRUE(mPlayer2NetworkManager.IsInitialized());
+        EXPECT_TRUE(mPlayer2NetworkManager.IsLoggedIn());
+        EXPECT_TRUE(mPlayer2NetworkManager.IsInLobby());
+
+        const NetLobbyInfo& lobbyInfo = mPlayer2NetworkManager.GetPlayersInfo().netLobbyInfo;
+        EXPECT_FALSE(lobbyInfo.isLocalPlayerLobbyOwner);
+        EXPECT_EQ(mPlayerIds[0], lobbyInfo.lobbyOwner);
+        EXPECT_EQ(std::vector<CrossPlatformIdWrapper>{mPlayerIds[0]}, lobbyInfo.remoteMemberIds);
+        EXPECT_TRUE(lobbyInfo.playerSpotMapping.IsLocked());
+        EXPECT_EQ(PlayerSpot::Player2, lobbyInfo.playerSpotMapping.GetLocalPlayerSpot());
+        EXPECT_TRUE(mPlayer1NetworkManager.GetPlayersInfo().netLobbyInfo.isLocalPlayerLobbyOwner);
+    }
+
+    TEST_F(LoopbackRollbackMatchTests, SimNetworkManager_whenTimeQualityReportAnswered_measuresRttWithGivenTime) {
+        ASSERT_TRUE(mPlayer2NetworkManager.SendP2PMessageToMatchLobbyHost(
+            mPlayer2NetworkManager.CreateTimeQualityReport(0), PacketReliability::UnreliableUnordered
+        ));
+
+        mCurTimeInMicroSec += 1000;
+        mPlayer1NetworkManager.Tick(); // Host answers report
+        mCurTimeInMicroSec += 2000;
+        mPlayer2NetworkManager.Tick();
+
+        const PeerLatencyStats latencyStats = mPlayer2NetworkManager.GetPeerLatencyStats(mPlayerIds[0]);
+        EXPECT_EQ(1, latencyStats.sampleCount);
+        EXPECT_EQ(3000, latencyStats.lastRttInMicroSec);
+    }
+
+    TEST_F(LoopbackRollbackMatchTests, OnTick_whenPeersExchangeInputsOverLoopback_simulateIdenticalConfirmedFrames) {
+        StartSession(mPlayer1Manager, PlayerSpot::Player1);
+        StartSession(mPlayer2Manager, PlayerSpot::Player2);
+
+        constexpr FrameType kFramesToRun = 60;
+        for (FrameType i = 0; i < kFramesToRun; i++) {
+            TickBothPeersOneFrame();
+        }
+
+        // Each peer predicted the other's changing inputs, so both must have rolled back to correct them
+        EXPECT_GT(mPlayer1User.restoreSnapshotCalls, 0);
+        EXPECT_GT(mPlayer2User.restoreSnapshotCalls, 0);
+
+        // Latest frames may still be predicted, but every earlier frame must have been simulated with same inputs
+        ASSERT_GE(mPlayer1User.simulatedInputs.size(), kFramesToRun - 1);
+        ASSERT_GE(mPlayer2User.simulatedInputs.size(), kFramesToRun - 1);
+        for (FrameType frame = 0; frame < kFramesToRun - 2; frame++) {
+            EXPECT_EQ(mPlayer1User.simulatedInputs[frame], mPlayer2User.simulatedInputs[frame]) << "Frame " << frame;
+        }
+    }
+
+    #pragma endregion
+}
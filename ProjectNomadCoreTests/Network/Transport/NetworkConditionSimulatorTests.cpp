@@ -0,0 +1,223 @@
+#include "pchNCT.h"
+
+#include <algorithm>
+
+#include "Network/Transport/LoopbackP2PTransport.h"
+#include "Network/Transport/NetworkConditionSimulator.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace NetworkConditionSimulatorTests {
+    // Records first byte of every received packet, which tests use as a packet id
+    class RecordingReceiver : public IP2PPacketReceiver {
+      public:
+        void OnPacketReceived(const CrossPlatformIdWrapper& senderId, const std::vector<char>& packetData) override {
+            packetIds.push_back(packetData[0]);
+        }
+
+        std::vector<char> packetIds = {};
+    };
+
+    class NetworkConditionSimulatorTests : public BaseSimTest {
+      protected:
+        uint64_t GetCurrentTime() const {
+            return mCurTimeInMicroSec;
+        }
+
+        // Sends packets with ids 0 through (count - 1) from peer 0 to peer 1
+        void SendPackets(char count, PacketReliability reliability) {
+            for (char i = 0; i < count; i++) {
+                ASSERT_TRUE(mToTest.SendPacket(LoopbackP2PNetwork::GetPeerId(1), &i, 1, reliability));
+            }
+        }
+        void ReceiveAll() {
+            mToTest.FlushDuePackets();
+            mNetwork.GetPeer(1).ReceivePackets(mReceiver, 1000);
+        }
+
+        static bool IsInOrder(const std::vector<char>& packetIds) {
+            return std::is_sorted(packetIds.begin(), packetIds.end());
+        }
+
+        // Sends 100 packets with given jitter then counts how many arrive within the first quarter of max jitter
+        size_t CountPacketsArrivingEarly(JitterDistribution distribution) {
+            NetworkLinkConditions conditions = {};
+            conditions.jitterInMicroSec = 40000;
+            conditions.jitterDistribution = distribution;
+            LoopbackP2PNetwork network(2);
+            NetworkConditionSimulator simulator(network.GetPeer(0), 12345, [this] { return mCurTimeInMicroSec; });
+            simulator.SetDefaultConditions(conditions);
+
+            mCurTimeInMicroSec = 0;
+            for (char i = 0; i < 100; i++) {
+                simulator.SendPacket(LoopbackP2PNetwork::GetPeerId(1), &i, 1, PacketReliability::UnreliableUnordered);
+            }
+            mCurTimeInMicroSec = conditions.jitterInMicroSec / 4;
+            simulator.FlushDuePackets();
+
+            RecordingReceiver receiver;
+            network.GetPeer(1).ReceivePackets(receiver, 1000);
+            return receiver.packetIds.size();
+        }
+
+        uint64_t mCurTimeInMicroSec = 0;
+        LoopbackP2PNetwork mNetwork = LoopbackP2PNetwork(2);
+        NetworkConditionSimulator mToTest = NetworkConditionSimulator(
+            mNetwork.GetPeer(0), 12345, std::bind_front(&NetworkConditionSimulatorTests::GetCurrentTime, this)
+        );
+        RecordingReceiver mReceiver = {};
+    };
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_whenNoImpairments_deliversImmediatelyInOrder) {
+        SendPackets(10, PacketReliability::UnreliableUnordered);
+        ReceiveAll();
+
+        ASSERT_EQ(10, mReceiver.packetIds.size());
+        EXPECT_TRUE(IsInOrder(mReceiver.packetIds));
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withLatency_holdsPacketUntilLatencyPassed) {
+        NetworkLinkConditions conditions = {};
+        conditions.latencyInMicroSec = 50000;
+        mToTest.SetDefaultConditions(conditions);
+
+        SendPackets(1, PacketReliability::UnreliableUnordered);
+        mCurTimeInMicroSec = 49999;
+        ReceiveAll();
+        EXPECT_EQ(0, mReceiver.packetIds.size());
+        EXPECT_EQ(1, mToTest.GetHeldPacketCount());
+
+        mCurTimeInMicroSec = 50000;
+        ReceiveAll();
+        EXPECT_EQ(1, mReceiver.packetIds.size());
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_whenUnreliableAndAlwaysLost_dropsEveryPacket) {
+        NetworkLinkConditions conditions = {};
+        conditions.lossChance = NetworkLinkConditions::kChanceScale;
+        mToTest.SetDefaultConditions(conditions);
+
+        SendPackets(10, PacketReliability::UnreliableUnordered);
+        ReceiveAll();
+
+        EXPECT_EQ(0, mReceiver.packetIds.size());
+        EXPECT_EQ(10, mToTest.GetStats().packetsDropped);
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_whenReliableAndAlwaysLost_deliversAfterExtraRoundTrip) {
+        NetworkLinkConditions conditions = {};
+        conditions.latencyInMicroSec = 10000;
+        conditions.lossChance = NetworkLinkConditions::kChanceScale;
+        mToTest.SetDefaultConditions(conditions);
+
+        SendPackets(1, PacketReliability::ReliableOrdered);
+        mCurTimeInMicroSec = 10000;
+        ReceiveAll();
+        EXPECT_EQ(0, mReceiver.packetIds.size());
+
+        mCurTimeInMicroSec = 30000; // Original one-way trip + resend after a round trip
+        ReceiveAll();
+        EXPECT_EQ(1, mReceiver.packetIds.size());
+        EXPECT_EQ(1, mToTest.GetStats().packetsResent);
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withJitter_onlyReordersUnorderedPackets) {
+        NetworkLinkConditions conditions = {};
+        conditions.jitterInMicroSec = 20000;
+        mToTest.SetDefaultConditions(conditions);
+
+        SendPackets(50, PacketReliability::UnreliableUnordered);
+        mCurTimeInMicroSec += conditions.jitterInMicroSec;
+        ReceiveAll();
+        ASSERT_EQ(50, mReceiver.packetIds.size());
+        EXPECT_FALSE(IsInOrder(mReceiver.packetIds));
+
+        mReceiver.packetIds.clear();
+        SendPackets(50, PacketReliability::ReliableOrdered);
+        mCurTimeInMicroSec += conditions.jitterInMicroSec;
+        ReceiveAll();
+        ASSERT_EQ(50, mReceiver.packetIds.size());
+        EXPECT_TRUE(IsInOrder(mReceiver.packetIds));
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_whenSameSeedAndSends_impairsIdentically) {
+        NetworkLinkConditions conditions = NetworkConditionProfiles::PoorMobile().conditions;
+        LoopbackP2PNetwork otherNetwork(2);
+        NetworkConditionSimulator other(otherNetwork.GetPeer(0), 12345, [this] { return mCurTimeInMicroSec; });
+        mToTest.SetDefaultConditions(conditions);
+        other.SetDefaultConditions(conditions);
+
+        for (char i = 0; i < 100; i++) {
+            mToTest.SendPacket(LoopbackP2PNetwork::GetPeerId(1), &i, 1, PacketReliability::UnreliableUnordered);
+            other.SendPacket(LoopbackP2PNetwork::GetPeerId(1), &i, 1, PacketReliability::UnreliableUnordered);
+        }
+        mCurTimeInMicroSec = 1000000;
+        ReceiveAll();
+        RecordingReceiver otherReceiver;
+        other.FlushDuePackets();
+        otherNetwork.GetPeer(1).ReceivePackets(otherReceiver, 1000);
+
+        EXPECT_EQ(mReceiver.packetIds, otherReceiver.packetIds);
+        EXPECT_GT(mToTest.GetStats().packetsDropped, 0);
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withReliabilityConditions_onlyImpairsThatReliability) {
+        NetworkLinkConditions reliableConditions = {};
+        reliableConditions.latencyInMicroSec = 50000;
+        mToTest.SetDefaultConditions(PacketReliability::ReliableOrdered, reliableConditions);
+
+        SendPackets(1, PacketReliability::UnreliableUnordered);
+        SendPackets(1, PacketReliability::ReliableOrdered);
+        ReceiveAll();
+        EXPECT_EQ(1, mReceiver.packetIds.size());
+        EXPECT_EQ(1, mToTest.GetHeldPacketCount());
+
+        mCurTimeInMicroSec = 50000;
+        ReceiveAll();
+        EXPECT_EQ(2, mReceiver.packetIds.size());
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withLinkReliabilityConditions_keepsDefaultsForOtherReliabilities) {
+        NetworkLinkConditions defaultConditions = {};
+        defaultConditions.latencyInMicroSec = 10000;
+        mToTest.SetDefaultConditions(defaultConditions);
+        NetworkLinkConditions unreliableConditions = {};
+        unreliableConditions.lossChance = NetworkLinkConditions::kChanceScale;
+        mToTest.SetLinkConditions(
+            LoopbackP2PNetwork::GetPeerId(1), PacketReliability::UnreliableUnordered, unreliableConditions
+        );
+
+        SendPackets(5, PacketReliability::UnreliableUnordered);
+        SendPackets(1, PacketReliability::ReliableUnordered);
+        ReceiveAll();
+        EXPECT_EQ(0, mReceiver.packetIds.size());
+        EXPECT_EQ(5, mToTest.GetStats().packetsDropped);
+
+        mCurTimeInMicroSec = 10000;
+        ReceiveAll();
+        EXPECT_EQ(1, mReceiver.packetIds.size());
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withJitterDistributions_shapesHowEarlyPacketsArrive) {
+        size_t uniformEarlyCount = CountPacketsArrivingEarly(JitterDistribution::Uniform);
+        size_t normalEarlyCount = CountPacketsArrivingEarly(JitterDistribution::Normal);
+        size_t longTailEarlyCount = CountPacketsArrivingEarly(JitterDistribution::LongTail);
+
+        // Expected about 25, 4, and 60 respectively
+        EXPECT_LT(normalEarlyCount, uniformEarlyCount);
+        EXPECT_GT(longTailEarlyCount, uniformEarlyCount * 2);
+    }
+
+    TEST_F(NetworkConditionSimulatorTests, SendPacket_withLongTailJitter_staysWithinMaxJitter) {
+        NetworkLinkConditions conditions = {};
+        conditions.jitterInMicroSec = 40000;
+        conditions.jitterDistribution = JitterDistribution::LongTail;
+        mToTest.SetDefaultConditions(conditions);
+
+        SendPackets(100, PacketReliability::UnreliableUnordered);
+        mCurTimeInMicroSec = conditions.jitterInMicroSec;
+        ReceiveAll();
+
+        EXPECT_EQ(100, mReceiver.packetIds.size());
+    }
+}
@@ -0,0 +1,245 @@
+#include "pchNCT.h"
+
+#include "Rollback/HeadlessRollbackMatch.h"
+#include "Rollback/Model/RegistrySnapshot.h"
+#include "TestHelpers/TestHelpers.h"
+#include "TestHelpers/TestSnapshot.h"
+
+using namespace ProjectNomad;
+namespace HeadlessRollbackMatchTests {
+    // Tiny deterministic "game" whose state depends on every player's input for every frame
+    class HeadlessTestGameUser : public RollbackUser<TestSnapshot> {
+      public:
+        explicit HeadlessTestGameUser(FrameType inputChangeInterval) : mInputChangeInterval(inputChangeInterval) {}
+        ~HeadlessTestGameUser() override = default;
+
+        void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {
+            result.number = mState;
+        }
+        void RestoreSnapshot(FrameType expectedFrame, const TestSnapshot& snapshotToRestore) override {
+            mState = snapshotToRestore.number;
+        }
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+            result.commandInputs.SetCommandValue(InputCommand::Jump, (expectedFrame / mInputChangeInterval) % 2 == 1);
+            return true;
+        }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            Simulate(expectedFrame, playerInputs);
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            Simulate(expectedFrame, playerInputs);
+        }
+        void OnPostRollback() override {}
+        void SendTimeQualityReport(FrameType currentFrame) override {}
+        void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) override {}
+        void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {}
+        void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) override {}
+        void OnInputsExitRollbackWindow(FrameType confirmedFrame) override {}
+
+        // State after each frame, indexed by frame. Re-simulated frames overwrite earlier predicted results
+        std::vector<uint32_t> statePerFrame = {};
+
+      private:
+        void Simulate(FrameType frame, const PlayerInputsForFrame& playerInputs) {
+            for (uint32_t i = 0; i < playerInputs.GetSize(); i++) {
+                mState = mState * 31 + playerInputs.Get(i).commandInputs.Serialize() + i;
+            }
+
+            if (statePerFrame.size() <= frame) {
+                statePerFrame.resize(frame + 1);
+            }
+            statePerFrame[frame] = mState;
+        }
+
+        FrameType mInputChangeInterval;
+        uint32_t mState = 0;
+    };
+
+    // Registry based "game", where one peer can be made to silently diverge a single entity from a given frame onwards
+    class HeadlessRegistryGameUser : public RollbackUser<CoreRegistrySnapshot> {
+      public:
+        static constexpr uint32_t kNumEntities = 50;
+
+        HeadlessRegistryGameUser() {
+            for (uint32_t i = 0; i < kNumEntities; i++) {
+                entt::entity entity = mContext.registry.create();
+                mContext.registry.emplace<TransformComponent>(entity);
+                mContext.registry.emplace<PhysicsComponent>(entity).velocity = FPVector(fp{static_cast<int32_t>(i % 5)}, fp{0}, fp{0});
+            }
+        }
+        ~HeadlessRegistryGameUser() override = default;
+
+        void GenerateSnapshot(FrameType expectedFrame, CoreRegistrySnapshot& result) override {
+            result.Capture(mContext);
+        }
+        void RestoreSnapshot(FrameType expectedFrame, const CoreRegistrySnapshot& snapshotToRestore) override {
+            snapshotToRestore.Restore(mContext);
+        }
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+            result.commandInputs.SetCommandValue(InputCommand::Jump, (expectedFrame / 6) % 2 == 1);
+            return true;
+        }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            Simulate(expectedFrame, playerInputs);
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            Simulate(expectedFrame, playerInputs);
+        }
+        void OnPostRollback() override {}
+        void SendTimeQualityReport(FrameType currentFrame) override {}
+        void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) override {}
+        void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {}
+        void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) override {}
+        void OnInputsExitRollbackWindow(FrameType confirmedFrame) override {}
+
+        void DivergeEntityFromFrame(entt::entity entity, FrameType frame) {
+            mDivergedEntity = entity;
+            mDivergeFromFrame = frame;
+        }
+
+      private:
+        void Simulate(FrameType frame, const PlayerInputsForFrame& playerInputs) {
+            // Every player's jump input pushes each entity up, so state depends on all remote inputs
+            fp verticalVelocity = fp{0};
+            for (uint32_t i = 0; i < playerInputs.GetSize(); i++) {
+                verticalVelocity += playerInputs.Get(i).commandInputs.IsCommandSet(InputCommand::Jump) ? fp{1} : fp{0};
+            }
+
+            for (auto [entity, transform, physics] : mContext.registry.view<TransformComponent, PhysicsComponent>().each()) {
+                physics.velocity.z = verticalVelocity;
+                if (entity == mDivergedEntity && frame >= mDivergeFromFrame) {
+                    physics.velocity.y = fp{1};
+                }
+                transform.location += physics.velocity;
+            }
+        }
+
+        CoreContext mContext = {};
+        entt::entity mDivergedEntity = entt::null;
+        FrameType mDivergeFromFrame = 0;
+    };
+
+    class HeadlessRollbackMatchTests : public BaseSimTest {
+      protected:
+        static constexpr uint64_t kMatchDurationInMicroSec = 10 * 1000 * 1000;
+
+        static HeadlessMatchSettings CreateSettings(const NetworkLinkConditions& conditions) {
+            HeadlessMatchSettings settings = {};
+            settings.linkConditions = conditions;
+            settings.networkSeed = 42;
+            settings.peerStartStaggerInMicroSec = 100000;
+            return settings;
+        }
+
+        // Frames outside the rollback window can never change again, so they must match between peers
+        void ExpectConfirmedStatesMatch(const HeadlessTestGameUser& host, const HeadlessTestGameUser& other) const {
+            const size_t framesToCompare = std::min(host.statePerFrame.size(), other.statePerFrame.size());
+            ASSERT_GT(framesToCompare, RollbackStaticSettings::kMaxRollbackFrames);
+
+            for (size_t frame = 0; frame < framesToCompare - RollbackStaticSettings::kMaxRollbackFrames; frame++) {
+                ASSERT_EQ(host.statePerFrame[frame], other.statePerFrame[frame]) << "Frame " << frame;
+            }
+        }
+
+        HeadlessTestGameUser mHostUser = HeadlessTestGameUser(5);
+        HeadlessTestGameUser mOtherUser = HeadlessTestGameUser(7);
+    };
+
+    TEST_F(HeadlessRollbackMatchTests, RunFor_withIdealConditions_neverStallsAndStaysInSync) {
+        HeadlessMatchSettings settings = CreateSettings({});
+        settings.peerStartStaggerInMicroSec = 0; // Otherwise host may briefly wait for other peer to catch up
+        HeadlessRollbackMatch<TestSnapshot> toTest({&mHostUser, &mOtherUser}, settings);
+        toTest.RunFor(kMatchDurationInMicroSec);
+
+        HeadlessMatchReport report = toTest.GetReport();
+        ASSERT_EQ(2, report.peers.GetSize());
+        EXPECT_EQ(0, report.peers.Get(0).stallTicks);
+        EXPECT_EQ(0, report.peers.Get(1).stallTicks);
+        EXPECT_GT(report.peers.Get(1).framesProcessed, 500);
+        ExpectConfirmedStatesMatch(mHostUser, mOtherUser);
+
+        TestHelpers::EmptySingletonLogger(); // Time sync logs as part of normal operation
+    }
+
+    TEST_F(HeadlessRollbackMatchTests, RunFor_withHighLatencyAndStaggeredStart_measuresLatencyAndClosesTimeDrift) {
+        NetworkLinkConditions conditions = {};
+        conditions.latencyInMicroSec = 80000;
+        HeadlessMatchSettings settings = CreateSettings(conditions);
+        settings.peerStartStaggerInMicroSec = 150000; // About 9 frames
+        HeadlessRollbackMatch<TestSnapshot> toTest({&mHostUser, &mOtherUser}, settings);
+        toTest.RunFor(kMatchDurationInMicroSec);
+
+        HeadlessMatchReport report = toTest.GetReport();
+        const PeerLatencyStats& latencyToHost = report.peers.Get(1).latencyToHost;
+        EXPECT_FALSE(report.peers.Get(0).latencyToHost.HasSamples());
+        ASSERT_TRUE(latencyToHost.HasSamples());
+        // Round trip is twice the latency, plus up to a tick on each side before packets are received
+        EXPECT_GE(latencyToHost.minRttInMicroSec, 2 * conditions.latencyInMicroSec);
+        EXPECT_LE(latencyToHost.smoothedRttInMicroSec, 2 * conditions.latencyInMicroSec + 2 * settings.tickIntervalInMicroSec);
+        // Time sync should close the stagger, despite host's frame in each report being a full one-way delay old
+        EXPECT_LE(std::abs(report.peers.Get(1).finalFramesAheadOfHost), 1);
+        ExpectConfirmedStatesMatch(mHostUser, mOtherUser);
+
+        TestHelpers::EmptySingletonLogger(); // Time sync logs as part of normal operation
+    }
+
+    TEST_F(HeadlessRollbackMatchTests, RunFor_withHighLatencyAndInputDelayTuning_resimulatesFewerFrames) {
+        HeadlessMatchSettings withoutDelaySettings = CreateSettings(NetworkConditionProfiles::CrossRegion().conditions);
+        withoutDelaySettings.rollbackSettings.localInputDelay = 0;
+        HeadlessRollbackMatch<TestSnapshot> withoutDelay({&mHostUser, &mOtherUser}, withoutDelaySettings);
+        withoutDelay.RunFor(kMatchDurationInMicroSec);
+
+        HeadlessTestGameUser hostUser(5), otherUser(7);
+        HeadlessMatchSettings tunedSettings = withoutDelaySettings;
+        tunedSettings.rollbackSettings.inputDelayTuning.isEnabled = true;
+        HeadlessRollbackMatch<TestSnapshot> tuned({&hostUser, &otherUser}, tunedSettings);
+        tuned.RunFor(kMatchDurationInMicroSec);
+
+        const HeadlessMatchReport withoutDelayReport = withoutDelay.GetReport();
+        const HeadlessMatchReport tunedReport = tuned.GetReport();
+        for (uint32_t i = 0; i < tunedReport.peers.GetSize(); i++) {
+            EXPECT_GT(tunedReport.peers.Get(i).finalLocalInputDelay, 0) << "Peer " << i;
+            EXPECT_LT(tunedReport.peers.Get(i).framesResimulated, withoutDelayReport.peers.Get(i).framesResimulated) << "Peer " << i;
+        }
+        ExpectConfirmedStatesMatch(hostUser, otherUser);
+
+        TestHelpers::EmptySingletonLogger(); // Time sync logs as part of normal operation
+    }
+
+    TEST_F(HeadlessRollbackMatchTests, RunFor_withEachNetworkProfile_staysInSyncAndReportsDeterministically) {
+        for (const NetworkConditionProfile& profile : NetworkConditionProfiles::GetAll()) {
+            HeadlessTestGameUser hostUser(5), otherUser(7);
+            HeadlessRollbackMatch<TestSnapshot> toTest({&hostUser, &otherUser}, CreateSettings(profile.conditions));
+            toTest.RunFor(kMatchDurationInMicroSec);
+            ExpectConfirmedStatesMatch(hostUser, otherUser);
+
+            HeadlessTestGameUser repeatHostUser(5), repeatOtherUser(7);
+            HeadlessRollbackMatch<TestSnapshot> repeat({&repeatHostUser, &repeatOtherUser}, CreateSettings(profile.conditions));
+            repeat.RunFor(kMatchDurationInMicroSec);
+
+            const std::string reportJson = toTest.GetReport().ToJson(profile.name);
+            EXPECT_EQ(reportJson, repeat.GetReport().ToJson(profile.name)) << profile.name;
+        }
+
+        TestHelpers::EmptySingletonLogger(); // Time sync logs as part of normal operation
+    }
+
+    TEST_F(HeadlessRollbackMatchTests, RunFor_whenPeerDivergesSingleEntity_localizesDesyncToThatEntityAndComponent) {
+        HeadlessRegistryGameUser hostUser, otherUser;
+        otherUser.DivergeEntityFromFrame(entt::entity{37}, 90);
+        HeadlessMatchSettings settings = CreateSettings(NetworkConditionProfiles::CrossRegion().conditions);
+        settings.rollbackSettings.useDesyncLocalization = true;
+        HeadlessRollbackMatch<CoreRegistrySnapshot> toTest({&hostUser, &otherUser}, settings);
+        toTest.RunFor(kMatchDurationInMicroSec / 2);
+
+        DesyncLocalizationResult result = {};
+        EXPECT_FALSE(toTest.GetRollbackManager(0).TryGetDesyncLocalizationResult(result)); // Host only answers
+        ASSERT_TRUE(toTest.GetRollbackManager(1).TryGetDesyncLocalizationResult(result));
+        EXPECT_TRUE(result.didFindDivergence);
+        EXPECT_GE(result.targetFrame, 90);
+        EXPECT_EQ(0, result.typeIndex); // TransformComponent, as location diverges first in component order
+        EXPECT_EQ(37, result.entityIndex);
+
+        TestHelpers::EmptySingletonLogger(); // Desync itself is logged
+    }
+}
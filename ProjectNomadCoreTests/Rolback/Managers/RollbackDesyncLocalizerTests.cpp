@@ -0,0 +1,156 @@
+#include "pchNCT.h"
+
+#include "Network/P2PMessages/NetMessageSerialization.h"
+#include "Rollback/Managers/RollbackDesyncLocalizer.h"
+#include "Rollback/Model/RegistrySnapshot.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+
+namespace RollbackDesyncLocalizerTests {
+    class RollbackDesyncLocalizerTests : public BaseSimTest {
+      protected:
+        static constexpr FrameType kTargetFrame = 120;
+        static constexpr uint32_t kNumEntities = 300;
+
+        void SetUp() override {
+            // Same state on both sides, which tests then diverge as needed
+            for (CoreContext* context : {&mHostContext, &mPeerContext}) {
+                for (uint32_t i = 0; i < kNumEntities; i++) {
+                    entt::entity entity = context->registry.create();
+                    context->registry.emplace<TransformComponent>(entity).location = FPVector(fp{static_cast<int32_t>(i)}, fp{0}, fp{0});
+                    if (i % 3 == 0) {
+                        context->registry.emplace<PhysicsComponent>(entity).velocity = FPVector(fp{1}, fp{0}, fp{0});
+                    }
+                }
+            }
+        }
+
+        // Retains both sides' current state then runs the whole exchange, sending every message through its wire format
+        void RunLocalization() {
+            CoreRegistrySnapshot snapshot;
+            snapshot.Capture(mHostContext);
+            mHost.RetainSnapshot(kTargetFrame, snapshot);
+            snapshot.Capture(mPeerContext);
+            mPeer.RetainSnapshot(kTargetFrame, snapshot);
+
+            DesyncLocalizationRequestMessage request;
+            ASSERT_TRUE(mPeer.TryStart(GetLoggerSingleton(), kTargetFrame, request));
+            bool shouldSendRequest = true;
+            for (uint32_t roundTrips = 0; shouldSendRequest; roundTrips++) {
+                ASSERT_LT(roundTrips, 10) << "Localization never finished";
+
+                DesyncLocalizationRequestMessage receivedRequest;
+                ASSERT_TRUE(SendOverWire(request, receivedRequest));
+                DesyncLocalizationResponseMessage response;
+                mHost.TryAnswerRequest(receivedRequest, response);
+
+                DesyncLocalizationResponseMessage receivedResponse;
+                ASSERT_TRUE(SendOverWire(response, receivedResponse));
+                shouldSendRequest = mPeer.HandleResponse(GetLoggerSingleton(), receivedResponse, request);
+            }
+        }
+
+        template <typename MessageType>
+        bool SendOverWire(const MessageType& message, MessageType& result) {
+            std::vector<uint8_t> encoded;
+            NetMessageSerialization::Encode(message, encoded);
+            mBytesSent += encoded.size();
+            return NetMessageSerialization::Decode(encoded.data(), encoded.size(), result);
+        }
+
+        CoreContext mHostContext = {};
+        CoreContext mPeerContext = {};
+        RollbackDesyncLocalizer<CoreRegistrySnapshot> mHost = {};
+        RollbackDesyncLocalizer<CoreRegistrySnapshot> mPeer = {};
+        size_t mBytesSent = 0;
+    };
+
+    TEST_F(RollbackDesyncLocalizerTests, HandleResponse_whenSingleComponentDiverged_findsTypeAndEntityWithinFewHundredBytes) {
+        const entt::entity divergedEntity = entt::entity{201};
+        mPeerContext.registry.get<PhysicsComponent>(divergedEntity).velocity.y = fp{0.001f};
+
+        RunLocalization();
+
+        ASSERT_FALSE(mPeer.IsInProgress());
+        ASSERT_TRUE(mPeer.HasResult());
+        const DesyncLocalizationResult& result = mPeer.GetResult();
+        EXPECT_TRUE(result.didFindDivergence);
+        EXPECT_EQ(kTargetFrame, result.targetFrame);
+        EXPECT_EQ(1, result.typeIndex); // PhysicsComponent
+        EXPECT_EQ(201, result.entityIndex);
+        EXPECT_EQ(6, result.roundTrips); // All types, then each range level down to single entities
+        EXPECT_LT(mBytesSent, 1000);
+    }
+
+    TEST_F(RollbackDesyncLocalizerTests, HandleResponse_whenOnlyEntityExistenceDiverged_findsEntitiesType) {
+        entt::entity entityWithoutComponents = mPeerContext.registry.create();
+        ASSERT_TRUE(mPeerContext.registry.valid(entityWithoutComponents));
+
+        RunLocalization();
+
+        const DesyncLocalizationResult& result = mPeer.GetResult();
+        EXPECT_TRUE(result.didFindDivergence);
+        EXPECT_EQ(CoreRegistrySnapshot::kEntitiesDesyncChecksumTypeIndex, result.typeIndex);
+        EXPECT_EQ(kNumEntities, result.entityIndex);
+        EXPECT_EQ("Entities", CoreRegistrySnapshot::GetDesyncChecksumTypeName(result.typeIndex));
+    }
+
+    TEST_F(RollbackDesyncLocalizerTests, HandleResponse_whenStatesMatch_finishesWithoutDivergenceAfterOneRoundTrip) {
+        RunLocalization();
+
+        const DesyncLocalizationResult& result = mPeer.GetResult();
+        EXPECT_FALSE(result.didFindDivergence);
+        EXPECT_EQ(1, result.roundTrips);
+    }
+
+    TEST_F(RollbackDesyncLocalizerTests, HandleResponse_whenHostNoLongerHasSnapshot_stopsWithoutDivergence) {
+        CoreRegistrySnapshot snapshot;
+        snapshot.Capture(mPeerContext);
+        mPeer.RetainSnapshot(kTargetFrame, snapshot);
+        for (FrameType i = 1; i <= RollbackDesyncLocalizer<CoreRegistrySnapshot>::kRetainedSnapshots; i++) {
+            mHost.RetainSnapshot(kTargetFrame + i * 60, snapshot); // Host has long since moved on
+        }
+
+        DesyncLocalizationRequestMessage request;
+        ASSERT_TRUE(mPeer.TryStart(GetLoggerSingleton(), kTargetFrame, request));
+        DesyncLocalizationResponseMessage response;
+        EXPECT_FALSE(mHost.TryAnswerRequest(request, response));
+        EXPECT_FALSE(mPeer.HandleResponse(GetLoggerSingleton(), response, request));
+
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_FALSE(mPeer.IsInProgress());
+        EXPECT_FALSE(mPeer.GetResult().didFindDivergence);
+    }
+
+    TEST_F(RollbackDesyncLocalizerTests, RetainSnapshot_whileLocalizing_neverReplacesLocalizedFrame) {
+        CoreRegistrySnapshot snapshot;
+        snapshot.Capture(mPeerContext);
+        mPeer.RetainSnapshot(kTargetFrame, snapshot);
+        DesyncLocalizationRequestMessage request;
+        ASSERT_TRUE(mPeer.TryStart(GetLoggerSingleton(), kTargetFrame, request));
+
+        for (FrameType i = 1; i <= 10; i++) {
+            mPeer.RetainSnapshot(kTargetFrame + i * 60, snapshot);
+        }
+
+        // Answer as if host had the exact same state, which can only be compared if frame is still retained
+        mHost.RetainSnapshot(kTargetFrame, snapshot);
+        DesyncLocalizationResponseMessage response;
+        ASSERT_TRUE(mHost.TryAnswerRequest(request, response));
+        mPeer.HandleResponse(GetLoggerSingleton(), response, request);
+        EXPECT_EQ(1, mPeer.GetResult().roundTrips);
+        TestHelpers::VerifySingleLoggingDidNotOccur();
+    }
+
+    TEST_F(RollbackDesyncLocalizerTests, TryAnswerRequest_whenRangeNotFromTree_fails) {
+        CoreRegistrySnapshot snapshot;
+        snapshot.Capture(mHostContext);
+        mHost.RetainSnapshot(kTargetFrame, snapshot);
+
+        DesyncLocalizationRequestMessage request(kTargetFrame, {0, 5, 20}); // Would index past child checksums
+        DesyncLocalizationResponseMessage response;
+        EXPECT_FALSE(mHost.TryAnswerRequest(request, response));
+        EXPECT_FALSE(response.didCalculateChecksums);
+    }
+}
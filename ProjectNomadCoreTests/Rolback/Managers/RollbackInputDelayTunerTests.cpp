@@ -0,0 +1,104 @@
+#include "pchNCT.h"
+
+#include "Rollback/Managers/RollbackInputDelayTuner.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+
+namespace RollbackInputDelayTunerTests {
+    class RollbackInputDelayTunerTests : public BaseSimTest {
+      protected:
+        static constexpr uint64_t kTimePerFrameInMicroSec = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+
+        static InputDelayTuningSettings CreateSettings() {
+            InputDelayTuningSettings settings = {};
+            settings.isEnabled = true;
+            settings.minInputDelay = 0;
+            settings.maxInputDelay = 6;
+            settings.deepRollbackFrames = 4;
+            settings.deepRollbacksToIncreaseDelay = 2;
+            settings.evaluationWindowFrames = 10;
+            return settings;
+        }
+
+        // Processes a full evaluation window with the given rollback depth happening every frame
+        void ProcessWindow(FrameType rollbackDepth) {
+            for (FrameType i = 0; i < CreateSettings().evaluationWindowFrames; i++) {
+                if (rollbackDepth > 0) {
+                    mToTest.RecordRollback(rollbackDepth);
+                }
+                mToTest.OnFrameProcessed();
+            }
+        }
+
+        RollbackInputDelayTuner mToTest = {};
+    };
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_whenDisabled_keepsInitialDelay) {
+        InputDelayTuningSettings settings = CreateSettings();
+        settings.isEnabled = false;
+        mToTest.OnSessionStart(settings, 3);
+
+        ProcessWindow(8);
+        ProcessWindow(0);
+
+        EXPECT_EQ(3, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_beforeWindowEnds_keepsCurrentDelay) {
+        mToTest.OnSessionStart(CreateSettings(), 2);
+
+        for (FrameType i = 0; i < CreateSettings().evaluationWindowFrames - 1; i++) {
+            mToTest.RecordRollback(8);
+            mToTest.OnFrameProcessed();
+        }
+
+        EXPECT_EQ(2, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_whenRepeatedDeepRollbacks_increasesDelayOneFramePerWindow) {
+        mToTest.OnSessionStart(CreateSettings(), 1);
+
+        ProcessWindow(5);
+        EXPECT_EQ(2, mToTest.GetTargetInputDelay());
+        ProcessWindow(5);
+        EXPECT_EQ(3, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_whenDelayAlreadyCoversLatency_doesNotIncreaseDelay) {
+        mToTest.OnSessionStart(CreateSettings(), 3);
+        mToTest.RecordRemoteLatency(PlayerSpot::Player2, kTimePerFrameInMicroSec * 3);
+
+        ProcessWindow(5); // Rollbacks must be due to something other than latency, so delay wouldn't help
+
+        EXPECT_EQ(3, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_whenDelayExceedsLatency_decreasesDelay) {
+        mToTest.OnSessionStart(CreateSettings(), 5);
+        mToTest.RecordRemoteLatency(PlayerSpot::Player2, kTimePerFrameInMicroSec * 2);
+
+        ProcessWindow(3); // Rollbacks are just below deep, which alone wouldn't be enough to decrease
+
+        EXPECT_EQ(4, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, OnFrameProcessed_whenRollbacksAreShallow_decreasesDelayDownToMin) {
+        InputDelayTuningSettings settings = CreateSettings();
+        settings.minInputDelay = 1;
+        mToTest.OnSessionStart(settings, 2);
+
+        ProcessWindow(2);
+        EXPECT_EQ(1, mToTest.GetTargetInputDelay());
+        ProcessWindow(0);
+        EXPECT_EQ(1, mToTest.GetTargetInputDelay());
+    }
+
+    TEST_F(RollbackInputDelayTunerTests, GetLatencyInFrames_whenMultipleRemotePlayers_usesFurthestRoundedUp) {
+        mToTest.OnSessionStart(CreateSettings(), 0);
+        mToTest.RecordRemoteLatency(PlayerSpot::Player2, kTimePerFrameInMicroSec);
+        mToTest.RecordRemoteLatency(PlayerSpot::Player3, kTimePerFrameInMicroSec * 2 + 1);
+
+        EXPECT_EQ(3, mToTest.GetLatencyInFrames());
+    }
+}
@@ -68,4 +68,114 @@ namespace RollbackSnapshotManagerTests {
 
         TestHelpers::VerifySingletonLoggingOccured();
     }
+
+    TEST_F(RollbackSnapshotManagerTests, StoreSnapshot_givenSnapshotInterval_canSkipFrames) {
+        mToTest.OnSessionStart(4);
+        
+        TestSnapshot toStore;
+        for (FrameType frame = 0; frame <= 8; frame += 4) {
+            toStore = {};
+            toStore.number = frame;
+            mToTest.StoreSnapshot(frame, toStore);
+        }
+
+        EXPECT_EQ(4, mToTest.GetSnapshot(4).number);
+        EXPECT_EQ(8, mToTest.GetLatestFrameSnapshot().number);
+        EXPECT_EQ(3, mToTest.GetStoredSnapshotCountSince(0));
+        EXPECT_EQ(1, mToTest.GetStoredSnapshotCountSince(5));
+    }
+
+    TEST_F(RollbackSnapshotManagerTests, GetNearestStoredFrameAtOrBefore_givenSkippedFrames_returnsLatestEarlierStoredFrame) {
+        mToTest.OnSessionStart(4);
+        
+        TestSnapshot toStore;
+        mToTest.StoreSnapshot(0, toStore);
+        toStore = {};
+        mToTest.StoreSnapshot(4, toStore);
+
+        EXPECT_EQ(0, mToTest.GetNearestStoredFrameAtOrBefore(3));
+        EXPECT_EQ(4, mToTest.GetNearestStoredFrameAtOrBefore(4));
+        EXPECT_EQ(4, mToTest.GetNearestStoredFrameAtOrBefore(7));
+    }
+
+    TEST_F(RollbackSnapshotManagerTests, GetSnapshot_givenSkippedFrame_thenLogsError) {
+        mToTest.OnSessionStart(4);
+        
+        TestSnapshot toStore;
+        mToTest.StoreSnapshot(0, toStore);
+        toStore = {};
+        mToTest.StoreSnapshot(4, toStore);
+        mToTest.GetSnapshot(2);
+
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(RollbackSnapshotManagerTests, StoreSnapshotInPlace_whenBufferFull_generatesIntoOldestSlot) {
+        for (FrameType frame = 0; frame < RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames; frame++) {
+            mToTest.StoreSnapshotInPlace(frame, [frame](TestSnapshot& slot) { slot.number = frame + 100; });
+        }
+
+        // Next slot handed out should be the one for oldest frame
+        FrameType recycledSlotNumber = 0;
+        const FrameType newFrame = RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames;
+        mToTest.StoreSnapshotInPlace(newFrame, [&recycledSlotNumber](TestSnapshot& slot) {
+            recycledSlotNumber = slot.number;
+            slot.number = 1;
+        });
+
+        EXPECT_EQ(100, recycledSlotNumber);
+        EXPECT_EQ(1, mToTest.GetSnapshot(newFrame).number);
+        EXPECT_EQ(newFrame - 1 + 100, mToTest.GetSnapshot(newFrame - 1).number);
+    }
+
+    TEST_F(RollbackSnapshotManagerTests, StoreSnapshotInPlace_whenReplacingFrame_generatesIntoExistingSlot) {
+        mToTest.StoreSnapshotInPlace(0, [](TestSnapshot& slot) { slot.number = 5; });
+        mToTest.StoreSnapshotInPlace(1, [](TestSnapshot& slot) { slot.number = 6; });
+        
+        FrameType replacedSlotNumber = 0;
+        mToTest.StoreSnapshotInPlace(0, [&replacedSlotNumber](TestSnapshot& slot) {
+            replacedSlotNumber = slot.number;
+            slot.number = 7;
+        });
+
+        EXPECT_EQ(5, replacedSlotNumber);
+        EXPECT_EQ(7, mToTest.GetSnapshot(0).number);
+        EXPECT_EQ(6, mToTest.GetSnapshot(1).number);
+    }
+
+    // Same as TestSnapshot but opts into delta-compressed storage
+    class TestDeltaSnapshot : public TestSnapshot {
+      public:
+        static constexpr bool kUseDeltaSnapshotStorage = true;
+    };
+
+    TEST_F(RollbackSnapshotManagerTests, UsesDeltaSnapshotStorage_onlyTrueWhenSnapshotOptsIn) {
+        EXPECT_FALSE(UsesDeltaSnapshotStorage<TestSnapshot>);
+        EXPECT_TRUE(UsesDeltaSnapshotStorage<TestDeltaSnapshot>);
+    }
+
+    TEST_F(RollbackSnapshotManagerTests, StoreSnapshot_givenDeltaStorage_canRetrieveAndReplacePriorSnapshots) {
+        RollbackSnapshotManager<TestDeltaSnapshot> deltaToTest;
+        deltaToTest.OnSessionStart();
+        
+        TestDeltaSnapshot toStore;
+        for (FrameType frame = 0; frame < RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames * 2; frame++) {
+            toStore = {};
+            toStore.number = frame * 10;
+            deltaToTest.StoreSnapshot(frame, toStore);
+        }
+        const FrameType latestFrame = RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames * 2 - 1;
+
+        // Replace a frame in middle of window
+        toStore = {};
+        toStore.number = 1;
+        deltaToTest.StoreSnapshot(latestFrame - 5, toStore);
+
+        EXPECT_EQ(latestFrame * 10, deltaToTest.GetLatestFrameSnapshot().number);
+        EXPECT_EQ((latestFrame - 4) * 10, deltaToTest.GetSnapshot(latestFrame - 4).number);
+        EXPECT_EQ(1, deltaToTest.GetSnapshot(latestFrame - 5).number);
+        EXPECT_EQ((latestFrame - 6) * 10, deltaToTest.GetSnapshot(latestFrame - 6).number);
+        const FrameType oldestFrame = latestFrame - RollbackStaticSettings::kOneMoreThanMaxRollbackFrames;
+        EXPECT_EQ(oldestFrame * 10, deltaToTest.GetSnapshot(oldestFrame).number);
+    }
 }
@@ -80,6 +80,46 @@ namespace RollbackTimeManagerTests {
         ASSERT_EQ(expected, result);
     }
 
+    TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenFramesExceedBudget_spreadsCatchUpAcrossTicks) {
+        mToTest.Start();
+        mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
+        // Each frame costs half the budget, so 2 frames fit per tick
+        mToTest.ReportFrameSimulationCost(RollbackTimeManager::GetCatchUpBudgetInMicroSec(), 2);
+
+        mCurTimeInMs = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 5; // Fall 5 frames behind
+
+        EXPECT_EQ(2, mToTest.CheckHowManyFramesToProcess());
+        EXPECT_EQ(3, mToTest.GetFrameDebt());
+        EXPECT_EQ(2, mToTest.CheckHowManyFramesToProcess()); // No time passed but still catching up
+        EXPECT_EQ(1, mToTest.CheckHowManyFramesToProcess());
+        EXPECT_EQ(0, mToTest.CheckHowManyFramesToProcess());
+    }
+
+    TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenBudgetAlreadySpent_stillProcessesOneFrame) {
+        mToTest.Start();
+        mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
+        mToTest.ReportFrameSimulationCost(RollbackTimeManager::GetCatchUpBudgetInMicroSec(), 2);
+
+        mCurTimeInMs = static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+        FrameType result = mToTest.CheckHowManyFramesToProcess(RollbackTimeManager::GetCatchUpBudgetInMicroSec());
+
+        EXPECT_EQ(1, result);
+        EXPECT_EQ(2, mToTest.GetFrameDebt());
+    }
+
+    TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenCalledAfterLongTime_onlyCatchesUpToMaxDebt) {
+        mToTest.Start();
+        mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
+        
+        mCurTimeInMs = SecondsToMicroSec(10); // Simulate moving 10 seconds into future
+        FrameType totalProcessed = 0;
+        for (int i = 0; i < 100; i++) {
+            totalProcessed += mToTest.CheckHowManyFramesToProcess();
+        }
+
+        EXPECT_EQ(RollbackTimeManager::GetMaxFrameDebt(), totalProcessed);
+    }
+
     TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenMoveForwardOneFrameAmountOfTime_returns1) {
         mToTest.Start();
         mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
@@ -109,4 +149,34 @@ namespace RollbackTimeManagerTests {
         
         ASSERT_EQ(1, result);
     }
+
+    TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenHostIsAhead_speedsUpToCatchUp) {
+        mToTest.Start();
+        mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
+        mToTest.SetupTimeSyncForRemoteFrameDifference(Singleton<LoggerSingleton>::get(), 10);
+        
+        FrameType totalProcessed = 0;
+        for (int i = 0; i < 60; i++) {
+            mCurTimeInMs += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+            totalProcessed += mToTest.CheckHowManyFramesToProcess();
+        }
+
+        EXPECT_GT(totalProcessed, 60);
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(RollbackTimeManagerTests, CheckHowManyFramesToProcess_whenHostIsBehind_slowsDownToLetHostCatchUp) {
+        mToTest.Start();
+        mToTest.CheckHowManyFramesToProcess(); // Clear initial frame processing special case
+        mToTest.SetupTimeSyncForRemoteFrameDifference(Singleton<LoggerSingleton>::get(), -10);
+        
+        FrameType totalProcessed = 0;
+        for (int i = 0; i < 60; i++) {
+            mCurTimeInMs += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+            totalProcessed += mToTest.CheckHowManyFramesToProcess();
+        }
+
+        EXPECT_LT(totalProcessed, 60);
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
 }
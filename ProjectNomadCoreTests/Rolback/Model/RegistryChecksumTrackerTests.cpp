@@ -0,0 +1,131 @@
+#include "pchNCT.h"
+
+#include <CRCpp/CRC.h>
+
+#include "TestHelpers/TestHelpers.h"
+#include "Rollback/Model/RegistryChecksumTracker.h"
+
+using namespace ProjectNomad;
+namespace RegistryChecksumTrackerTests {
+    struct FirstTestComponent {
+        uint32_t value = 0;
+
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = CRC::Calculate(&value, sizeof(value), CRC::CRC_32(), resultThusFar);
+        }
+    };
+
+    struct SecondTestComponent {
+        uint64_t value = 0;
+
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = CRC::Calculate(&value, sizeof(value), CRC::CRC_32(), resultThusFar);
+        }
+    };
+
+    using TrackerType = RegistryChecksumTracker<FirstTestComponent, SecondTestComponent>;
+
+    class RegistryChecksumTrackerTests : public BaseSimTest {
+      protected:
+        void SetUp() override {
+            BaseSimTest::SetUp();
+            mTracker.Connect(mRegistry);
+        }
+
+        void TearDown() override {
+            mTracker.Disconnect(mRegistry);
+            BaseSimTest::TearDown();
+        }
+
+        // Computes checksum from scratch, for comparison against incrementally maintained checksum
+        uint32_t CalculateFullChecksum() {
+            TrackerType freshTracker;
+            return freshTracker.UpdateChecksum(mRegistry);
+        }
+
+        void CreateStartingEntities() {
+            for (uint32_t i = 0; i < 5; i++) {
+                entt::entity entity = mRegistry.create();
+                mRegistry.emplace<FirstTestComponent>(entity, i);
+                if (i % 2 == 0) {
+                    mRegistry.emplace<SecondTestComponent>(entity, i * 10ull);
+                }
+            }
+        }
+
+        entt::registry mRegistry;
+        TrackerType mTracker;
+    };
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenRegistryUnchanged_returnsSameChecksum) {
+        CreateStartingEntities();
+
+        uint32_t first = mTracker.UpdateChecksum(mRegistry);
+        uint32_t second = mTracker.UpdateChecksum(mRegistry);
+
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(CalculateFullChecksum(), second);
+    }
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenComponentReplaced_matchesFullRecalculation) {
+        CreateStartingEntities();
+        uint32_t before = mTracker.UpdateChecksum(mRegistry);
+
+        entt::entity toChange = *mRegistry.view<FirstTestComponent>().begin();
+        mRegistry.replace<FirstTestComponent>(toChange, 1234u);
+        uint32_t after = mTracker.UpdateChecksum(mRegistry);
+
+        EXPECT_NE(before, after);
+        EXPECT_EQ(CalculateFullChecksum(), after);
+    }
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenDirectlyModifiedAndMarkedDirty_matchesFullRecalculation) {
+        CreateStartingEntities();
+        mTracker.UpdateChecksum(mRegistry);
+
+        entt::entity toChange = *mRegistry.view<SecondTestComponent>().begin();
+        mRegistry.get<SecondTestComponent>(toChange).value = 999;
+        mTracker.MarkDirty<SecondTestComponent>(toChange);
+
+        EXPECT_EQ(CalculateFullChecksum(), mTracker.UpdateChecksum(mRegistry));
+    }
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenComponentRemovedOrEntityDestroyed_matchesFullRecalculation) {
+        CreateStartingEntities();
+        uint32_t before = mTracker.UpdateChecksum(mRegistry);
+
+        entt::entity toRemoveFrom = *mRegistry.view<SecondTestComponent>().begin();
+        mRegistry.remove<SecondTestComponent>(toRemoveFrom);
+        entt::entity toDestroy = *mRegistry.view<FirstTestComponent>().begin();
+        mRegistry.destroy(toDestroy);
+        uint32_t after = mTracker.UpdateChecksum(mRegistry);
+
+        EXPECT_NE(before, after);
+        EXPECT_EQ(CalculateFullChecksum(), after);
+    }
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenSameComponentChangedMultipleTimes_matchesFullRecalculation) {
+        CreateStartingEntities();
+        mTracker.UpdateChecksum(mRegistry);
+
+        entt::entity toChange = mRegistry.create();
+        mRegistry.emplace<FirstTestComponent>(toChange, 1u);
+        mRegistry.patch<FirstTestComponent>(toChange, [](FirstTestComponent& component) { component.value = 2; });
+        mRegistry.replace<FirstTestComponent>(toChange, 3u);
+
+        EXPECT_EQ(CalculateFullChecksum(), mTracker.UpdateChecksum(mRegistry));
+    }
+
+    TEST_F(RegistryChecksumTrackerTests, UpdateChecksum_whenValuesSwappedBetweenEntities_changesChecksum) {
+        entt::entity first = mRegistry.create();
+        entt::entity second = mRegistry.create();
+        mRegistry.emplace<FirstTestComponent>(first, 1u);
+        mRegistry.emplace<FirstTestComponent>(second, 2u);
+        uint32_t before = mTracker.UpdateChecksum(mRegistry);
+
+        mRegistry.replace<FirstTestComponent>(first, 2u);
+        mRegistry.replace<FirstTestComponent>(second, 1u);
+
+        EXPECT_NE(before, mTracker.UpdateChecksum(mRegistry));
+    }
+}
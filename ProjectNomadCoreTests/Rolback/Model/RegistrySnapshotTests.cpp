@@ -0,0 +1,126 @@
+#include "pchNCT.h"
+
+#include "TestHelpers/TestHelpers.h"
+#include "Rollback/Model/RegistrySnapshot.h"
+
+using namespace ProjectNomad;
+namespace RegistrySnapshotTests {
+    class RegistrySnapshotTests : public BaseSimTest {
+      protected:
+        entt::entity CreateMovingEntity(fp xLocation) {
+            entt::entity entity = mContext.registry.create();
+            
+            TransformComponent& transform = mContext.registry.emplace<TransformComponent>(entity);
+            transform.location = FPVector(xLocation, fp{0}, fp{0});
+            PhysicsComponent& physics = mContext.registry.emplace<PhysicsComponent>(entity);
+            physics.velocity = FPVector(fp{1}, fp{2}, fp{3});
+            
+            return entity;
+        }
+
+        CoreContext mContext = {};
+        CoreRegistrySnapshot mToTest = {};
+    };
+
+    TEST_F(RegistrySnapshotTests, Restore_whenStateChangedAfterCapture_restoresExactComponentsAndEntities) {
+        entt::entity first = CreateMovingEntity(fp{1});
+        entt::entity second = CreateMovingEntity(fp{2});
+        mContext.registry.emplace<HitstopComponent>(second, 5u, 10u);
+        mContext.simFrame.SetCurrentFrameCount(30);
+        mToTest.Capture(mContext);
+
+        // Change state in every possible way
+        mContext.registry.get<TransformComponent>(first).location = FPVector(fp{100}, fp{0}, fp{0});
+        mContext.registry.destroy(second);
+        entt::entity third = CreateMovingEntity(fp{3});
+        mContext.simFrame.SetCurrentFrameCount(31);
+        
+        mToTest.Restore(mContext);
+
+        EXPECT_EQ(30, mContext.simFrame.GetCurrentFrameCount());
+        EXPECT_TRUE(mContext.registry.valid(first));
+        EXPECT_TRUE(mContext.registry.valid(second));
+        EXPECT_EQ(fp{1}, mContext.registry.get<TransformComponent>(first).location.x);
+        EXPECT_EQ(fp{2}, mContext.registry.get<TransformComponent>(second).location.x);
+        EXPECT_EQ(fp{3}, mContext.registry.get<PhysicsComponent>(second).velocity.z);
+        EXPECT_EQ(5, mContext.registry.get<HitstopComponent>(second).startingFrame);
+        EXPECT_FALSE(mContext.registry.all_of<HitstopComponent>(first));
+        
+        // Third entity was created by recycling second's id, so only need to check that the exact version is gone
+        EXPECT_NE(third, second);
+        EXPECT_FALSE(mContext.registry.valid(third));
+    }
+
+    TEST_F(RegistrySnapshotTests, Restore_whenEntitiesCreatedAfterRestore_matchesEntitiesCreatedBeforeRestore) {
+        CreateMovingEntity(fp{1});
+        entt::entity toDestroy = CreateMovingEntity(fp{2});
+        mContext.registry.destroy(toDestroy); // So there's a released entity to be recycled
+        mToTest.Capture(mContext);
+
+        entt::entity createdBeforeRestore = mContext.registry.create();
+        mToTest.Restore(mContext);
+        entt::entity createdAfterRestore = mContext.registry.create();
+
+        EXPECT_EQ(createdBeforeRestore, createdAfterRestore);
+    }
+
+    TEST_F(RegistrySnapshotTests, GetChecksum_whenRestoredStateCapturedAgain_matchesOriginalChecksum) {
+        CreateMovingEntity(fp{1});
+        CreateMovingEntity(fp{2});
+        mToTest.Capture(mContext);
+        
+        CreateMovingEntity(fp{3});
+        CoreRegistrySnapshot changedSnapshot = {};
+        changedSnapshot.Capture(mContext);
+        mToTest.Restore(mContext);
+        CoreRegistrySnapshot restoredSnapshot = {};
+        restoredSnapshot.Capture(mContext);
+
+        EXPECT_NE(mToTest.GetChecksum(), changedSnapshot.GetChecksum());
+        EXPECT_EQ(mToTest.GetChecksum(), restoredSnapshot.GetChecksum());
+    }
+
+    TEST_F(RegistrySnapshotTests, Capture_whenStateSizeUnchanged_reusesExistingBuffer) {
+        for (int i = 0; i < 10; i++) {
+            CreateMovingEntity(fp{i});
+        }
+        mToTest.Capture(mContext);
+        const size_t initialCapacity = mToTest.GetCapacityBytes();
+        
+        for (int i = 0; i < 5; i++) {
+            mToTest.Capture(mContext);
+        }
+
+        EXPECT_EQ(initialCapacity, mToTest.GetCapacityBytes());
+        EXPECT_LE(mToTest.GetUsedBytes(), mToTest.GetCapacityBytes());
+    }
+
+    TEST_F(RegistrySnapshotTests, Restore_whenNeverCaptured_logsWarning) {
+        CreateMovingEntity(fp{1});
+        mToTest.Restore(mContext);
+
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(RegistrySnapshotTests, CalculateDesyncChecksums_forAllTypes_returnsOneChecksumPerComponentTypePlusEntities) {
+        CreateMovingEntity(fp{1});
+        mToTest.Capture(mContext);
+
+        DesyncChecksumList result;
+        ASSERT_TRUE(mToTest.CalculateDesyncChecksums(DesyncChecksumQuery::ForAllTypes(), result));
+
+        ASSERT_EQ(CoreRegistrySnapshot::kEntitiesDesyncChecksumTypeIndex + 1, result.GetSize());
+        EXPECT_NE(0, result.Get(0)); // TransformComponent
+        EXPECT_EQ(0, result.Get(2)); // DynamicColliderComponent, which no entity has
+    }
+
+    TEST_F(RegistrySnapshotTests, CalculateDesyncChecksums_whenQueryInvalid_fails) {
+        CreateMovingEntity(fp{1});
+        mToTest.Capture(mContext);
+
+        DesyncChecksumList result;
+        EXPECT_FALSE(mToTest.CalculateDesyncChecksums(DesyncChecksumQuery::ForType(200), result));
+        EXPECT_FALSE(mToTest.CalculateDesyncChecksums({0, 16, 256}, result)); // Misaligned range
+        EXPECT_TRUE(mToTest.CalculateDesyncChecksums({0, 256, 256}, result));
+    }
+}
@@ -0,0 +1,42 @@
+#include "pchNCT.h"
+
+#include "Rollback/Model/RollbackDesyncChecker.h"
+#include "TestHelpers/TestHelpers.h"
+
+using namespace ProjectNomad;
+namespace RollbackDesyncCheckerTests {
+    class RollbackDesyncCheckerTests : public BaseSimTest {
+      protected:
+        void ProvideChecksums(FrameType targetFrame, uint32_t localChecksum, uint32_t remoteHostChecksum) {
+            mToTest.ProvideLocalHostChecksum(GetLoggerSingleton(), targetFrame, localChecksum);
+            mToTest.ProvideRemoteHostChecksum(GetLoggerSingleton(), targetFrame, remoteHostChecksum);
+        }
+
+        RollbackDesyncChecker mToTest = {};
+    };
+
+    TEST_F(RollbackDesyncCheckerTests, DidDesyncOccur_whenChecksumsMatch_returnsFalse) {
+        ProvideChecksums(0, 1234, 1234);
+
+        ASSERT_TRUE(mToTest.IsResultForCurrentTargetFrameReady());
+        EXPECT_FALSE(mToTest.DidDesyncOccur());
+    }
+
+    TEST_F(RollbackDesyncCheckerTests, DidDesyncOccur_whenChecksumsDiffer_returnsTrue) {
+        ProvideChecksums(0, 1234, 4321);
+
+        ASSERT_TRUE(mToTest.IsResultForCurrentTargetFrameReady());
+        EXPECT_TRUE(mToTest.DidDesyncOccur());
+    }
+
+    TEST_F(RollbackDesyncCheckerTests, DidDesyncOccur_whenNewFrameAfterMismatch_onlyComparesNewFramesChecksums) {
+        ProvideChecksums(0, 1234, 4321);
+        ASSERT_TRUE(mToTest.DidDesyncOccur());
+
+        ProvideChecksums(60, 5678, 5678);
+
+        EXPECT_EQ(60, mToTest.GetCurrentTargetFrame());
+        ASSERT_TRUE(mToTest.IsResultForCurrentTargetFrameReady());
+        EXPECT_FALSE(mToTest.DidDesyncOccur());
+    }
+}
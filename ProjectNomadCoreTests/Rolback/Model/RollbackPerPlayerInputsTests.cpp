@@ -1,5 +1,6 @@
 #include "pchNCT.h"
 
+#include "Input/CharacterInputQuantizer.h"
 #include "Rollback/Model/RollbackPerPlayerInputs.h"
 #include "TestHelpers/TestHelpers.h"
 
@@ -20,4 +21,115 @@ namespace RollbackPerPlayerInputsTests {
         mToTest.SetupForNewSession(GetLoggerSingleton(), {});
         mToTest.AddInput(GetLoggerSingleton(), 0, {});
     }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenFrameNotYetProcessed_returnsFalse) {
+        mToTest.SetupForNewSession(GetLoggerSingleton(), {});
+
+        CharacterInput input = {};
+        input.commandInputs.SetCommandValue(InputCommand::Jump, true);
+        
+        EXPECT_FALSE(mToTest.AddInput(GetLoggerSingleton(), 0, input));
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenProcessedWithMatchingPrediction_returnsFalse) {
+        mToTest.SetupForNewSession(GetLoggerSingleton(), {});
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 0); // Predicts default input
+        
+        EXPECT_FALSE(mToTest.AddInput(GetLoggerSingleton(), 0, {}));
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenProcessedWithDifferentPrediction_returnsTrue) {
+        mToTest.SetupForNewSession(GetLoggerSingleton(), {});
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 0); // Predicts default input
+
+        CharacterInput input = {};
+        input.commandInputs.SetCommandValue(InputCommand::Jump, true);
+        
+        EXPECT_TRUE(mToTest.AddInput(GetLoggerSingleton(), 0, input));
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenLaterFramesPredicted_onlyComparesAgainstPredictionForSameFrame) {
+        mToTest.SetupForNewSession(GetLoggerSingleton(), {});
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 0);
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 1);
+
+        CharacterInput jumpInput = {};
+        jumpInput.commandInputs.SetCommandValue(InputCommand::Jump, true);
+        
+        EXPECT_TRUE(mToTest.AddInput(GetLoggerSingleton(), 0, jumpInput));
+        EXPECT_FALSE(mToTest.AddInput(GetLoggerSingleton(), 1, {})); // Frame 1 was predicted with default input as well
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, GetInputForFrame_whenExtrapolatingCamPosition_continuesLatestMotion) {
+        RollbackSettings settings = {};
+        settings.inputPrediction.ForField(CharacterInputField::CamPosition).method = InputPredictionMethod::Extrapolate;
+        mToTest.SetupForNewSession(GetLoggerSingleton(), settings);
+
+        CharacterInput input = {};
+        mToTest.AddInput(GetLoggerSingleton(), 0, input);
+        input.camPosition = FPVector(fp{1}, fp{0}, fp{0});
+        mToTest.AddInput(GetLoggerSingleton(), 1, input);
+
+        // 2 frames past latest known input
+        CharacterInput result = mToTest.GetInputForFrame(GetLoggerSingleton(), 3);
+        EXPECT_EQ(FPVector(fp{3}, fp{0}, fp{0}), result.camPosition);
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenExtrapolatingSteadyCamTurnInMultiplayer_neverMispredicts) {
+        RollbackSettings settings = {};
+        settings.totalPlayers = 2;
+        settings.inputPrediction.ForField(CharacterInputField::CamRotation).method = InputPredictionMethod::Extrapolate;
+        mToTest.SetupForNewSession(GetLoggerSingleton(), settings);
+
+        // Steady yaw turn around 90 degrees as received over network, where each quantized component of the rotation
+        //      changes by one code (about 1.3 degrees of turn) every frame
+        for (FrameType frame = 0; frame < 10; frame++) {
+            CharacterInput input = {};
+            input.camRotation.w = CharacterInputQuantizer::FromCode(static_cast<int8_t>(90 - frame));
+            input.camRotation.v.z = CharacterInputQuantizer::FromCode(static_cast<int8_t>(90 + frame));
+            if (frame >= 2) { // Extrapolation needs two known inputs
+                mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), frame);
+            }
+            
+            EXPECT_FALSE(mToTest.AddInput(GetLoggerSingleton(), frame, input)) << "Frame " << frame;
+        }
+
+        const InputPredictionStats& stats = mToTest.GetPredictionStats();
+        EXPECT_EQ(8, stats.checkedPredictions);
+        EXPECT_EQ(0, stats.GetFieldMispredictions(CharacterInputField::CamRotation));
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenOnlyIgnoredFieldMispredicted_returnsFalseButRecordsStats) {
+        RollbackSettings settings = {};
+        settings.inputPrediction.ForField(CharacterInputField::CamRotation).countsForMisprediction = false;
+        mToTest.SetupForNewSession(GetLoggerSingleton(), settings);
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 0); // Predicts default input
+
+        CharacterInput input = {};
+        input.camRotation = FPQuat::fromDegrees(FPVector(fp{0}, fp{0}, fp{1}), fp{90});
+        
+        EXPECT_FALSE(mToTest.AddInput(GetLoggerSingleton(), 0, input));
+        
+        const InputPredictionStats& stats = mToTest.GetPredictionStats();
+        EXPECT_EQ(1, stats.checkedPredictions);
+        EXPECT_EQ(0, stats.mispredictions);
+        EXPECT_EQ(1, stats.GetFieldMispredictions(CharacterInputField::CamRotation));
+        EXPECT_EQ(0, stats.GetFieldMispredictions(CharacterInputField::CommandInputs));
+    }
+
+    TEST_F(RollbackPerPlayerInputsTests, AddInput_whenCountedFieldMispredicted_recordsMisprediction) {
+        mToTest.SetupForNewSession(GetLoggerSingleton(), {});
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 0);
+        mToTest.GetInputForFrameToProcess(GetLoggerSingleton(), 1);
+
+        CharacterInput jumpInput = {};
+        jumpInput.commandInputs.SetCommandValue(InputCommand::Jump, true);
+        mToTest.AddInput(GetLoggerSingleton(), 0, jumpInput);
+        mToTest.AddInput(GetLoggerSingleton(), 1, {});
+
+        const InputPredictionStats& stats = mToTest.GetPredictionStats();
+        EXPECT_EQ(2, stats.checkedPredictions);
+        EXPECT_EQ(1, stats.mispredictions);
+        EXPECT_FLOAT_EQ(0.5f, stats.GetFieldMispredictionRate(CharacterInputField::CommandInputs));
+    }
 }
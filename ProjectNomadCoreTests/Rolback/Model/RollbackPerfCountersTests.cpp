@@ -0,0 +1,83 @@
+#include "pchNCT.h"
+
+#include <rapidjson/document.h>
+
+#include "TestHelpers/TestHelpers.h"
+#include "Rollback/Model/RollbackPerfCounters.h"
+
+using namespace ProjectNomad;
+namespace RollbackPerfCountersTests {
+    class RollbackPerfCountersTests : public BaseSimTest {
+      protected:
+        // Simulates a full tick which processed the given number of frames in the given time
+        void AddTick(FrameType framesProcessed, uint64_t tickTimeInMicroSec) {
+            mToTest.BeginTick();
+            mToTest.OnFramesProcessed(framesProcessed);
+            mToTest.EndTick(tickTimeInMicroSec);
+        }
+
+        RollbackPerfCounters mToTest = {};
+    };
+
+    TEST_F(RollbackPerfCountersTests, EndTick_whenMoreTicksThanWindow_windowOnlyCoversLatestTicks) {
+        constexpr uint32_t kWindowTicks = RollbackPerfCounterStaticSettings::kRollingWindowTicks;
+        for (uint32_t i = 0; i < kWindowTicks + 5; i++) {
+            AddTick(1, i);
+        }
+
+        const RollbackPerfTotals& windowTotals = mToTest.GetWindowTotals();
+        EXPECT_EQ(kWindowTicks, windowTotals.ticks);
+        EXPECT_EQ(kWindowTicks, windowTotals.framesProcessed);
+        // Sum of tick times 5 through kWindowTicks + 4
+        uint64_t expectedWindowTime = 0;
+        for (uint32_t i = 5; i < kWindowTicks + 5; i++) {
+            expectedWindowTime += i;
+        }
+        EXPECT_EQ(expectedWindowTime, windowTotals.tickTimeInMicroSec);
+
+        EXPECT_EQ(kWindowTicks + 5, mToTest.GetSessionTotals().ticks);
+    }
+
+    TEST_F(RollbackPerfCountersTests, EndTick_whenStalledAndRolledBack_tracksCauseAndDepth) {
+        FlexStallPlayerInfoArray waitingOnPlayers = {};
+        waitingOnPlayers.Add({PlayerSpot::Player3, 10});
+
+        mToTest.BeginTick();
+        mToTest.OnRollback(4);
+        mToTest.AddTime(RollbackPerfTimer::RestoreSnapshot, 7);
+        mToTest.AddTime(RollbackPerfTimer::ProcessFrameWithoutRendering, 20);
+        mToTest.OnStall(RollbackStallInfo::WithStall(waitingOnPlayers));
+        mToTest.EndTick(30);
+
+        const RollbackTickCounters& lastTick = mToTest.GetLastTick();
+        EXPECT_TRUE(lastTick.didStall);
+        EXPECT_EQ(4, lastTick.framesResimulated);
+
+        const RollbackPerfTotals& sessionTotals = mToTest.GetSessionTotals();
+        EXPECT_EQ(1, sessionTotals.stallTicks);
+        EXPECT_EQ(1, sessionTotals.stallTicksPerPlayer[static_cast<uint32_t>(PlayerSpot::Player3)]);
+        EXPECT_EQ(1, sessionTotals.rollbacks);
+        EXPECT_EQ(1, sessionTotals.rollbackDepthHistogram[4]);
+        EXPECT_EQ(7, sessionTotals.GetTimeInMicroSec(RollbackPerfTimer::RestoreSnapshot));
+        EXPECT_EQ(20, sessionTotals.GetTimeInMicroSec(RollbackPerfTimer::ProcessFrameWithoutRendering));
+    }
+
+    TEST_F(RollbackPerfCountersTests, ToJson_afterTicks_producesParseableCounters) {
+        mToTest.BeginTick();
+        mToTest.OnFramesProcessed(2);
+        mToTest.AddTime(RollbackPerfTimer::ProcessFrame, 12);
+        mToTest.EndTick(15);
+
+        std::string json = mToTest.ToJson();
+        rapidjson::Document document;
+        document.Parse(json.c_str());
+
+        ASSERT_FALSE(document.HasParseError());
+        EXPECT_EQ(2, document["lastTick"]["framesProcessed"].GetUint());
+        EXPECT_EQ(12, document["lastTick"]["timesInMicroSec"]["processFrame"].GetUint64());
+        EXPECT_EQ(1, document["window"]["ticks"].GetUint64());
+        EXPECT_EQ(15, document["session"]["timesInMicroSec"]["tick"].GetUint64());
+        EXPECT_EQ(RollbackPerfCounterStaticSettings::kRollbackDepthHistogramSize,
+                  document["session"]["rollbackDepthHistogram"].Size());
+    }
+}
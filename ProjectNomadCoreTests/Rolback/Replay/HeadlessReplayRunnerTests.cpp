@@ -0,0 +1,212 @@
+#include "pchNCT.h"
+
+#include <filesystem>
+
+#include "TestHelpers/TestHelpers.h"
+#include "TestHelpers/TestSnapshot.h"
+#include "TestHelpers/Rollback/RollbackTestUser.h"
+#include "Rollback/Replay/HeadlessReplayRunner.h"
+#include "Rollback/Replay/ReplayWriter.h"
+
+using namespace ProjectNomad;
+namespace HeadlessReplayRunnerTests {
+    // Game state is a hash of every processed frame + input, so checksums depend on every input played back
+    class HashingTestUser : public RollbackTestUser {
+      public:
+        void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {
+            result.number = state;
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            state = Simulate(state, expectedFrame, playerInputs.Get(0));
+        }
+
+        static FrameType Simulate(FrameType state, FrameType frame, const CharacterInput& input) {
+            return state * 31 + frame + static_cast<FrameType>(input.moveForward.raw_value());
+        }
+
+        FrameType state = 0;
+    };
+
+    // Logs every so often into the logger it was created with, so each replay's messages can be told apart
+    class LoggingTestUser : public HashingTestUser {
+      public:
+        LoggingTestUser(LoggerSingleton& logger, uint32_t replaySeed) : mLogger(logger), mReplaySeed(replaySeed) {}
+
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            HashingTestUser::ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            if (expectedFrame % kLogInterval == 0) {
+                mLogger.LogInfoMessage(CreateLogMessage(mReplaySeed, expectedFrame));
+            }
+        }
+
+        static std::string CreateLogMessage(uint32_t replaySeed, FrameType frame) {
+            return "Replay " + std::to_string(replaySeed) + " frame " + std::to_string(frame);
+        }
+
+        static constexpr FrameType kLogInterval = 25;
+
+      private:
+        LoggerSingleton& mLogger;
+        uint32_t mReplaySeed;
+    };
+
+    class HeadlessReplayRunnerTests : public BaseSimTest {
+      protected:
+        void TearDown() override {
+            for (const std::string& filePath : mFilePaths) {
+                std::filesystem::remove(filePath);
+            }
+            BaseSimTest::TearDown();
+        }
+
+        // Single player replay whose inputs differ per replay seed, so every replay has its own checksum trace
+        std::string WriteReplay(uint32_t replaySeed, FrameType numFrames) {
+            const std::string filePath = (std::filesystem::temp_directory_path() /
+                (std::string("HeadlessReplayRunnerTests_") + ::testing::UnitTest::GetInstance()->current_test_info()->name()
+                 + "_" + std::to_string(replaySeed) + ".replay")).string();
+            mFilePaths.push_back(filePath);
+
+            ReplayHeader header = {};
+            header.sessionSeed = replaySeed;
+            header.rollbackSettings.totalPlayers = 1;
+            header.rollbackSettings.localPlayerSpot = PlayerSpot::Player1;
+
+            ReplayWriter writer;
+            EXPECT_TRUE(writer.Open(GetLoggerSingleton(), filePath, header));
+            for (FrameType frame = 0; frame < numFrames; frame++) {
+                EXPECT_TRUE(writer.AddFrame(GetLoggerSingleton(), frame, CreateInputsForFrame(replaySeed, frame)));
+            }
+            EXPECT_TRUE(writer.Close(GetLoggerSingleton()));
+            return filePath;
+        }
+
+        static PlayerInputsForFrame CreateInputsForFrame(uint32_t replaySeed, FrameType frame) {
+            CharacterInput input = {};
+            input.moveForward = fp{static_cast<int32_t>((frame + replaySeed) % 7)} / fp{7};
+
+            PlayerInputsForFrame result = {};
+            result.Add(input);
+            return result;
+        }
+
+        // Checksum at start of each frame, from straight playback of the same inputs
+        static std::vector<ReplayChecksumEntry> CreateExpectedTrace(uint32_t replaySeed, FrameType numFrames) {
+            std::vector<ReplayChecksumEntry> result;
+            FrameType state = 0;
+            for (FrameType frame = 0; frame <= numFrames; frame++) {
+                result.push_back({frame, state});
+                state = HashingTestUser::Simulate(state, frame, CreateInputsForFrame(replaySeed, frame).Get(0));
+            }
+            return result;
+        }
+
+        static HeadlessReplayRunner<TestSnapshot> CreateRunner(const HeadlessReplayRunnerSettings& settings = {}) {
+            return HeadlessReplayRunner<TestSnapshot>([](LoggerSingleton&, const ReplayHeader&) {
+                return std::make_unique<HashingTestUser>();
+            }, settings);
+        }
+
+        std::vector<std::string> mFilePaths;
+    };
+
+    TEST_F(HeadlessReplayRunnerTests, RunReplay_whenChecksummingEveryFrame_traceMatchesStraightPlayback) {
+        const std::string filePath = WriteReplay(3, 500);
+
+        const ReplayRunReport report = CreateRunner().RunReplay(GetLoggerSingleton(), filePath);
+
+        EXPECT_TRUE(report.didComplete);
+        EXPECT_EQ(filePath, report.replayPath);
+        EXPECT_EQ(500, report.framesSimulated);
+        EXPECT_EQ(CreateExpectedTrace(3, 500), report.checksumTrace); // Includes state after final frame
+    }
+
+    TEST_F(HeadlessReplayRunnerTests, RunReplay_withChecksumInterval_recordsEveryNthFrameAndFinalFrame) {
+        const std::string filePath = WriteReplay(0, 25);
+        HeadlessReplayRunnerSettings settings = {};
+        settings.checksumInterval = 10;
+
+        const ReplayRunReport report = CreateRunner(settings).RunReplay(GetLoggerSingleton(), filePath);
+
+        const std::vector<ReplayChecksumEntry> everyFrameTrace = CreateExpectedTrace(0, 25);
+        const std::vector<ReplayChecksumEntry> expected = {everyFrameTrace[0], everyFrameTrace[10], everyFrameTrace[20], everyFrameTrace[25]};
+        EXPECT_EQ(expected, report.checksumTrace);
+    }
+
+    TEST_F(HeadlessReplayRunnerTests, RunBatch_whenManyReplaysOnManyThreads_eachReplayMatchesItsOwnPlayback) {
+        std::vector<std::string> filePaths;
+        for (uint32_t replaySeed = 0; replaySeed < 8; replaySeed++) {
+            filePaths.push_back(WriteReplay(replaySeed, 200 + replaySeed * 50));
+        }
+        HeadlessReplayRunnerSettings settings = {};
+        settings.maxThreads = 4;
+
+        const ReplayBatchReport report = CreateRunner(settings).RunBatch(GetLoggerSingleton(), filePaths);
+
+        EXPECT_EQ(4, report.threadsUsed);
+        EXPECT_EQ(0, report.GetNumFailed());
+        ASSERT_EQ(8, report.replays.size());
+        for (uint32_t replaySeed = 0; replaySeed < 8; replaySeed++) {
+            const ReplayRunReport& replay = report.replays[replaySeed];
+            EXPECT_EQ(filePaths[replaySeed], replay.replayPath);
+            EXPECT_EQ(CreateExpectedTrace(replaySeed, 200 + replaySeed * 50), replay.checksumTrace) << "Replay " << replaySeed;
+        }
+        EXPECT_EQ(8 * 200 + 50 * 28, report.GetTotalFramesSimulated());
+    }
+
+    TEST_F(HeadlessReplayRunnerTests, RunBatch_whenReplayMissing_failsOnlyThatReplayAndForwardsItsLogs) {
+        const std::vector<std::string> filePaths = {
+            WriteReplay(1, 50),
+            (std::filesystem::temp_directory_path() / "HeadlessReplayRunnerTests_missing.replay").string(),
+            WriteReplay(2, 50)
+        };
+
+        const ReplayBatchReport report = CreateRunner().RunBatch(GetLoggerSingleton(), filePaths);
+
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(1, report.GetNumFailed());
+        EXPECT_TRUE(report.replays[0].didComplete);
+        EXPECT_FALSE(report.replays[1].didComplete);
+        EXPECT_TRUE(report.replays[2].didComplete);
+    }
+
+    TEST_F(HeadlessReplayRunnerTests, RunBatch_whenUsersLog_forwardsEachReplaysLogsInReplayOrder) {
+        std::vector<std::string> filePaths;
+        for (uint32_t replaySeed = 0; replaySeed < 8; replaySeed++) {
+            filePaths.push_back(WriteReplay(replaySeed, 100));
+        }
+        HeadlessReplayRunnerSettings settings = {};
+        settings.maxThreads = 4;
+        HeadlessReplayRunner<TestSnapshot> toTest([](LoggerSingleton& logger, const ReplayHeader& header) {
+            return std::make_unique<LoggingTestUser>(logger, header.sessionSeed);
+        }, settings);
+
+        const ReplayBatchReport report = toTest.RunBatch(GetLoggerSingleton(), filePaths);
+
+        EXPECT_EQ(0, report.GetNumFailed());
+        // Replays ran concurrently, yet each replay's messages are forwarded together as if they had run one by one
+        std::queue<DebugMessage>& messages = GetLoggerSingleton().getDebugMessages();
+        for (uint32_t replaySeed = 0; replaySeed < 8; replaySeed++) {
+            for (FrameType frame = 0; frame < 100; frame += LoggingTestUser::kLogInterval) {
+                ASSERT_FALSE(messages.empty()) << "Replay " << replaySeed << " frame " << frame;
+                EXPECT_NE(std::string::npos, messages.front().mTextMessage.find(LoggingTestUser::CreateLogMessage(replaySeed, frame)));
+                messages.pop();
+            }
+        }
+        EXPECT_TRUE(messages.empty());
+    }
+
+    TEST_F(HeadlessReplayRunnerTests, TryFindFirstMismatch_whenTracesDiverge_returnsFirstDifferingFrame) {
+        ReplayRunReport report = {};
+        report.checksumTrace = CreateExpectedTrace(0, 30);
+        std::vector<ReplayChecksumEntry> expectedTrace = CreateExpectedTrace(0, 30);
+
+        FrameType mismatchFrame = 0;
+        EXPECT_FALSE(report.TryFindFirstMismatch(expectedTrace, mismatchFrame));
+
+        expectedTrace[17].checksum++;
+        expectedTrace[23].checksum++;
+        ASSERT_TRUE(report.TryFindFirstMismatch(expectedTrace, mismatchFrame));
+        EXPECT_EQ(17, mismatchFrame);
+    }
+}
@@ -0,0 +1,163 @@
+#include "pchNCT.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include "TestHelpers/TestHelpers.h"
+#include "Rollback/Replay/ReplayReader.h"
+#include "Rollback/Replay/ReplayWriter.h"
+
+using namespace ProjectNomad;
+namespace ReplayReaderTests {
+    class ReplayReaderTests : public BaseSimTest {
+      protected:
+        static constexpr FrameType kFramesPerChunk = 10;
+
+        void SetUp() override {
+            mFilePath = (std::filesystem::temp_directory_path() /
+                         (std::string("ReplayReaderTests_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".replay")).string();
+        }
+        void TearDown() override {
+            std::filesystem::remove(mFilePath);
+            BaseSimTest::TearDown();
+        }
+
+        // Single player replay where move forward is (frame / 100), so every frame is easy to identify
+        void WriteReplay(FrameType numFrames) {
+            ReplayHeader header = {};
+            header.rollbackSettings.totalPlayers = 1;
+            header.rollbackSettings.localPlayerSpot = PlayerSpot::Player1;
+
+            ReplayWriter writer(kFramesPerChunk);
+            ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, header));
+            for (FrameType frame = 0; frame < numFrames; frame++) {
+                ASSERT_TRUE(writer.AddFrame(GetLoggerSingleton(), frame, CreateInputsForFrame(frame)));
+                writer.WaitUntilNotWriting(); // Otherwise chunks may be bigger if worker is still busy
+            }
+            ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+        }
+
+        static PlayerInputsForFrame CreateInputsForFrame(FrameType frame) {
+            CharacterInput input = {};
+            input.moveForward = fp{static_cast<int32_t>(frame)} / fp{100};
+
+            PlayerInputsForFrame result = {};
+            result.Add(input);
+            return result;
+        }
+
+        void FlipByteInFile(std::streamoff offset) {
+            std::fstream file(mFilePath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekg(offset);
+            const char original = static_cast<char>(file.get());
+            file.seekp(offset);
+            file.put(static_cast<char>(~original));
+        }
+
+        // Same little endian byte order as BitWriter, which is what every 32 bit replay field is written with
+        uint32_t ReadUint32FromFile(std::streamoff offset) const {
+            std::ifstream file(mFilePath, std::ios::binary);
+            file.seekg(offset);
+            uint32_t result = 0;
+            for (uint32_t i = 0; i < 4; i++) {
+                result |= static_cast<uint32_t>(static_cast<uint8_t>(file.get())) << (i * 8);
+            }
+            return result;
+        }
+        void WriteUint32InFile(std::streamoff offset, uint32_t value) {
+            std::fstream file(mFilePath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(offset);
+            for (uint32_t i = 0; i < 4; i++) {
+                file.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+            }
+        }
+
+        // Header body size is last field of file header prefix
+        static constexpr std::streamoff kHeaderBodySizeOffset = ReplayFormat::kFileHeaderPrefixSizeInBytes - 4;
+
+        std::string mFilePath;
+    };
+
+    TEST_F(ReplayReaderTests, GetInputsForFrame_whenRequestedOutOfOrder_returnsEachFramesInputs) {
+        WriteReplay(35);
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+        ASSERT_EQ(4, reader.GetNumChunks());
+
+        for (FrameType frame : {34, 0, 17, 16, 9, 10, 33}) {
+            PlayerInputsForFrame inputs;
+            ASSERT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), frame, inputs));
+            EXPECT_EQ(CreateInputsForFrame(frame).Get(0), inputs.Get(0)) << "frame " << frame;
+        }
+    }
+
+    TEST_F(ReplayReaderTests, GetInputsForFrame_whenPastEnd_returnsFalseWithoutLogging) {
+        WriteReplay(15);
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+
+        PlayerInputsForFrame inputs;
+        EXPECT_FALSE(reader.GetInputsForFrame(GetLoggerSingleton(), 15, inputs));
+    }
+
+    TEST_F(ReplayReaderTests, Open_whenLastChunkTruncated_endsReplayAtLastCompleteChunk) {
+        WriteReplay(25);
+        std::filesystem::resize_file(mFilePath, std::filesystem::file_size(mFilePath) - 1);
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+        TestHelpers::VerifySingletonLoggingOccured();
+
+        EXPECT_EQ(20, reader.GetEndFrame());
+        PlayerInputsForFrame inputs;
+        EXPECT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), 19, inputs));
+        EXPECT_FALSE(reader.GetInputsForFrame(GetLoggerSingleton(), 20, inputs));
+    }
+
+    TEST_F(ReplayReaderTests, GetInputsForFrame_whenChunkCorrupted_failsOnlyForThatChunk) {
+        WriteReplay(20);
+        // Last byte of file is within second chunk's payload
+        FlipByteInFile(static_cast<std::streamoff>(std::filesystem::file_size(mFilePath)) - 1);
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+
+        PlayerInputsForFrame inputs;
+        EXPECT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), 5, inputs));
+        EXPECT_FALSE(reader.GetInputsForFrame(GetLoggerSingleton(), 15, inputs));
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(ReplayReaderTests, Open_whenNotAReplayFile_fails) {
+        std::ofstream(mFilePath, std::ios::binary) << "definitely not a replay";
+
+        ReplayReader reader;
+        EXPECT_FALSE(reader.Open(GetLoggerSingleton(), mFilePath));
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_FALSE(reader.IsOpen());
+    }
+
+    TEST_F(ReplayReaderTests, Open_whenHeaderBodySizeLargerThanFile_fails) {
+        WriteReplay(5);
+        WriteUint32InFile(kHeaderBodySizeOffset, 0xFFFFFFFF);
+
+        ReplayReader reader;
+        EXPECT_FALSE(reader.Open(GetLoggerSingleton(), mFilePath));
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(ReplayReaderTests, Open_whenChunkClaimsTooManyFrames_ignoresChunkAndRestOfReplay) {
+        WriteReplay(25);
+        const std::streamoff firstChunkOffset = static_cast<std::streamoff>(ReplayFormat::kFileHeaderPrefixSizeInBytes) +
+                                                ReadUint32FromFile(kHeaderBodySizeOffset);
+        WriteUint32InFile(firstChunkOffset + 4, ReplayFormat::kMaxFramesPerChunk + 1); // Number of frames field
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+        TestHelpers::VerifySingletonLoggingOccured();
+
+        EXPECT_FALSE(reader.HasAnyFrames());
+    }
+}
@@ -0,0 +1,188 @@
+#include "pchNCT.h"
+
+#include <filesystem>
+
+#include "TestHelpers/TestHelpers.h"
+#include "TestHelpers/TestSnapshot.h"
+#include "TestHelpers/Rollback/RollbackTestUser.h"
+#include "Rollback/Replay/ReplaySeekIndex.h"
+#include "Rollback/Replay/ReplayWriter.h"
+
+using namespace ProjectNomad;
+namespace ReplaySeekIndexTests {
+    // Game state is a hash of every processed frame + input, so any divergence from straight playback shows up
+    class ReplayPlaybackTestUser : public RollbackTestUser {
+      public:
+        explicit ReplayPlaybackTestUser(ReplayReader& reader) : mReader(reader) {}
+
+        void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {
+            result.number = state;
+        }
+        void RestoreSnapshot(FrameType expectedFrame, const TestSnapshot& snapshotToRestore) override {
+            RollbackTestUser::RestoreSnapshot(expectedFrame, snapshotToRestore);
+            state = snapshotToRestore.number;
+        }
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+            PlayerInputsForFrame inputs;
+            if (!mReader.GetInputsForFrame(Singleton<LoggerSingleton>::get(), expectedFrame, inputs)) {
+                return false;
+            }
+            result = inputs.Get(0);
+            return true;
+        }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrame(expectedFrame, playerInputs);
+            Simulate(expectedFrame, playerInputs);
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            Simulate(expectedFrame, playerInputs);
+        }
+
+        FrameType state = 0;
+
+      private:
+        void Simulate(FrameType frame, const PlayerInputsForFrame& playerInputs) {
+            state = state * 31 + frame + static_cast<FrameType>(playerInputs.Get(0).moveForward.raw_value());
+        }
+
+        ReplayReader& mReader;
+    };
+
+    class ReplaySeekIndexTests : public BaseSimTest {
+      protected:
+        static constexpr FrameType kReplayFrames = 1000;
+        static constexpr FrameType kKeyframeInterval = 100;
+
+        void SetUp() override {
+            mFilePath = (std::filesystem::temp_directory_path() /
+                         (std::string("ReplaySeekIndexTests_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".replay")).string();
+
+            ReplayHeader header = {};
+            header.rollbackSettings = CreateSinglePlayerSettings();
+            ReplayWriter writer;
+            ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, header));
+            for (FrameType frame = 0; frame < kReplayFrames; frame++) {
+                CharacterInput input = {};
+                input.moveForward = fp{static_cast<int32_t>(frame % 13)} / fp{13};
+                PlayerInputsForFrame inputs = {};
+                inputs.Add(input);
+                ASSERT_TRUE(writer.AddFrame(GetLoggerSingleton(), frame, inputs));
+            }
+            ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+            ASSERT_TRUE(mReader.Open(GetLoggerSingleton(), mFilePath));
+
+            // Straight playback from frame 0 is the source of truth for every seek
+            ReplayPlaybackTestUser straightUser(mReader);
+            mExpectedStatePerFrame.push_back(straightUser.state);
+            for (FrameType frame = 0; frame < kReplayFrames; frame++) {
+                PlayerInputsForFrame inputs;
+                ASSERT_TRUE(mReader.GetInputsForFrame(GetLoggerSingleton(), frame, inputs));
+                straightUser.ProcessFrame(frame, inputs);
+                mExpectedStatePerFrame.push_back(straightUser.state);
+            }
+        }
+        void TearDown() override {
+            mReader.Close();
+            std::filesystem::remove(mFilePath);
+            BaseSimTest::TearDown();
+        }
+
+        static RollbackSettings CreateSinglePlayerSettings() {
+            RollbackSettings settings = {};
+            settings.totalPlayers = 1;
+            settings.localPlayerSpot = PlayerSpot::Player1;
+            settings.hostPlayerSpot = PlayerSpot::Player1;
+            return settings;
+        }
+
+        // Manager whose time only passes when tests advance it, so tests control how many frames each tick processes
+        RollbackManager<TestSnapshot> CreateTimeControlledManager(RollbackUser<TestSnapshot>& user) {
+            return RollbackManager<TestSnapshot>(user, [this] { return mCurTimeInMicroSec; });
+        }
+
+        std::string mFilePath;
+        ReplayReader mReader;
+        std::vector<FrameType> mExpectedStatePerFrame; // Index is frame, value is state at start of that frame
+        uint64_t mCurTimeInMicroSec = 0;
+    };
+
+    TEST_F(ReplaySeekIndexTests, SeekTo_whenPlayingUserDirectly_matchesStraightPlaybackAndIsBoundedByInterval) {
+        ReplayPlaybackTestUser user(mReader);
+        ReplaySeekIndex<TestSnapshot> toTest(kKeyframeInterval);
+        toTest.RecordKeyframeIfDue(user, 0);
+
+        // First seek far ahead fills in keyframes along the way
+        ASSERT_TRUE(toTest.SeekTo(GetLoggerSingleton(), user, mReader, 735));
+        EXPECT_EQ(mExpectedStatePerFrame[735], user.state);
+        EXPECT_EQ(8, toTest.GetNumKeyframes()); // Frames 0 through 700
+        EXPECT_EQ(1, user.postRollbackCalls);
+
+        // Any frame already played is then within keyframe interval of a keyframe
+        for (FrameType targetFrame : {250, 700, 0, 699, 735}) {
+            const uint32_t framesProcessedBefore = user.processFrameWithoutRenderingCalls;
+            ASSERT_TRUE(toTest.SeekTo(GetLoggerSingleton(), user, mReader, targetFrame));
+
+            EXPECT_EQ(mExpectedStatePerFrame[targetFrame], user.state) << "Frame " << targetFrame;
+            EXPECT_LT(user.processFrameWithoutRenderingCalls - framesProcessedBefore, kKeyframeInterval);
+        }
+    }
+
+    TEST_F(ReplaySeekIndexTests, SeekTo_whenNoKeyframeRecorded_fails) {
+        ReplayPlaybackTestUser user(mReader);
+        ReplaySeekIndex<TestSnapshot> toTest(kKeyframeInterval);
+
+        EXPECT_FALSE(toTest.SeekTo(GetLoggerSingleton(), user, mReader, 10));
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(0, user.processFrameWithoutRenderingCalls);
+    }
+
+    TEST_F(ReplaySeekIndexTests, SeekTo_whenPastEndOfReplay_stopsAtEndAndFails) {
+        ReplayPlaybackTestUser user(mReader);
+        ReplaySeekIndex<TestSnapshot> toTest(kKeyframeInterval);
+        toTest.RecordKeyframeIfDue(user, 0);
+
+        EXPECT_FALSE(toTest.SeekTo(GetLoggerSingleton(), user, mReader, kReplayFrames + 5));
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(mExpectedStatePerFrame[kReplayFrames], user.state);
+    }
+
+    TEST_F(ReplaySeekIndexTests, SeekTo_whenUsingRollbackManager_restoresManagerAndContinuesFromTargetFrame) {
+        ReplayPlaybackTestUser user(mReader);
+        RollbackManager<TestSnapshot> manager = CreateTimeControlledManager(user);
+        ReplaySeekIndex<TestSnapshot> toTest(kKeyframeInterval);
+        manager.StartRollbackSession(CreateSinglePlayerSettings());
+        toTest.RecordKeyframeIfDue(manager, user);
+
+        // Normal playback with multiple frames per tick, so keyframes don't land exactly on interval boundaries
+        manager.OnTick(); // Initial frame 0
+        while (manager.GetInternalStateSnapshot().lastProcessedFrame < 450) {
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+            manager.OnTick();
+            toTest.RecordKeyframeIfDue(manager, user);
+        }
+        ASSERT_GE(toTest.GetNumKeyframes(), 5);
+
+        for (FrameType targetFrame : {130, 620, 17}) {
+            ASSERT_TRUE(toTest.SeekTo(GetLoggerSingleton(), manager, user, targetFrame));
+            EXPECT_EQ(mExpectedStatePerFrame[targetFrame], user.state) << "Frame " << targetFrame;
+            EXPECT_EQ(targetFrame - 1, manager.GetInternalStateSnapshot().lastProcessedFrame);
+        }
+
+        // Manager carries on from seeked frame as if it never left
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        ASSERT_EQ(1, manager.OnTick());
+        EXPECT_EQ(mExpectedStatePerFrame[18], user.state);
+    }
+
+    TEST_F(ReplaySeekIndexTests, SeekTo_whenKeyframesHaveNoManagerState_failsForManager) {
+        ReplayPlaybackTestUser user(mReader);
+        RollbackManager<TestSnapshot> manager = CreateTimeControlledManager(user);
+        ReplaySeekIndex<TestSnapshot> toTest(kKeyframeInterval);
+        manager.StartRollbackSession(CreateSinglePlayerSettings());
+        toTest.RecordKeyframeIfDue(user, 0);
+
+        EXPECT_FALSE(toTest.SeekTo(GetLoggerSingleton(), manager, user, 10));
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+}
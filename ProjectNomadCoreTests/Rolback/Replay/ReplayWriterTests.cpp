@@ -0,0 +1,167 @@
+#include "pchNCT.h"
+
+#include <filesystem>
+
+#include "TestHelpers/TestHelpers.h"
+#include "Rollback/Replay/ReplayReader.h"
+#include "Rollback/Replay/ReplayWriter.h"
+
+using namespace ProjectNomad;
+namespace ReplayWriterTests {
+    class ReplayWriterTests : public BaseSimTest {
+      protected:
+        void SetUp() override {
+            mFilePath = (std::filesystem::temp_directory_path() /
+                         (std::string("ReplayWriterTests_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".replay")).string();
+        }
+        void TearDown() override {
+            std::filesystem::remove(mFilePath);
+            BaseSimTest::TearDown();
+        }
+
+        static ReplayHeader CreateTwoPlayerHeader() {
+            ReplayHeader header = {};
+            header.sessionSeed = 123;
+            header.rollbackSettings.totalPlayers = 2;
+            header.rollbackSettings.localPlayerSpot = PlayerSpot::Player2;
+            header.rollbackSettings.hostPlayerSpot = PlayerSpot::Player1;
+            header.rollbackSettings.localInputDelay = 2;
+            header.rollbackSettings.snapshotInterval = 4;
+            header.rollbackSettings.inputDelayTuning.isEnabled = true;
+            header.rollbackSettings.inputPrediction.ForField(CharacterInputField::MoveRight).method = InputPredictionMethod::Extrapolate;
+            return header;
+        }
+
+        // Inputs which change every few frames in various ways, similar to real gameplay
+        static PlayerInputsForFrame CreateInputsForFrame(FrameType frame) {
+            PlayerInputsForFrame result = {};
+            for (int32_t player = 0; player < 2; player++) {
+                CharacterInput input = {};
+                input.camPosition = FPVector(fp{static_cast<int32_t>(frame / 3)}, fp{player}, fp{-7} / fp{3});
+                input.camRotation = FPQuat(fp{1}, FPVector(fp{0}, fp{static_cast<int32_t>(frame / 5)} / fp{100}, fp{0}));
+                input.moveForward = fp{static_cast<int32_t>(frame % 4)} / fp{4};
+                input.moveRight = player == 0 ? fp{-1} : fp{1} / fp{3};
+                input.commandInputs.SetCommandValue(InputCommand::Jump, (frame / 7) % 2 == 0);
+                if (frame % 50 == 0) {
+                    input.uiChoice = GameplayInteractiveUIChoice::ChooseOptionB;
+                }
+                result.Add(input);
+            }
+            return result;
+        }
+
+        // Inputs which are held for a while like most real inputs, such as walking in one direction
+        static PlayerInputsForFrame CreateHeldInputsForFrame(FrameType frame) {
+            PlayerInputsForFrame result = {};
+            for (int32_t player = 0; player < 2; player++) {
+                CharacterInput input = {};
+                input.camPosition = FPVector(fp{static_cast<int32_t>(frame / 40)}, fp{player}, fp{0});
+                input.moveForward = (frame / 90) % 2 == 0 ? fp{1} : fp{0};
+                input.commandInputs.SetCommandValue(InputCommand::Jump, frame % 120 < 5);
+                result.Add(input);
+            }
+            return result;
+        }
+
+        // Waits for each chunk to be written before continuing, so chunks are exactly the expected size
+        void WriteFrames(ReplayWriter& writer, FrameType firstFrame, FrameType numFrames) {
+            for (FrameType frame = firstFrame; frame < firstFrame + numFrames; frame++) {
+                ASSERT_TRUE(writer.AddFrame(GetLoggerSingleton(), frame, CreateInputsForFrame(frame)));
+                writer.WaitUntilNotWriting();
+            }
+        }
+
+        std::string mFilePath;
+    };
+
+    TEST_F(ReplayWriterTests, Close_whenFramesSpanMultipleChunks_readerReturnsEveryFrameAndHeader) {
+        ReplayWriter writer(64);
+        const ReplayHeader header = CreateTwoPlayerHeader();
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, header));
+        WriteFrames(writer, 5, 300);
+        ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+        EXPECT_EQ(123, reader.GetHeader().sessionSeed);
+        const RollbackSettings& settings = reader.GetHeader().rollbackSettings;
+        EXPECT_EQ(2, settings.totalPlayers);
+        EXPECT_EQ(PlayerSpot::Player2, settings.localPlayerSpot);
+        EXPECT_EQ(2, settings.localInputDelay);
+        EXPECT_EQ(4, settings.snapshotInterval);
+        EXPECT_TRUE(settings.inputDelayTuning.isEnabled);
+        EXPECT_EQ(InputPredictionMethod::Extrapolate, settings.inputPrediction.ForField(CharacterInputField::MoveRight).method);
+
+        EXPECT_EQ(5, reader.GetFirstFrame());
+        EXPECT_EQ(305, reader.GetEndFrame());
+        EXPECT_EQ(5, reader.GetNumChunks()); // 4 full chunks, then the rest on close
+        for (FrameType frame = 5; frame < 305; frame++) {
+            PlayerInputsForFrame inputs;
+            ASSERT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), frame, inputs));
+            const PlayerInputsForFrame expected = CreateInputsForFrame(frame);
+            ASSERT_EQ(2, inputs.GetSize());
+            EXPECT_EQ(expected.Get(0), inputs.Get(0)) << "frame " << frame;
+            EXPECT_EQ(expected.Get(1), inputs.Get(1)) << "frame " << frame;
+        }
+    }
+
+    TEST_F(ReplayWriterTests, Close_whenInputsMostlyHeld_fileIsFarSmallerThanRawInputs) {
+        ReplayWriter writer;
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, CreateTwoPlayerHeader()));
+        constexpr FrameType kNumFrames = 3600; // 1 minute at 60fps
+        for (FrameType frame = 0; frame < kNumFrames; frame++) {
+            ASSERT_TRUE(writer.AddFrame(GetLoggerSingleton(), frame, CreateHeldInputsForFrame(frame)));
+        }
+        ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+
+        const uint64_t rawSize = static_cast<uint64_t>(kNumFrames) * 2 * sizeof(CharacterInput);
+        const uint64_t fileSize = std::filesystem::file_size(mFilePath);
+        EXPECT_EQ(fileSize, writer.GetBytesWritten());
+        EXPECT_LT(fileSize * 100, rawSize);
+    }
+
+    TEST_F(ReplayWriterTests, AddFrame_whenChunkFull_writesChunkInBackgroundWithoutClosing) {
+        ReplayWriter writer(16);
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, CreateTwoPlayerHeader()));
+        const uint64_t headerSize = writer.GetBytesWritten();
+
+        WriteFrames(writer, 0, 16);
+
+        EXPECT_GT(writer.GetBytesWritten(), headerSize);
+        EXPECT_FALSE(writer.HasWriteFailed());
+        ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+    }
+
+    TEST_F(ReplayWriterTests, AddFrame_whenFrameSkipped_rejectsFrame) {
+        ReplayWriter writer;
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, CreateTwoPlayerHeader()));
+        WriteFrames(writer, 0, 3);
+
+        EXPECT_FALSE(writer.AddFrame(GetLoggerSingleton(), 4, CreateInputsForFrame(4)));
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(3, writer.GetNextFrameToAdd());
+    }
+
+    TEST_F(ReplayWriterTests, AddFrame_whenWrongNumberOfPlayers_rejectsFrame) {
+        ReplayWriter writer;
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, CreateTwoPlayerHeader()));
+
+        PlayerInputsForFrame singlePlayerInputs = {};
+        singlePlayerInputs.Add({});
+        EXPECT_FALSE(writer.AddFrame(GetLoggerSingleton(), 0, singlePlayerInputs));
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_FALSE(writer.HasAnyFrames());
+    }
+
+    TEST_F(ReplayWriterTests, Destructor_whenNotClosed_stillFlushesAddedFrames) {
+        {
+            ReplayWriter writer(8);
+            ASSERT_TRUE(writer.Open(GetLoggerSingleton(), mFilePath, CreateTwoPlayerHeader()));
+            WriteFrames(writer, 0, 20);
+        }
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), mFilePath));
+        EXPECT_EQ(20, reader.GetEndFrame());
+    }
+}
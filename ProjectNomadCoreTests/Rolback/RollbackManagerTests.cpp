@@ -1,7 +1,10 @@
 #include "pchNCT.h"
 
+#include <filesystem>
+
 #include "Rollback/RollbackManager.h"
 #include "Rollback/Managers/RollbackSnapshotManager.h"
+#include "Rollback/Replay/ReplayReader.h"
 #include "TestHelpers/TestHelpers.h"
 #include "TestHelpers/TestSnapshot.h"
 #include "TestHelpers/Rollback/RollbackTestUser.h"
@@ -14,10 +17,72 @@ namespace RollbackManagerTests {
         void SetUp() override {
             // Reset any possibly changed state between runs
             mRollbackTestUser = {};
+            mSyncTestUser = {};
+            mCurTimeInMicroSec = 0;
+        }
+
+        // Function which will retrieve current time for the manager's time tracking
+        uint64_t GetCurrentTime() const {
+            return mCurTimeInMicroSec;
+        }
+
+        // Helper to start a simple two player session where local player is Player1
+        void StartTwoPlayerSession() {
+            mTimeControlledToTest.StartRollbackSession(CreateTwoPlayerSettings());
+        }
+        // No input delay by default, so each local input is used on the same frame it's retrieved for
+        static RollbackSettings CreateTwoPlayerSettings() {
+            RollbackSettings settings = {};
+            settings.totalPlayers = 2;
+            settings.localPlayerSpot = PlayerSpot::Player1;
+            settings.hostPlayerSpot = PlayerSpot::Player1;
+            settings.localInputDelay = 0;
+            return settings;
+        }
+
+        // For tests which need to inspect a differently behaving user than the default test user
+        RollbackManager<TestSnapshot> CreateTimeControlledManager(RollbackUser<TestSnapshot>& user) {
+            return RollbackManager<TestSnapshot>(user, std::bind_front(&RollbackManagerTests::GetCurrentTime, this));
+        }
+
+        // Helper to start a single player session which re-simulates sync test frames on the separate sync test user
+        void StartAsyncSyncTestSession(RollbackUser<TestSnapshot>& syncTestUser) {
+            RollbackSettings settings = {};
+            settings.totalPlayers = 1;
+            settings.localPlayerSpot = PlayerSpot::Player1;
+            settings.hostPlayerSpot = PlayerSpot::Player1;
+            settings.useSyncTest = true;
+            settings.syncTestFrames = 2;
+            settings.useAsyncSyncTest = true;
+            
+            mTimeControlledToTest.SetAsyncSyncTestUser(&syncTestUser);
+            mTimeControlledToTest.StartRollbackSession(settings);
+        }
+
+        // Processes exactly one new frame then waits for any sync test started during that tick to finish
+        void TickOneFrameAndWaitForSyncTest() {
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+            mTimeControlledToTest.OnTick();
+            mTimeControlledToTest.WaitForPendingAsyncSyncTest();
+        }
+
+        // Simple input which is guaranteed to differ from the default (initial) prediction
+        static InputHistoryArray CreateInputsWithJumpPressed() {
+            InputHistoryArray result = {};
+            for (CharacterInput& input : result) {
+                input.commandInputs.SetCommandValue(InputCommand::Jump, true);
+            }
+            return result;
         }
 
         RollbackTestUser mRollbackTestUser = {};
+        RollbackTestUser mSyncTestUser = {};
         RollbackManager<TestSnapshot> mToTest = RollbackManager(mRollbackTestUser);
+
+        uint64_t mCurTimeInMicroSec = 0;
+        RollbackManager<TestSnapshot> mTimeControlledToTest = RollbackManager<TestSnapshot>(
+            mRollbackTestUser, std::bind_front(&RollbackManagerTests::GetCurrentTime, this)
+        );
     };
     
     TEST_F(RollbackManagerTests, BasicUsageTestForCompiling) {
@@ -25,4 +90,623 @@ namespace RollbackManagerTests {
         mToTest.StartRollbackSession({});
         mToTest.OnTick();
     }
+
+    TEST_F(RollbackManagerTests, OnTick_whenRemoteInputMatchesPrediction_doesNotRollback) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0 processed with predicted (default) remote input
+
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 0, {});
+        mTimeControlledToTest.OnTick();
+
+        EXPECT_EQ(0, mRollbackTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(0, mRollbackTestUser.postRollbackCalls);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenRemoteInputMispredicted_rollsBackToMispredictedFrame) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0 processed with predicted (default) remote input
+
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 0, CreateInputsWithJumpPressed());
+        mTimeControlledToTest.OnTick();
+
+        EXPECT_EQ(1, mRollbackTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(0, mRollbackTestUser.lastRestoredFrame);
+        EXPECT_EQ(1, mRollbackTestUser.processFrameWithoutRenderingCalls);
+        EXPECT_EQ(1, mRollbackTestUser.postRollbackCalls);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenMultipleMispredictionsReceived_rollsBackOnceToEarliestFrame) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        // Process 3 more frames (1 through 3), all with predicted remote inputs
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+        mTimeControlledToTest.OnTick();
+        ASSERT_EQ(4, mRollbackTestUser.processFrameCalls);
+
+        // Receive two separate corrections before next update
+        InputHistoryArray jumpInputs = CreateInputsWithJumpPressed();
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 1, jumpInputs); // Frames 0-1
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 2, jumpInputs); // Frame 2
+        mTimeControlledToTest.OnTick();
+
+        EXPECT_EQ(1, mRollbackTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(0, mRollbackTestUser.lastRestoredFrame);
+        EXPECT_EQ(4, mRollbackTestUser.processFrameWithoutRenderingCalls); // Frames 0 through 3 re-processed
+        EXPECT_EQ(1, mRollbackTestUser.postRollbackCalls);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenNoAcksReceived_sendsAllAvailableInputs) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+        mTimeControlledToTest.OnTick(); // Frames 1 through 3
+
+        const InputUpdateMessage& sentMessage = mRollbackTestUser.lastSentInputUpdate;
+        EXPECT_EQ(3, sentMessage.updateFrame);
+        EXPECT_EQ(4, sentMessage.numInputs);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenRemotePlayerAcksInputs_sendsOnlyUnackedInputsAndOwnAck) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+        mTimeControlledToTest.OnTick(); // Frames 1 through 3
+
+        // Remote player sends their frame 0 input and acks our inputs up to frame 2
+        InputUpdateMessage remoteMessage(0, {});
+        remoteMessage.numInputs = 1;
+        remoteMessage.ackedFrames[static_cast<size_t>(PlayerSpot::Player1)] = 2;
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, remoteMessage);
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        mTimeControlledToTest.OnTick(); // Frame 4
+
+        const InputUpdateMessage& sentMessage = mRollbackTestUser.lastSentInputUpdate;
+        EXPECT_EQ(4, sentMessage.updateFrame);
+        EXPECT_EQ(2, sentMessage.numInputs); // Frames 3 and 4
+        EXPECT_EQ(0, sentMessage.ackedFrames[static_cast<size_t>(PlayerSpot::Player2)]);
+    }
+
+    TEST_F(RollbackManagerTests, OnReceivedRemotePlayerInput_whenOlderUnackedInputsMissing_ignoresMessage) {
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        mTimeControlledToTest.OnTick(); // Frame 1
+
+        // Only includes frame 1 input, but frame 0 input was never received
+        InputUpdateMessage remoteMessage(1, CreateInputsWithJumpPressed());
+        remoteMessage.numInputs = 1;
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, remoteMessage);
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        mTimeControlledToTest.OnTick();
+
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(0, mRollbackTestUser.restoreSnapshotCalls);
+        // Still nothing received from remote player, so nothing to ack
+        EXPECT_EQ(std::numeric_limits<FrameType>::max(),
+                  mRollbackTestUser.lastSentInputUpdate.ackedFrames[static_cast<size_t>(PlayerSpot::Player2)]);
+    }
+
+    TEST_F(RollbackManagerTests, GetPerfCounters_whenRemoteInputMispredicted_countsRollbackAndResimulatedFrames) {
+        if constexpr (!kRollbackPerfCountersEnabled) {
+            GTEST_SKIP() << "Perf counters are compiled out";
+        }
+        
+        StartTwoPlayerSession();
+        mTimeControlledToTest.OnTick(); // Initial frame 0 processed with predicted (default) remote input
+
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 0, CreateInputsWithJumpPressed());
+        mTimeControlledToTest.OnTick();
+
+        const RollbackPerfCounters& counters = mTimeControlledToTest.GetPerfCounters();
+        const RollbackTickCounters& lastTick = counters.GetLastTick();
+        EXPECT_EQ(0, lastTick.framesProcessed);
+        EXPECT_EQ(1, lastTick.framesResimulated);
+        ASSERT_EQ(1, lastTick.rollbackDepths.GetSize());
+        EXPECT_EQ(1, lastTick.rollbackDepths.Get(0));
+
+        const RollbackPerfTotals& sessionTotals = counters.GetSessionTotals();
+        EXPECT_EQ(2, sessionTotals.ticks);
+        EXPECT_EQ(1, sessionTotals.framesProcessed);
+        EXPECT_EQ(1, sessionTotals.rollbacks);
+        EXPECT_EQ(1, sessionTotals.rollbackDepthHistogram[1]);
+    }
+
+    // Gives every retrieved local input a unique value, so tests can verify exactly which input each frame used
+    class InputRecordingTestUser : public RollbackTestUser {
+      public:
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override {
+            requestedInputFrames.push_back(expectedFrame);
+            result.camPosition.x = fp{static_cast<int32_t>(requestedInputFrames.size())}; // Not quantized, so stays exact
+            if (shouldPressJumpEveryInput) {
+                result.commandInputs.SetCommandValue(InputCommand::Jump, true);
+                result.uiChoice = GameplayInteractiveUIChoice::ChooseOptionA;
+            }
+            return true;
+        }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrame(expectedFrame, playerInputs);
+            RecordLocalInput(expectedFrame, playerInputs);
+        }
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+            RollbackTestUser::ProcessFrameWithoutRendering(expectedFrame, playerInputs);
+            RecordLocalInput(expectedFrame, playerInputs);
+        }
+
+        bool shouldPressJumpEveryInput = false;
+        std::vector<FrameType> requestedInputFrames = {};
+        // Indexed by frame, id of the local input used. 0 for empty inputs from before session start
+        std::vector<int32_t> processedLocalInputIds = {};
+        // Indexed by frame, whether local input had jump or any UI choice
+        std::vector<bool> processedLocalOneShotInputs = {};
+
+      private:
+        void RecordLocalInput(FrameType frame, const PlayerInputsForFrame& playerInputs) {
+            if (processedLocalInputIds.size() <= frame) {
+                processedLocalInputIds.resize(frame + 1);
+            }
+            processedLocalInputIds[frame] = static_cast<int32_t>(playerInputs.Get(0).camPosition.x);
+
+            if (processedLocalOneShotInputs.size() <= frame) {
+                processedLocalOneShotInputs.resize(frame + 1);
+            }
+            processedLocalOneShotInputs[frame] = playerInputs.Get(0).commandInputs.IsCommandSet(InputCommand::Jump)
+                || playerInputs.Get(0).uiChoice != GameplayInteractiveUIChoice::None;
+        }
+    };
+
+    TEST_F(RollbackManagerTests, OnTick_whenUsingInputDelay_sendsLocalInputsAheadOfProcessedFrame) {
+        InputRecordingTestUser user = {};
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.localInputDelay = 2;
+        toTest.StartRollbackSession(settings);
+
+        toTest.OnTick(); // Initial frame 0
+
+        EXPECT_EQ(2, toTest.GetLocalInputDelay());
+        ASSERT_EQ(1, user.requestedInputFrames.size());
+        EXPECT_EQ(2, user.requestedInputFrames[0]);
+        ASSERT_EQ(1, user.processedLocalInputIds.size());
+        EXPECT_EQ(0, user.processedLocalInputIds[0]); // Delayed input isn't used yet
+        EXPECT_EQ(2, user.lastSentInputUpdate.updateFrame);
+        EXPECT_EQ(3, user.lastSentInputUpdate.numInputs);
+    }
+
+    TEST_F(RollbackManagerTests, StartRollbackSession_whenSinglePlayer_ignoresInputDelay) {
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+        settings.localInputDelay = 3;
+        mTimeControlledToTest.StartRollbackSession(settings);
+        mTimeControlledToTest.OnTick();
+
+        EXPECT_EQ(0, mTimeControlledToTest.GetLocalInputDelay());
+    }
+
+    TEST_F(RollbackManagerTests, StartRollbackSession_whenDesyncLocalizationUnsupportedBySnapshot_doesNotStart) {
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.useDesyncLocalization = true; // TestSnapshot has no desync checksum tree
+        mTimeControlledToTest.StartRollbackSession(settings);
+        mTimeControlledToTest.OnTick();
+
+        TestHelpers::VerifySingletonLoggingOccured();
+        EXPECT_EQ(0, mRollbackTestUser.processFrameCalls);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenInputDelayTuningDecreasesDelay_usesEveryLocalInputExactlyOnce) {
+        InputRecordingTestUser user = {};
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.localInputDelay = 3;
+        settings.inputDelayTuning.isEnabled = true;
+        settings.inputDelayTuning.evaluationWindowFrames = 4; // No rollbacks at all, so decreases every window
+        toTest.StartRollbackSession(settings);
+
+        for (FrameType frame = 0; frame < 30; frame++) {
+            toTest.OnTick();
+            toTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, InputUpdateMessage(frame, {}));
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        }
+
+        EXPECT_EQ(0, toTest.GetLocalInputDelay());
+        ASSERT_EQ(30, user.processedLocalInputIds.size());
+        // Frames within initial delay use empty inputs, then every retrieved input is used in order without gaps
+        for (int32_t frame = 0; frame < 3; frame++) {
+            EXPECT_EQ(0, user.processedLocalInputIds[frame]);
+        }
+        for (int32_t frame = 3; frame < 30; frame++) {
+            EXPECT_EQ(frame - 2, user.processedLocalInputIds[frame]) << "Frame " << frame;
+        }
+        // Input retrieval is skipped once per frame of delay removed
+        EXPECT_EQ(27, user.requestedInputFrames.size());
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenInputDelayTuningIncreasesDelay_holdsLatestInputForInsertedFrames) {
+        InputRecordingTestUser user = {};
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.inputDelayTuning.isEnabled = true;
+        settings.inputDelayTuning.maxInputDelay = 2;
+        settings.inputDelayTuning.deepRollbackFrames = 1; // Every rollback counts
+        settings.inputDelayTuning.deepRollbacksToIncreaseDelay = 1;
+        settings.inputDelayTuning.evaluationWindowFrames = 4;
+        toTest.StartRollbackSession(settings);
+
+        // Remote input alternates every frame, so each frame is mispredicted
+        for (FrameType frame = 0; frame < 30; frame++) {
+            toTest.OnTick();
+            InputUpdateMessage remoteMessage(frame, frame % 2 == 1 ? CreateInputsWithJumpPressed() : InputHistoryArray{});
+            remoteMessage.numInputs = 1;
+            toTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, remoteMessage);
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        }
+
+        EXPECT_EQ(2, toTest.GetLocalInputDelay());
+        ASSERT_EQ(30, user.processedLocalInputIds.size());
+        // Every retrieved input is used in order, and each inserted frame holds the prior input for one more frame
+        int32_t numOfHeldFrames = 0;
+        for (size_t frame = 1; frame < user.processedLocalInputIds.size(); frame++) {
+            const int32_t difference = user.processedLocalInputIds[frame] - user.processedLocalInputIds[frame - 1];
+            ASSERT_TRUE(difference == 0 || difference == 1) << "Frame " << frame;
+            numOfHeldFrames += difference == 0 ? 1 : 0;
+        }
+        EXPECT_EQ(2, numOfHeldFrames);
+        EXPECT_EQ(user.requestedInputFrames.size(), user.processedLocalInputIds.back() + 2); // Last 2 are still delayed
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenInputDelayTuningIncreasesDelay_processesEachPressedCommandOnce) {
+        InputRecordingTestUser user = {};
+        user.shouldPressJumpEveryInput = true;
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.inputDelayTuning.isEnabled = true;
+        settings.inputDelayTuning.maxInputDelay = 2;
+        settings.inputDelayTuning.deepRollbackFrames = 1; // Every rollback counts
+        settings.inputDelayTuning.deepRollbacksToIncreaseDelay = 1;
+        settings.inputDelayTuning.evaluationWindowFrames = 4;
+        toTest.StartRollbackSession(settings);
+
+        // Remote input alternates every frame, so each frame is mispredicted
+        for (FrameType frame = 0; frame < 30; frame++) {
+            toTest.OnTick();
+            InputUpdateMessage remoteMessage(frame, frame % 2 == 1 ? CreateInputsWithJumpPressed() : InputHistoryArray{});
+            remoteMessage.numInputs = 1;
+            toTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, remoteMessage);
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        }
+
+        ASSERT_EQ(2, toTest.GetLocalInputDelay());
+        ASSERT_EQ(30, user.processedLocalInputIds.size());
+        // Inserted frames hold the prior input's axes + camera, but never repeat its jump or UI choice
+        EXPECT_TRUE(user.processedLocalOneShotInputs[0]);
+        int32_t numOfOneShotFrames = 1;
+        for (size_t frame = 1; frame < user.processedLocalInputIds.size(); frame++) {
+            const bool isHeldFrame = user.processedLocalInputIds[frame] == user.processedLocalInputIds[frame - 1];
+            EXPECT_EQ(!isHeldFrame, user.processedLocalOneShotInputs[frame]) << "Frame " << frame;
+            numOfOneShotFrames += user.processedLocalOneShotInputs[frame] ? 1 : 0;
+        }
+        EXPECT_EQ(user.processedLocalInputIds.back(), numOfOneShotFrames);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenReplayWriterSet_writesEveryConfirmedFrameInOrder) {
+        const std::string filePath = (std::filesystem::temp_directory_path() / "RollbackManagerTests_Replay.replay").string();
+        InputRecordingTestUser user = {};
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+        settings.useSyncTest = true; // Frames only exit rollback window after sync test frames
+        settings.syncTestFrames = 2;
+
+        ReplayWriter writer(4);
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), filePath, {7, settings}));
+        toTest.SetReplayWriter(&writer);
+        toTest.StartRollbackSession(settings);
+
+        toTest.OnTick(); // Initial frame 0
+        for (int i = 0; i < 5; i++) { // Multiple frames per tick, so multiple frames are confirmed at once
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+            toTest.OnTick();
+        }
+        toTest.EndRollbackSessionIfAny();
+        ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), filePath));
+        EXPECT_EQ(7, reader.GetHeader().sessionSeed);
+        EXPECT_EQ(0, reader.GetFirstFrame());
+        // Last sync test frames never exit rollback window
+        ASSERT_EQ(user.processedLocalInputIds.size() - 2, reader.GetEndFrame());
+        for (FrameType frame = 0; frame < reader.GetEndFrame(); frame++) {
+            PlayerInputsForFrame inputs;
+            ASSERT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), frame, inputs));
+            EXPECT_EQ(user.processedLocalInputIds[frame], static_cast<int32_t>(inputs.Get(0).camPosition.x)) << "Frame " << frame;
+        }
+        reader.Close();
+        std::filesystem::remove(filePath);
+    }
+
+    TEST_F(RollbackManagerTests, FastForwardFrames_whenReplayWriterSet_writesFastForwardedFramesWithoutGaps) {
+        const std::string filePath = (std::filesystem::temp_directory_path() / "RollbackManagerTests_FastForward.replay").string();
+        InputRecordingTestUser user = {};
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+
+        ReplayWriter writer(16);
+        ASSERT_TRUE(writer.Open(GetLoggerSingleton(), filePath, {0, settings}));
+        toTest.SetReplayWriter(&writer);
+        toTest.StartRollbackSession(settings);
+
+        toTest.OnTick(); // Initial frame 0
+        // Far more frames than input history holds, so frames must be written as they're processed
+        constexpr FrameType kFramesToFastForward = 300;
+        ASSERT_EQ(kFramesToFastForward, toTest.FastForwardFrames(kFramesToFastForward));
+        mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+        toTest.OnTick();
+        toTest.EndRollbackSessionIfAny();
+        ASSERT_TRUE(writer.Close(GetLoggerSingleton()));
+
+        ReplayReader reader;
+        ASSERT_TRUE(reader.Open(GetLoggerSingleton(), filePath));
+        ASSERT_EQ(user.processedLocalInputIds.size(), reader.GetEndFrame());
+        for (FrameType frame = 0; frame < reader.GetEndFrame(); frame++) {
+            PlayerInputsForFrame inputs;
+            ASSERT_TRUE(reader.GetInputsForFrame(GetLoggerSingleton(), frame, inputs));
+            EXPECT_EQ(user.processedLocalInputIds[frame], static_cast<int32_t>(inputs.Get(0).camPosition.x)) << "Frame " << frame;
+        }
+        reader.Close();
+        std::filesystem::remove(filePath);
+    }
+
+    // Sync test user whose re-simulation never matches the original simulation
+    class NonDeterministicSyncTestUser : public RollbackTestUser {
+      public:
+        void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {
+            result.number = expectedFrame + 100;
+        }
+    };
+
+    TEST_F(RollbackManagerTests, OnTick_whenAsyncSyncTestEnabled_resimulatesOnSyncTestUserInsteadOfMainUser) {
+        StartAsyncSyncTestSession(mSyncTestUser);
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        for (int i = 0; i < 3; i++) { // Frames 1 through 3, with sync tests starting once frame 2 is processed
+            TickOneFrameAndWaitForSyncTest();
+        }
+
+        // Main user should never be rolled back
+        EXPECT_EQ(4, mRollbackTestUser.processFrameCalls);
+        EXPECT_EQ(0, mRollbackTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(0, mRollbackTestUser.processFrameWithoutRenderingCalls);
+        EXPECT_EQ(0, mRollbackTestUser.postRollbackCalls);
+
+        // Sync test user should have re-simulated 2 frames for each of the 2 tests (after frame 2 and after frame 3)
+        EXPECT_EQ(2, mSyncTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(1, mSyncTestUser.lastRestoredFrame);
+        EXPECT_EQ(4, mSyncTestUser.processFrameWithoutRenderingCalls);
+        EXPECT_EQ(0, mSyncTestUser.processFrameCalls);
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenAsyncSyncTestResimulationDiffers_logsFailure) {
+        NonDeterministicSyncTestUser nonDeterministicUser = {};
+        StartAsyncSyncTestSession(nonDeterministicUser);
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        for (int i = 0; i < 2; i++) {
+            TickOneFrameAndWaitForSyncTest();
+        }
+        mTimeControlledToTest.SetAsyncSyncTestUser(nullptr); // Local user is about to go out of scope
+
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(RollbackManagerTests, StartRollbackSession_whenAsyncSyncTestEnabledWithoutSyncTestUser_doesNotStart) {
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+        settings.useSyncTest = true;
+        settings.useAsyncSyncTest = true;
+        mTimeControlledToTest.StartRollbackSession(settings);
+
+        EXPECT_EQ(0, mTimeControlledToTest.OnTick());
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenUsingSnapshotInterval_restoresNearestEarlierSnapshotAndFastForwards) {
+        RollbackSettings settings = CreateTwoPlayerSettings();
+        settings.snapshotInterval = 4;
+        mTimeControlledToTest.StartRollbackSession(settings);
+        
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        for (int i = 0; i < 2; i++) { // Frames 1 through 6
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec()) * 3;
+            mTimeControlledToTest.OnTick();
+        }
+        ASSERT_EQ(7, mRollbackTestUser.processFrameCalls);
+
+        // Confirm frames 0 through 4 as predicted, then mispredict only frame 5
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 4, {});
+        mTimeControlledToTest.OnReceivedRemotePlayerInput(PlayerSpot::Player2, 5, CreateInputsWithJumpPressed());
+        mTimeControlledToTest.OnTick();
+
+        // Only frames 0 and 4 have snapshots, so should restore 4 and re-process frames 4 through 6
+        EXPECT_EQ(1, mRollbackTestUser.restoreSnapshotCalls);
+        EXPECT_EQ(4, mRollbackTestUser.lastRestoredFrame);
+        EXPECT_EQ(3, mRollbackTestUser.processFrameWithoutRenderingCalls);
+
+        const RollbackSnapshotStats& stats = mTimeControlledToTest.GetSnapshotStats();
+        EXPECT_EQ(2, stats.snapshotsStored);
+        EXPECT_EQ(7, stats.snapshotsSkipped); // Frames 1, 2, 3, 5, 6 then 5 and 6 again during re-processing
+        EXPECT_EQ(1, stats.rollbacks);
+        EXPECT_EQ(3, stats.framesResimulated);
+        EXPECT_EQ(1, stats.extraFramesResimulated);
+    }
+
+    // Snapshot generation which takes a fixed amount of (injected) time
+    class SlowSnapshotTestUser : public RollbackTestUser {
+      public:
+        static constexpr uint64_t kGenerationTimeInMicroSec = 250;
+
+        explicit SlowSnapshotTestUser(uint64_t& curTimeInMicroSec) : mCurTimeInMicroSec(curTimeInMicroSec) {}
+
+        void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {
+            mCurTimeInMicroSec += kGenerationTimeInMicroSec;
+        }
+
+      private:
+        uint64_t& mCurTimeInMicroSec;
+    };
+
+    TEST_F(RollbackManagerTests, GetSnapshotStats_whenGeneratingSnapshot_measuresWithInjectedTime) {
+        if constexpr (!kRollbackPerfCountersEnabled) {
+            GTEST_SKIP() << "Perf counters are compiled out";
+        }
+
+        SlowSnapshotTestUser user(mCurTimeInMicroSec);
+        RollbackManager<TestSnapshot> toTest = CreateTimeControlledManager(user);
+        toTest.StartRollbackSession(CreateTwoPlayerSettings());
+        toTest.OnTick(); // Initial frame 0
+
+        const RollbackSnapshotStats& stats = toTest.GetSnapshotStats();
+        EXPECT_EQ(1, stats.snapshotsStored);
+        EXPECT_EQ(SlowSnapshotTestUser::kGenerationTimeInMicroSec, stats.GetAverageSnapshotGenerationTimeInMicroSec());
+        EXPECT_EQ(SlowSnapshotTestUser::kGenerationTimeInMicroSec,
+                  toTest.GetPerfCounters().GetSessionTotals().GetTimeInMicroSec(RollbackPerfTimer::GenerateSnapshot));
+    }
+
+    TEST_F(RollbackManagerTests, OnTick_whenUsingSnapshotIntervalWithSyncTest_runsSyncTestWithoutErrors) {
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+        settings.useSyncTest = true;
+        settings.syncTestFrames = 2;
+        settings.snapshotInterval = 3;
+        mTimeControlledToTest.StartRollbackSession(settings);
+
+        mTimeControlledToTest.OnTick(); // Initial frame 0
+        for (int i = 0; i < 4; i++) {
+            mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+            mTimeControlledToTest.OnTick();
+        }
+
+        // Every rollback should restore from a frame that's a multiple of the interval
+        EXPECT_EQ(3, mRollbackTestUser.restoreSnapshotCalls); // Sync test starts once frame 2 is processed
+        EXPECT_EQ(0, mRollbackTestUser.lastRestoredFrame % 3);
+    }
+
+    TEST_F(RollbackManagerTests, StartRollbackSession_whenSnapshotIntervalOutOfRange_doesNotStart) {
+        RollbackSettings settings = {};
+        settings.totalPlayers = 1;
+        settings.localPlayerSpot = PlayerSpot::Player1;
+        settings.hostPlayerSpot = PlayerSpot::Player1;
+        settings.snapshotInterval = RollbackStaticSettings::kMaxSnapshotInterval + 1;
+        mTimeControlledToTest.StartRollbackSession(settings);
+
+        EXPECT_EQ(0, mTimeControlledToTest.OnTick());
+        TestHelpers::VerifySingletonLoggingOccured();
+    }
+
+    // Counts every allocation made through it, so tests can verify that steady-state snapshot storage doesn't allocate
+    inline uint64_t gSnapshotAllocationCount = 0;
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(size_t count) {
+            gSnapshotAllocationCount++;
+            return std::allocator<T>().allocate(count);
+        }
+        void deallocate(T* pointer, size_t count) {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>&) const { return true; }
+    };
+
+    // Represents snapshots which own heap memory, such as a copy of an EnTT registry
+    template <bool kInPlace>
+    class HeapOwningTestSnapshot : public BaseSnapshot {
+      public:
+        static constexpr bool kGenerateSnapshotInPlace = kInPlace;
+        
+        uint32_t CalculateChecksum() const override {
+            return values.empty() ? 0 : values[0];
+        }
+
+        std::vector<uint32_t, CountingAllocator<uint32_t>> values;
+    };
+
+    template <typename SnapshotType>
+    class HeapOwningTestUser : public RollbackUser<SnapshotType> {
+      public:
+        void GenerateSnapshot(FrameType expectedFrame, SnapshotType& result) override {
+            result.values.assign(64, expectedFrame); // Reuses existing capacity if any
+        }
+        void RestoreSnapshot(FrameType expectedFrame, const SnapshotType& snapshotToRestore) override {
+            mCurrentState = snapshotToRestore.values; // Copy-assign also reuses existing capacity
+        }
+        bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override { return true; }
+        void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {}
+        void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {}
+        void OnPostRollback() override {}
+        void SendTimeQualityReport(FrameType currentFrame) override {}
+        void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) override {}
+        void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {}
+        void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) override {}
+        void OnInputsExitRollbackWindow(FrameType confirmedFrame) override {}
+
+      private:
+        std::vector<uint32_t, CountingAllocator<uint32_t>> mCurrentState;
+    };
+
+    class RollbackManagerAllocationTests : public RollbackManagerTests {
+      protected:
+        // Runs a sync test session (so both storing and restoring snapshots every frame) and counts snapshot
+        //      allocations once every snapshot buffer slot has already been used at least once
+        template <typename SnapshotType>
+        uint64_t CountSteadyStateSnapshotAllocations() {
+            HeapOwningTestUser<SnapshotType> user = {};
+            RollbackManager<SnapshotType> toTest(user, std::bind_front(&RollbackManagerAllocationTests::GetCurrentTime, this));
+            
+            RollbackSettings settings = {};
+            settings.totalPlayers = 1;
+            settings.localPlayerSpot = PlayerSpot::Player1;
+            settings.hostPlayerSpot = PlayerSpot::Player1;
+            settings.useSyncTest = true;
+            settings.syncTestFrames = 2;
+            toTest.StartRollbackSession(settings);
+            toTest.OnTick(); // Initial frame 0
+
+            auto tickFrames = [&](int numOfFrames) {
+                for (int i = 0; i < numOfFrames; i++) {
+                    mCurTimeInMicroSec += static_cast<uint64_t>(FrameRate::TimePerFrameInMicroSec());
+                    toTest.OnTick();
+                }
+            };
+            tickFrames(RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames * 2); // Warm up every buffer slot
+
+            const uint64_t allocationsBefore = gSnapshotAllocationCount;
+            tickFrames(RollbackStaticSettings::kTwoMoreThanMaxRollbackFrames * 2);
+            return gSnapshotAllocationCount - allocationsBefore;
+        }
+    };
+
+    TEST_F(RollbackManagerAllocationTests, StoreSnapshot_whenGeneratingInPlace_doesNotAllocateInSteadyState) {
+        EXPECT_EQ(0, CountSteadyStateSnapshotAllocations<HeapOwningTestSnapshot<true>>());
+    }
+
+    TEST_F(RollbackManagerAllocationTests, StoreSnapshot_whenNotGeneratingInPlace_allocatesEveryStoredFrame) {
+        // Mostly a sanity check that the allocation counting itself actually works
+        EXPECT_LT(0, CountSteadyStateSnapshotAllocations<HeapOwningTestSnapshot<false>>());
+    }
 }
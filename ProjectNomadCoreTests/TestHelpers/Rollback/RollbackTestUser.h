@@ -8,15 +8,34 @@ using namespace ProjectNomad;
 class RollbackTestUser : public RollbackUser<TestSnapshot> {
 public:
     void GenerateSnapshot(FrameType expectedFrame, TestSnapshot& result) override {}
-    void RestoreSnapshot(FrameType expectedFrame, const TestSnapshot& snapshotToRestore) override {}
+    void RestoreSnapshot(FrameType expectedFrame, const TestSnapshot& snapshotToRestore) override {
+        restoreSnapshotCalls++;
+        lastRestoredFrame = expectedFrame;
+    }
     bool GetInputForNextFrame(FrameType expectedFrame, CharacterInput& result) override { return true; }
-    void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {}
-    void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {}
-    void OnPostRollback() override {}
+    void ProcessFrame(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+        processFrameCalls++;
+    }
+    void ProcessFrameWithoutRendering(FrameType expectedFrame, const PlayerInputsForFrame& playerInputs) override {
+        processFrameWithoutRenderingCalls++;
+    }
+    void OnPostRollback() override {
+        postRollbackCalls++;
+    }
     void SendTimeQualityReport(FrameType currentFrame) override {}
     void SendValidationChecksum(FrameType targetFrame, uint32_t checksum) override {}
-    void SendLocalInputsToRemotePlayers(FrameType expectedFrame, const InputHistoryArray& playerInputs) override {}
+    void SendLocalInputsToRemotePlayers(const InputUpdateMessage& message) override {
+        lastSentInputUpdate = message;
+    }
     void OnStallingForRemoteInputs(const RollbackStallInfo& stallInfo) override {}
     void OnInputsExitRollbackWindow(FrameType confirmedFrame) override {}
     ~RollbackTestUser() override = default;
-};
\ No newline at end of file
+
+    // Simple call tracking so tests can verify expected rollback behavior
+    uint32_t restoreSnapshotCalls = 0;
+    FrameType lastRestoredFrame = 0;
+    uint32_t processFrameCalls = 0;
+    uint32_t processFrameWithoutRenderingCalls = 0;
+    uint32_t postRollbackCalls = 0;
+    InputUpdateMessage lastSentInputUpdate = {};
+};
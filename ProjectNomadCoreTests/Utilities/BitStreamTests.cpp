@@ -0,0 +1,62 @@
+#include "pchNCT.h"
+
+#include "TestHelpers/TestHelpers.h"
+#include "Utilities/BitStream.h"
+
+using namespace ProjectNomad;
+namespace BitStreamTests {
+    class BitStreamTests : public BaseSimTest {
+      protected:
+        std::vector<uint8_t> mBuffer = {};
+    };
+
+    TEST_F(BitStreamTests, ReadBits_whenMixedBitWidthsWritten_readsBackSameValues) {
+        BitWriter writer(mBuffer);
+        writer.WriteBool(true);
+        writer.WriteBits(5, 3);
+        writer.WriteBits(0xABCD, 16);
+        writer.WriteVarSigned(-3);
+        writer.WriteVarSigned(0);
+        writer.WriteVarSigned(std::numeric_limits<int64_t>::min());
+        writer.WriteVarUnsigned(0);
+        writer.WriteVarUnsigned(std::numeric_limits<uint64_t>::max());
+        writer.WriteBits(0xFFFFFFFFFFFFFFFF, 64);
+
+        BitReader reader(mBuffer.data(), mBuffer.size());
+        EXPECT_TRUE(reader.ReadBool());
+        EXPECT_EQ(5, reader.ReadBits(3));
+        EXPECT_EQ(0xABCD, reader.ReadBits(16));
+        EXPECT_EQ(-3, reader.ReadVarSigned());
+        EXPECT_EQ(0, reader.ReadVarSigned());
+        EXPECT_EQ(std::numeric_limits<int64_t>::min(), reader.ReadVarSigned());
+        EXPECT_EQ(0, reader.ReadVarUnsigned());
+        EXPECT_EQ(std::numeric_limits<uint64_t>::max(), reader.ReadVarUnsigned());
+        EXPECT_EQ(0xFFFFFFFFFFFFFFFF, reader.ReadBits(64));
+
+        EXPECT_FALSE(reader.HasReadPastEnd());
+        EXPECT_EQ(mBuffer.size(), reader.GetBytesRead());
+    }
+
+    TEST_F(BitStreamTests, ReadBits_whenReadingPastEnd_returnsZeroAndFlagsReader) {
+        BitWriter writer(mBuffer);
+        writer.WriteBits(0xFF, 8);
+
+        BitReader reader(mBuffer.data(), mBuffer.size());
+        EXPECT_EQ(0xFF, reader.ReadBits(8));
+        EXPECT_FALSE(reader.HasReadPastEnd());
+
+        EXPECT_EQ(0, reader.ReadBits(1));
+        EXPECT_TRUE(reader.HasReadPastEnd());
+    }
+
+    TEST_F(BitStreamTests, BitWriter_whenBufferReused_replacesOldContents) {
+        BitWriter firstWriter(mBuffer);
+        firstWriter.WriteBits(0xFFFFFFFF, 32);
+
+        BitWriter secondWriter(mBuffer);
+        secondWriter.WriteBits(1, 2);
+
+        EXPECT_EQ(1, secondWriter.GetSizeInBytes());
+        EXPECT_EQ(1, mBuffer[0]);
+    }
+}
@@ -0,0 +1,296 @@
+#include "pchNCT.h"
+
+#include <string>
+#include <vector>
+#include <CRCpp/CRC.h>
+
+#include "Context/CoreContext.h"
+#include "GameCore/CoreComponents.h"
+#include "Input/CharacterInput.h"
+#include "Rollback/Model/RegistrySnapshot.h"
+#include "TestHelpers/TestHelpers.h"
+#include "Utilities/ChecksumHasher.h"
+#include "Utilities/SharedUtilities.h"
+#include "Utilities/Containers/FlexArray.h"
+
+using namespace ProjectNomad;
+namespace ChecksumHasherTests {
+    static_assert(ChecksumHasher::kIsHashedAsRawBytes<TransformComponent>);
+    static_assert(ChecksumHasher::kIsHashedAsRawBytes<HitstopComponent>);
+    static_assert(ChecksumHasher::kIsHashedAsRawBytes<CommandSetList>);
+    static_assert(!ChecksumHasher::kIsHashedAsRawBytes<PhysicsComponent>); // Padded
+    static_assert(!ChecksumHasher::kIsHashedAsRawBytes<Collider>); // Only checksums fields in use
+    static_assert(!DefinesLegacyCalculateCRC32<FPVector>); // Only wraps ChecksumHasher
+
+    // Per-field CRC::Calculate calls, exactly as every CalculateCRC32 method did before ChecksumHasher existed
+    namespace Legacy {
+        template <typename ValueType>
+        void AddField(const ValueType& value, uint32_t& resultThusFar) {
+            resultThusFar = CRC::Calculate(&value, sizeof(value), CRC::CRC_32(), resultThusFar);
+        }
+        void AddVector(const FPVector& value, uint32_t& resultThusFar) {
+            AddField(value.x, resultThusFar);
+            AddField(value.y, resultThusFar);
+            AddField(value.z, resultThusFar);
+        }
+        void AddQuat(const FPQuat& value, uint32_t& resultThusFar) {
+            AddField(value.w, resultThusFar);
+            AddVector(value.v, resultThusFar);
+        }
+        void AddTransform(const TransformComponent& value, uint32_t& resultThusFar) {
+            AddVector(value.location, resultThusFar);
+            AddQuat(value.rotation, resultThusFar);
+        }
+        void AddPhysics(const PhysicsComponent& value, uint32_t& resultThusFar) {
+            AddField(value.mass, resultThusFar);
+            AddVector(value.velocity, resultThusFar);
+        }
+        void AddBoxCollider(const Collider& value, uint32_t& resultThusFar) {
+            AddVector(value.center, resultThusFar);
+            AddQuat(value.rotation, resultThusFar);
+            AddField(value.boxHalfSizeX, resultThusFar);
+            AddField(value.boxHalfSizeY, resultThusFar);
+            AddField(value.boxHalfSizeZ, resultThusFar);
+        }
+        void AddCharacterInput(const CharacterInput& value, uint32_t& resultThusFar) {
+            AddVector(value.camPosition, resultThusFar);
+            AddQuat(value.camRotation, resultThusFar);
+            AddField(value.moveForward, resultThusFar);
+            AddField(value.moveRight, resultThusFar);
+            AddField(value.uiChoice, resultThusFar);
+            AddField(value.commandInputs.commandInputs.GetAllAsNumber(), resultThusFar);
+        }
+    }
+
+    struct LegacyOnlyComponent {
+        uint32_t value = 0;
+
+        void CalculateCRC32(uint32_t& resultThusFar) const {
+            resultThusFar = CRC::Calculate(&value, sizeof(value), CRC::CRC_32(), resultThusFar);
+        }
+    };
+
+    class ChecksumHasherTests : public BaseSimTest {
+      protected:
+        static std::vector<uint8_t> CreateTestBytes(size_t size) {
+            std::vector<uint8_t> result(size);
+            for (size_t i = 0; i < size; i++) {
+                result[i] = static_cast<uint8_t>(i * 31 + 7);
+            }
+            return result;
+        }
+
+        // Plain bit at a time CRC-32C, as CRCpp only includes it with esoteric definitions enabled
+        static uint32_t CalculateBitwiseCrc32c(const std::vector<uint8_t>& bytes) {
+            uint32_t result = 0xFFFFFFFF;
+            for (uint8_t byte : bytes) {
+                result ^= byte;
+                for (int bit = 0; bit < 8; bit++) {
+                    result = (result & 1) != 0 ? (result >> 1) ^ 0x82F63B78 : result >> 1;
+                }
+            }
+            return ~result;
+        }
+
+        static Collider CreateBox(const FPVector& center, const FPVector& halfSize) {
+            Collider result;
+            result.setBox(center, halfSize);
+            return result;
+        }
+
+        static TransformComponent CreateTransform(int32_t seed) {
+            TransformComponent result = {};
+            result.location = FPVector(fp{seed}, fp{-seed * 2}, fp{0.25f});
+            result.rotation = FPQuat::fromDegrees(FPVector::up(), fp{seed % 360});
+            return result;
+        }
+    };
+
+    TEST_F(ChecksumHasherTests, AddBytes_forStandardCheckInput_matchesPublishedCheckValues) {
+        const std::string checkInput = "123456789";
+
+        ChecksumHasher crc32(ChecksumAlgorithm::Crc32Compatible);
+        crc32.AddBytes(checkInput.data(), checkInput.size());
+        ChecksumHasher crc32c(ChecksumAlgorithm::Crc32c);
+        crc32c.AddBytes(checkInput.data(), checkInput.size());
+
+        EXPECT_EQ(0xCBF43926, crc32.GetResult());
+        EXPECT_EQ(0xE3069283, crc32c.GetResult());
+    }
+
+    TEST_F(ChecksumHasherTests, AddBytes_whenSplitAcrossManyCalls_matchesSingleCallReference) {
+        const std::vector<uint8_t> bytes = CreateTestBytes(1000);
+        const uint32_t expectedCrc32 = CRC::Calculate(bytes.data(), bytes.size(), CRC::CRC_32());
+        const uint32_t expectedCrc32c = CalculateBitwiseCrc32c(bytes);
+
+        // Odd split sizes, so every combination of word-sized blocks and leftover bytes is covered
+        for (size_t splitSize : {1, 3, 7, 8, 13, 64, 1000}) {
+            ChecksumHasher crc32(ChecksumAlgorithm::Crc32Compatible);
+            ChecksumHasher crc32c(ChecksumAlgorithm::Crc32c);
+            for (size_t offset = 0; offset < bytes.size(); offset += splitSize) {
+                const size_t size = std::min(splitSize, bytes.size() - offset);
+                crc32.AddBytes(bytes.data() + offset, size);
+                crc32c.AddBytes(bytes.data() + offset, size);
+            }
+
+            EXPECT_EQ(expectedCrc32, crc32.GetResult()) << "Split size " << splitSize;
+            EXPECT_EQ(expectedCrc32c, crc32c.GetResult()) << "Split size " << splitSize;
+        }
+    }
+
+    TEST_F(ChecksumHasherTests, Add_withCrc32Compatible_matchesLegacyPerFieldChecksums) {
+        const TransformComponent transform = CreateTransform(42);
+        PhysicsComponent physics = {};
+        physics.mass = 250;
+        physics.velocity = FPVector(fp{1}, fp{-2}, fp{3.5f});
+        const Collider box = CreateBox(FPVector(fp{5}, fp{6}, fp{7}), FPVector(fp{1}, fp{2}, fp{3}));
+        CharacterInput input = {};
+        input.moveForward = fp{0.5f};
+        input.uiChoice = GameplayInteractiveUIChoice::ChooseOptionB;
+        input.commandInputs.SetCommandValue(InputCommand::Jump, true);
+        FlexArray<CharacterInput, 4> inputs;
+        inputs.Add(input);
+        inputs.Add({});
+
+        uint32_t expected = 123; // Also continue from an earlier checksum, same as chained CalculateCRC32 calls
+        Legacy::AddTransform(transform, expected);
+        Legacy::AddPhysics(physics, expected);
+        Legacy::AddBoxCollider(box, expected);
+        Legacy::AddField(inputs.GetSize(), expected);
+        Legacy::AddCharacterInput(inputs.Get(0), expected);
+        Legacy::AddCharacterInput(inputs.Get(1), expected);
+
+        ChecksumHasher hasher(ChecksumAlgorithm::Crc32Compatible, 123);
+        hasher.Add(transform);
+        hasher.Add(physics);
+        hasher.Add(box);
+        hasher.Add(inputs);
+
+        EXPECT_EQ(expected, hasher.GetResult());
+    }
+
+    TEST_F(ChecksumHasherTests, CalculateCRC32_onEngineTypes_matchesLegacyPerFieldChecksums) {
+        const TransformComponent transform = CreateTransform(42);
+        PhysicsComponent physics = {};
+        physics.mass = 250;
+        physics.velocity = FPVector(fp{1}, fp{-2}, fp{3.5f});
+        const Collider box = CreateBox(FPVector(fp{5}, fp{6}, fp{7}), FPVector(fp{1}, fp{2}, fp{3}));
+        CharacterInput input = {};
+        input.moveForward = fp{0.5f};
+        input.commandInputs.SetCommandValue(InputCommand::Jump, true);
+
+        uint32_t expected = 123;
+        Legacy::AddTransform(transform, expected);
+        Legacy::AddPhysics(physics, expected);
+        Legacy::AddBoxCollider(box, expected);
+        Legacy::AddCharacterInput(input, expected);
+
+        uint32_t actual = 123;
+        transform.CalculateCRC32(actual);
+        physics.CalculateCRC32(actual);
+        box.CalculateCRC32(actual);
+        input.CalculateCRC32(actual);
+
+        EXPECT_EQ(expected, actual);
+    }
+
+    TEST_F(ChecksumHasherTests, Calculate_withCrc32c_onlyDiffersWhenComponentValuesDiffer) {
+        const TransformComponent transform = CreateTransform(42);
+        const TransformComponent sameTransform = CreateTransform(42);
+        const TransformComponent otherTransform = CreateTransform(43);
+        PhysicsComponent physics = {};
+        physics.velocity = FPVector(fp{1}, fp{-100}, fp{0.5f});
+        PhysicsComponent otherPhysics = {};
+        otherPhysics.velocity = FPVector(fp{-0.5f}, fp{100}, fp{0});
+        DynamicColliderComponent collider = {CreateBox(FPVector(fp{1}, fp{-100}, fp{0.5f}), FPVector(fp{1}, fp{2}, fp{3}))};
+        DynamicColliderComponent otherCollider = {CreateBox(FPVector(fp{-0.5f}, fp{100}, fp{0}), FPVector(fp{1}, fp{2}, fp{3}))};
+        HitstopComponent hitstop = {99, 2};
+        HitstopComponent otherHitstop = {100, 3};
+
+        constexpr ChecksumAlgorithm algorithm = ChecksumAlgorithm::Crc32c;
+        EXPECT_EQ(ChecksumHasher::Calculate(algorithm, transform), ChecksumHasher::Calculate(algorithm, sameTransform));
+        EXPECT_NE(ChecksumHasher::Calculate(algorithm, transform), ChecksumHasher::Calculate(algorithm, otherTransform));
+        EXPECT_EQ(ChecksumHasher::Calculate(algorithm, physics), ChecksumHasher::Calculate(algorithm, PhysicsComponent(physics)));
+        EXPECT_NE(ChecksumHasher::Calculate(algorithm, physics), ChecksumHasher::Calculate(algorithm, otherPhysics));
+        EXPECT_NE(ChecksumHasher::Calculate(algorithm, collider), ChecksumHasher::Calculate(algorithm, otherCollider));
+        EXPECT_NE(ChecksumHasher::Calculate(algorithm, hitstop), ChecksumHasher::Calculate(algorithm, otherHitstop));
+    }
+
+    TEST_F(ChecksumHasherTests, Add_whenTypeOnlyDefinesLegacyCalculateCRC32_usesThatMethod) {
+        LegacyOnlyComponent first = {5};
+        LegacyOnlyComponent second = {6};
+
+        uint32_t expected = 0;
+        first.CalculateCRC32(expected);
+        EXPECT_EQ(expected, ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32Compatible, first));
+        EXPECT_NE(ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32c, first),
+                  ChecksumHasher::Calculate(ChecksumAlgorithm::Crc32c, second));
+    }
+
+    TEST_F(ChecksumHasherTests, AddRange_forRawBytesType_matchesAddingEachValue) {
+        std::vector<TransformComponent> transforms;
+        for (int32_t i = 0; i < 50; i++) {
+            transforms.push_back(CreateTransform(i));
+        }
+
+        for (ChecksumAlgorithm algorithm : {ChecksumAlgorithm::Crc32Compatible, ChecksumAlgorithm::Crc32c}) {
+            ChecksumHasher perValue(algorithm);
+            for (const TransformComponent& transform : transforms) {
+                perValue.Add(transform);
+            }
+            ChecksumHasher range(algorithm);
+            range.AddRange(transforms.data(), transforms.size());
+
+            EXPECT_EQ(perValue.GetResult(), range.GetResult());
+        }
+    }
+
+    // Not a correctness test. Run explicitly via --gtest_also_run_disabled_tests to compare a real snapshot capture
+    //      (which checksums while copying) against legacy per-field checksums. Results are recorded as test properties
+    TEST_F(ChecksumHasherTests, DISABLED_Benchmark_registrySnapshotCaptureAgainstLegacyChecksums) {
+        CoreContext context = {};
+        for (int32_t i = 0; i < 2000; i++) {
+            entt::entity entity = context.registry.create();
+            context.registry.emplace<TransformComponent>(entity, CreateTransform(i));
+            context.registry.emplace<PhysicsComponent>(entity).velocity = FPVector(fp{i % 7}, fp{0}, fp{1});
+            if (i % 4 == 0) {
+                context.registry.emplace<DynamicColliderComponent>(entity).collider =
+                    CreateBox(FPVector(fp{i}, fp{0}, fp{0}), FPVector(fp{1}, fp{1}, fp{1}));
+            }
+        }
+        constexpr int kIterations = 20;
+
+        uint32_t legacyChecksum = 0;
+        uint64_t startTime = SharedUtilities::getTimeInMicroseconds();
+        for (int i = 0; i < kIterations; i++) {
+            legacyChecksum = 0;
+            for (auto [entity, transform, physics] : context.registry.view<const TransformComponent, const PhysicsComponent>().each()) {
+                Legacy::AddField(entt::to_integral(entity), legacyChecksum);
+                Legacy::AddTransform(transform, legacyChecksum);
+                Legacy::AddPhysics(physics, legacyChecksum);
+            }
+            for (auto [entity, collider] : context.registry.view<const DynamicColliderComponent>().each()) {
+                Legacy::AddField(entt::to_integral(entity), legacyChecksum);
+                Legacy::AddBoxCollider(collider.collider, legacyChecksum);
+            }
+        }
+        const uint64_t legacyTime = SharedUtilities::getTimeInMicroseconds() - startTime;
+
+        CoreRegistrySnapshot snapshot;
+        snapshot.Capture(context); // Warm up, as steady state captures reuse the already sized buffer
+        startTime = SharedUtilities::getTimeInMicroseconds();
+        for (int i = 0; i < kIterations; i++) {
+            snapshot.Capture(context);
+        }
+        const uint64_t captureTime = SharedUtilities::getTimeInMicroseconds() - startTime;
+
+        EXPECT_NE(0u, legacyChecksum); // Also prevents optimizing away either loop
+        EXPECT_NE(0u, snapshot.CalculateChecksum());
+        RecordProperty("iterations", kIterations);
+        RecordProperty("snapshotBytes", static_cast<int>(snapshot.GetUsedBytes()));
+        RecordProperty("legacyPerFieldCrc32InMicroSec", static_cast<int>(legacyTime));
+        RecordProperty("snapshotCaptureWithChecksumInMicroSec", static_cast<int>(captureTime));
+        RecordProperty("checksumHardwareAccelerated",
+            ChecksumHasher::IsHardwareAccelerated(RollbackStaticSettings::kChecksumAlgorithm) ? 1 : 0);
+    }
+}
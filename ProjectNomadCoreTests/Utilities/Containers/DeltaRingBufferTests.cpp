@@ -0,0 +1,228 @@
+#include "pchNCT.h"
+
+#include <iostream>
+
+#include "Rollback/Model/BaseSnapshot.h"
+#include "TestHelpers/TestHelpers.h"
+#include "Utilities/SharedUtilities.h"
+#include "Utilities/Containers/DeltaRingBuffer.h"
+#include "Utilities/Containers/RingBuffer.h"
+
+using namespace ProjectNomad;
+namespace DeltaRingBufferTests {
+    // Big enough value that deltas should be noticeably smaller than full copies
+    struct LargeTestValue {
+        uint32_t values[512] = {};
+    };
+
+    // Odd size to assure partial "tail" words are handled
+    struct OddSizedTestValue {
+        uint8_t values[13] = {};
+    };
+
+    // Snapshot with a lazily cached checksum stored within its own bytes
+    struct ChecksumTestSnapshot : BaseSnapshot {
+        ChecksumTestSnapshot() = default;
+        explicit ChecksumTestSnapshot(uint32_t value) : value(value) {}
+
+        uint32_t CalculateChecksum() const override {
+            return value * 7 + 1;
+        }
+
+        uint32_t value = 0;
+    };
+
+    class DeltaRingBufferTests : public BaseSimTest {
+      protected:
+        // Simulates typical frame to frame snapshot change: Small portion of data changes
+        static LargeTestValue CreateValueForFrame(uint32_t frame) {
+            LargeTestValue result = {};
+            result.values[0] = frame;
+            result.values[100] = frame * 2;
+            result.values[511] = frame * 3;
+            return result;
+        }
+
+        static void ExpectValueForFrame(uint32_t frame, const LargeTestValue& actual) {
+            LargeTestValue expected = CreateValueForFrame(frame);
+            EXPECT_EQ(0, std::memcmp(&expected, &actual, sizeof(LargeTestValue))) << "Mismatch for frame " << frame;
+        }
+    };
+
+    TEST_F(DeltaRingBufferTests, Get_whenSingleElementInserted_retrievesInsertedElement) {
+        DeltaRingBuffer<LargeTestValue, 4> toTest;
+
+        LargeTestValue toInsert = CreateValueForFrame(1);
+        toTest.SwapInsert(toInsert);
+
+        ExpectValueForFrame(1, toTest.Get(0));
+    }
+
+    TEST_F(DeltaRingBufferTests, Get_whenInsertingMoreElementsThanSize_retrievesAllStoredElements) {
+        DeltaRingBuffer<LargeTestValue, 4> toTest;
+
+        for (uint32_t frame = 0; frame < 10; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+            toTest.SwapInsert(toInsert);
+        }
+
+        ExpectValueForFrame(9, toTest.Get(0));
+        ExpectValueForFrame(8, toTest.Get(-1));
+        ExpectValueForFrame(7, toTest.Get(-2));
+        ExpectValueForFrame(6, toTest.Get(-3));
+    }
+
+    TEST_F(DeltaRingBufferTests, Get_whenValueHasPartialTailWord_retrievesExactValues) {
+        DeltaRingBuffer<OddSizedTestValue, 3> toTest;
+
+        for (uint8_t i = 0; i < 5; i++) {
+            OddSizedTestValue toInsert = {};
+            toInsert.values[12] = i;
+            toTest.SwapInsert(toInsert);
+        }
+
+        EXPECT_EQ(4, toTest.Get(0).values[12]);
+        EXPECT_EQ(3, toTest.Get(-1).values[12]);
+        EXPECT_EQ(2, toTest.Get(-2).values[12]);
+    }
+
+    TEST_F(DeltaRingBufferTests, SwapReplace_whenReplacingMiddleValue_retainsNeighboringValues) {
+        DeltaRingBuffer<LargeTestValue, 4> toTest;
+        for (uint32_t frame = 0; frame < 4; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+            toTest.SwapInsert(toInsert);
+        }
+
+        LargeTestValue replacement = CreateValueForFrame(100);
+        toTest.SwapReplace(-2, replacement);
+
+        ExpectValueForFrame(3, toTest.Get(0));
+        ExpectValueForFrame(2, toTest.Get(-1));
+        ExpectValueForFrame(100, toTest.Get(-2));
+        ExpectValueForFrame(0, toTest.Get(-3));
+    }
+
+    TEST_F(DeltaRingBufferTests, SwapReplace_whenReplacingLatestValue_retainsOlderValues) {
+        DeltaRingBuffer<LargeTestValue, 4> toTest;
+        for (uint32_t frame = 0; frame < 4; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+            toTest.SwapInsert(toInsert);
+        }
+
+        LargeTestValue replacement = CreateValueForFrame(100);
+        toTest.SwapReplace(0, replacement);
+
+        ExpectValueForFrame(100, toTest.Get(0));
+        ExpectValueForFrame(2, toTest.Get(-1));
+        ExpectValueForFrame(1, toTest.Get(-2));
+        ExpectValueForFrame(0, toTest.Get(-3));
+    }
+
+    TEST_F(DeltaRingBufferTests, SwapReplace_whenReplacingRangeInOrder_likeRollbackResimulation_retrievesNewValues) {
+        DeltaRingBuffer<LargeTestValue, 5> toTest;
+        for (uint32_t frame = 0; frame < 5; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+            toTest.SwapInsert(toInsert);
+        }
+
+        // Re-store frames 2 through 4 (oldest to newest) with different data
+        for (int offset = -2; offset <= 0; offset++) {
+            LargeTestValue replacement = CreateValueForFrame(100 + offset);
+            toTest.SwapReplace(offset, replacement);
+        }
+
+        ExpectValueForFrame(100, toTest.Get(0));
+        ExpectValueForFrame(99, toTest.Get(-1));
+        ExpectValueForFrame(98, toTest.Get(-2));
+        ExpectValueForFrame(1, toTest.Get(-3));
+        ExpectValueForFrame(0, toTest.Get(-4));
+    }
+
+    TEST_F(DeltaRingBufferTests, GetChecksum_whenLatestChecksumCachedAfterInsert_olderValuesUseOwnChecksums) {
+        DeltaRingBuffer<ChecksumTestSnapshot, 4> toTest;
+        ChecksumTestSnapshot first(1);
+        toTest.SwapInsert(first);
+        ChecksumTestSnapshot second(2);
+        toTest.SwapInsert(second);
+
+        EXPECT_EQ(ChecksumTestSnapshot(2).CalculateChecksum(), toTest.Get(0).GetChecksum());
+        EXPECT_EQ(ChecksumTestSnapshot(1).CalculateChecksum(), toTest.Get(-1).GetChecksum());
+    }
+
+    TEST_F(DeltaRingBufferTests, GetChecksum_whenLatestChecksumCachedAfterEveryInsert_olderValuesUseOwnChecksums) {
+        DeltaRingBuffer<ChecksumTestSnapshot, 4> toTest;
+        for (uint32_t frame = 0; frame < 12; frame++) {
+            ChecksumTestSnapshot toInsert(frame);
+            toTest.SwapInsert(toInsert);
+            toTest.Get(0).GetChecksum(); // Like sync test, which checksums every newly stored snapshot
+
+            for (uint32_t age = 0; age < 4 && age <= frame; age++) {
+                EXPECT_EQ(
+                    ChecksumTestSnapshot(frame - age).CalculateChecksum(),
+                    toTest.Get(-static_cast<int>(age)).GetChecksum()
+                ) << "Mismatch for frame " << frame - age;
+            }
+        }
+    }
+
+    TEST_F(DeltaRingBufferTests, GetEncodedDeltaBytes_whenFewWordsChange_isMuchSmallerThanFullCopies) {
+        DeltaRingBuffer<LargeTestValue, 4> toTest;
+        for (uint32_t frame = 0; frame < 10; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+            toTest.SwapInsert(toInsert);
+        }
+
+        // 3 deltas with 3 separate runs of 1 changed word each (header + changed word)
+        EXPECT_EQ(3 * 3 * 2 * sizeof(uint64_t), toTest.GetEncodedDeltaBytes());
+        EXPECT_LT(toTest.GetEncodedDeltaBytes(), sizeof(LargeTestValue) * 3);
+    }
+
+    // Not a correctness test. Run explicitly via --gtest_also_run_disabled_tests to compare against full copies
+    TEST_F(DeltaRingBufferTests, DISABLED_Benchmark_bytesPerFrameAndRestoreCost) {
+        constexpr uint32_t kBufferSize = 12; // Same as rollback snapshot window
+        constexpr uint32_t kFramesToStore = 10000;
+
+        RingBuffer<LargeTestValue, kBufferSize> fullCopies;
+        DeltaRingBuffer<LargeTestValue, kBufferSize> deltas;
+
+        uint64_t fullStoreTime = 0;
+        uint64_t deltaStoreTime = 0;
+        uint64_t fullRestoreTime = 0;
+        uint64_t deltaRestoreTime = 0;
+        uint64_t checksum = 0; // Prevents optimizing away retrieval
+
+        for (uint32_t frame = 0; frame < kFramesToStore; frame++) {
+            LargeTestValue toInsert = CreateValueForFrame(frame);
+
+            uint64_t startTime = SharedUtilities::getTimeInMicroseconds();
+            fullCopies.SwapInsert(toInsert);
+            fullStoreTime += SharedUtilities::getTimeInMicroseconds() - startTime;
+
+            toInsert = CreateValueForFrame(frame);
+            startTime = SharedUtilities::getTimeInMicroseconds();
+            deltas.SwapInsert(toInsert);
+            deltaStoreTime += SharedUtilities::getTimeInMicroseconds() - startTime;
+
+            // Restore from deepest possible frame in window
+            if (frame >= kBufferSize) {
+                startTime = SharedUtilities::getTimeInMicroseconds();
+                LargeTestValue restored = fullCopies.Get(-static_cast<int>(kBufferSize - 1));
+                fullRestoreTime += SharedUtilities::getTimeInMicroseconds() - startTime;
+                checksum += restored.values[0];
+
+                startTime = SharedUtilities::getTimeInMicroseconds();
+                restored = deltas.Get(-static_cast<int>(kBufferSize - 1));
+                deltaRestoreTime += SharedUtilities::getTimeInMicroseconds() - startTime;
+                checksum += restored.values[0];
+            }
+        }
+
+        const size_t fullBytesPerFrame = sizeof(LargeTestValue);
+        const size_t deltaBytesPerFrame = (deltas.GetEncodedDeltaBytes() + sizeof(LargeTestValue)) / kBufferSize;
+        std::cout << "Full copies: " << fullBytesPerFrame << " bytes/frame, store " << fullStoreTime
+            << "us total, deepest restore " << fullRestoreTime << "us total" << std::endl;
+        std::cout << "Deltas: " << deltaBytesPerFrame << " bytes/frame, store " << deltaStoreTime
+            << "us total, deepest restore " << deltaRestoreTime << "us total" << std::endl;
+        std::cout << "(Checksum: " << checksum << ")" << std::endl;
+    }
+}
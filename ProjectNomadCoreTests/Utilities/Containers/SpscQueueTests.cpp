@@ -0,0 +1,62 @@
+#include "pchNCT.h"
+
+#include <thread>
+
+#include "TestHelpers/TestHelpers.h"
+#include "Utilities/Containers/SpscQueue.h"
+
+using namespace ProjectNomad;
+namespace SpscQueueTests {
+    class SpscQueueTests : public BaseSimTest {};
+
+    TEST_F(SpscQueueTests, TryPop_whenElementsPushed_returnsInFifoOrder) {
+        SpscQueue<int, 4> toTest;
+        ASSERT_TRUE(toTest.TryPush([](int& slot) { slot = 123; }));
+        ASSERT_TRUE(toTest.TryPush([](int& slot) { slot = 456; }));
+
+        int result = 0;
+        ASSERT_TRUE(toTest.TryPop([&](const int& slot) { result = slot; }));
+        EXPECT_EQ(123, result);
+        ASSERT_TRUE(toTest.TryPop([&](const int& slot) { result = slot; }));
+        EXPECT_EQ(456, result);
+        EXPECT_FALSE(toTest.TryPop([&](const int&) {}));
+    }
+
+    TEST_F(SpscQueueTests, TryPush_whenFull_failsUntilElementPopped) {
+        SpscQueue<int, 2> toTest;
+        ASSERT_TRUE(toTest.TryPush([](int& slot) { slot = 1; }));
+        ASSERT_TRUE(toTest.TryPush([](int& slot) { slot = 2; }));
+
+        EXPECT_FALSE(toTest.TryPush([](int& slot) { slot = 3; }));
+        EXPECT_EQ(2, toTest.GetSize());
+
+        ASSERT_TRUE(toTest.TryPop([](const int&) {}));
+        EXPECT_TRUE(toTest.TryPush([](int& slot) { slot = 3; }));
+    }
+
+    TEST_F(SpscQueueTests, TryPop_whenPushedFromOtherThread_receivesEveryElementInOrder) {
+        constexpr int kNumElements = 100000;
+        SpscQueue<int, 64> toTest;
+
+        std::thread producer([&] {
+            for (int i = 0; i < kNumElements; i++) {
+                while (!toTest.TryPush([i](int& slot) { slot = i; })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int nextExpected = 0;
+        bool wasOrderCorrect = true;
+        while (nextExpected < kNumElements) {
+            toTest.TryPop([&](const int& slot) {
+                wasOrderCorrect &= slot == nextExpected;
+                nextExpected++;
+            });
+        }
+        producer.join();
+
+        EXPECT_TRUE(wasOrderCorrect);
+        EXPECT_EQ(0, toTest.GetSize());
+    }
+}